@@ -5,7 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
-#include <unordered_map>
+#include <array>
 #include "Chunk.hpp"
 #include "Entity.hpp"
 #include "../Span.hpp"
@@ -69,6 +69,15 @@ namespace lstg::ECS
          */
         void Free(ArchetypeEntityId id) noexcept;
 
+        /**
+         * 批量释放 Entity
+         * 先将所有 Entity 放回空闲链表，再按 Component 逐列回收资源，最后清除使用标记，顺序与单个释放一致。
+         * 已经释放或序号不匹配的 Entity 会被忽略，重复的 ID 只释放一次。
+         * @param ids 实例 ID，必须属于当前 Archetype，调用后会被原地压缩为实际释放的实例
+         * @return 实际释放的数量
+         */
+        size_t Free(Span<EntityId> ids) noexcept;
+
         /**
          * 获取实例状态
          * @param id ID
@@ -99,20 +108,22 @@ namespace lstg::ECS
          * @return Component
          */
         template <typename T>
-        T& GetComponent(ArchetypeEntityId id) noexcept
+        ComponentReference<T> GetComponent(ArchetypeEntityId id) noexcept
         {
-            auto component = GetComponent(id, GetComponentId(static_cast<T*>(nullptr)));
-            return *static_cast<T*>(component);
+            assert(id < m_stEntities.size());
+            assert(m_stEntities[id].Used);
+            return GetChunk(GetComponentId(static_cast<T*>(nullptr))).template GetComponent<T>(id);
         }
 
         template <typename T>
-        const T& GetComponent(ArchetypeEntityId id) const noexcept
+        std::conditional_t<IsColumnComponentV<T>, T, const T&> GetComponent(ArchetypeEntityId id) const noexcept
         {
             return const_cast<Archetype*>(this)->GetComponent<T>(id);
         }
 
         /**
          * 获取 Component
+         * 只用于非按列存储的 Component。
          * @param id 实例 ID
          * @param componentId 组件 ID
          * @return 组件内存地址
@@ -131,16 +142,51 @@ namespace lstg::ECS
             return const_cast<Archetype*>(this)->GetComponent(id, componentId);
         }
 
+        /**
+         * 尝试获取 Component
+         * 只用于非按列存储的 Component。
+         * @param id 实例 ID
+         * @param componentId 组件 ID
+         * @return 组件内存地址，若不存在该组件返回 nullptr
+         */
+        void* TryGetComponent(ArchetypeEntityId id, ComponentId componentId) noexcept
+        {
+            assert(id < m_stEntities.size());
+            assert(m_stEntities[id].Used);
+
+            auto chunk = TryGetChunk(componentId);
+            return chunk ? chunk->GetComponentRaw(id) : nullptr;
+        }
+
+        /**
+         * 尝试获取按列存储的 Component 各字段的地址
+         * @param id 实例 ID
+         * @param componentId 组件 ID
+         * @param fields 输出各字段的地址
+         * @return 若不存在该组件返回 false
+         */
+        bool TryGetComponentColumns(ArchetypeEntityId id, ComponentId componentId, void** fields) noexcept
+        {
+            assert(id < m_stEntities.size());
+            assert(m_stEntities[id].Used);
+
+            auto chunk = TryGetChunk(componentId);
+            if (!chunk)
+                return false;
+            chunk->GetComponentColumnsRaw(id, fields);
+            return true;
+        }
+
         /**
          * 获取 Chunk
          * @param componentId 组件ID
          */
         Chunk& GetChunk(ComponentId componentId) noexcept
         {
-            assert((m_uTypeId & (1 << componentId)));
-            auto it = m_stChunks.find(componentId);
-            assert(it != m_stChunks.end());
-            return it->second;
+            assert((m_uTypeId & (static_cast<ArchetypeTypeId>(1u) << componentId)));
+            auto chunk = TryGetChunk(componentId);
+            assert(chunk);
+            return *chunk;
         }
 
         const Chunk& GetChunk(ComponentId componentId) const noexcept
@@ -148,6 +194,21 @@ namespace lstg::ECS
             return const_cast<Archetype*>(this)->GetChunk(componentId);
         }
 
+        /**
+         * 尝试获取 Chunk
+         * @param componentId 组件ID
+         * @return 若不存在该组件返回 nullptr
+         */
+        Chunk* TryGetChunk(ComponentId componentId) noexcept
+        {
+            assert(componentId < kMaxComponentId);
+            auto index = m_stChunkIndex[componentId];
+            if (index == kInvalidChunkIndex)
+                return nullptr;
+            assert(index < m_stChunks.size());
+            return &m_stChunks[index];
+        }
+
         /**
          * 获取分配的内存大小
          */
@@ -159,15 +220,21 @@ namespace lstg::ECS
         size_t GetUsedMemorySize() const noexcept;
 
     private:
+        static constexpr size_t kMaxComponentId = 64;
+        static constexpr uint8_t kInvalidChunkIndex = 0xFFu;
+
         struct EntityInfo : public EntityState
         {
             ArchetypeEntityId Prev = kInvalidArchetypeEntityId;
             ArchetypeEntityId Next = kInvalidArchetypeEntityId;
         };
 
+        void MoveToFreeList(ArchetypeEntityId id) noexcept;
+
         ArchetypeId m_uId = 0u;
         ArchetypeTypeId m_uTypeId = 0u;
-        std::unordered_map<ComponentId, Chunk> m_stChunks;  // 存储 Component[]
+        std::vector<Chunk> m_stChunks;  // 存储 Component[]
+        std::array<uint8_t, kMaxComponentId> m_stChunkIndex;  // ComponentId -> m_stChunks 下标
         std::vector<EntityInfo> m_stEntities;  // 存储所有 Entity
         ArchetypeEntityId m_uFirstUsedEntity = kInvalidArchetypeEntityId;  // 首个使用中的 Entity
         ArchetypeEntityId m_uLastUsedEntity = kInvalidArchetypeEntityId;  // 最后一个使用中的 Entity
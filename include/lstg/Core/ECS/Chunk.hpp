@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <array>
 #include <cassert>
 #include <cstdlib>
 #include <vector>
@@ -16,6 +17,11 @@ namespace lstg::ECS
     /**
      * 块
      * 块用来存储 Component[]。
+     *
+     * 块由若干个固定大小的页组成，扩展时只追加新页而不搬移已有数据，因此 Component 的地址在整个生命周期内保持不变。
+     * 每页可容纳的 Component 数量总是 2 的幂，以便通过移位计算页号和页内偏移。
+     *
+     * 按列存储的 Component（见 ColumnLayout）在每页内为每个字段分配一段连续的内存，各列起始于缓存行边界。
      */
     class Chunk
     {
@@ -39,8 +45,19 @@ namespace lstg::ECS
          */
         [[nodiscard]] size_t GetMemorySize() const noexcept { return m_uMemorySize; }
 
+        /**
+         * 获取每页可以存储的组件数量
+         */
+        [[nodiscard]] size_t GetPageCapacity() const noexcept { return static_cast<size_t>(1u) << m_uPageCapacityShift; }
+
+        /**
+         * 是否按列存储
+         */
+        [[nodiscard]] bool IsColumnar() const noexcept { return m_pDescriptor->ColumnCount != 0; }
+
         /**
          * 扩展空间
+         * 每次扩展分配一个新页，已分配的 Component 地址不会发生变化。
          */
         Result<void> Expand() noexcept;
 
@@ -57,27 +74,41 @@ namespace lstg::ECS
          * @return Component 对象
          */
         template <typename T>
-        T& GetComponent(ArchetypeEntityId index) noexcept
+        ComponentReference<T> GetComponent(ArchetypeEntityId index) noexcept
         {
             assert(GetComponentId(static_cast<T*>(nullptr)) == m_pDescriptor->Id);
-            return *static_cast<T*>(GetComponentRaw(index));
+            if constexpr (IsColumnComponentV<T>)
+            {
+                void* fields[kMaxComponentColumns];
+                GetComponentColumnsRaw(index, fields);
+                return detail::ColumnComponentHelper<T>::MakeView(fields);
+            }
+            else
+            {
+                return *static_cast<T*>(GetComponentRaw(index));
+            }
         }
 
         template <typename T>
-        const T& GetComponent(ArchetypeEntityId index) const noexcept
+        std::conditional_t<IsColumnComponentV<T>, T, const T&> GetComponent(ArchetypeEntityId index) const noexcept
         {
             return const_cast<Chunk*>(this)->GetComponent<T>(index);
         }
 
         /**
          * 获取 Component 原始内存
+         * 只用于非按列存储的 Component。
          * @param index 索引
          * @return Component 原始内存
          */
         void* GetComponentRaw(ArchetypeEntityId index) noexcept
         {
-            auto p = m_pMemory + index * m_pDescriptor->SizeOfComponent;
-            assert(p < m_pMemory + m_uMemorySize);
+            assert(!IsColumnar());
+            assert(index < m_uComponentCapacity);
+            auto page = index >> m_uPageCapacityShift;
+            auto offset = index & ((static_cast<size_t>(1u) << m_uPageCapacityShift) - 1);
+            assert(page < m_stPages.size());
+            auto p = m_stPages[page] + offset * m_pDescriptor->SizeOfComponent;
             return static_cast<void*>(p);
         }
 
@@ -86,13 +117,33 @@ namespace lstg::ECS
             return const_cast<Chunk*>(this)->GetComponentRaw(index);
         }
 
+        /**
+         * 获取按列存储的 Component 各字段的原始内存
+         * @param index 索引
+         * @param fields 输出各字段的地址，至少能容纳 ColumnCount 个元素
+         */
+        void GetComponentColumnsRaw(ArchetypeEntityId index, void** fields) noexcept
+        {
+            assert(IsColumnar());
+            assert(index < m_uComponentCapacity);
+            auto page = index >> m_uPageCapacityShift;
+            auto offset = index & ((static_cast<size_t>(1u) << m_uPageCapacityShift) - 1);
+            assert(page < m_stPages.size());
+            auto base = m_stPages[page];
+            for (size_t i = 0; i < m_pDescriptor->ColumnCount; ++i)
+                fields[i] = static_cast<void*>(base + m_stColumnOffsets[i] + offset * m_pDescriptor->Columns[i].Size);
+        }
+
     private:
+        size_t GetPageSize() const noexcept;
         void FreeMemory() noexcept;
 
     private:
         const ComponentDescriptor* m_pDescriptor = nullptr;
+        size_t m_uPageCapacityShift = 0;  // 每页容纳 1 << N 个 Component
         size_t m_uComponentCapacity = 0;
         size_t m_uMemorySize = 0;
-        uint8_t* m_pMemory = nullptr;
+        std::vector<uint8_t*> m_stPages;
+        std::array<size_t, kMaxComponentColumns> m_stColumnOffsets {};  // 按列存储时各列在页内的偏移
     };
 }
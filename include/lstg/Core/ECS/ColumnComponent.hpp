@@ -0,0 +1,165 @@
+/**
+ * @file
+ * @author 9chu
+ * @date 2022/9/23
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lstg::ECS
+{
+    /**
+     * 按列存储的组件最多包含的字段数
+     */
+    static constexpr size_t kMaxComponentColumns = 8;
+
+    /**
+     * 按列存储的组件布局
+     * 组件类型通过 using Columns = ColumnLayout<TFields...> 声明各个字段的类型，Chunk 在每页中为每个字段分配一段连续的内存（SoA），
+     * 只读写部分字段的遍历因此只会触及这些字段所在的缓存行。
+     *
+     * 此时组件类型本身是由各列元素的引用按声明顺序组成的视图，例如 struct T { A& a; B& b; void Reset() noexcept; }，
+     * GetComponent 按值返回视图，TryGetComponent 返回 ColumnComponentPtr。
+     * @tparam TFields 各列的类型
+     */
+    template <typename... TFields>
+    struct ColumnLayout
+    {
+        static_assert(sizeof...(TFields) > 0 && sizeof...(TFields) <= kMaxComponentColumns);
+        static_assert((std::is_trivially_copyable_v<TFields> && ...));
+        static_assert((std::is_trivially_destructible_v<TFields> && ...));
+
+        using Types = std::tuple<TFields...>;
+    };
+
+    /**
+     * 判断组件是否按列存储
+     */
+    template <typename T, typename = void>
+    struct IsColumnComponent : std::false_type {};
+
+    template <typename T>
+    struct IsColumnComponent<T, std::void_t<typename T::Columns>> : std::true_type {};
+
+    template <typename T>
+    constexpr bool IsColumnComponentV = IsColumnComponent<T>::value;
+
+    namespace detail
+    {
+        template <typename T>
+        struct ColumnComponentHelper
+        {
+        public:
+            using Types = typename T::Columns::Types;
+
+            static constexpr size_t kColumnCount = std::tuple_size_v<Types>;
+
+            template <size_t Index>
+            using FieldType = std::tuple_element_t<Index, Types>;
+
+            /**
+             * 以各列元素的地址构造视图
+             * @param fields 各列元素的地址
+             */
+            static T MakeView(void* const* fields) noexcept
+            {
+                return MakeView(fields, std::make_index_sequence<kColumnCount> {});
+            }
+
+            static void DefaultConstruct(void* const* fields) noexcept
+            {
+                DefaultConstruct(fields, std::make_index_sequence<kColumnCount> {});
+                MakeView(fields).Reset();
+            }
+
+            static void DefaultReset(void* const* fields) noexcept
+            {
+                MakeView(fields).Reset();
+            }
+
+        private:
+            template <size_t... Indices>
+            static T MakeView(void* const* fields, std::index_sequence<Indices...>) noexcept
+            {
+                return T { *static_cast<FieldType<Indices>*>(fields[Indices])... };
+            }
+
+            template <size_t... Indices>
+            static void DefaultConstruct(void* const* fields, std::index_sequence<Indices...>) noexcept
+            {
+                ((new (fields[Indices]) FieldType<Indices>()), ...);
+            }
+        };
+    }
+
+    /**
+     * 按列存储的组件的指针
+     * 持有一个视图，用法与 T* 一致。
+     * 视图由引用组成，即便通过 const 访问也可以修改字段。
+     * @tparam T 组件类型
+     */
+    template <typename T>
+    class ColumnComponentPtr
+    {
+    public:
+        ColumnComponentPtr() noexcept = default;
+        ColumnComponentPtr(std::nullptr_t) noexcept {}
+        explicit ColumnComponentPtr(const T& view) noexcept { m_stView.emplace(view); }
+
+        ColumnComponentPtr(const ColumnComponentPtr& rhs) noexcept
+        {
+            if (rhs.m_stView)
+                m_stView.emplace(*rhs.m_stView);
+        }
+
+        ColumnComponentPtr& operator=(const ColumnComponentPtr& rhs) noexcept
+        {
+            // 视图中的引用无法重新绑定，因此重新构造
+            if (this != &rhs)
+            {
+                m_stView.reset();
+                if (rhs.m_stView)
+                    m_stView.emplace(*rhs.m_stView);
+            }
+            return *this;
+        }
+
+        explicit operator bool() const noexcept { return m_stView.has_value(); }
+
+        const T& operator*() const noexcept
+        {
+            assert(m_stView);
+            return *m_stView;
+        }
+
+        const T* operator->() const noexcept
+        {
+            assert(m_stView);
+            return &*m_stView;
+        }
+
+    private:
+        std::optional<T> m_stView;
+    };
+
+    /**
+     * 组件的引用类型
+     * 按列存储的组件为视图本身，其他组件为 T&。
+     */
+    template <typename T>
+    using ComponentReference = std::conditional_t<IsColumnComponentV<T>, T, T&>;
+
+    /**
+     * 组件的指针类型
+     * 按列存储的组件为 ColumnComponentPtr<T>，其他组件为 T*。
+     */
+    template <typename T>
+    using ComponentPointer = std::conditional_t<IsColumnComponentV<T>, ColumnComponentPtr<T>, T*>;
+}
@@ -5,10 +5,13 @@
 * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
 */
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <utility>
 #include "../Span.hpp"
+#include "ColumnComponent.hpp"
 #include "Entity.hpp"
 
 namespace lstg::ECS
@@ -44,6 +47,16 @@ namespace lstg::ECS
 
     using TypeErasedComponentMethod = void(*)(void*) noexcept;
     using TypeErasedComponentMethod2 = void(*)(void*, void*) noexcept;
+    using TypeErasedColumnComponentMethod = void(*)(void* const*) noexcept;
+
+    /**
+     * 按列存储的组件中单个字段的描述
+     */
+    struct ComponentColumnDescriptor
+    {
+        size_t Size = 0;
+        size_t Align = 0;
+    };
 
     /**
      * 组件描述
@@ -53,27 +66,79 @@ namespace lstg::ECS
         template <typename T>
         static const ComponentDescriptor& GetDescriptor() noexcept
         {
-            static_assert(sizeof(T) % alignof(T) == 0);
-
-            static ComponentDescriptor kDescriptor {
-                GetComponentId(static_cast<T*>(nullptr)),
-                sizeof(T),
-                alignof(T),
-                detail::ComponentHelper<T>::DefaultConstruct,
-                detail::ComponentHelper<T>::DefaultMoveConstructor,
-                detail::ComponentHelper<T>::DefaultDestructor,
-                detail::ComponentHelper<T>::DefaultReset,
-            };
-            return kDescriptor;
+            if constexpr (IsColumnComponentV<T>)
+            {
+                using Helper = detail::ColumnComponentHelper<T>;
+
+                static const auto kColumns = MakeColumnDescriptors<T>(std::make_index_sequence<Helper::kColumnCount> {});
+                static ComponentDescriptor kDescriptor {
+                    GetComponentId(static_cast<T*>(nullptr)),
+                    GetColumnsSize<T>(std::make_index_sequence<Helper::kColumnCount> {}),
+                    GetColumnsAlign<T>(std::make_index_sequence<Helper::kColumnCount> {}),
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    kColumns.data(),
+                    kColumns.size(),
+                    Helper::DefaultConstruct,
+                    Helper::DefaultReset,
+                };
+                return kDescriptor;
+            }
+            else
+            {
+                static_assert(sizeof(T) % alignof(T) == 0);
+
+                static ComponentDescriptor kDescriptor {
+                    GetComponentId(static_cast<T*>(nullptr)),
+                    sizeof(T),
+                    alignof(T),
+                    detail::ComponentHelper<T>::DefaultConstruct,
+                    detail::ComponentHelper<T>::DefaultMoveConstructor,
+                    detail::ComponentHelper<T>::DefaultDestructor,
+                    detail::ComponentHelper<T>::DefaultReset,
+                };
+                return kDescriptor;
+            }
         }
 
         ComponentId Id = 0;
-        size_t SizeOfComponent = 0;
-        size_t AlignOfComponent = 0;
+        size_t SizeOfComponent = 0;  // 按列存储时为各字段大小之和
+        size_t AlignOfComponent = 0;  // 按列存储时为各字段对齐的最大值
         TypeErasedComponentMethod Constructor = nullptr;
         TypeErasedComponentMethod2 MoveConstructor = nullptr;
         TypeErasedComponentMethod Destructor = nullptr;
         TypeErasedComponentMethod Reset = nullptr;
+
+        // 按列存储时有效，方法的参数为各字段的地址，字段总是可平凡析构的
+        const ComponentColumnDescriptor* Columns = nullptr;
+        size_t ColumnCount = 0;
+        TypeErasedColumnComponentMethod ColumnConstructor = nullptr;
+        TypeErasedColumnComponentMethod ColumnReset = nullptr;
+
+    private:
+        template <typename T, size_t... Indices>
+        static auto MakeColumnDescriptors(std::index_sequence<Indices...>) noexcept
+        {
+            using Helper = detail::ColumnComponentHelper<T>;
+            return std::array<ComponentColumnDescriptor, sizeof...(Indices)> {
+                ComponentColumnDescriptor { sizeof(typename Helper::template FieldType<Indices>),
+                    alignof(typename Helper::template FieldType<Indices>) }...
+            };
+        }
+
+        template <typename T, size_t... Indices>
+        static constexpr size_t GetColumnsSize(std::index_sequence<Indices...>) noexcept
+        {
+            return (sizeof(typename detail::ColumnComponentHelper<T>::template FieldType<Indices>) + ...);
+        }
+
+        template <typename T, size_t... Indices>
+        static constexpr size_t GetColumnsAlign(std::index_sequence<Indices...>) noexcept
+        {
+            return std::max({ alignof(typename detail::ColumnComponentHelper<T>::template FieldType<Indices>)... });
+        }
     };
 
     /**
@@ -89,7 +154,7 @@ namespace lstg::ECS
             auto desc = components[i];
             assert(desc);
             assert(desc->Id < 64);
-            ret |= (1 << desc->Id);
+            ret |= (static_cast<ArchetypeTypeId>(1u) << desc->Id);
         }
         return ret;
     }
@@ -97,6 +162,6 @@ namespace lstg::ECS
     template <typename... TComponent>
     constexpr inline ArchetypeTypeId GetArchetypeTypeId() noexcept
     {
-        return ((1u << ComponentDescriptor::GetDescriptor<TComponent>().Id) | ...);
+        return ((static_cast<ArchetypeTypeId>(1u) << ComponentDescriptor::GetDescriptor<TComponent>().Id) | ...);
     }
 }
@@ -8,6 +8,7 @@
 #include <cassert>
 #include <cstdint>
 #include <tuple>
+#include "ColumnComponent.hpp"
 
 namespace lstg::ECS
 {
@@ -163,12 +164,23 @@ namespace lstg::ECS
         /**
          * 获取组件
          * @tparam T 组件类型
-         * @return 组件指针
+         * @return 组件引用，按列存储的组件返回视图
          */
         template <typename T>
-        T& GetComponent() noexcept
+        ComponentReference<T> GetComponent() noexcept
         {
-            return *static_cast<T*>(GetComponent(GetComponentId(static_cast<T*>(nullptr))));
+            if constexpr (IsColumnComponentV<T>)
+            {
+                void* fields[kMaxComponentColumns];
+                auto ret = TryGetComponentColumns(GetComponentId(static_cast<T*>(nullptr)), fields);
+                assert(ret);
+                static_cast<void>(ret);
+                return detail::ColumnComponentHelper<T>::MakeView(fields);
+            }
+            else
+            {
+                return *static_cast<T*>(GetComponent(GetComponentId(static_cast<T*>(nullptr))));
+            }
         }
 
         template <typename T>
@@ -180,12 +192,22 @@ namespace lstg::ECS
         /**
          * 尝试获取组件
          * @tparam T 组件类型
-         * @return 组件指针
+         * @return 组件指针，按列存储的组件返回 ColumnComponentPtr
          */
         template <typename T>
-        T* TryGetComponent() noexcept
+        ComponentPointer<T> TryGetComponent() noexcept
         {
-            return static_cast<T*>(TryGetComponent(GetComponentId(static_cast<T*>(nullptr))));
+            if constexpr (IsColumnComponentV<T>)
+            {
+                void* fields[kMaxComponentColumns];
+                if (!TryGetComponentColumns(GetComponentId(static_cast<T*>(nullptr)), fields))
+                    return nullptr;
+                return ColumnComponentPtr<T> { detail::ColumnComponentHelper<T>::MakeView(fields) };
+            }
+            else
+            {
+                return static_cast<T*>(TryGetComponent(GetComponentId(static_cast<T*>(nullptr))));
+            }
         }
 
         template <typename T>
@@ -203,6 +225,7 @@ namespace lstg::ECS
         bool HasComponent(ComponentId id) const noexcept;
         void* GetComponent(ComponentId id) noexcept;
         void* TryGetComponent(ComponentId id) noexcept;
+        bool TryGetComponentColumns(ComponentId id, void** fields) noexcept;
 
     private:
         World* m_pWorld = nullptr;
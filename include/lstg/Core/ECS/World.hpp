@@ -5,7 +5,9 @@
 * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
 */
 #pragma once
+#include <unordered_map>
 #include "Archetype.hpp"
+#include "../ThreadPool.hpp"
 
 namespace lstg::ECS
 {
@@ -36,6 +38,27 @@ namespace lstg::ECS
             return CreateEntity(Span<const ComponentDescriptor*>(descriptors, std::extent_v<decltype(descriptors)>));
         }
 
+        /**
+         * 延迟销毁实例
+         * 实例在下一次调用 FlushDeferredDestroy 前仍然有效，用于在 VisitEntities 等迭代过程中安全地销毁实例。
+         * 重复提交同一实例是安全的。
+         * @param entity 实例
+         */
+        void DeferDestroy(const Entity& entity) noexcept;
+
+        /**
+         * 销毁所有延迟销毁的实例
+         * 按提交顺序销毁，相邻且属于同一 Archetype 的实例会被批量释放。
+         * 不能在 VisitEntities 的回调中调用。
+         * @return 实际销毁的实例数
+         */
+        size_t FlushDeferredDestroy() noexcept;
+
+        /**
+         * 获取等待销毁的实例数
+         */
+        [[nodiscard]] size_t GetDeferredDestroyCount() const noexcept { return m_stDeferredDestroyEntities.size(); }
+
         /**
          * 访问所有实例
          * @tparam TRet 返回值
@@ -50,6 +73,22 @@ namespace lstg::ECS
             VisitEntitiesHelper<TComponents>{}(this, callback);
         }
 
+        /**
+         * 并行访问所有实例
+         * 按照 Archetype 和实例槽位区间划分任务并分发到线程池上执行，划分方式只取决于 World 的状态，与线程数无关。
+         * 回调会在多个线程上同时执行，因此只能读写当前实例的 Component，且不能创建或销毁实例。
+         * 当实例数较少时退化为 VisitEntities。
+         * @tparam TComponents
+         * @tparam TCallback 回调类型
+         * @param pool 线程池
+         * @param callback
+         */
+        template <typename TComponents, typename TCallback>
+        void ParallelVisitEntities(ThreadPool<>& pool, TCallback callback) noexcept
+        {
+            ParallelVisitEntitiesHelper<TComponents>{}(this, pool, callback);
+        }
+
         /**
          * 获取分配的内存大小
          */
@@ -98,6 +137,88 @@ namespace lstg::ECS
             }
         };
 
+        template <typename TComponents>
+        struct ParallelVisitEntitiesHelper;
+
+        template <typename... TArgs>
+        struct ParallelVisitEntitiesHelper<std::tuple<TArgs...>>
+        {
+            template <typename TCallback>
+            void operator()(World* self, ThreadPool<>& pool, TCallback& callback) noexcept
+            {
+                self->template ParallelVisitEntities<TCallback, TArgs...>(pool, callback);
+            }
+        };
+
+        struct ParallelVisitTask
+        {
+            ArchetypeId Archetype;
+            ArchetypeEntityId Begin;
+            ArchetypeEntityId End;
+        };
+
+        static const size_t kParallelVisitBatchSize = 1024;  // 单个任务覆盖的实例槽位数
+        static const size_t kParallelVisitMinEntities = 4096;  // 启用并行访问所需的最少实例数
+
+        template <typename TCallback, typename... TComponents>
+        void ParallelVisitEntities(ThreadPool<>& pool, TCallback& callback) noexcept
+        {
+            auto archetypeTypeId = GetArchetypeTypeId<TComponents...>();
+
+            // 划分任务
+            size_t entityCount = 0;
+            m_stParallelVisitTasks.clear();
+            try
+            {
+                for (auto& archetype : m_stArchetypes)
+                {
+                    if ((archetype.GetTypeId() & archetypeTypeId) != archetypeTypeId || archetype.GetUsedEntityCount() == 0)
+                        continue;
+
+                    auto capacity = archetype.GetEntityCapacity();
+                    for (size_t begin = 0; begin < capacity; begin += kParallelVisitBatchSize)
+                    {
+                        auto end = std::min(capacity, begin + kParallelVisitBatchSize);
+                        m_stParallelVisitTasks.push_back({ archetype.GetId(), static_cast<ArchetypeEntityId>(begin),
+                            static_cast<ArchetypeEntityId>(end) });
+                    }
+                    entityCount += archetype.GetUsedEntityCount();
+                }
+            }
+            catch (...)  // bad_alloc
+            {
+                m_stParallelVisitTasks.clear();
+            }
+
+            if (entityCount < kParallelVisitMinEntities || m_stParallelVisitTasks.size() <= 1)
+            {
+                VisitEntities<TCallback, TComponents...>(callback);
+                return;
+            }
+
+            // 执行任务
+            auto job = [&](size_t index) noexcept {
+                const auto& task = m_stParallelVisitTasks[index];
+                auto& archetype = m_stArchetypes[task.Archetype];
+
+                Chunk* chunks[sizeof...(TComponents)] = {
+                    &archetype.GetChunk(GetComponentId(static_cast<TComponents*>(nullptr)))...
+                };
+
+                for (auto id = task.Begin; id < task.End; ++id)
+                {
+                    auto state = archetype.GetEntityState(id);
+                    if (!state.Used)
+                        continue;
+
+                    Entity ent {this, CompositeEntityId(state.Seq, archetype.GetId(), id)};
+                    ComponentApplyHelper<TComponents...>{}(ent, callback, chunks, id,
+                        std::make_index_sequence<sizeof...(TComponents)> {});
+                }
+            };
+            pool.ParallelFor(m_stParallelVisitTasks.size(), job);
+        }
+
         template <typename TCallback, typename... TComponents>
         void VisitEntities(TCallback& callback) noexcept
         {
@@ -152,5 +273,7 @@ namespace lstg::ECS
     private:
         std::vector<Archetype> m_stArchetypes;
         std::unordered_map<ArchetypeTypeId, ArchetypeId> m_stArchetypeTypes;  // TypeID -> ID 查找表
+        std::vector<ParallelVisitTask> m_stParallelVisitTasks;  // ParallelVisitEntities 的任务列表
+        std::vector<EntityId> m_stDeferredDestroyEntities;  // 等待销毁的实例
     };
 }
@@ -6,6 +6,7 @@
  */
 #pragma once
 #include <map>
+#include <vector>
 #include "Asset.hpp"
 
 namespace lstg::Subsystem::Asset
@@ -26,6 +27,15 @@ namespace lstg::Subsystem::Asset
             Unused,
         };
 
+    public:
+        /**
+         * 计算资产名的哈希值
+         * 可以预先计算并通过 GetAsset(name, hash) 查找，以便在多个资产池中查找同一名称时只计算一次。
+         * @param name 资产名
+         * @return 哈希值
+         */
+        static uint32_t HashName(std::string_view name) noexcept;
+
     public:
         AssetPool() = default;
         AssetPool(const AssetPool&) = delete;
@@ -33,6 +43,12 @@ namespace lstg::Subsystem::Asset
         ~AssetPool();
 
     public:
+        /**
+         * 获取世代号
+         * 每次增加或删除资产时自增，调用方可以通过比较世代号判断缓存的查找结果是否仍然有效。
+         */
+        [[nodiscard]] uint64_t GetGeneration() const noexcept { return m_uGeneration; }
+
         /**
          * 增加资产
          * @param asset 资产指针
@@ -77,6 +93,14 @@ namespace lstg::Subsystem::Asset
          */
         AssetPtr GetAsset(std::string_view name) const noexcept;
 
+        /**
+         * 获取资产对象
+         * @param name 资产名
+         * @param hash 通过 HashName 计算的资产名哈希值
+         * @return 资产对象，如果没有找到则返回 nullptr
+         */
+        AssetPtr GetAsset(std::string_view name, uint32_t hash) const noexcept;
+
         /**
          * 获取资产对象
          * @param id 资产ID
@@ -102,10 +126,32 @@ namespace lstg::Subsystem::Asset
             return {};
         }
 
+    private:
+        /**
+         * 名称索引的槽位
+         * 槽位直接指向 m_stAssets 中的元素，std::map 的节点地址在删除前保持不变。
+         */
+        struct NameIndexSlot
+        {
+            const AssetPtr* Asset = nullptr;
+            uint32_t Hash = 0;
+            bool Removed = false;  // 墓碑，查找时需要越过
+        };
+
+        size_t FindNameIndexSlot(std::string_view name, uint32_t hash) const noexcept;
+        void ReserveNameIndex(size_t count);
+        void InsertNameIndex(const AssetPtr* asset, uint32_t hash) noexcept;
+        void RemoveNameIndex(std::string_view name) noexcept;
+
     private:
         size_t m_iNextAssetId = 1;
+        uint64_t m_uGeneration = 0;
         std::map<size_t, AssetPtr> m_stAssets;
-        std::map<std::string, size_t, std::less<>> m_stLookupTable;
+
+        // 名称索引，线性探测的开放寻址哈希表，容量总是 2 的幂
+        std::vector<NameIndexSlot> m_stNameIndex;
+        size_t m_uNameIndexCount = 0;
+        size_t m_uNameIndexRemoved = 0;
     };
 
     using AssetPoolPtr = std::shared_ptr<AssetPool>;
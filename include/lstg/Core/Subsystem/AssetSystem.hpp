@@ -68,9 +68,10 @@ namespace lstg::Subsystem
         /**
          * 打开资产流
          * @param path 路径
+         * @param flags 打开标志位
          * @return 流指针
          */
-        Result<VFS::StreamPtr> OpenAssetStream(std::string_view path) noexcept;
+        Result<VFS::StreamPtr> OpenAssetStream(std::string_view path, VFS::FileOpenFlags flags = VFS::FileOpenFlags::None) noexcept;
 
         /**
          * 获取资产流属性
@@ -79,6 +80,15 @@ namespace lstg::Subsystem
          */
         Result<VFS::FileAttribute> GetAssetStreamAttribute(std::string_view path) noexcept;
 
+        /**
+         * 预取资产流
+         * 并行解压给定的资产文件，之后的 OpenAssetStream 将直接命中解压后的数据。
+         * @see VirtualFileSystem::Prefetch
+         * @param paths 路径列表
+         * @return 放入缓存的文件数量
+         */
+        Result<size_t> PrefetchAssetStreams(Span<const std::string_view> paths) noexcept;
+
         /**
          * 注册资产工厂
          */
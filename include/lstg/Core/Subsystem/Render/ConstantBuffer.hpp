@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <cstring>
 #include <string>
 #include "RenderDevice.hpp"
 #include "GraphDef/DefinitionError.hpp"
@@ -116,19 +117,45 @@ namespace lstg::Subsystem::Render
                 return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
 
             // 设置数据
-            assert(field->Offset < m_stBuffer.size() && field->Offset + field->Size <= m_stBuffer.size());
+            auto ret = SetUniform(*field, v);
+            if (!ret)
+                return ret.GetError();
+            return {};
+        }
+
+        /**
+         * 通过字段描述设置变量
+         * 值与当前值一致时不会产生脏数据。
+         * @tparam T 类型
+         * @param field 字段描述，必须属于当前 CBuffer 的定义
+         * @param v 值
+         * @return 值是否发生了变化
+         */
+        template <typename T>
+        Result<bool> SetUniform(const GraphDef::ConstantBufferDefinition::FieldDesc& field, const T& v) noexcept
+        {
+            // 类型检查
+            if (!GraphDef::detail::CBufferTypeChecker<T>{}(field.Type))
+                return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
+
+            // 设置数据
+            assert(field.Offset < m_stBuffer.size() && field.Offset + field.Size <= m_stBuffer.size());
             if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>)  // Bool 特殊处理
             {
                 int32_t val = v ? 1 : 0;
-                assert(field->Size == sizeof(val));
-                CopyFrom(&val, sizeof(val), field->Offset);
+                assert(field.Size == sizeof(val));
+                if (::memcmp(m_stBuffer.data() + field.Offset, &val, sizeof(val)) == 0)
+                    return false;
+                CopyFrom(&val, sizeof(val), field.Offset);
             }
             else
             {
-                assert(field->Size == sizeof(v));
-                CopyFrom(const_cast<T*>(&v), sizeof(v), field->Offset);
+                assert(field.Size == sizeof(v));
+                if (::memcmp(m_stBuffer.data() + field.Offset, &v, sizeof(v)) == 0)
+                    return false;
+                CopyFrom(const_cast<T*>(&v), sizeof(v), field.Offset);
             }
-            return {};
+            return true;
         }
 
     private:
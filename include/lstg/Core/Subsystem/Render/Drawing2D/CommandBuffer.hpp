@@ -57,14 +57,39 @@ namespace lstg::Subsystem::Render::Drawing2D
         ColorRGBA32 Color1 = 0x00000000;  // 在默认2D材质中被当做 MultiplierColor
     };
 
+    /**
+     * 精灵实例
+     * 在顶点着色器中展开为四边形，展开结果与 SpriteDrawing 依次调用 Shape、Texture、Transform、Translate 一致。
+     */
+    struct SpriteInstance
+    {
+        glm::vec3 Position;  // 平移
+        float Rotation = 0.f;  // 旋转，弧度
+        glm::vec4 Shape;  // 宽度、高度、中心X（相对于左边）、中心Y（相对于顶边）
+        glm::vec2 Scale = { 1.f, 1.f };  // 缩放
+        glm::vec4 TexRect;  // U、V、宽度、高度
+        ColorRGBA32 Color0 = 0x000000FF;  // AdditiveColor
+        ColorRGBA32 Color1 = 0xFFFFFFFF;  // MultiplierColor
+    };
+
     /**
      * 命令缓冲
      */
     class CommandBuffer
     {
     public:
+        /**
+         * 绘图命令类型
+         */
+        enum class DrawCommandTypes
+        {
+            Quad,  ///< @brief 四边形，使用顶点与索引缓冲区
+            SpriteInstance,  ///< @brief 精灵实例，使用实例缓冲区
+        };
+
         struct DrawCommand
         {
+            DrawCommandTypes Type = DrawCommandTypes::Quad;  // 命令类型
             ColorBlendMode ColorBlend = ColorBlendMode::Alpha;  // 颜色混合模式
             bool NoDepth = false;  // 是否关闭深度
             FogTypes FogType = FogTypes::Disabled;  // 雾类型
@@ -75,7 +100,9 @@ namespace lstg::Subsystem::Render::Drawing2D
             size_t MaterialId = 0;  // 材质ID
             size_t IndexStart = 0;  // Index起始下标
             size_t IndexCount = 0;  // Index个数
-            size_t BaseVertexIndex = 0;  // 基准顶点索引
+            size_t BaseVertexIndex = 0;  // 基准顶点索引，使用 32 位索引后总是为 0
+            size_t InstanceStart = 0;  // 实例起始下标
+            size_t InstanceCount = 0;  // 实例个数
         };
 
         using DrawCommandContainer = std::vector<DrawCommand>;
@@ -102,7 +129,8 @@ namespace lstg::Subsystem::Render::Drawing2D
         {
             CommandGroupContainer& CommandGroup;
             std::vector<Vertex>& VertexBuffer;
-            std::vector<uint16_t>& IndexBuffer;
+            std::vector<uint32_t>& IndexBuffer;
+            std::vector<SpriteInstance>& InstanceBuffer;
             std::vector<FreeListPtr<CameraPtr>>& CameraList;
             std::vector<TexturePtr>& TextureList;
             std::vector<MaterialPtr>& MaterialList;
@@ -119,9 +147,45 @@ namespace lstg::Subsystem::Render::Drawing2D
 
         /**
          * 完成命令队列收集
+         * 若开启了命令重排，会在此时对每个队列中的命令进行重排与合并。
          */
         DrawData End() noexcept;
 
+        /**
+         * 是否开启命令重排
+         */
+        [[nodiscard]] bool IsReorderEnabled() const noexcept { return m_bReorderEnabled; }
+
+        /**
+         * 设置是否开启命令重排
+         * 开启后，在 End 时会将状态相同的命令合并为一次绘制。
+         * 只有当一个命令的屏幕范围与被越过的所有命令都不相交时才会被提前，因此不会改变渲染结果。
+         * @param enable 是否开启
+         */
+        void SetReorderEnabled(bool enable) noexcept { m_bReorderEnabled = enable; }
+
+        /**
+         * 获取最后一次 End 时重排前的命令个数
+         */
+        [[nodiscard]] size_t GetLastCommandCountBeforeReorder() const noexcept { return m_uLastCommandCountBeforeReorder; }
+
+        /**
+         * 获取最后一次 End 时重排后的命令个数
+         */
+        [[nodiscard]] size_t GetLastCommandCountAfterReorder() const noexcept { return m_uLastCommandCountAfterReorder; }
+
+        /**
+         * 是否开启精灵实例化绘制
+         */
+        [[nodiscard]] bool IsInstancingEnabled() const noexcept { return m_bInstancingEnabled; }
+
+        /**
+         * 设置是否开启精灵实例化绘制
+         * 关闭时 DrawSpriteInstance 总是在 CPU 上展开为四边形。
+         * @param enable 是否开启
+         */
+        void SetInstancingEnabled(bool enable) noexcept { m_bInstancingEnabled = enable; }
+
         /**
          * 通过 ID 查询缓存的纹理
          * @param id ID
@@ -217,6 +281,32 @@ namespace lstg::Subsystem::Render::Drawing2D
          */
         Result<Span<Vertex>> DrawQuadInPlace(TexturePtr tex2d) noexcept;
 
+        /**
+         * 绘制多个四边形
+         * @param tex2d 关联的纹理
+         * @param count 四边形个数，必须大于 0
+         * @return 如果成功，返回连续的 4 * count 个顶点，否则返回错误
+         */
+        Result<Span<Vertex>> DrawQuadsInPlace(TexturePtr tex2d, size_t count) noexcept;
+
+        /**
+         * 绘制精灵实例
+         * 实例数据在顶点着色器中展开。由于自定义材质不一定提供实例化的 Pass，设置了材质或未开启实例化时在 CPU 上展开为四边形。
+         * @param tex2d 关联的纹理
+         * @param instance 实例数据
+         * @return 是否成功
+         */
+        Result<void> DrawSpriteInstance(TexturePtr tex2d, const SpriteInstance& instance) noexcept;
+
+        /**
+         * 批量绘制使用相同纹理的精灵实例
+         * 在 CPU 上展开时使用 TransformSpriteInstances 一次处理所有实例。
+         * @param tex2d 关联的纹理
+         * @param instances 实例数据
+         * @return 是否成功
+         */
+        Result<void> DrawSpriteInstances(TexturePtr tex2d, Span<const SpriteInstance> instances) noexcept;
+
         /**
          * 清空颜色和 ZBuffer
          * @param color 颜色
@@ -234,6 +324,8 @@ namespace lstg::Subsystem::Render::Drawing2D
         Result<void> InstantialGroup() noexcept;
         Result<void> InstantialQueue() noexcept;
         Result<void> InstantialCommand() noexcept;
+        Result<void> InstantialCommand(DrawCommandTypes type, size_t textureId, size_t materialId) noexcept;
+        void ReorderQueue(CommandQueue& queue);
 
     private:
         struct CameraStateKey
@@ -267,6 +359,21 @@ namespace lstg::Subsystem::Render::Drawing2D
 
         using UniqueCameraCache = std::unordered_map<CameraStateKey, size_t, CameraStateKeyHasher>;
 
+        struct ReorderBatch
+        {
+            size_t FirstCommand = 0;  // 批次中的首个命令，用于比较状态
+            size_t LastCommand = 0;  // 批次中的最后一个命令，用于追加
+            size_t IndexCount = 0;  // 批次中的索引总数
+
+            // 批次中所有命令在 NDC 下的包围盒
+            float MinX = 0.f;
+            float MinY = 0.f;
+            float MaxX = 0.f;
+            float MaxY = 0.f;
+        };
+
+        static constexpr size_t kReorderSearchWindow = 32;  // 合并时最多向前检查的批次数
+
         // 资源池
         FreeList<CameraPtr> m_stCameraFreeList;
         FreeList<CommandGroup> m_stCommandGroupFreeList;
@@ -281,9 +388,9 @@ namespace lstg::Subsystem::Render::Drawing2D
         std::map<Material*, size_t> m_stMaterialMapping;
 
         // 正在生成的图元
-        size_t m_uCurrentBaseVertexIndex = 0;
         std::vector<Vertex> m_stVertices;
-        std::vector<uint16_t> m_stIndexes;
+        std::vector<uint32_t> m_stIndexes;
+        std::vector<SpriteInstance> m_stInstances;
 
         // 正在生成的命令组
         CommandGroupContainer m_stCommandGroups;
@@ -304,5 +411,15 @@ namespace lstg::Subsystem::Render::Drawing2D
         float m_fCurrentFogArg1 = 0.f;
         float m_fCurrentFogArg2 = 0.f;
         ColorRGBA32 m_stCurrentFogColor = 0x00000000;  // 雾颜色
+        bool m_bInstancingEnabled = false;
+
+        // 命令重排
+        bool m_bReorderEnabled = false;
+        size_t m_uLastCommandCountBeforeReorder = 0;
+        size_t m_uLastCommandCountAfterReorder = 0;
+        std::vector<ReorderBatch> m_stReorderBatches;
+        std::vector<size_t> m_stReorderNextCommand;  // 同一批次中的下一个命令
+        std::vector<uint32_t> m_stReorderIndexes;
+        DrawCommandContainer m_stReorderCommands;
     };
 }
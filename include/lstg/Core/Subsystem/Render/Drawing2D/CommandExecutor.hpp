@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <optional>
 #include "../Material.hpp"
 #include "../Mesh.hpp"
 #include "CommandBuffer.hpp"
@@ -34,32 +35,52 @@ namespace lstg::Subsystem::Render::Drawing2D
         size_t GetLastExecutedDrawCalls() const noexcept { return m_uDrawCalls; }
 
     protected:
+        // 渲染状态键
+        // 位 0-1 为混合模式，位 2 为是否关闭深度，位 3-4 为雾类型，位 5 为是否实例化绘制
+        static constexpr uint32_t kRenderStateKeyCount = 4 * 2 * 4 * 2;
+
+        static uint32_t MakeRenderStateKey(ColorBlendMode blend, bool noDepth, FogTypes fog, bool instanced) noexcept
+        {
+            return static_cast<uint32_t>(blend) | (noDepth ? 0x4u : 0u) | (static_cast<uint32_t>(fog) << 3u) | (instanced ? 0x20u : 0u);
+        }
+
         virtual const GraphDef::EffectPassGroupDefinition* OnSelectEffectGroup(const GraphDef::EffectDefinition* effect,
-            const std::map<std::string, std::string, std::less<>>& tags) noexcept;
+            uint32_t stateKey) noexcept;
         virtual void OnDrawGroup(CommandBuffer::DrawData& drawData, CommandBuffer::CommandGroup& groupData) noexcept;
         virtual void OnDrawQueue(CommandBuffer::DrawData& drawData, CommandBuffer::CommandQueue& queueData) noexcept;
 
     protected:
         struct SelectableEffectPassGroups
         {
-            const GraphDef::EffectPassGroupDefinition* AlphaBlendGroup[2] = { nullptr, nullptr };
-            const GraphDef::EffectPassGroupDefinition* AddBlendGroup[2] = { nullptr, nullptr };
-            const GraphDef::EffectPassGroupDefinition* SubtractBlendGroup[2] = { nullptr, nullptr };
-            const GraphDef::EffectPassGroupDefinition* ReverseSubtractBlendGroup[2] = { nullptr, nullptr };
+            const GraphDef::EffectPassGroupDefinition* Groups[kRenderStateKeyCount] = {};  // 以渲染状态键为下标
         };
 
+        struct MaterialSlots
+        {
+            Render::MaterialPtr Owner;  // 持有材质，保证作为键的地址在缓存期间不被复用
+            std::optional<Render::Material::UniformSlot> FogType;
+            std::optional<Render::Material::UniformSlot> FogColorRGBA32;
+            std::optional<Render::Material::UniformSlot> FogArg1;
+            std::optional<Render::Material::UniformSlot> FogArg2;
+            std::optional<Render::Material::TextureSlot> MainTexture;
+        };
+
+        MaterialSlots* GetMaterialSlots(const Render::MaterialPtr& material) noexcept;
+
         RenderSystem& m_stRenderSystem;
         Render::TexturePtr m_pDefaultTexture;
         Render::MaterialPtr m_pDefaultMaterial;
         Render::MeshPtr m_pMesh;
-
-        // 临时变量
-        std::string m_stOldBlendTag;
-        std::string m_stOldDepthDisabledTag;
+        Render::MeshPtr m_pInstanceMesh;  // 精灵实例使用的网格，顶点为四边形的四个角点
 
         // 效果选择器
         LRUCache<const GraphDef::EffectDefinition*, SelectableEffectPassGroups, 16> m_stEffectGroupSelector;
 
+        // 材质槽位
+        LRUCache<const Render::Material*, MaterialSlots, 16> m_stMaterialSlots;
+        const Render::Material* m_pLastSlotsMaterial = nullptr;
+        MaterialSlots* m_pLastSlots = nullptr;
+
         // 数据统计
         size_t m_uDrawCalls = 0;
     };
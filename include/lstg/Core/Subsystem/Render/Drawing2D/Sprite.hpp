@@ -110,6 +110,52 @@ namespace lstg::Subsystem::Render::Drawing2D
          */
         Result<SpriteDrawing> Draw(CommandBuffer& buffer, std::optional<ColorBlendMode> blendModeOverride = {}) const noexcept;
 
+        /**
+         * 以精灵实例的方式绘制
+         * 变换顺序与 Draw 后依次调用 Transform、Translate 一致。四个顶点的颜色不一致时退化为四边形绘制。
+         * @param buffer 绘制缓冲区
+         * @param position 平移
+         * @param rotation 旋转，弧度
+         * @param scale 缩放
+         * @param blendModeOverride 混合模式覆盖
+         * @return 是否成功
+         */
+        Result<void> DrawInstance(CommandBuffer& buffer, glm::vec3 position, float rotation, glm::vec2 scale,
+            std::optional<ColorBlendMode> blendModeOverride = {}) const noexcept;
+
+        /**
+         * 四个顶点的颜色是否一致
+         * 只有颜色一致时才能通过 MakeInstance 与 DrawInstances 批量绘制。
+         */
+        [[nodiscard]] bool IsUniformColor() const noexcept { return m_bUniformColor; }
+
+        /**
+         * 构造精灵实例
+         * @param position 平移
+         * @param rotation 旋转，弧度
+         * @param scale 缩放
+         * @return 实例数据
+         */
+        [[nodiscard]] SpriteInstance MakeInstance(glm::vec3 position, float rotation, glm::vec2 scale) const noexcept
+        {
+            auto instance = m_stPrecomputedInstance;
+            instance.Position = position;
+            instance.Rotation = rotation;
+            instance.Scale = scale;
+            return instance;
+        }
+
+        /**
+         * 批量绘制由 MakeInstance 构造的实例
+         * @pre IsUniformColor() 为真
+         * @param buffer 绘制缓冲区
+         * @param instances 实例
+         * @param blendModeOverride 混合模式覆盖
+         * @return 是否成功
+         */
+        Result<void> DrawInstances(CommandBuffer& buffer, Span<const SpriteInstance> instances,
+            std::optional<ColorBlendMode> blendModeOverride = {}) const noexcept;
+
     private:
         void PrecomputedVertex(int what) noexcept;
 
@@ -121,5 +167,7 @@ namespace lstg::Subsystem::Render::Drawing2D
         SpriteColorComponents m_stAdditiveBlendColor = { 0x000000FFu, 0x000000FFu, 0x000000FFu, 0x000000FFu };
         SpriteColorComponents m_stMultiplyBlendColor = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu };
         std::array<Vertex, 4> m_stPrecomputedVertex;
+        SpriteInstance m_stPrecomputedInstance;
+        bool m_bUniformColor = true;  // 四个顶点的颜色是否一致，此时可以使用实例绘制
     };
 }
@@ -0,0 +1,53 @@
+/**
+ * @file
+ * @date 2022/9/18
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include "../../../Span.hpp"
+#include "CommandBuffer.hpp"
+
+namespace lstg::Subsystem::Render::Drawing2D
+{
+    /**
+     * 精灵变换内核
+     */
+    enum class SpriteTransformKernels
+    {
+        Scalar,
+        SSE2,  ///< @brief 每次处理 4 个精灵
+        AVX2,  ///< @brief 每次处理 8 个精灵，运行时检测 CPU 支持
+        NEON,  ///< @brief 每次处理 4 个精灵
+    };
+
+    /**
+     * 获取当前使用的精灵变换内核
+     * 首次调用时根据编译平台和 CPU 特性选择。
+     */
+    SpriteTransformKernels GetSpriteTransformKernel() noexcept;
+
+    /**
+     * 检查内核在当前平台上是否可用
+     * @param kernel 内核
+     */
+    bool IsSpriteTransformKernelSupported(SpriteTransformKernels kernel) noexcept;
+
+    /**
+     * 将精灵实例批量展开为四边形顶点
+     * 展开结果与 SpriteDrawing 依次调用 Shape、Texture、SetAdditiveColor、SetMultiplyColor、Transform、Translate 一致。
+     * 平台支持时以 SoA 形式每次使用 SIMD 处理多个精灵，内核由 GetSpriteTransformKernel 决定。
+     * @param output 输出顶点，大小必须为实例个数的四倍
+     * @param instances 实例
+     */
+    void TransformSpriteInstances(Span<Vertex> output, Span<const SpriteInstance> instances) noexcept;
+
+    /**
+     * 使用指定内核将精灵实例批量展开为四边形顶点
+     * 用于校验与性能测试，内核必须可用。
+     * @param kernel 内核
+     * @param output 输出顶点，大小必须为实例个数的四倍
+     * @param instances 实例
+     */
+    void TransformSpriteInstances(SpriteTransformKernels kernel, Span<Vertex> output, Span<const SpriteInstance> instances) noexcept;
+}
@@ -73,13 +73,15 @@ namespace lstg::Subsystem::Render::GraphDef
         {
             VertexElementType Type;
             VertexElementSemantic Semantic;  // 用于和 VertexShader 进行关联
-            size_t Offset = 0;  // 相对于当前顶点的偏移
+            size_t Offset = 0;  // 相对于当前顶点（或实例）的偏移
+            bool PerInstance = false;  // 是否为逐实例数据，逐实例数据存放于独立的实例缓冲区中
 
             bool operator==(const VertexElement& rhs) const noexcept
             {
                 return Type == rhs.Type &&
                     Semantic == rhs.Semantic &&
-                    Offset == rhs.Offset;
+                    Offset == rhs.Offset &&
+                    PerInstance == rhs.PerInstance;
             }
         };
 
@@ -110,15 +112,28 @@ namespace lstg::Subsystem::Render::GraphDef
          */
         void SetVertexStride(size_t stride) noexcept { m_iVertexStride = stride; }
 
+        /**
+         * 获取单个实例的大小
+         * 为 0 时网格不包含逐实例数据。
+         */
+        [[nodiscard]] size_t GetInstanceStride() const noexcept { return m_iInstanceStride; }
+
+        /**
+         * 设置单个实例的大小
+         * @param stride 大小
+         */
+        void SetInstanceStride(size_t stride) noexcept { m_iInstanceStride = stride; }
+
         /**
          * 增加顶点元素定义
          * @pre !ContainsSemantic(semantic)
          * @param type 类型
          * @param semantic 语义
          * @param offset 偏移
+         * @param perInstance 是否为逐实例数据
          * @return 是否成功
          */
-        Result<void> AddVertexElement(VertexElementType type, VertexElementSemantic semantic, size_t offset) noexcept;
+        Result<void> AddVertexElement(VertexElementType type, VertexElementSemantic semantic, size_t offset, bool perInstance = false) noexcept;
 
         /**
          * 是否包含语义
@@ -139,6 +154,7 @@ namespace lstg::Subsystem::Render::GraphDef
     private:
         PrimitiveTopologyTypes m_iTopologyType = PrimitiveTopologyTypes::TriangleList;
         size_t m_iVertexStride = 0;
+        size_t m_iInstanceStride = 0;
         std::vector<VertexElement> m_stVertexElements;
     };
 
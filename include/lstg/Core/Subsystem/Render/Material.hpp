@@ -31,6 +31,31 @@ namespace lstg::Subsystem::Render
     {
         friend class lstg::Subsystem::RenderSystem;
 
+        struct TextureVariableState;
+
+    public:
+        /**
+         * 变量槽位
+         * 通过 GetUniformSlot 预先解析符号，之后设置变量时不再需要查找。
+         * 槽位仅对解析它的材质有效。
+         */
+        struct UniformSlot
+        {
+            ConstantBuffer* Buffer = nullptr;
+            const GraphDef::ConstantBufferDefinition::FieldDesc* Field = nullptr;
+        };
+
+        /**
+         * 纹理槽位
+         * 通过 GetTextureSlot 预先解析符号，之后设置纹理时不再需要查找。
+         * 槽位仅对解析它的材质有效。
+         */
+        struct TextureSlot
+        {
+            const GraphDef::ShaderTextureDefinition* Definition = nullptr;
+            TextureVariableState* State = nullptr;
+        };
+
     public:
         Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr definition, const TexturePtr& defaultTex2D);
         Material(const Material&) = delete;
@@ -77,23 +102,30 @@ namespace lstg::Subsystem::Render
         template <typename T>
         Result<void> SetUniform(std::string_view symbol, const T& value) noexcept
         {
-            auto info = m_pDefinition->GetSymbol(symbol);
-            if (!info)
-                return make_error_code(GraphDef::DefinitionError::SymbolNotFound);
-
-            // 只能设置 Uniform
-            // Global Uniform 需要在外部进行设置
-            if (info->Type != GraphDef::ShaderDefinition::SymbolTypes::Uniform)
-                return make_error_code(std::errc::invalid_argument);
+            auto slot = GetUniformSlot(symbol);
+            if (!slot)
+                return slot.GetError();
+            return SetUniform(*slot, value);
+        }
 
-            // 找到对应的 CBuffer
-            auto cb = std::get<GraphDef::EffectDefinition::UniformSymbolInfo>(info->AssocInfo).Definition;
-            auto it = m_stCBufferInstances.find(cb.get());
-            assert(it != m_stCBufferInstances.end());
-            auto ret = it->second->SetUniform(symbol, value);
-            if (ret)
+        /**
+         * 通过槽位设置变量
+         * 值未发生变化时不会使材质变脏。
+         * @tparam T 类型
+         * @param slot 槽位
+         * @param value 值
+         * @return 是否成功
+         */
+        template <typename T>
+        Result<void> SetUniform(const UniformSlot& slot, const T& value) noexcept
+        {
+            assert(slot.Buffer && slot.Field);
+            auto ret = slot.Buffer->SetUniform(*slot.Field, value);
+            if (!ret)
+                return ret.GetError();
+            if (*ret)
                 m_bCBufferDirty = true;
-            return ret;
+            return {};
         }
 
         /**
@@ -104,6 +136,29 @@ namespace lstg::Subsystem::Render
          */
         Result<void> SetTexture(std::string_view symbol, const TexturePtr& texture) noexcept;
 
+        /**
+         * 通过槽位设置纹理
+         * 纹理未发生变化时不会使材质变脏。
+         * @param slot 槽位
+         * @param texture 纹理指针
+         * @return 是否成功
+         */
+        Result<void> SetTexture(const TextureSlot& slot, const TexturePtr& texture) noexcept;
+
+        /**
+         * 解析变量槽位
+         * @param symbol 符号
+         * @return 槽位
+         */
+        Result<UniformSlot> GetUniformSlot(std::string_view symbol) const noexcept;
+
+        /**
+         * 解析纹理槽位
+         * @param symbol 符号
+         * @return 槽位
+         */
+        Result<TextureSlot> GetTextureSlot(std::string_view symbol) noexcept;
+
     private:
         /**
          * 提交数据
@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <vector>
 #include "RenderDevice.hpp"
 #include "GraphDef/MeshDefinition.hpp"
 #include "../../Flag.hpp"
@@ -13,6 +14,7 @@
 namespace Diligent
 {
     struct IBuffer;
+    struct IFence;
 }
 
 namespace lstg::Subsystem
@@ -37,8 +39,20 @@ namespace lstg::Subsystem::Render
         };
 
     public:
-        Mesh(RenderDevice& device, GraphDef::ImmutableMeshDefinitionPtr definition, Diligent::IBuffer* vertexBuffer,
-            Diligent::IBuffer* indexBuffer, bool use32BitsIndex, Usage usage);
+        /**
+         * 构造网格
+         * @param device 渲染设备
+         * @param definition 网格定义
+         * @param vertexBuffer 顶点缓冲区，不持有原生对象的设备上为空
+         * @param vertexBufferSize 顶点缓冲区大小
+         * @param indexBuffer 索引缓冲区，不持有原生对象的设备上为空
+         * @param indexBufferSize 索引缓冲区大小
+         * @param use32BitsIndex 是否使用 32 位索引
+         * @param usage 用途
+         * @param dynamicBufferCount 动态网格轮换使用的缓冲区组数，大于 1 时每次 Commit 写入一组 GPU 不再使用的缓冲区
+         */
+        Mesh(RenderDevice& device, GraphDef::ImmutableMeshDefinitionPtr definition, Diligent::IBuffer* vertexBuffer, size_t vertexBufferSize,
+            Diligent::IBuffer* indexBuffer, size_t indexBufferSize, bool use32BitsIndex, Usage usage, size_t dynamicBufferCount = 1);
         ~Mesh();
 
     public:
@@ -67,13 +81,56 @@ namespace lstg::Subsystem::Render
          */
         [[nodiscard]] size_t GetIndexCount() const noexcept;
 
+        /**
+         * 获取实例个数
+         * 网格定义不包含逐实例数据或尚未提交实例数据时返回 0。
+         */
+        [[nodiscard]] size_t GetInstanceCount() const noexcept;
+
+        /**
+         * 获取动态网格轮换使用的缓冲区组数
+         */
+        [[nodiscard]] size_t GetDynamicBufferCount() const noexcept { return m_stDynamicBuffers.empty() ? 1 : m_stDynamicBuffers.size(); }
+
         /**
          * 提交数据
+         * 当存在多组缓冲区时，先切换到下一组缓冲区再写入，仅当 GPU 落后超过缓冲区组数时才会等待。
          * @param vertexData 顶点数据
          * @param indexData 索引数据
          * @return 结果
          */
-        Result<void> Commit(Span<const uint8_t> vertexData, Span<const uint8_t> indexData) noexcept;
+        Result<void> Commit(Span<const uint8_t> vertexData, Span<const uint8_t> indexData) noexcept
+        {
+            return Commit(vertexData, indexData, {});
+        }
+
+        /**
+         * 提交数据
+         * @param vertexData 顶点数据
+         * @param indexData 索引数据
+         * @param instanceData 实例数据，为空时不写入实例缓冲区
+         * @return 结果
+         */
+        Result<void> Commit(Span<const uint8_t> vertexData, Span<const uint8_t> indexData, Span<const uint8_t> instanceData) noexcept;
+
+    private:
+        struct BufferSizes
+        {
+            size_t Vertex = 0;
+            size_t Index = 0;
+            size_t Instance = 0;
+        };
+
+        struct DynamicBufferSet
+        {
+            Diligent::IBuffer* VertexBuffer = nullptr;
+            Diligent::IBuffer* IndexBuffer = nullptr;
+            Diligent::IBuffer* InstanceBuffer = nullptr;
+            BufferSizes Sizes;
+            uint64_t FenceValue = 0;  // GPU 完成到该值后缓冲区可以再次写入
+        };
+
+        void SwitchDynamicBuffers() noexcept;
 
     private:
         RenderDevice& m_stDevice;
@@ -82,6 +139,15 @@ namespace lstg::Subsystem::Render
         Usage m_iUsage = Usage::Static;
         Diligent::IBuffer* m_pVertexBuffer = nullptr;
         Diligent::IBuffer* m_pIndexBuffer = nullptr;
+        Diligent::IBuffer* m_pInstanceBuffer = nullptr;  // 仅当网格包含逐实例数据时使用，在首次提交时创建
+        BufferSizes m_stBufferSizes;  // 不依赖原生对象记录各缓冲区的大小
+
+        // 轮换缓冲区
+        // 下标 m_uCurrentBuffers 对应的缓冲区由 m_pVertexBuffer / m_pIndexBuffer / m_pInstanceBuffer 持有，其他条目持有空闲中的缓冲区
+        std::vector<DynamicBufferSet> m_stDynamicBuffers;
+        size_t m_uCurrentBuffers = 0;
+        Diligent::IFence* m_pFence = nullptr;
+        uint64_t m_ullLastFenceValue = 0;
     };
 
     using MeshPtr = std::shared_ptr<Mesh>;
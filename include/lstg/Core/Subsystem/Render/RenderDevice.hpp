@@ -5,22 +5,74 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <lstg/Core/Exception.hpp>
+#include "../../Span.hpp"
+#include "../../Result.hpp"
 
 namespace Diligent
 {
     struct IRenderDevice;
     struct IDeviceContext;
     struct ISwapChain;
+    struct IDeviceObject;
+    struct IBuffer;
+    struct ITexture;
+    struct ITextureView;
+    struct IFence;
+    struct IShader;
+    struct IPipelineResourceSignature;
+    struct IPipelineState;
+    struct IShaderResourceBinding;
+    struct IShaderResourceVariable;
+    struct SwapChainDesc;
+    struct BufferDesc;
+    struct BufferData;
+    struct TextureDesc;
+    struct TextureData;
+    struct TextureSubResData;
+    struct FenceDesc;
+    struct ShaderCreateInfo;
+    struct PipelineResourceSignatureDesc;
+    struct GraphicsPipelineStateCreateInfo;
+    struct Viewport;
+    struct Rect;
+    struct Box;
+    struct DrawIndexedAttribs;
+}
+
+namespace lstg::Subsystem::Render
+{
+    class Texture;
+}
+
+namespace lstg::Subsystem::Render::GraphDef
+{
+    class ShaderDefinition;
 }
 
 namespace lstg::Subsystem::Render
 {
     LSTG_DEFINE_EXCEPTION(RenderDeviceInitializeFailedException);
 
+    /**
+     * 纹理视图类型
+     */
+    enum class TextureViewTypes
+    {
+        ShaderResource,
+        RenderTarget,
+        DepthStencil,
+    };
+
     /**
      * 渲染设备
      * 由 DiligentEngine 完成抽象，不对应用暴露 DiligentEngine。
+     *
+     * 资源对象与 RenderSystem 对 DiligentEngine 的调用均经由下述虚方法转发，默认实现直接调用 DiligentEngine。
+     * 不持有 DiligentEngine 对象的设备（如 RenderDeviceNull）覆写这些方法：创建方法成功返回空的原生对象，其余方法不做任何事。
      */
     class RenderDevice
     {
@@ -56,13 +108,13 @@ namespace lstg::Subsystem::Render
 
         /**
          * 获取渲染画面宽度
-         * 转发到 SwapChain.GetDesc().Width
+         * 转发到 GetSwapChainDesc().Width
          */
         [[nodiscard]] uint32_t GetRenderOutputWidth() const noexcept;
 
         /**
          * 获取渲染画面高度
-         * 转发到 SwapChain.GetDesc().Height
+         * 转发到 GetSwapChainDesc().Height
          */
         [[nodiscard]] uint32_t GetRenderOutputHeight() const noexcept;
 
@@ -77,6 +129,224 @@ namespace lstg::Subsystem::Render
          */
         virtual void Present() noexcept;
 
+    public:  // 交换链
+        /**
+         * 获取交换链描述
+         */
+        [[nodiscard]] virtual const Diligent::SwapChainDesc& GetSwapChainDesc() const noexcept;
+
+        /**
+         * 调整交换链大小
+         * @param width 宽度
+         * @param height 高度
+         */
+        virtual void ResizeSwapChain(uint32_t width, uint32_t height) noexcept;
+
+        /**
+         * 获取交换链当前后台缓冲区的 RT 视图
+         */
+        [[nodiscard]] virtual Diligent::ITextureView* GetBackBufferRenderTargetView() noexcept;
+
+        /**
+         * 获取交换链的深度缓冲区视图
+         */
+        [[nodiscard]] virtual Diligent::ITextureView* GetBackBufferDepthStencilView() noexcept;
+
+    public:  // 资源
+        /**
+         * 获取动态网格需要轮换的缓冲区组数
+         * 默认为 1，即由驱动或 DiligentEngine 完成缓冲区重命名。
+         */
+        [[nodiscard]] virtual size_t GetDynamicMeshBufferCount() const noexcept;
+
+        /**
+         * 创建缓冲区
+         * @param desc 描述
+         * @param data 初始数据，可以为空
+         * @param[out] buffer 输出缓冲区，由调用方持有引用
+         */
+        virtual Result<void> CreateBuffer(const Diligent::BufferDesc& desc, const Diligent::BufferData* data,
+            Diligent::IBuffer** buffer) noexcept;
+
+        /**
+         * 创建纹理
+         * @param desc 描述
+         * @param data 初始数据，可以为空
+         * @return 纹理对象
+         */
+        virtual Result<std::shared_ptr<Texture>> CreateTexture(const Diligent::TextureDesc& desc, const Diligent::TextureData* data) noexcept;
+
+        /**
+         * 创建 Fence
+         * @param desc 描述
+         * @param[out] fence 输出 Fence，由调用方持有引用
+         */
+        virtual Result<void> CreateFence(const Diligent::FenceDesc& desc, Diligent::IFence** fence) noexcept;
+
+        /**
+         * 编译 Shader
+         * @param createInfo 参数
+         * @param[out] shader 输出 Shader，由调用方持有引用
+         */
+        virtual Result<void> CreateShader(const Diligent::ShaderCreateInfo& createInfo, Diligent::IShader** shader) noexcept;
+
+        /**
+         * 创建 PRS
+         * @param desc 描述
+         * @param[out] signature 输出 PRS，由调用方持有引用
+         */
+        virtual Result<void> CreatePipelineResourceSignature(const Diligent::PipelineResourceSignatureDesc& desc,
+            Diligent::IPipelineResourceSignature** signature) noexcept;
+
+        /**
+         * 创建 SRB
+         * @param signature PRS
+         * @param[out] binding 输出 SRB，由调用方持有引用
+         */
+        virtual Result<void> CreateShaderResourceBinding(Diligent::IPipelineResourceSignature* signature,
+            Diligent::IShaderResourceBinding** binding) noexcept;
+
+        /**
+         * 创建 PSO
+         * @param createInfo 参数
+         * @param[out] pipelineState 输出 PSO，由调用方持有引用
+         */
+        virtual Result<void> CreateGraphicsPipelineState(const Diligent::GraphicsPipelineStateCreateInfo& createInfo,
+            Diligent::IPipelineState** pipelineState) noexcept;
+
+        /**
+         * 设置 PRS 上的静态变量
+         * @param signature PRS
+         * @param shader 变量所在的 Shader
+         * @param name 变量名
+         * @param object 绑定的对象
+         */
+        virtual void SetStaticVariable(Diligent::IPipelineResourceSignature* signature, const GraphDef::ShaderDefinition& shader,
+            const char* name, Diligent::IDeviceObject* object) noexcept;
+
+        /**
+         * 获取 SRB 上的变量
+         * @param binding SRB
+         * @param shader 变量所在的 Shader
+         * @param name 变量名
+         */
+        [[nodiscard]] virtual Diligent::IShaderResourceVariable* GetVariable(Diligent::IShaderResourceBinding* binding,
+            const GraphDef::ShaderDefinition& shader, const char* name) noexcept;
+
+        /**
+         * 设置 SRB 上的变量
+         * @param variable 由 GetVariable 获取的变量
+         * @param object 绑定的对象
+         */
+        virtual void SetVariable(Diligent::IShaderResourceVariable* variable, Diligent::IDeviceObject* object) noexcept;
+
+        /**
+         * 获取纹理的默认视图
+         * @param texture 纹理
+         * @param type 视图类型
+         */
+        virtual Result<Diligent::ITextureView*> GetTextureView(Diligent::ITexture* texture, TextureViewTypes type) noexcept;
+
+    public:  // 命令
+        /**
+         * 设置 RT
+         * @param renderTarget 颜色缓冲区
+         * @param depthStencil 深度/模板缓冲区
+         */
+        virtual void SetRenderTargets(Diligent::ITextureView* renderTarget, Diligent::ITextureView* depthStencil) noexcept;
+
+        /**
+         * 解除所有 RT 的绑定
+         */
+        virtual void ResetRenderTargets() noexcept;
+
+        /**
+         * 设置视口
+         */
+        virtual void SetViewport(const Diligent::Viewport& viewport) noexcept;
+
+        /**
+         * 设置裁剪矩形
+         * @param rect 矩形
+         * @param width RT 宽度
+         * @param height RT 高度
+         */
+        virtual void SetScissorRect(const Diligent::Rect& rect, uint32_t width, uint32_t height) noexcept;
+
+        /**
+         * 清空颜色缓冲区
+         * @param view RT 视图
+         * @param color RGBA 颜色
+         */
+        virtual void ClearRenderTarget(Diligent::ITextureView* view, const float* color) noexcept;
+
+        /**
+         * 清空深度/模板缓冲区
+         * @param view 深度/模板缓冲区视图
+         * @param depth 深度值，为空时不清空深度
+         * @param stencil 模板值，为空时不清空模板
+         */
+        virtual void ClearDepthStencil(Diligent::ITextureView* view, std::optional<float> depth, std::optional<uint8_t> stencil) noexcept;
+
+        /**
+         * 更新缓冲区的一部分
+         * 用于 USAGE_DEFAULT 的缓冲区。
+         * @param buffer 缓冲区
+         * @param offset 偏移
+         * @param data 数据
+         */
+        virtual void UpdateBuffer(Diligent::IBuffer* buffer, size_t offset, Span<const uint8_t> data) noexcept;
+
+        /**
+         * 映射并写入缓冲区
+         * 用于 USAGE_DYNAMIC 的缓冲区。
+         * @param buffer 缓冲区
+         * @param data 数据，从缓冲区开头写入
+         * @param noOverwrite 调用方保证 GPU 不再使用该缓冲区时以 NoOverwrite 方式映射，否则以 Discard 方式映射
+         */
+        virtual Result<void> WriteBuffer(Diligent::IBuffer* buffer, Span<const uint8_t> data, bool noOverwrite) noexcept;
+
+        /**
+         * 更新纹理
+         * @param texture 纹理
+         * @param mipLevel Mipmap 级别
+         * @param slice 数组下标
+         * @param box 更新范围
+         * @param data 数据
+         */
+        virtual void UpdateTexture(Diligent::ITexture* texture, uint32_t mipLevel, uint32_t slice, const Diligent::Box& box,
+            const Diligent::TextureSubResData& data) noexcept;
+
+        /**
+         * 设置顶点缓冲区
+         * @param count 缓冲区个数，从槽 0 开始
+         * @param buffers 缓冲区
+         * @param offsets 各缓冲区的偏移，可以为空
+         */
+        virtual void SetVertexBuffers(uint32_t count, Diligent::IBuffer* const* buffers, const uint64_t* offsets) noexcept;
+
+        /**
+         * 设置索引缓冲区
+         * @param buffer 缓冲区
+         * @param offset 偏移
+         */
+        virtual void SetIndexBuffer(Diligent::IBuffer* buffer, uint64_t offset) noexcept;
+
+        /**
+         * 设置 PSO
+         */
+        virtual void SetPipelineState(Diligent::IPipelineState* pipelineState) noexcept;
+
+        /**
+         * 提交 SRB
+         */
+        virtual void CommitShaderResources(Diligent::IShaderResourceBinding* binding) noexcept;
+
+        /**
+         * 绘制
+         */
+        virtual void DrawIndexed(const Diligent::DrawIndexedAttribs& attribs) noexcept;
+
     protected:
         Diligent::IRenderDevice* m_pRenderDevice = nullptr;
         Diligent::IDeviceContext* m_pRenderContext = nullptr;
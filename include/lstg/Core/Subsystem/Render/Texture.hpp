@@ -14,6 +14,7 @@
 namespace Diligent
 {
     struct ITexture;
+    struct TextureDesc;
 }
 
 namespace lstg::Subsystem
@@ -38,7 +39,14 @@ namespace lstg::Subsystem::Render
         friend class lstg::Subsystem::RenderSystem;
 
     public:
-        Texture(RenderDevice& device, Diligent::ITexture* handler);
+        /**
+         * 构造纹理
+         * 由 RenderDevice::CreateTexture 调用。
+         * @param device 渲染设备
+         * @param desc 纹理描述
+         * @param handler 原生对象，不持有原生对象的设备上为空
+         */
+        Texture(RenderDevice& device, const Diligent::TextureDesc& desc, Diligent::ITexture* handler);
         Texture(const Texture&) = delete;
         Texture(Texture&&) noexcept = delete;
         ~Texture();
@@ -75,9 +83,13 @@ namespace lstg::Subsystem::Render
         Result<void> Commit(Math::ImageRectangle range, Span<const uint8_t> data, size_t stride, size_t mipmapLevel = 0,
             size_t arrayIndex = 0) noexcept;
 
+    private:
+        const Diligent::TextureDesc& GetNativeDesc() const noexcept;
+
     private:
         RenderDevice& m_stDevice;
         Diligent::ITexture* m_pNativeHandler = nullptr;
+        std::unique_ptr<Diligent::TextureDesc> m_pDesc;
     };
 
     using TexturePtr = std::shared_ptr<Texture>;
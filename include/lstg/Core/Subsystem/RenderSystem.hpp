@@ -38,7 +38,7 @@ namespace lstg::Subsystem
     public:
         using TagContainer = std::map<std::string, std::string, std::less<>>;
         using EffectGroupSelectCallback = std::function<const Render::GraphDef::EffectPassGroupDefinition*(
-            const Render::GraphDef::EffectDefinition*, const TagContainer&)>;
+            const Render::GraphDef::EffectDefinition*, uint32_t, const TagContainer&)>;
 
         /**
          * 获取默认占位纹理大小
@@ -210,6 +210,24 @@ namespace lstg::Subsystem
          */
         void SetRenderTag(std::string_view key, std::string_view value);
 
+        /**
+         * 获取渲染状态键
+         */
+        [[nodiscard]] uint32_t GetRenderStateKey() const noexcept { return m_uRenderStateKey; }
+
+        /**
+         * 设置渲染状态键
+         * 状态键的含义由效果组选择器解释，相比渲染 Tag 可以避免逐次绘制时的字符串比较。
+         * @param key 键
+         */
+        void SetRenderStateKey(uint32_t key) noexcept
+        {
+            if (key == m_uRenderStateKey)
+                return;
+            m_uRenderStateKey = key;
+            m_pCurrentPassGroup = nullptr;
+        }
+
         /**
          * 获取效果组选择器
          */
@@ -239,12 +257,27 @@ namespace lstg::Subsystem
          */
         Result<void> Draw(Render::Mesh* mesh, size_t indexCount, size_t indexOffset, size_t vertexOffset = 0) noexcept;
 
+        /**
+         * 实例化绘制网格
+         * 网格定义需要包含逐实例数据，每个实例使用相同的索引范围。
+         * @param mesh 网格对象
+         * @param indexCount 每个实例使用的索引个数
+         * @param instanceCount 实例个数
+         * @param vertexOffset 顶点偏移（个数），offset = vertexOffset * stride
+         * @param indexOffset 索引偏移（个数）
+         * @param instanceOffset 实例偏移（个数），offset = instanceOffset * instanceStride
+         */
+        Result<void> DrawInstanced(Render::Mesh* mesh, size_t indexCount, size_t instanceCount, size_t vertexOffset, size_t indexOffset,
+            size_t instanceOffset) noexcept;
+
     private:
         std::tuple<uint32_t, uint32_t> GetCurrentOutputViewSize() noexcept;
         const Render::GraphDef::EffectPassGroupDefinition* SelectPassGroup() noexcept;
         Result<void> CommitCamera() noexcept;
         Result<void> CommitMaterial() noexcept;
         Result<void> PreparePipeline(const Render::GraphDef::EffectPassDefinition* pass, const Render::GraphDef::MeshDefinition* meshDef);
+        Result<void> DrawImpl(Render::Mesh* mesh, size_t indexCount, size_t vertexOffset, size_t indexOffset,
+            std::optional<std::tuple<size_t, size_t>> instances) noexcept;
 
         // </editor-fold>
     protected:  // ISubsystem
@@ -276,6 +309,7 @@ namespace lstg::Subsystem
         Render::CameraPtr m_pCurrentCamera;
         Render::MaterialPtr m_pCurrentMaterial;
         TagContainer m_stEffectRenderTag;
+        uint32_t m_uRenderStateKey = 0;
         EffectGroupSelectCallback m_stCurrentEffectGroupSelector;
         const Render::GraphDef::EffectPassGroupDefinition* m_pCurrentPassGroup = nullptr;
         Render::Camera::Viewport m_stCurrentViewport;
@@ -241,6 +241,11 @@ namespace lstg::Subsystem::VFS
             }
         }
 
+        Result<Span<const uint8_t>> GetMemoryView() const noexcept override
+        {
+            return Span<const uint8_t> { m_pContainer->data(), m_pContainer->size() };
+        }
+
     public:
         /**
          * @brief 获取底层容器
@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <functional>
 #include "Path.hpp"
 #include "IStream.hpp"
 #include "../../Flag.hpp"
@@ -72,6 +73,8 @@ namespace lstg::Subsystem::VFS
     LSTG_FLAG_BEGIN(FileOpenFlags)
         None = 0,
         Truncate = 1,
+        MemoryMapped = 2,  ///< @brief 只读打开时尽可能使用内存映射，不支持的文件系统可以忽略
+        RandomAccess = 4,  ///< @brief 只读打开时需要随机访问，压缩的条目会建立检查点索引以支持 Seek，不支持的文件系统可以忽略
     LSTG_FLAG_END(FileOpenFlags)
 
     /**
@@ -90,6 +93,13 @@ namespace lstg::Subsystem::VFS
      */
     class IFileSystem
     {
+    public:
+        /**
+         * 不可变条目句柄
+         * 由 VisitImmutablePaths 给出，含义由实现方决定。
+         */
+        using ImmutableEntryHandle = const void*;
+
     public:
         IFileSystem() = default;
         virtual ~IFileSystem() = default;
@@ -149,6 +159,43 @@ namespace lstg::Subsystem::VFS
          * @param ud 数据
          */
         virtual void SetUserData(std::string ud) noexcept = 0;
+
+        /**
+         * 遍历所有文件和文件夹的路径
+         * 只有内容在存续期间不会变化的文件系统（如 ZIP 档案）才支持，用于上层建立索引。
+         * 回调参数为规格化的完整路径（规则同 Path::ToNormalizedStringView）和对应条目的句柄。
+         * 调用方可以不复制地保存这些 string_view 和句柄：只要文件系统对象仍然存在（例如仍挂载在 OverlayFileSystem 中），
+         * 实现方必须保证它们指向的内容有效且不变。
+         * 回调抛出的异常会传递给调用方。
+         * @param visitor 访问器
+         * @return 不支持时返回 not_supported
+         */
+        virtual Result<void> VisitImmutablePaths(const std::function<void(std::string_view, ImmutableEntryHandle)>& visitor) const
+        {
+            return make_error_code(std::errc::not_supported);
+        }
+
+        /**
+         * 获取不可变条目的属性
+         * 与 GetFileAttribute 相同，但跳过路径查找。
+         * @param entry VisitImmutablePaths 给出的句柄
+         * @return 成功返回文件属性，失败返回错误码
+         */
+        virtual Result<FileAttribute> GetImmutableEntryAttribute(ImmutableEntryHandle entry) noexcept
+        {
+            return make_error_code(std::errc::not_supported);
+        }
+
+        /**
+         * 打开不可变条目
+         * 与 OpenFile 相同，但跳过路径查找。
+         * @param entry VisitImmutablePaths 给出的句柄
+         * @return 成功返回文件流，失败返回错误码
+         */
+        virtual Result<StreamPtr> OpenImmutableEntry(ImmutableEntryHandle entry, FileAccessMode access, FileOpenFlags flags) noexcept
+        {
+            return make_error_code(std::errc::not_supported);
+        }
     };
 
     using FileSystemPtr = std::shared_ptr<IFileSystem>;
@@ -5,9 +5,11 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include "../../Result.hpp"
+#include "../../Span.hpp"
 
 namespace lstg::Subsystem::VFS
 {
@@ -110,6 +112,17 @@ namespace lstg::Subsystem::VFS
          * 复制后的流应当具备单独的读写位置和线程安全性。
          */
         virtual Result<StreamPtr> Clone() const noexcept = 0;
+
+        /**
+         * 获取流数据的内存视图
+         * 仅当流的全部数据常驻于连续内存中时（如内存映射文件）才能获取，视图覆盖整个流，与读写位置无关。
+         * 视图在流被写入或销毁前有效，调用方不得通过视图修改数据。
+         * @return 视图，不支持时返回 not_supported
+         */
+        virtual Result<Span<const uint8_t>> GetMemoryView() const noexcept
+        {
+            return make_error_code(std::errc::not_supported);
+        }
     };
 
     struct LittleEndianTag {};
@@ -692,6 +705,20 @@ namespace lstg::Subsystem::VFS
 
         try
         {
+            // 数据常驻内存时一次复制剩余部分
+            auto view = stream->GetMemoryView();
+            if (view)
+            {
+                auto position = stream->GetPosition();
+                if (!position)
+                    return position.GetError();
+                auto offset = std::min<uint64_t>(*position, view->GetSize());
+                out.resize(view->GetSize() - offset);
+                if (!out.empty())
+                    ::memcpy(out.data(), view->GetData() + offset, out.size());
+                return stream->Seek(0, StreamSeekOrigins::End);
+            }
+
             while (true)
             {
                 auto sz = out.size();
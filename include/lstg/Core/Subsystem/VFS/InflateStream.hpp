@@ -15,16 +15,36 @@ namespace lstg::Subsystem::VFS
     {
         class ZStream;
         using ZStreamPtr = std::shared_ptr<ZStream>;
+
+        struct InflateCheckpoint;
+        class InflateCheckpointIndex;
+        using InflateCheckpointIndexPtr = std::shared_ptr<InflateCheckpointIndex>;
     }
 
     /**
      * 解压流
+     * 默认只支持顺序读取。
+     * 指定检查点间隔后，解压过程中会在 deflate 块边界处每隔一段距离保存一次解压状态（含 32k 滑动窗口），
+     * 此时若底层流支持 Seek，则解压流支持随机访问，任意一次 Seek 最多需要解压一个检查点间隔的数据。
+     * 检查点索引由 Clone 出的流共享。
      */
     class InflateStream :
         public IStream
     {
     public:
-        InflateStream(StreamPtr underlayStream, std::optional<uint64_t> uncompressedSize = {});
+        /**
+         * 默认的检查点间隔
+         */
+        static const uint64_t kDefaultCheckpointInterval = 1024 * 1024;
+
+    public:
+        /**
+         * 构造解压流
+         * @param underlayStream 底层压缩数据流，当前位置须位于压缩数据起始处
+         * @param uncompressedSize 解压后的大小
+         * @param checkpointInterval 检查点间隔，为 0 时不建立检查点索引
+         */
+        InflateStream(StreamPtr underlayStream, std::optional<uint64_t> uncompressedSize = {}, uint64_t checkpointInterval = 0);
         InflateStream(const InflateStream& org);
 
     public:  // IStream
@@ -53,11 +73,18 @@ namespace lstg::Subsystem::VFS
          */
         Result<void> Reset() noexcept;
 
+    private:
+        Result<void> RestoreCheckpoint(const detail::InflateCheckpoint& checkpoint) noexcept;
+        void RecordCheckpoint() noexcept;
+
     private:
         detail::ZStreamPtr m_pZStream;
         StreamPtr m_pUnderlayStream;
         bool m_bFinished = false;
         std::optional<uint64_t> m_stUncompressedSize;
-        uint8_t m_stChunk[4 * 1024];  // 4k
+        detail::InflateCheckpointIndexPtr m_pCheckpointIndex;  // 为空时不支持随机访问
+        uint64_t m_ullInputBase = 0;  // 当前 ZStream 的输入起点在底层流中的位置
+        uint64_t m_ullOutputBase = 0;  // 当前 ZStream 的输出起点在解压数据中的位置
+        uint8_t m_stChunk[32 * 1024];  // 32k，较大的输入块可以减少对底层流（及解密流）的调用次数
     };
 }
@@ -0,0 +1,28 @@
+/**
+ * @file
+ * @date 2022/9/20
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <filesystem>
+#include "MemoryViewStream.hpp"
+
+namespace lstg::Subsystem::VFS
+{
+    /**
+     * 内存映射文件流
+     * 以只读方式将整个文件映射到内存，读取操作退化为内存复制。
+     * 所有 Clone 出的流共享同一份映射，不会再次打开文件。
+     */
+    class MappedFileStream :
+        public MemoryViewStream
+    {
+    public:
+        /**
+         * 映射文件
+         * @param path 路径
+         */
+        explicit MappedFileStream(const std::filesystem::path& path);
+    };
+}
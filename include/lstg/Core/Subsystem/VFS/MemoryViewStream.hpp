@@ -0,0 +1,51 @@
+/**
+ * @file
+ * @date 2022/9/20
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include "IStream.hpp"
+
+namespace lstg::Subsystem::VFS
+{
+    /**
+     * 只读内存视图流
+     * 在一段只读内存上进行读取，内存由 owner 持有，流存续期间保证有效。
+     * Clone 操作只复制视图和读取位置，不会复制数据。
+     */
+    class MemoryViewStream :
+        public IStream
+    {
+    public:
+        /**
+         * 构造内存视图流
+         * @param view 视图
+         * @param owner 视图所在内存的持有者
+         */
+        MemoryViewStream(Span<const uint8_t> view, std::shared_ptr<const void> owner) noexcept;
+
+    protected:
+        MemoryViewStream() noexcept = default;
+
+    public:  // IStream
+        bool IsReadable() const noexcept override;
+        bool IsWriteable() const noexcept override;
+        bool IsSeekable() const noexcept override;
+        Result<uint64_t> GetLength() const noexcept override;
+        Result<void> SetLength(uint64_t length) noexcept override;
+        Result<uint64_t> GetPosition() const noexcept override;
+        Result<void> Seek(int64_t offset, StreamSeekOrigins origin) noexcept override;
+        Result<bool> IsEof() const noexcept override;
+        Result<void> Flush() noexcept override;
+        Result<size_t> Read(uint8_t* buffer, size_t length) noexcept override;
+        Result<void> Write(const uint8_t* buffer, size_t length) noexcept override;
+        Result<StreamPtr> Clone() const noexcept override;
+        Result<Span<const uint8_t>> GetMemoryView() const noexcept override;
+
+    protected:
+        Span<const uint8_t> m_stView;
+        std::shared_ptr<const void> m_pOwner;
+        uint64_t m_ullPosition = 0;
+    };
+}
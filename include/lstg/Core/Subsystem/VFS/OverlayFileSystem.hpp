@@ -6,6 +6,7 @@
  */
 #pragma once
 #include <vector>
+#include <string_view>
 #include "IFileSystem.hpp"
 
 namespace lstg::Subsystem::VFS
@@ -63,8 +64,40 @@ namespace lstg::Subsystem::VFS
         const std::string& GetUserData() const noexcept override;
         void SetUserData(std::string ud) noexcept override;
 
+    private:
+        /**
+         * 路径索引的槽位
+         */
+        struct PathIndexSlot
+        {
+            std::string_view Path;
+            ImmutableEntryHandle Entry = nullptr;  // 包含该路径的最上层中的条目，为空表示空槽位
+            uint32_t Hash = 0;
+            uint32_t Layer = 0;  // 包含该路径的最上层
+        };
+
+        /**
+         * 按路径查找的结果
+         */
+        enum class PathIndexLookupResult
+        {
+            Unavailable,  // 无法使用索引，所有层都需要按路径查找
+            Found,
+            NotFound,  // 已收录的层中都不存在该路径
+        };
+
+        void RebuildPathIndex() noexcept;
+        PathIndexLookupResult LookupPathIndex(const Path& path, PathIndexSlot& entry) const noexcept;
+
     private:
         std::string m_stUserData;
         std::vector<FileSystemPtr> m_stFileSystems;
+
+        // 不可变层（如 zip）合并后的路径索引，每个路径只记录包含它的最上层及其条目，一次查找即可定位
+        // 线性探测的开放寻址哈希表，容量总是 2 的幂，槽位中保存哈希值，只有哈希值相同时才需要访问键的内容
+        // m_stIndexedLayers 记录每一层的内容是否已经完整收录在索引中，未收录的层仍然按路径查找
+        // 键和句柄直接引用各层 VisitImmutablePaths 给出的数据，层由 m_stFileSystems 持有，增删层后立即重建索引，被移除的层的数据不会再被访问
+        std::vector<PathIndexSlot> m_stPathIndex;
+        std::vector<uint8_t> m_stIndexedLayers;
     };
 }
@@ -167,6 +167,14 @@ namespace lstg::Subsystem::VFS
          */
         std::string_view ToStringView() const noexcept;
 
+        /**
+         * 转换到规格化的字符串
+         * 规则同 Normalize。路径已经是规格化的相对路径时直接返回内部视图，否则结果写入 buffer。
+         * @param buffer 缓冲区
+         * @return 规格化的路径，根目录返回空串
+         */
+        std::string_view ToNormalizedStringView(std::string& buffer) const;
+
     private:
         PathSpan m_stSpan;
     };
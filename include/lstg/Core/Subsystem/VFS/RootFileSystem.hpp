@@ -8,6 +8,8 @@
 #include <tuple>
 #include <map>
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include "IFileSystem.hpp"
 
 namespace lstg::Subsystem::VFS
@@ -48,6 +50,7 @@ namespace lstg::Subsystem::VFS
         struct MountingPoint
         {
             std::string Name;
+            std::string FullPath;  // 规格化的完整路径
             FileSystemPtr FileSystem;
             std::map<std::string, MountingPoint, std::less<>> SubNodes;
         };
@@ -57,5 +60,10 @@ namespace lstg::Subsystem::VFS
     private:
         std::string m_stUserData;
         MountingPoint m_stRoot;
+
+        // 挂载过文件系统的节点的索引，键指向 MountingPoint::FullPath
+        // 卸载时节点不会被删除，查找时跳过 FileSystem 为空的节点即可，因此只在挂载时更新
+        std::unordered_map<std::string_view, const MountingPoint*> m_stMountPointIndex;
+        std::vector<size_t> m_stMountPointDepths;  // 索引中出现过的路径段数，降序
     };
 }
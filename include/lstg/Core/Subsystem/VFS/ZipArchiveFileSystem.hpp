@@ -7,6 +7,8 @@
 #pragma once
 #include <map>
 #include <variant>
+#include <string_view>
+#include <unordered_map>
 #include "IFileSystem.hpp"
 
 namespace lstg::Subsystem::VFS
@@ -19,6 +21,7 @@ namespace lstg::Subsystem::VFS
         struct ZipDirectoryEntry
         {
             std::string Name;
+            std::string FullPath;  // 规格化的完整路径
             std::map<std::string, ZipDirectoryEntry*, std::less<>> Directories;
             std::map<std::string, ZipFileEntry, std::less<>> Files;
         };
@@ -47,9 +50,14 @@ namespace lstg::Subsystem::VFS
         Result<StreamPtr> OpenFile(Path path, FileAccessMode access, FileOpenFlags flags) noexcept override;
         const std::string& GetUserData() const noexcept override;
         void SetUserData(std::string ud) noexcept override;
+        Result<void> VisitImmutablePaths(const std::function<void(std::string_view, ImmutableEntryHandle)>& visitor) const override;
+        Result<FileAttribute> GetImmutableEntryAttribute(ImmutableEntryHandle entry) noexcept override;
+        Result<StreamPtr> OpenImmutableEntry(ImmutableEntryHandle entry, FileAccessMode access, FileOpenFlags flags) noexcept override;
 
     private:
         [[nodiscard]] detail::ConstZipEntry LocatePath(const Path& path) const noexcept;
+        Result<FileAttribute> GetEntryAttribute(const detail::ConstZipEntry& entry) const noexcept;
+        Result<StreamPtr> OpenEntry(const detail::ConstZipEntry& entry, FileAccessMode access, FileOpenFlags flags) noexcept;
         void ClearFileTree();
         detail::ZipDirectoryEntry* CreateTree(const Path& path);
 
@@ -58,5 +66,10 @@ namespace lstg::Subsystem::VFS
         detail::ZipFile* m_pZipFile = nullptr;
         detail::ZipDirectoryEntry m_stRoot;
         std::string m_stPassword;
+
+        // 规格化完整路径到条目的索引，键指向文件树中的 FullPath / FileName
+        // 同名的文件和文件夹同时存在时，文件夹优先
+        // 值的地址即 VisitImmutablePaths 给出的句柄
+        std::unordered_map<std::string_view, detail::ConstZipEntry> m_stPathIndex;
     };
 }
@@ -5,6 +5,12 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include "../Span.hpp"
+#include "../ThreadPool.hpp"
 #include "ISubsystem.hpp"
 #include "VFS/RootFileSystem.hpp"
 
@@ -16,6 +22,12 @@ namespace lstg::Subsystem
     class VirtualFileSystem :
         public ISubsystem
     {
+    public:
+        /**
+         * 默认的预取缓存上限（字节）
+         */
+        static const size_t kDefaultPrefetchCacheLimit = 128 * 1024 * 1024;
+
     public:
         VirtualFileSystem(SubsystemContainer& container);
         VirtualFileSystem(const VirtualFileSystem&) = delete;
@@ -36,6 +48,18 @@ namespace lstg::Subsystem
          */
         void SetAssetBaseDirectory(std::string_view path) { m_stAssetBaseDirectory = path; }
 
+        /**
+         * 获取预取缓存上限（字节）
+         */
+        [[nodiscard]] size_t GetPrefetchCacheLimit() const noexcept { return m_uPrefetchCacheLimit; }
+
+        /**
+         * 设置预取缓存上限（字节）
+         * @note 不会淘汰已经缓存的数据，为 0 时禁用预取
+         * @param limit 上限
+         */
+        void SetPrefetchCacheLimit(size_t limit) noexcept { m_uPrefetchCacheLimit = limit; }
+
         /**
          * 创建文件夹
          * @param path 路径
@@ -82,6 +106,22 @@ namespace lstg::Subsystem
         Result<VFS::StreamPtr> OpenFile(std::string_view path, VFS::FileAccessMode access,
             VFS::FileOpenFlags flags = VFS::FileOpenFlags::None) noexcept;
 
+        /**
+         * 预取文件
+         * 在工作线程上并行读取（解压）给定的文件并放入预取缓存，之后以只读方式打开这些文件时直接返回缓存中的数据。
+         * 每份缓存数据只会被打开一次，打开后即从缓存中移除。
+         * 数据已经常驻内存的文件（如内存映射的资源包中未压缩的条目）不会进入缓存。
+         * 方法阻塞直到所有文件处理完毕，超出缓存上限的文件会被跳过。
+         * @param paths 路径列表
+         * @return 放入缓存的文件数量
+         */
+        Result<size_t> Prefetch(Span<const std::string> paths) noexcept;
+
+        /**
+         * 清空预取缓存
+         */
+        void ClearPrefetchCache() noexcept;
+
         /**
          * 读取整个文件
          * @param out 输出
@@ -104,8 +144,20 @@ namespace lstg::Subsystem
          */
         Result<bool> Unmount(std::string_view path) noexcept;
 
+    private:
+        Result<VFS::StreamPtr> TakePrefetchedFile(const VFS::Path& path) noexcept;
+        void InvalidatePrefetchedFile(const VFS::Path& path) noexcept;
+
     private:
         VFS::RootFileSystem m_stRootFileSystem;
         std::string m_stAssetBaseDirectory;
+
+        // 预取
+        size_t m_uPrefetchCacheLimit = kDefaultPrefetchCacheLimit;
+        std::unique_ptr<ThreadPool<>> m_pPrefetchThreads;
+        std::mutex m_stPrefetchCacheMutex;
+        std::atomic<size_t> m_uPrefetchCacheCount { 0 };  // 用于在缓存为空时免于加锁
+        size_t m_uPrefetchCacheBytes = 0;
+        std::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>> m_stPrefetchCache;
     };
 }
@@ -7,6 +7,7 @@
 #pragma once
 #include <cstdint>
 #include <cassert>
+#include <atomic>
 #include <chrono>
 #include <system_error>
 #include <variant>
@@ -72,6 +73,11 @@ namespace lstg
              * @note 总是在主线程
              */
             virtual void CallHandler() noexcept = 0;
+
+            /**
+             * 是否需要在 Update 中执行回调
+             */
+            virtual bool IsCompletedHandlerRequired() const noexcept { return true; }
         };
 
         using ThreadJobPtr = std::shared_ptr<IThreadJob>;
@@ -174,6 +180,72 @@ namespace lstg
             ThreadJobCallback<void> m_stJob;
             ThreadJobCompletedCallback<void> m_stCompletedCallback;
         };
+
+#if !(defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__))
+        /**
+         * 并行任务的共享状态
+         * 任务索引通过原子变量领取，因此哪个线程执行哪个任务是不确定的，调用方需要保证任务之间相互独立。
+         */
+        struct ParallelForState
+        {
+            void (*Invoke)(void*, size_t) = nullptr;
+            void* Context = nullptr;
+            size_t Count = 0;
+            std::atomic<size_t> Next { 0 };
+            std::atomic<size_t> Completed { 0 };
+            std::mutex Mutex;
+            std::condition_variable CondVar;
+
+            void Run() noexcept
+            {
+                size_t completed = 0;
+                while (true)
+                {
+                    auto index = Next.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= Count)
+                        break;
+                    Invoke(Context, index);
+                    ++completed;
+                }
+
+                // 最后完成的线程负责唤醒等待者
+                if (completed && Completed.fetch_add(completed, std::memory_order_acq_rel) + completed == Count)
+                {
+                    {
+                        std::unique_lock<std::mutex> lockGuard(Mutex);
+                    }
+                    CondVar.notify_all();
+                }
+            }
+
+            void Wait() noexcept
+            {
+                std::unique_lock<std::mutex> lockGuard(Mutex);
+                CondVar.wait(lockGuard, [this]() { return Completed.load(std::memory_order_acquire) == Count; });
+            }
+        };
+
+        class ParallelForJob :
+            public IThreadJob
+        {
+        public:
+            ParallelForJob(std::shared_ptr<ParallelForState> state)
+                : m_pState(std::move(state)) {}
+
+        public:
+            void Execute() noexcept override
+            {
+                m_pState->Run();
+            }
+
+            void CallHandler() noexcept override {}
+
+            bool IsCompletedHandlerRequired() const noexcept override { return false; }
+
+        private:
+            std::shared_ptr<ParallelForState> m_pState;
+        };
+#endif
     }
 
     /**
@@ -213,6 +285,19 @@ namespace lstg
             m_stJobQueue.emplace_back(std::move(wrapper));
         }
 
+        /**
+         * 并行执行
+         * 单线程下顺序执行所有任务。
+         * @param count 任务数
+         * @param callback 回调，参数为任务索引
+         */
+        template <typename TCallback>
+        void ParallelFor(size_t count, TCallback& callback) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                callback(i);
+        }
+
         /**
          * 更新状态
          */
@@ -303,6 +388,59 @@ namespace lstg
             }
         }
 
+        /**
+         * 并行执行
+         * 将 [0, count) 范围内的任务分发到工作线程上，当前线程同样参与执行，直到所有任务完成后返回。
+         * 任务之间不能存在依赖，回调中也不能再次调用 ParallelFor。
+         * 由于工作线程可能被其他任务占用，当前线程总是能够独立完成所有任务，不会因此死锁。
+         * @param count 任务数
+         * @param callback 回调，参数为任务索引
+         */
+        template <typename TCallback>
+        void ParallelFor(size_t count, TCallback& callback) noexcept
+        {
+            if (count == 0)
+                return;
+
+            std::shared_ptr<detail::ParallelForState> state;
+            try
+            {
+                state = std::make_shared<detail::ParallelForState>();
+            }
+            catch (...)  // bad_alloc
+            {
+                // 退化到单线程执行
+                for (size_t i = 0; i < count; ++i)
+                    callback(i);
+                return;
+            }
+            state->Invoke = [](void* context, size_t index) {
+                (*static_cast<TCallback*>(context))(index);
+            };
+            state->Context = &callback;
+            state->Count = count;
+
+            // 提交辅助任务，失败时由当前线程完成剩余的工作
+            try
+            {
+                auto helpers = std::min(count - 1, m_stThreads.size());
+                if (helpers > 0)
+                {
+                    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+                    for (size_t i = 0; i < helpers; ++i)
+                        m_stJobQueue.emplace_back(std::make_shared<detail::ParallelForJob>(state));
+                    lockGuard.unlock();
+                    m_stCondVar.notify_all();
+                }
+            }
+            catch (...)  // bad_alloc
+            {
+            }
+
+            state->Run();
+            state->Wait();
+        }
+
         /**
          * 更新状态
          */
@@ -357,6 +495,7 @@ namespace lstg
                 wrapper->Execute();
 
                 // 任务完成后放入完成队列
+                if (wrapper->IsCompletedHandlerRequired())
                 {
                     std::unique_lock<std::mutex> completedLockGuard(m_stPendingJobMutex);
                     m_stPendingCompletedJobQueue.emplace_back(std::move(wrapper));
@@ -5,6 +5,7 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <array>
 #include <lstg/Core/Subsystem/Asset/AssetPool.hpp>
 #include <lstg/Core/Subsystem/Asset/IAssetFactory.hpp>
 #include "AssetNaming.hpp"
@@ -63,6 +64,17 @@ namespace lstg::v2
          */
         [[nodiscard]] Subsystem::Asset::AssetPtr FindAsset(AssetTypes type, std::string_view name) const noexcept;
 
+        /**
+         * 通过驻留字符串寻找资产
+         * 用于渲染等高频调用的场合。name 通常来自 Lua 字符串，其地址在字符串存活期间不变，因此以地址作为缓存键，
+         * 命中时无需拼接完整资产名和查表。任一资源池发生变化后缓存自动失效。
+         * 返回的指针不持有资产，只在资源池下一次发生变化前有效。
+         * @param type 资产类型
+         * @param name 资产名
+         * @return 资产对象，若未找到返回 nullptr
+         */
+        [[nodiscard]] Subsystem::Asset::Asset* FindAssetInterned(AssetTypes type, const char* name) const noexcept;
+
         /**
          * 定位资产池
          * @param type 资产类型
@@ -90,12 +102,26 @@ namespace lstg::v2
     protected:  // IAssetDependencyResolver
         [[nodiscard]] Subsystem::Asset::AssetPtr OnResolveAsset(std::string_view name) const noexcept override;
 
+    private:
+        static constexpr size_t kInternedLookupCacheSize = 256;
+
+        struct InternedLookupEntry
+        {
+            const char* Key = nullptr;
+            AssetTypes Type = AssetTypes::Texture;
+            uint64_t StageGeneration = 0;
+            uint64_t GlobalGeneration = 0;
+            Subsystem::Asset::Asset* Asset = nullptr;
+            std::string Name;  // 字符串被回收后地址可能被复用，命中时需要校验内容
+        };
+
     private:
         Subsystem::Asset::AssetPoolPtr m_pGlobalAssetPool;
         Subsystem::Asset::AssetPoolPtr m_pStageAssetPool;
         Subsystem::Asset::AssetPool* m_pCurrentAssetPool = nullptr;
 
         mutable std::string m_stTmpNameBuffer;
+        mutable std::array<InternedLookupEntry, kInternedLookupCacheSize> m_stInternedLookupCache;
     };
 
     using AssetPoolsPtr = std::unique_ptr<AssetPools>;
@@ -18,6 +18,7 @@ namespace lstg::v2::Bridge
     {
     public:
         using LuaStack = Subsystem::Script::LuaStack;
+        using AbsIndex = LuaStack::AbsIndex;
 
     public:
         /**
@@ -122,6 +123,16 @@ namespace lstg::v2::Bridge
         LSTG_METHOD()
         static void ExtractRes(const char* path, const char* target);
 
+        /**
+         * 预取资源文件
+         * 在多个线程上并行解压给定的资源文件，之后加载这些资源时直接使用解压后的数据。
+         * @note 仅为加速手段，文件不存在或缓存已满时不会报错
+         * @param stack Lua栈
+         * @param paths 路径数组
+         */
+        LSTG_METHOD()
+        static void PrefetchRes(LuaStack& stack, AbsIndex paths);
+
         /**
          * 执行指定路径的脚本
          * @note 已执行过的脚本会再次执行
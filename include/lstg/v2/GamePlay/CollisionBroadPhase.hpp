@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @date 2022/9/3
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cassert>
+#include <vector>
+#include "../../Core/Result.hpp"
+#include "../../Core/ECS/Entity.hpp"
+
+namespace lstg::v2::GamePlay
+{
+    /**
+     * 碰撞粗检测
+     *
+     * 使用均匀网格组织同一碰撞组中的所有碰撞体，用于在 CollisionCheck 中快速剔除不可能相交的碰撞对。
+     * 网格按对象中心进行划分，外接矩形超过单元格大小的对象单独存放，总是作为候选者返回。
+     * 索引只是某一时刻的快照，使用方需要通过版本号自行判断是否需要重建，并在窄检测中使用实时数据。
+     */
+    class CollisionBroadPhase
+    {
+    public:
+        /**
+         * 代理对象
+         */
+        struct Proxy
+        {
+            ECS::Entity BindingEntity;
+            double X = 0.;
+            double Y = 0.;
+            double HalfWidth = 0.;
+            double HalfHeight = 0.;
+        };
+
+    public:
+        /**
+         * 获取构建时的版本号
+         */
+        [[nodiscard]] uint64_t GetVersion() const noexcept { return m_uVersion; }
+
+        /**
+         * 获取代理对象数量
+         */
+        [[nodiscard]] size_t GetProxyCount() const noexcept { return m_stProxies.size(); }
+
+        /**
+         * 获取代理对象
+         * @param index 索引，即对象加入的顺序
+         */
+        [[nodiscard]] const Proxy& GetProxy(uint32_t index) const noexcept
+        {
+            assert(index < m_stProxies.size());
+            return m_stProxies[index];
+        }
+
+        /**
+         * 清空并开始新一轮的构建
+         * 之后需要按照遍历顺序依次调用 AddProxy，最后调用 Build。
+         * @param version 版本号
+         */
+        void Reset(uint64_t version) noexcept;
+
+        /**
+         * 加入代理对象
+         * @param entity 实体
+         * @param x 中心 X
+         * @param y 中心 Y
+         * @param halfWidth 外接矩形半宽
+         * @param halfHeight 外接矩形半高
+         */
+        Result<void> AddProxy(ECS::Entity entity, double x, double y, double halfWidth, double halfHeight) noexcept;
+
+        /**
+         * 构建网格
+         */
+        Result<void> Build() noexcept;
+
+        /**
+         * 查询与矩形可能相交的对象
+         * 输出结果按照加入顺序升序排列。
+         * @param left 左边界
+         * @param right 右边界
+         * @param top 上边界
+         * @param bottom 下边界
+         * @param out 输出代理对象索引
+         */
+        Result<void> Query(double left, double right, double top, double bottom, std::vector<uint32_t>& out) const noexcept;
+
+    private:
+        uint64_t m_uVersion = 0;
+        std::vector<Proxy> m_stProxies;
+
+        // 网格参数
+        double m_dOriginX = 0.;
+        double m_dOriginY = 0.;
+        double m_dCellWidth = 0.;
+        double m_dCellHeight = 0.;
+        double m_dQueryExpand = 0.;  // 普通对象的最大半宽，查询时需要外扩
+        uint32_t m_uColumns = 0;
+        uint32_t m_uRows = 0;
+
+        // 网格数据，单元格 i 中的对象为 m_stCellItems[m_stCellStart[i], m_stCellStart[i + 1])
+        std::vector<uint32_t> m_stCellStart;
+        std::vector<uint32_t> m_stCellItems;
+        std::vector<uint32_t> m_stOversizedItems;  // 不参与网格划分的对象
+        std::vector<uint32_t> m_stProxyCells;  // 构建时的临时数据
+    };
+}
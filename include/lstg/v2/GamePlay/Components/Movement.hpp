@@ -6,38 +6,52 @@
  */
 #pragma once
 #include "../../MathAlias.hpp"
+#include "../../../Core/ECS/ColumnComponent.hpp"
 
 namespace lstg::v2::GamePlay::Components
 {
     /**
      * 简单移动
+     * 各字段按列存储在 Chunk 中，组件对象是由各列元素的引用组成的视图，需要按值传递。
+     * @tparam TScalar 存储精度，对象上使用的精度由 ComponentScalar 决定
      */
-    struct Movement
+    template <typename TScalar>
+    struct BasicMovement
     {
+        using Scalar = TScalar;
+        using Vec2 = glm::vec<2, TScalar, glm::defaultp>;
+        using Columns = ECS::ColumnLayout<TScalar, Vec2, Vec2, bool>;
+
         /**
          * 角速度
          */
-        double AngularVelocity = 0;
+        TScalar& AngularVelocity;
 
         /**
          * 线速度
          */
-        Vec2 Velocity { 0, 0 };
+        Vec2& Velocity;
 
         /**
          * 加速度
          */
-        Vec2 AccelVelocity { 0, 0 };
+        Vec2& AccelVelocity;
 
         /**
          * 自动转向
          */
-        bool RotateToSpeedDirection = false;
+        bool& RotateToSpeedDirection;
 
         void Reset() noexcept;
     };
 
-    constexpr uint32_t GetComponentId(Movement*) noexcept
+    extern template struct BasicMovement<float>;
+    extern template struct BasicMovement<double>;
+
+    using Movement = BasicMovement<ComponentScalar>;
+
+    template <typename TScalar>
+    constexpr uint32_t GetComponentId(BasicMovement<TScalar>*) noexcept
     {
         return 3u;
     }
@@ -5,7 +5,6 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
-#include <lstg/Core/IntrusiveSkipList.hpp>
 #include "../../MathAlias.hpp"
 #include "../../../Core/ECS/Entity.hpp"
 #include "../../../Core/Subsystem/Render/Drawing2D/ParticlePool.hpp"
@@ -13,17 +12,28 @@
 #include "../../Asset/SpriteSequenceAsset.hpp"
 #include "../../Asset/HgeParticleAsset.hpp"
 
-namespace lstg::v2::GamePlay::Components
+namespace lstg::v2::GamePlay
 {
-    static constexpr size_t kRendererSkipListNodeDepth = 3;
+    struct RenderLayerBucket;
 
+    /**
+     * 渲染对象在 RenderLayerIndex 中的位置
+     */
+    struct RenderLayerSlot
+    {
+        RenderLayerBucket* Owner = nullptr;  // 为空表示不在索引中
+        uint32_t Index = 0;
+        uint32_t VisitEpoch = 0;  // 最后一次被遍历到的轮次，用于防止同一次遍历中重复访问
+    };
+}
+
+namespace lstg::v2::GamePlay::Components
+{
     /**
      * 渲染
      */
     struct Renderer
     {
-        static Renderer* FromSkipListNode(IntrusiveSkipListNode<kRendererSkipListNodeDepth>* n) noexcept;
-
         struct SpriteRenderer
         {
             Asset::SpriteAssetPtr Asset;
@@ -67,42 +77,21 @@ namespace lstg::v2::GamePlay::Components
         uint32_t AnimationTimer = 0;
 
         /**
-         * 链表域
+         * 索引域
          * 用于保持渲染顺序。
          */
         ECS::Entity BindingEntity;
-        IntrusiveSkipListNode<kRendererSkipListNodeDepth> SkipListNode;
+        RenderLayerSlot LayerSlot;
 
         Renderer() noexcept {} /* = default; */  // g++ won't compile, make it happy
         Renderer(Renderer&& org) noexcept;
 
         void Reset() noexcept;
         std::string_view GetAssetName() noexcept;
-
-        Renderer* NextNode() noexcept;
-        Renderer* PrevNode() noexcept;
     };
 
     constexpr uint32_t GetComponentId(Renderer*) noexcept
     {
         return 4u;
     }
-
-    /**
-     * 根元素
-     */
-    struct RendererRoot
-    {
-        Renderer RendererHeader;
-        Renderer RendererTailer;
-
-        RendererRoot() noexcept;
-        RendererRoot(RendererRoot&&) noexcept;
-        void Reset() noexcept;
-    };
-
-    constexpr uint32_t GetComponentId(RendererRoot*) noexcept
-    {
-        return 5u;
-    }
 }
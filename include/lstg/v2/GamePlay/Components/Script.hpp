@@ -25,6 +25,11 @@ namespace lstg::v2::GamePlay::Components
          */
         uint32_t ScriptObjectId = 0;
 
+        /**
+         * 对象所属类在脚本对象池中的缓存 ID
+         */
+        uint32_t ScriptClassId = 0;
+
         /**
          * 脚本对象池
          */
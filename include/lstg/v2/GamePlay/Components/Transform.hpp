@@ -6,38 +6,52 @@
  */
 #pragma once
 #include "../../MathAlias.hpp"
+#include "../../../Core/ECS/ColumnComponent.hpp"
 
 namespace lstg::v2::GamePlay::Components
 {
     /**
      * 变换组件
+     * 各字段按列存储在 Chunk 中，组件对象是由各列元素的引用组成的视图，需要按值传递。
+     * @tparam TScalar 存储精度，对象上使用的精度由 ComponentScalar 决定
      */
-    struct Transform
+    template <typename TScalar>
+    struct BasicTransform
     {
+        using Scalar = TScalar;
+        using Vec2 = glm::vec<2, TScalar, glm::defaultp>;
+        using Columns = ECS::ColumnLayout<Vec2, Vec2, Vec2, TScalar>;
+
         /**
          * 坐标
          */
-        Vec2 Location { 0., 0. };
+        Vec2& Location;
 
         /**
          * 上一帧坐标
          */
-        Vec2 LastLocation { 0., 0. };
+        Vec2& LastLocation;
 
         /**
          * 距离上一帧的坐标差量
          */
-        Vec2 LocationDelta { 0., 0. };
+        Vec2& LocationDelta;
 
         /**
          * 旋转量
          */
-        double Rotation = 0;
+        TScalar& Rotation;
 
         void Reset() noexcept;
     };
 
-    constexpr uint32_t GetComponentId(Transform*) noexcept
+    extern template struct BasicTransform<float>;
+    extern template struct BasicTransform<double>;
+
+    using Transform = BasicTransform<ComponentScalar>;
+
+    template <typename TScalar>
+    constexpr uint32_t GetComponentId(BasicTransform<TScalar>*) noexcept
     {
         return 0u;
     }
@@ -8,7 +8,12 @@
 #include <lstg/Core/IntrusiveSkipList.hpp>
 #include <lstg/Core/Subsystem/SubsystemContainer.hpp>
 #include <lstg/Core/ECS/World.hpp>
+#include <lstg/Core/Subsystem/Render/Drawing2D/Sprite.hpp>
 #include "ScriptObjectPool.hpp"
+#include "CollisionBroadPhase.hpp"
+#include "RenderLayerIndex.hpp"
+#include "Components/Collider.hpp"
+#include "Components/Transform.hpp"
 #include "../MathAlias.hpp"
 
 namespace lstg::v2
@@ -18,9 +23,9 @@ namespace lstg::v2
 
 namespace lstg::v2::GamePlay::Components
 {
+    struct Script;
     struct LifeTimeRoot;
     struct ColliderRoot;
-    struct RendererRoot;
 }
 
 namespace lstg::v2::GamePlay
@@ -71,6 +76,19 @@ namespace lstg::v2::GamePlay
          */
         void SetBoundary(const WorldRectangle& rect) noexcept { m_stBoundary = rect; }
 
+        /**
+         * 是否开启批量运动积分
+         * 开启后 Frame 会先按链表顺序调用所有对象的 OnFrame，再统一对所有对象进行运动积分和粒子更新。
+         * 此时 OnFrame 中观察到的其他对象的坐标总是上一帧的结果，与 luastg 的行为存在差异。
+         */
+        bool IsBatchMotionIntegrationEnabled() const noexcept { return m_bBatchMotionIntegration; }
+
+        /**
+         * 设置是否开启批量运动积分
+         * @param enable 是否开启
+         */
+        void SetBatchMotionIntegrationEnabled(bool enable) noexcept { m_bBatchMotionIntegration = enable; }
+
         /**
          * 在 Lua 栈上创建实例
          * 在 classIndex + 1 到栈顶元素被作为参数传递给 OnInit 方法
@@ -165,19 +183,55 @@ namespace lstg::v2::GamePlay
         bool OnSetAttribute(Subsystem::Script::LuaStack stack, ECS::EntityId id, std::string_view key,
             Subsystem::Script::LuaStack::AbsIndex value) override;
 
+    private:
+        struct CollisionCheckState
+        {
+            uint32_t GroupA = 0;
+            uint32_t GroupB = 0;
+
+            // 当前正在检查的对象 A
+            ECS::Entity EntityA;
+            Components::Collider* ColliderA = nullptr;
+            ECS::ComponentPointer<Components::Transform> TransformA;
+            Components::Script* ScriptA = nullptr;
+            Components::Collider* NextColliderA = nullptr;
+
+            // 对象 A 的 AABB 范围
+            double LeftA = 0.;
+            double RightA = 0.;
+            double TopA = 0.;
+            double BottomA = 0.;
+
+            // 统计
+            size_t PotentialPairs = 0;
+            size_t CandidatePairs = 0;
+            size_t NarrowPhaseTests = 0;
+        };
+
+        void InvalidateCollisionBroadPhase() noexcept { ++m_uColliderVersion; }
+        bool CollisionCheckPair(CollisionCheckState& state, ECS::Entity entityB, Components::Collider& colliderB) noexcept;
+        void CollisionCheckLinear(CollisionCheckState& state, Components::Collider* colliderB) noexcept;
+        bool CollisionCheckBroadPhase(CollisionCheckState& state) noexcept;
+        Result<void> RebuildCollisionBroadPhase(uint32_t group) noexcept;
+
+        void AppendSpriteBatch(Subsystem::Render::Drawing2D::CommandBuffer& cmdBuffer, const Subsystem::Render::Drawing2D::Sprite& sprite,
+            const Components::Transform& transform, const Components::Renderer& renderer) noexcept;
+        void FlushSpriteBatch(Subsystem::Render::Drawing2D::CommandBuffer& cmdBuffer) noexcept;
+
     private:
         GameApp& m_stApp;
         ECS::World m_stWorld;
         ScriptObjectPool m_stScriptObjectPool;
+        ThreadPool<> m_stParallelVisitThreads;  // 用于不涉及脚本的并行更新
 
         // 世界属性
         WorldRectangle m_stBoundary;
+        bool m_bBatchMotionIntegration = false;
 
         // 根对象
         ECS::Entity m_stRootEntity;
         Components::LifeTimeRoot* m_pLifeTimeRoot = nullptr;
         Components::ColliderRoot* m_pColliderRoot = nullptr;
-        Components::RendererRoot* m_pRendererRoot = nullptr;
 
         // 跳表插入器
         // 我们选择了深度为 3 层的跳表，且每层有 1/4 的概率被选中，则对于 10000 个对象，大概的分布如下：
@@ -185,5 +239,20 @@ namespace lstg::v2::GamePlay
         //  level1:  2500
         //  level2:   625
         SkipListDepthRandomizer<3, 4> m_stSkipListRandomizer;
+
+        // 渲染层索引
+        RenderLayerIndex m_stRenderLayerIndex;
+
+        // 原生渲染的精灵批次
+        // 连续使用同一精灵进行默认渲染的对象合并为一次 DrawInstances 调用，在进入脚本前或遍历结束时提交
+        const Subsystem::Render::Drawing2D::Sprite* m_pSpriteBatchSprite = nullptr;
+        std::vector<Subsystem::Render::Drawing2D::SpriteInstance> m_stSpriteBatchInstances;
+
+        // 碰撞粗检测
+        // 任何可能影响碰撞组成员、位置、外接矩形的操作都会使版本号自增，各组的网格在版本号变化后的首次检查时重建
+        uint64_t m_uColliderVersion = 1;
+        uint32_t m_uCollisionCheckDepth = 0;  // 回调中嵌套调用 CollisionCheck 时不使用粗检测
+        CollisionBroadPhase m_stColliderBroadPhases[Components::kColliderGroupCount];
+        std::vector<uint32_t> m_stCollisionCandidates;
     };
 }
@@ -0,0 +1,75 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cmath>
+#include <lstg/Core/ECS/World.hpp>
+#include "Components/Transform.hpp"
+#include "Components/Movement.hpp"
+
+namespace lstg::v2::GamePlay
+{
+    /**
+     * 积分一帧的运动
+     * 在 Frame 中对每个对象执行。
+     * @param transform 变换组件
+     * @param movement 移动组件
+     */
+    template <typename TScalar>
+    inline void IntegrateMotion(Components::BasicTransform<TScalar> transform, Components::BasicMovement<TScalar> movement) noexcept
+    {
+        movement.Velocity += movement.AccelVelocity;
+        transform.Location += movement.Velocity;
+        transform.Rotation += movement.AngularVelocity;
+    }
+
+    /**
+     * 更新坐标差量，并按需使对象朝向速度方向
+     * 在 UpdateXY 中对每个对象执行。
+     * @param transform 变换组件
+     * @param movement 移动组件
+     */
+    template <typename TScalar>
+    inline void UpdateMotionDelta(Components::BasicTransform<TScalar> transform, Components::BasicMovement<TScalar> movement) noexcept
+    {
+        transform.LocationDelta = transform.Location - transform.LastLocation;
+        transform.LastLocation = transform.Location;
+        if (movement.RotateToSpeedDirection && (transform.LocationDelta.x != 0 && transform.LocationDelta.y != 0))
+            transform.Rotation = static_cast<TScalar>(::atan2(transform.LocationDelta.y, transform.LocationDelta.x));
+    }
+
+    /**
+     * 对世界中的所有对象积分一帧的运动
+     * 开启批量运动积分时在 Frame 中执行，按 Archetype 连续遍历 Transform 和 Movement 的各列。
+     * @param world 世界
+     * @param pool 并行遍历使用的线程池
+     */
+    template <typename TScalar>
+    inline void BatchIntegrateMotion(ECS::World& world, ThreadPool<>& pool) noexcept
+    {
+        using Transform = Components::BasicTransform<TScalar>;
+        using Movement = Components::BasicMovement<TScalar>;
+        world.ParallelVisitEntities<std::tuple<Transform, Movement>>(pool, [](ECS::Entity ent, Transform transform, Movement movement) {
+            IntegrateMotion(transform, movement);
+        });
+    }
+
+    /**
+     * 更新世界中所有对象的坐标差量
+     * 在 UpdateXY 中执行。
+     * @param world 世界
+     * @param pool 并行遍历使用的线程池
+     */
+    template <typename TScalar>
+    inline void BatchUpdateMotionDelta(ECS::World& world, ThreadPool<>& pool) noexcept
+    {
+        using Transform = Components::BasicTransform<TScalar>;
+        using Movement = Components::BasicMovement<TScalar>;
+        world.ParallelVisitEntities<std::tuple<Transform, Movement>>(pool, [](ECS::Entity ent, Transform transform, Movement movement) {
+            UpdateMotionDelta(transform, movement);
+        });
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * @file
+ * @date 2022/9/10
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cassert>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "../../Core/Result.hpp"
+#include "Components/Renderer.hpp"
+
+namespace lstg::v2::GamePlay
+{
+    /**
+     * 渲染层桶
+     * 同一渲染层的对象存放在连续数组中。插入总是追加到末尾，删除只留下空位，在下一次遍历前统一压缩并按排序键升序整理。
+     */
+    struct RenderLayerBucket
+    {
+        struct Item
+        {
+            uint64_t SortKey = 0;
+            Components::Renderer* Renderer = nullptr;  // 为空表示已删除
+        };
+
+        std::vector<Item> Items;
+        size_t RemovedCount = 0;
+        bool Unsorted = false;  // 存在排序键小于前一个对象的插入
+    };
+
+    /**
+     * 渲染层索引
+     *
+     * 按照 (Layer, SortKey) 的顺序组织所有渲染对象，用于替代跳表。
+     * 插入只追加到对应层的末尾，删除只留下空位，均不需要移动其他对象。修改渲染层的对象排序键通常较小，所在层会被标记为无序，
+     * 在下一次遍历开始前统一排序。
+     * 遍历过程中允许插入和删除对象：插入到当前层或之后的层的对象会在本次遍历中访问到（当前层中总是位于末尾），
+     * 已经访问过的对象不会被重复访问。
+     */
+    class RenderLayerIndex
+    {
+    public:
+        /**
+         * 删除对象
+         * 若对象不在索引中则不做任何事情。
+         * @param renderer 渲染组件
+         */
+        static void Remove(Components::Renderer& renderer) noexcept;
+
+    public:
+        RenderLayerIndex() = default;
+        RenderLayerIndex(const RenderLayerIndex&) = delete;
+        RenderLayerIndex(RenderLayerIndex&&) = delete;
+        ~RenderLayerIndex() noexcept;
+
+        RenderLayerIndex& operator=(const RenderLayerIndex&) = delete;
+        RenderLayerIndex& operator=(RenderLayerIndex&&) = delete;
+
+    public:
+        /**
+         * 获取渲染层数量
+         */
+        [[nodiscard]] size_t GetLayerCount() const noexcept { return m_stBuckets.size(); }
+
+        /**
+         * 插入对象
+         * @param renderer 渲染组件，不能已经在索引中
+         * @param layer 渲染层
+         * @param sortKey 同一渲染层内的排序键
+         */
+        Result<void> Insert(Components::Renderer& renderer, double layer, uint64_t sortKey) noexcept;
+
+        /**
+         * 清空索引
+         * 所有对象会从索引脱离。
+         */
+        void Clear() noexcept;
+
+        /**
+         * 按顺序遍历所有对象
+         * @param callback 回调，签名为 void(Components::Renderer&)
+         */
+        template <typename TCallback>
+        void Traverse(TCallback&& callback) noexcept
+        {
+            // 只有在没有其他遍历时才能整理，否则会使游标失效
+            if (!m_pTopCursor)
+                Compact();
+
+            if (++m_uVisitEpoch == 0)  // 0 保留给未访问过的对象
+                ++m_uVisitEpoch;
+            auto epoch = m_uVisitEpoch;
+
+            Cursor cursor;
+            cursor.Prev = m_pTopCursor;
+            m_pTopCursor = &cursor;
+            for (auto it = m_stBuckets.begin(); it != m_stBuckets.end(); ++it)
+            {
+                cursor.Owner = &it->second;
+                for (cursor.Index = 0; cursor.Index < cursor.Owner->Items.size(); ++cursor.Index)
+                {
+                    auto renderer = cursor.Owner->Items[cursor.Index].Renderer;
+                    if (!renderer || renderer->LayerSlot.VisitEpoch == epoch)
+                        continue;
+                    renderer->LayerSlot.VisitEpoch = epoch;
+                    callback(*renderer);
+                }
+            }
+            m_pTopCursor = cursor.Prev;
+        }
+
+    private:
+        struct LayerLess
+        {
+            bool operator()(double lhs, double rhs) const noexcept
+            {
+                // NaN 总是排在最后，保证严格弱序
+                return lhs < rhs || (!std::isnan(lhs) && std::isnan(rhs));
+            }
+        };
+
+        struct Cursor
+        {
+            RenderLayerBucket* Owner = nullptr;
+            size_t Index = 0;
+            Cursor* Prev = nullptr;
+        };
+
+        void Compact() noexcept;
+
+    private:
+        std::map<double, RenderLayerBucket, LayerLess> m_stBuckets;
+        Cursor* m_pTopCursor = nullptr;  // 正在进行的遍历
+        uint32_t m_uVisitEpoch = 0;
+    };
+}
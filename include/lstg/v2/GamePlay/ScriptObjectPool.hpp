@@ -5,7 +5,9 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <cassert>
 #include <optional>
+#include <vector>
 #include <unordered_map>
 #include <lstg/Core/Subsystem/Script/LuaState.hpp>
 #include <lstg/Core/Subsystem/Script/LuaReference.hpp>
@@ -57,6 +59,9 @@ namespace lstg::v2::GamePlay
     };
 
     using ScriptObjectId = uint32_t;
+    using ScriptClassId = uint32_t;
+
+    static constexpr ScriptClassId kInvalidScriptClassId = 0;
 
     static constexpr int kIndexOfClassInObject = 1;
     static constexpr int kIndexOfScriptObjectIdInObject = 2;
@@ -140,6 +145,21 @@ namespace lstg::v2::GamePlay
         ScriptCallbackInvokeResult InvokeCallback(Subsystem::Script::LuaStack stack, ScriptObjectId scriptId, ScriptCallbackFunctions callback,
             unsigned args) noexcept;
 
+        /**
+         * 通过类缓存调用回调函数
+         * 回调函数直接从缓存中取出，不再经由对象查找类表。回调未定义时不会访问 Lua。
+         * 调用的总是最近一次 RefreshClassCache 时类表上的回调，在此之后对类表的修改要到下一次刷新才生效。
+         * 对于无效的类ID，退化为逐次查找。
+         * [-args, +0]
+         * @param stack Lua栈
+         * @param scriptId 脚本侧对象ID
+         * @param classId 对象所属类ID
+         * @param callback 回调方法
+         * @param args 参数个数
+         */
+        ScriptCallbackInvokeResult InvokeCallback(Subsystem::Script::LuaStack stack, ScriptObjectId scriptId, ScriptClassId classId,
+            ScriptCallbackFunctions callback, unsigned args) noexcept;
+
         /**
          * 获取对象实例ID
          * @param scriptObjectId 脚本对象ID
@@ -147,6 +167,59 @@ namespace lstg::v2::GamePlay
          */
         std::optional<ECS::EntityId> GetEntityId(ScriptObjectId scriptObjectId) noexcept;
 
+        /**
+         * 获取类在缓存中的 ID，并增加引用计数
+         * 每个引用都需要通过 ReleaseClass 释放。
+         * @param stack Lua栈
+         * @param classIndex Class对象在栈上的索引
+         * @return 类ID，当 Class 不是表时返回 kInvalidScriptClassId
+         */
+        Result<ScriptClassId> AcquireClass(Subsystem::Script::LuaStack stack, Subsystem::Script::LuaStack::AbsIndex classIndex) noexcept;
+
+        /**
+         * 释放类的引用
+         * 引用计数归零时类从缓存中移除。
+         * @param classId 类ID
+         */
+        void ReleaseClass(ScriptClassId classId) noexcept;
+
+        /**
+         * 检查类上是否定义了回调
+         * 对于无效的类ID总是返回 true，由 InvokeCallback 处理具体情况。
+         * @param classId 类ID
+         * @param callback 回调方法
+         */
+        bool IsCallbackDefined(ScriptClassId classId, ScriptCallbackFunctions callback) const noexcept
+        {
+            if (classId == kInvalidScriptClassId)
+                return true;
+            assert(classId <= m_stClasses.size() && m_stClasses[classId - 1].RefCount > 0);
+            return (m_stClasses[classId - 1].CallbackMask & (1u << static_cast<unsigned>(callback))) != 0;
+        }
+
+        /**
+         * 刷新类缓存
+         * 类表上的回调可能被脚本修改（如热重载），在依赖缓存的遍历开始前需要调用本方法重新读取。
+         * 两次刷新之间对类表的修改不会被观察到，即遍历中途对类回调的修改从下一次遍历开始生效，这是有意的行为。
+         * @param stack Lua栈
+         */
+        void RefreshClassCache(Subsystem::Script::LuaStack stack) noexcept;
+
+    private:
+        static constexpr size_t kCallbackCount = static_cast<size_t>(ScriptCallbackFunctions::OnKill);
+
+        struct ClassCacheEntry
+        {
+            Subsystem::Script::LuaReference ClassRef;
+            const void* Key = nullptr;  // 类表地址，类表由 ClassRef 持有，因此在条目存续期间不会被复用
+            uint32_t RefCount = 0;
+            uint32_t CallbackMask = 0;  // 第 N 位表示槽位 N 上的回调非空
+            uint32_t FunctionMask = 0;  // 第 N 位表示槽位 N 上的回调为函数
+            Subsystem::Script::LuaReference Callbacks[kCallbackCount];  // 槽位 N 上的函数，下标为 N - 1
+        };
+
+        static void LoadClassCallbacks(Subsystem::Script::LuaStack stack, ClassCacheEntry& entry) noexcept;
+
     private:
         Subsystem::Script::LuaState& m_stState;
         IScriptObjectBridge* m_pBridge = nullptr;
@@ -157,6 +230,10 @@ namespace lstg::v2::GamePlay
         // 由于 luajit 不能存储 int64_t，我们需要中间表进行转换
         std::unordered_map<ScriptObjectId, ECS::EntityId> m_stEntityIdMapping;
 
+        // 类缓存，类ID为下标加一
+        std::vector<ClassCacheEntry> m_stClasses;
+        std::unordered_map<const void*, ScriptClassId> m_stClassMapping;
+
         ScriptObjectId m_uNextObjectId = 1;
         size_t m_uCurrentObjects = 0;
     };
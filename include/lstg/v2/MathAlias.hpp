@@ -15,4 +15,13 @@ namespace lstg::v2
     using Vec2 = glm::vec<2, double, glm::defaultp>;
     using WorldRectangle = Math::Rectangle<double, Math::BottomUpTag>;
     using ColliderShape = Math::Collider2D::ColliderShape<double>;
+
+    // 高频访问组件（Transform、Movement）的存储精度
+    // 开启 LSTG_V2_SINGLE_PRECISION_COMPONENTS 时使用单精度存储以减少每帧遍历的内存带宽，碰撞检测等计算仍在双精度下进行
+#ifdef LSTG_V2_SINGLE_PRECISION_COMPONENTS
+    using ComponentScalar = float;
+#else
+    using ComponentScalar = double;
+#endif
+    using ComponentVec2 = glm::vec<2, ComponentScalar, glm::defaultp>;
 }
@@ -6,6 +6,7 @@
  */
 #include <lstg/Core/ECS/Archetype.hpp>
 
+#include <algorithm>
 #include <optional>
 
 using namespace std;
@@ -16,16 +17,22 @@ Archetype::Archetype(ArchetypeId id, Span<const ComponentDescriptor*> descriptor
     : m_uId(id), m_uTypeId(ECS::GetArchetypeTypeId(descriptors))
 {
     assert(!descriptors.IsEmpty());
+    assert(descriptors.GetSize() < kInvalidChunkIndex);
 
     // 初始化 Chunk
     // 由于每个 Chunk 初始化时大小相同，可以容纳的 Component 数量不同，这里需要取最小值作为初始可分配数量
     optional<size_t> entityCount;
+    m_stChunkIndex.fill(kInvalidChunkIndex);
+    m_stChunks.reserve(descriptors.GetSize());
     for (auto desc : descriptors)
     {
+        assert(desc->Id < kMaxComponentId);
+        assert(m_stChunkIndex[desc->Id] == kInvalidChunkIndex);
         Chunk chunk(*desc);
         chunk.Expand().ThrowIfError();  // 分配一块内存
         entityCount = entityCount ? std::min(*entityCount, chunk.GetCapacity()) : chunk.GetCapacity();
-        m_stChunks.emplace(desc->Id, std::move(chunk));
+        m_stChunkIndex[desc->Id] = static_cast<uint8_t>(m_stChunks.size());
+        m_stChunks.emplace_back(std::move(chunk));
         m_uComponentSizeOfOneEntity += desc->SizeOfComponent;  // 统计单个 Entity 占用的内存大小
     }
     assert(entityCount);
@@ -45,7 +52,8 @@ Archetype::Archetype(ArchetypeId id, Span<const ComponentDescriptor*> descriptor
 }
 
 Archetype::Archetype(Archetype&& org) noexcept
-    : m_uId(org.m_uId), m_uTypeId(org.m_uTypeId), m_stChunks(std::move(org.m_stChunks)), m_stEntities(std::move(org.m_stEntities)),
+    : m_uId(org.m_uId), m_uTypeId(org.m_uTypeId), m_stChunks(std::move(org.m_stChunks)), m_stChunkIndex(org.m_stChunkIndex),
+    m_stEntities(std::move(org.m_stEntities)),
     m_uFirstUsedEntity(org.m_uFirstUsedEntity), m_uLastUsedEntity(org.m_uLastUsedEntity), m_uFirstFreeEntity(org.m_uFirstFreeEntity),
     m_uUsedEntity(org.m_uUsedEntity), m_uFreeEntity(org.m_uFreeEntity)
 {
@@ -62,16 +70,16 @@ Result<ArchetypeEntityId> Archetype::Alloc() noexcept
     {
         // 此时需要申请空间
         optional<size_t> entityCount;
-        for (auto& pair : m_stChunks)
+        for (auto& chunk : m_stChunks)
         {
-            if (pair.second.GetCapacity() <= m_stEntities.size())  // 只在短板的 Component 分配内存
+            if (chunk.GetCapacity() <= m_stEntities.size())  // 只在短板的 Component 分配内存
             {
-                assert(pair.second.GetCapacity() == m_stEntities.size());
-                auto ret = pair.second.Expand();
+                assert(chunk.GetCapacity() == m_stEntities.size());
+                auto ret = chunk.Expand();
                 if (!ret)  // 内存分配失败
                     return ret.GetError();
             }
-            entityCount = entityCount ? std::min(*entityCount, pair.second.GetCapacity()) : pair.second.GetCapacity();
+            entityCount = entityCount ? std::min(*entityCount, chunk.GetCapacity()) : chunk.GetCapacity();
         }
         assert(entityCount);
         assert(*entityCount > m_stEntities.size());  // 一定可以分配出内存
@@ -145,9 +153,58 @@ Result<ArchetypeEntityId> Archetype::Alloc() noexcept
 void Archetype::Free(ArchetypeEntityId id) noexcept
 {
     assert(id < m_stEntities.size());
+    assert(m_stEntities[id].Used);
 
+    MoveToFreeList(id);
+
+    // 初始化 Components
+    // 通过 Reset 方法回收资源
+    for (auto& chunk : m_stChunks)
+        chunk.ResetComponent(id);
+
+    // 刷新状态
+    m_stEntities[id].Used = false;
+}
+
+size_t Archetype::Free(Span<EntityId> ids) noexcept
+{
+    // 过滤掉无效的实例
+    size_t count = 0;
+    for (size_t i = 0; i < ids.GetSize(); ++i)
+    {
+        auto entityId = ids[i];
+        assert(GetEntityArchetypeId(entityId) == m_uId);
+        auto id = GetEntityArchetypeEntityId(entityId);
+        assert(id < m_stEntities.size());
+
+        auto& ent = m_stEntities[id];
+        if (!ent.Used || ent.Seq != GetEntitySeq(entityId))
+            continue;
+        ids[count++] = entityId;
+    }
+
+    // 去重
+    // 在 Reset 完成前 Used 标记保持不变，因此不能依赖它过滤重复的 ID
+    auto begin = ids.GetData();
+    std::sort(begin, begin + count);
+    count = static_cast<size_t>(std::unique(begin, begin + count) - begin);
+
+    // 与单个释放的顺序一致：先断开链表，再回收资源，最后刷新状态
+    for (size_t i = 0; i < count; ++i)
+        MoveToFreeList(GetEntityArchetypeEntityId(ids[i]));
+    for (auto& chunk : m_stChunks)
+    {
+        for (size_t i = 0; i < count; ++i)
+            chunk.ResetComponent(GetEntityArchetypeEntityId(ids[i]));
+    }
+    for (size_t i = 0; i < count; ++i)
+        m_stEntities[GetEntityArchetypeEntityId(ids[i])].Used = false;
+    return count;
+}
+
+void Archetype::MoveToFreeList(ArchetypeEntityId id) noexcept
+{
     auto& ent = m_stEntities[id];
-    assert(ent.Used);
 
     // 从使用中链表断开
     if (ent.Prev != kInvalidArchetypeEntityId)
@@ -177,14 +234,6 @@ void Archetype::Free(ArchetypeEntityId id) noexcept
     ent.Next = m_uFirstFreeEntity;
     m_uFirstFreeEntity = id;
     ++m_uFreeEntity;
-
-    // 初始化 Components
-    // 通过 Reset 方法回收资源
-    for (auto& pair : m_stChunks)
-        pair.second.ResetComponent(id);
-
-    // 刷新状态
-    ent.Used = false;
 }
 
 EntityState Archetype::GetEntityState(ArchetypeEntityId id) noexcept
@@ -212,7 +261,7 @@ size_t Archetype::GetAllocatedMemorySize() const noexcept
 {
     size_t ret = 0;
     for (const auto& chunk : m_stChunks)
-        ret += chunk.second.GetMemorySize();
+        ret += chunk.GetMemorySize();
     return ret;
 }
 
@@ -12,7 +12,8 @@ using namespace std;
 using namespace lstg;
 using namespace lstg::ECS;
 
-static const size_t kChunkMemoryExpandSize = 16 * 1024;  // 16K
+static const size_t kChunkPageSize = 16 * 1024;  // 16K
+static const size_t kChunkColumnAlignment = 64;  // 按列存储时每列起始于缓存行边界
 
 namespace
 {
@@ -34,20 +35,58 @@ namespace
         return free(p);
 #endif
     }
+
+    size_t AlignUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * 计算按列存储时各列在页内的偏移
+     * @param descriptor 组件描述
+     * @param pageCapacity 每页容纳的 Component 数量
+     * @param offsets 输出各列的偏移
+     * @return 页大小
+     */
+    size_t LayoutColumns(const ComponentDescriptor& descriptor, size_t pageCapacity, size_t* offsets) noexcept
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < descriptor.ColumnCount; ++i)
+        {
+            assert(descriptor.Columns[i].Align <= kChunkColumnAlignment);
+            offsets[i] = size;
+            size = AlignUp(size + pageCapacity * descriptor.Columns[i].Size, kChunkColumnAlignment);
+        }
+        return size;
+    }
 }
 
 Chunk::Chunk(const ComponentDescriptor& descriptor)
     : m_pDescriptor(&descriptor)
 {
-    assert(kChunkMemoryExpandSize >= descriptor.SizeOfComponent);
+    assert(kChunkPageSize >= descriptor.SizeOfComponent);
+
+    // 每页容纳的 Component 数量取不超过 kChunkPageSize 的最大 2 的幂
+    if (descriptor.ColumnCount == 0)
+    {
+        while ((static_cast<size_t>(2u) << m_uPageCapacityShift) * descriptor.SizeOfComponent <= kChunkPageSize)
+            ++m_uPageCapacityShift;
+    }
+    else
+    {
+        assert(descriptor.ColumnCount <= kMaxComponentColumns);
+        while (LayoutColumns(descriptor, static_cast<size_t>(2u) << m_uPageCapacityShift, m_stColumnOffsets.data()) <= kChunkPageSize)
+            ++m_uPageCapacityShift;
+        LayoutColumns(descriptor, GetPageCapacity(), m_stColumnOffsets.data());
+    }
 }
 
 Chunk::Chunk(Chunk&& rhs) noexcept
-    : m_pDescriptor(rhs.m_pDescriptor), m_uComponentCapacity(rhs.m_uComponentCapacity), m_uMemorySize(rhs.m_uMemorySize),
-    m_pMemory(rhs.m_pMemory)
+    : m_pDescriptor(rhs.m_pDescriptor), m_uPageCapacityShift(rhs.m_uPageCapacityShift), m_uComponentCapacity(rhs.m_uComponentCapacity),
+    m_uMemorySize(rhs.m_uMemorySize), m_stPages(std::move(rhs.m_stPages)), m_stColumnOffsets(rhs.m_stColumnOffsets)
 {
     rhs.m_uComponentCapacity = rhs.m_uMemorySize = 0u;
-    rhs.m_pMemory = nullptr;
+    rhs.m_stPages.clear();
 }
 
 Chunk::~Chunk()
@@ -63,72 +102,101 @@ Chunk& Chunk::operator=(Chunk&& rhs) noexcept
     FreeMemory();
 
     m_pDescriptor = rhs.m_pDescriptor;
+    m_uPageCapacityShift = rhs.m_uPageCapacityShift;
     m_uComponentCapacity = rhs.m_uComponentCapacity;
     m_uMemorySize = rhs.m_uMemorySize;
-    m_pMemory = rhs.m_pMemory;
+    m_stPages = std::move(rhs.m_stPages);
+    m_stColumnOffsets = rhs.m_stColumnOffsets;
 
     rhs.m_uComponentCapacity = rhs.m_uMemorySize = 0;
-    rhs.m_pMemory = nullptr;
+    rhs.m_stPages.clear();
     return *this;
 }
 
 Result<void> Chunk::Expand() noexcept
 {
-    // 分配内存块，每次增长 kChunkMemoryExpandSize
-    auto size = m_uMemorySize + kChunkMemoryExpandSize;
-    auto capacity = size / m_pDescriptor->SizeOfComponent;
-    auto m = reinterpret_cast<uint8_t*>(AlignedAlloc(size, m_pDescriptor->AlignOfComponent));
+    // 分配新页，已有的页不做任何移动
+    auto pageCapacity = GetPageCapacity();
+    auto pageSize = GetPageSize();
+    try
+    {
+        m_stPages.reserve(m_stPages.size() + 1);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    auto alignment = IsColumnar() ? kChunkColumnAlignment : m_pDescriptor->AlignOfComponent;
+    auto m = reinterpret_cast<uint8_t*>(AlignedAlloc(pageSize, alignment));
     if (!m)
         return make_error_code(errc::not_enough_memory);
 
-    // 进行移动构造和释放
-    for (size_t i = 0; i < m_uComponentCapacity; ++i)
+    // 进行构造
+    if (IsColumnar())
     {
-        auto dest = m + i * m_pDescriptor->SizeOfComponent;
-        auto src = m_pMemory + i * m_pDescriptor->SizeOfComponent;
-        m_pDescriptor->MoveConstructor(dest, src);
-        m_pDescriptor->Destructor(src);
+        void* fields[kMaxComponentColumns];
+        for (size_t i = 0; i < pageCapacity; ++i)
+        {
+            for (size_t j = 0; j < m_pDescriptor->ColumnCount; ++j)
+                fields[j] = m + m_stColumnOffsets[j] + i * m_pDescriptor->Columns[j].Size;
+            m_pDescriptor->ColumnConstructor(fields);
+        }
     }
-
-    // 进行构造
-    for (size_t i = m_uComponentCapacity; i < capacity; ++i)
+    else
     {
-        auto dest = m + i * m_pDescriptor->SizeOfComponent;
-        m_pDescriptor->Constructor(dest);
+        for (size_t i = 0; i < pageCapacity; ++i)
+        {
+            auto dest = m + i * m_pDescriptor->SizeOfComponent;
+            m_pDescriptor->Constructor(dest);
+        }
     }
 
-    // 释放原始数据
-    if (m_pMemory)
-        ::AlignedFree(m_pMemory);
-
-    m_uComponentCapacity = capacity;
-    m_uMemorySize = size;
-    m_pMemory = m;
+    m_stPages.push_back(m);
+    m_uComponentCapacity += pageCapacity;
+    m_uMemorySize += pageSize;
     return {};
 }
 
 void Chunk::ResetComponent(ArchetypeEntityId index) noexcept
 {
-    auto p = m_pMemory + index * m_pDescriptor->SizeOfComponent;
-    assert(p < m_pMemory + m_uMemorySize);
-    m_pDescriptor->Reset(p);
+    if (IsColumnar())
+    {
+        void* fields[kMaxComponentColumns];
+        GetComponentColumnsRaw(index, fields);
+        m_pDescriptor->ColumnReset(fields);
+    }
+    else
+    {
+        auto p = GetComponentRaw(index);
+        m_pDescriptor->Reset(p);
+    }
+}
+
+size_t Chunk::GetPageSize() const noexcept
+{
+    if (!IsColumnar())
+        return GetPageCapacity() * m_pDescriptor->SizeOfComponent;
+
+    std::array<size_t, kMaxComponentColumns> offsets {};
+    return LayoutColumns(*m_pDescriptor, GetPageCapacity(), offsets.data());
 }
 
 void Chunk::FreeMemory() noexcept
 {
-    if (m_pMemory)
+    for (auto page : m_stPages)
     {
-        // 调用析构
-        for (size_t i = 0; i < m_uComponentCapacity; ++i)
+        // 调用析构，按列存储的字段总是可平凡析构的
+        auto pageCapacity = GetPageCapacity();
+        for (size_t i = 0; !IsColumnar() && i < pageCapacity; ++i)
         {
-            auto dest = m_pMemory + i * m_pDescriptor->SizeOfComponent;
+            auto dest = page + i * m_pDescriptor->SizeOfComponent;
             m_pDescriptor->Destructor(dest);
         }
 
         // 释放内存
-        AlignedFree(m_pMemory);
-
-        m_uComponentCapacity = m_uMemorySize = 0;
-        m_pMemory = nullptr;
+        AlignedFree(page);
     }
+
+    m_stPages.clear();
+    m_uComponentCapacity = m_uMemorySize = 0;
 }
@@ -53,7 +53,7 @@ bool Entity::HasComponent(ComponentId id) const noexcept
 {
     auto archetypeId = GetEntityArchetypeId(m_uId);
     auto& archetype = m_pWorld->GetArchetype(archetypeId);
-    return (archetype.GetTypeId() & (1u << id)) != 0;
+    return (archetype.GetTypeId() & (static_cast<ArchetypeTypeId>(1u) << id)) != 0;
 }
 
 void* Entity::GetComponent(ComponentId id) noexcept
@@ -72,10 +72,18 @@ void* Entity::TryGetComponent(ComponentId id) noexcept
         return nullptr;
 
     auto archetypeId = GetEntityArchetypeId(m_uId);
+    auto archetypeEntityId = GetEntityArchetypeEntityId(m_uId);
     auto& archetype = m_pWorld->GetArchetype(archetypeId);
-    if ((archetype.GetTypeId() & (1u << id)) == 0)
-        return nullptr;
+    return archetype.TryGetComponent(archetypeEntityId, id);
+}
+
+bool Entity::TryGetComponentColumns(ComponentId id, void** fields) noexcept
+{
+    if (!m_pWorld || m_uId == kInvalidEntityId)
+        return false;
+
+    auto archetypeId = GetEntityArchetypeId(m_uId);
     auto archetypeEntityId = GetEntityArchetypeEntityId(m_uId);
-    auto ret = archetype.GetComponent(archetypeEntityId, id);
-    return ret;
+    auto& archetype = m_pWorld->GetArchetype(archetypeId);
+    return archetype.TryGetComponentColumns(archetypeEntityId, id, fields);
 }
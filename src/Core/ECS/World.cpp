@@ -50,6 +50,44 @@ size_t World::GetFreeEntityCount() const noexcept
     return ret;
 }
 
+void World::DeferDestroy(const Entity& entity) noexcept
+{
+    if (!entity)
+        return;
+    assert(entity.GetWorld() == this);
+
+    try
+    {
+        m_stDeferredDestroyEntities.push_back(entity.GetId());
+    }
+    catch (...)  // bad_alloc
+    {
+        // 无法延迟时退化为立即销毁
+        auto copy = entity;
+        copy.Destroy();
+    }
+}
+
+size_t World::FlushDeferredDestroy() noexcept
+{
+    size_t ret = 0;
+    size_t i = 0;
+    auto& pending = m_stDeferredDestroyEntities;
+    while (i < pending.size())
+    {
+        // 找到属于同一 Archetype 的连续区间
+        auto archetypeId = GetEntityArchetypeId(pending[i]);
+        auto j = i + 1;
+        while (j < pending.size() && GetEntityArchetypeId(pending[j]) == archetypeId)
+            ++j;
+
+        ret += GetArchetype(archetypeId).Free(Span<EntityId>(pending.data() + i, j - i));
+        i = j;
+    }
+    pending.clear();
+    return ret;
+}
+
 Result<Entity> World::CreateEntity(Span<const ComponentDescriptor*> desc) noexcept
 {
     assert(!desc.IsEmpty());
@@ -6,6 +6,8 @@
  */
 #include <lstg/Core/Subsystem/Asset/AssetPool.hpp>
 
+#include <algorithm>
+#include <lstg/Core/Hash.hpp>
 #include <lstg/Core/Subsystem/Asset/AssetError.hpp>
 #include "detail/WeakPtrTraits.hpp"
 
@@ -13,6 +15,14 @@ using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::Asset;
 
+static const size_t kMinNameIndexCapacity = 64;
+static const size_t kNotFound = static_cast<size_t>(-1);
+
+uint32_t AssetPool::HashName(std::string_view name) noexcept
+{
+    return MurmurHash3({ reinterpret_cast<const uint8_t*>(name.data()), name.size() });
+}
+
 AssetPool::~AssetPool()
 {
     Clear(AssetClearTypes::All);
@@ -24,34 +34,29 @@ Result<void> AssetPool::AddAsset(AssetPtr asset) noexcept
     auto id = m_iNextAssetId++;
 
     // 允许资产为匿名资产，此时不能通过名称快速查找
-    if (!asset->GetName().empty())
-    {
-        auto it = m_stLookupTable.find(asset->GetName());
-        if (it != m_stLookupTable.end())
-            return make_error_code(AssetError::AssetAlreadyExists);
-    }
+    auto named = !asset->GetName().empty();
+    auto hash = named ? HashName(asset->GetName()) : 0u;
+    if (named && FindNameIndexSlot(asset->GetName(), hash) != kNotFound)
+        return make_error_code(AssetError::AssetAlreadyExists);
     assert(m_stAssets.find(id) == m_stAssets.end());
 
     try
     {
-        if (!asset->GetName().empty())
-            m_stLookupTable.emplace(asset->GetName(), id);
-        m_stAssets.emplace(id, asset);
+        // 预先扩容名称索引，保证插入 m_stAssets 之后的操作不会失败
+        if (named)
+            ReserveNameIndex(m_uNameIndexCount + 1);
+        auto it = m_stAssets.emplace(id, asset).first;
+        if (named)
+            InsertNameIndex(&it->second, hash);
     }
     catch (...)  // bad_alloc
     {
-        // 回滚状态，若 m_stAssets 插入失败只要判断 m_stLookupTable 是否有插入就行
-        if (!asset->GetName().empty())
-        {
-            auto it = m_stLookupTable.find(asset->GetName());
-            if (it != m_stLookupTable.end())
-                m_stLookupTable.erase(it);
-        }
         return make_error_code(errc::not_enough_memory);
     }
 
     asset->m_uId = id;
     asset->m_pPool = shared_from_this();
+    ++m_uGeneration;
     return {};
 }
 
@@ -65,8 +70,7 @@ bool AssetPool::ContainsAsset(AssetId id) noexcept
 
 bool AssetPool::ContainsAsset(std::string_view name) noexcept
 {
-    auto it = m_stLookupTable.find(name);
-    return it != m_stLookupTable.end();
+    return FindNameIndexSlot(name, HashName(name)) != kNotFound;
 }
 
 Result<void> AssetPool::RemoveAsset(AssetId id) noexcept
@@ -89,25 +93,22 @@ Result<void> AssetPool::RemoveAsset(AssetId id) noexcept
     if (cnt != m_stAssets.size())
         it = m_stAssets.find(id);
     assert(it != m_stAssets.end());
-    m_stAssets.erase(it);
     if (!asset->GetName().empty())
-    {
-        auto jt = m_stLookupTable.find(asset->GetName());
-        assert(jt != m_stLookupTable.end());
-        m_stLookupTable.erase(jt);
-    }
+        RemoveNameIndex(asset->GetName());
+    m_stAssets.erase(it);
 
     asset->m_uId = kEmptyAssetId;
     asset->m_pPool.reset();
+    ++m_uGeneration;
     return {};
 }
 
 Result<void> AssetPool::RemoveAsset(std::string_view name) noexcept
 {
-    auto it = m_stLookupTable.find(name);
-    if (it == m_stLookupTable.end())
+    auto slot = FindNameIndexSlot(name, HashName(name));
+    if (slot == kNotFound)
         return make_error_code(AssetError::AssetNotFound);
-    auto ret = RemoveAsset(it->second);
+    auto ret = RemoveAsset((*m_stNameIndex[slot].Asset)->GetId());
     assert(ret || ret.GetError() != make_error_code(AssetError::AssetNotFound));
     return ret;
 }
@@ -119,10 +120,12 @@ void AssetPool::Clear(AssetClearTypes type) noexcept
     while (it != m_stAssets.end())
     {
         auto id = it->first;
-        auto asset = it->second;
 
-        if (type == AssetClearTypes::All || (type == AssetClearTypes::Unused && asset.use_count() == 1))
+        // 需要在复制指针之前检查引用计数，否则计数总是大于 1
+        if (type == AssetClearTypes::All || (type == AssetClearTypes::Unused && it->second.use_count() == 1))
         {
+            auto asset = it->second;
+
             // 调用 Asset::OnRemove 方法，通知回收子资源
             // 注意这里 Asset 上的 Pool 被 OnRemove 需要，不能在这里断开关联
             assert(asset->m_uId != kEmptyAssetId);
@@ -132,17 +135,14 @@ void AssetPool::Clear(AssetClearTypes type) noexcept
             if (cnt != m_stAssets.size())
                 it = m_stAssets.find(id);
             assert(it != m_stAssets.end());
+            if (!asset->GetName().empty())
+                RemoveNameIndex(asset->GetName());
             it = m_stAssets.erase(it);
             cnt = m_stAssets.size();
-            if (!asset->GetName().empty())
-            {
-                auto jt = m_stLookupTable.find(asset->GetName());
-                assert(jt != m_stLookupTable.end());
-                m_stLookupTable.erase(jt);
-            }
 
             asset->m_uId = kEmptyAssetId;
             asset->m_pPool.reset();
+            ++m_uGeneration;
         }
         else
         {
@@ -155,12 +155,17 @@ void AssetPool::Clear(AssetClearTypes type) noexcept
 
 AssetPtr AssetPool::GetAsset(std::string_view name) const noexcept
 {
-    auto it = m_stLookupTable.find(name);
-    if (it != m_stLookupTable.end())
+    return GetAsset(name, HashName(name));
+}
+
+AssetPtr AssetPool::GetAsset(std::string_view name, uint32_t hash) const noexcept
+{
+    assert(hash == HashName(name));
+    auto slot = FindNameIndexSlot(name, hash);
+    if (slot != kNotFound)
     {
-        auto ret = GetAsset(it->second);
-        assert(ret);
-        return ret;
+        assert(m_stNameIndex[slot].Asset && *m_stNameIndex[slot].Asset);
+        return *m_stNameIndex[slot].Asset;
     }
     return nullptr;
 }
@@ -172,3 +177,88 @@ AssetPtr AssetPool::GetAsset(AssetId id) const noexcept
         return it->second;
     return nullptr;
 }
+
+size_t AssetPool::FindNameIndexSlot(std::string_view name, uint32_t hash) const noexcept
+{
+    if (m_uNameIndexCount == 0)
+        return kNotFound;
+
+    auto mask = m_stNameIndex.size() - 1;
+    for (auto i = static_cast<size_t>(hash) & mask; ; i = (i + 1) & mask)
+    {
+        const auto& slot = m_stNameIndex[i];
+        if (!slot.Asset)
+        {
+            if (!slot.Removed)
+                return kNotFound;
+            continue;
+        }
+        if (slot.Hash == hash && (*slot.Asset)->GetName() == name)
+            return i;
+    }
+}
+
+void AssetPool::ReserveNameIndex(size_t count)
+{
+    // 负载因子（含墓碑）不超过 1/2，保证探测序列总能遇到空槽位
+    if ((count + m_uNameIndexRemoved) * 2 <= m_stNameIndex.size())
+        return;
+
+    auto capacity = kMinNameIndexCapacity;
+    while (capacity < count * 2)
+        capacity *= 2;
+
+    std::vector<NameIndexSlot> slots(capacity);
+    auto mask = capacity - 1;
+    for (const auto& slot : m_stNameIndex)
+    {
+        if (!slot.Asset)
+            continue;
+        auto i = static_cast<size_t>(slot.Hash) & mask;
+        while (slots[i].Asset)
+            i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+    m_stNameIndex = std::move(slots);
+    m_uNameIndexRemoved = 0;
+}
+
+void AssetPool::InsertNameIndex(const AssetPtr* asset, uint32_t hash) noexcept
+{
+    assert(asset && *asset);
+    assert((m_uNameIndexCount + m_uNameIndexRemoved + 1) * 2 <= m_stNameIndex.size());
+
+    // 可以复用墓碑，调用方已经保证名称不存在
+    auto mask = m_stNameIndex.size() - 1;
+    auto i = static_cast<size_t>(hash) & mask;
+    while (m_stNameIndex[i].Asset)
+        i = (i + 1) & mask;
+    auto& slot = m_stNameIndex[i];
+    if (slot.Removed)
+        --m_uNameIndexRemoved;
+    slot.Asset = asset;
+    slot.Hash = hash;
+    slot.Removed = false;
+    ++m_uNameIndexCount;
+}
+
+void AssetPool::RemoveNameIndex(std::string_view name) noexcept
+{
+    auto i = FindNameIndexSlot(name, HashName(name));
+    assert(i != kNotFound);
+    if (i == kNotFound)
+        return;
+
+    auto& slot = m_stNameIndex[i];
+    slot.Asset = nullptr;
+    slot.Removed = true;
+    --m_uNameIndexCount;
+    ++m_uNameIndexRemoved;
+
+    // 清空时顺带清理所有墓碑
+    if (m_uNameIndexCount == 0)
+    {
+        std::fill(m_stNameIndex.begin(), m_stNameIndex.end(), NameIndexSlot {});
+        m_uNameIndexRemoved = 0;
+    }
+}
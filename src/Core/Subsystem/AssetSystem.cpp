@@ -111,6 +111,14 @@ AssetSystem::AssetSystem(SubsystemContainer& container)
         LSTG_LOG_INFO_CAT(AssetSystem, "Async loading is enabled");
         SetAsyncLoadingEnabled(true);
     }
+
+    // 预取缓存大小
+    auto cmdPrefetchCacheSize = AppBase::GetCmdline().GetOption<int>("prefetch-cache-size", -1);
+    if (cmdPrefetchCacheSize >= 0)
+    {
+        LSTG_LOG_INFO_CAT(AssetSystem, "Prefetch cache size is set to {}MB", cmdPrefetchCacheSize);
+        m_pVirtualFileSystem->SetPrefetchCacheLimit(static_cast<size_t>(cmdPrefetchCacheSize) * 1024 * 1024);
+    }
 }
 
 AssetSystem::~AssetSystem()
@@ -119,12 +127,12 @@ AssetSystem::~AssetSystem()
     s_pInstance = nullptr;
 }
 
-Result<VFS::StreamPtr> AssetSystem::OpenAssetStream(std::string_view path) noexcept
+Result<VFS::StreamPtr> AssetSystem::OpenAssetStream(std::string_view path, VFS::FileOpenFlags flags) noexcept
 {
     try
     {
         auto fullPath = fmt::format("{0}/{1}", m_pVirtualFileSystem->GetAssetBaseDirectory(), path);
-        return m_pVirtualFileSystem->OpenFile(fullPath, VFS::FileAccessMode::Read);
+        return m_pVirtualFileSystem->OpenFile(fullPath, VFS::FileAccessMode::Read, flags);
     }
     catch (...)
     {
@@ -145,6 +153,22 @@ Result<VFS::FileAttribute> AssetSystem::GetAssetStreamAttribute(std::string_view
     }
 }
 
+Result<size_t> AssetSystem::PrefetchAssetStreams(Span<const std::string_view> paths) noexcept
+{
+    std::vector<std::string> fullPaths;
+    try
+    {
+        fullPaths.reserve(paths.GetSize());
+        for (size_t i = 0; i < paths.GetSize(); ++i)
+            fullPaths.emplace_back(fmt::format("{0}/{1}", m_pVirtualFileSystem->GetAssetBaseDirectory(), paths[i]));
+    }
+    catch (...)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    return m_pVirtualFileSystem->Prefetch(Span<const std::string>{fullPaths});
+}
+
 Result<void> AssetSystem::RegisterAssetFactory(Asset::AssetFactoryPtr factory) noexcept
 {
     // 检查是否已经存在
@@ -375,6 +375,8 @@ ImGuiRenderer::ImGuiRenderer(Render::RenderDevice* deviceBridge, ImGuiIO& io)
     : m_pDeviceBridge(deviceBridge), m_stImGuiIO(io)
 {
     auto renderDevice = m_pDeviceBridge->GetDevice();
+    if (!renderDevice)
+        LSTG_THROW(ImGuiRendererInitializeFailedException, "Native render device not available");
 
     // 检查是否支持 Base Vertex Offset
     // https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_draw_elements_base_vertex.txt
@@ -187,7 +187,16 @@ DebugGUISystem::DebugGUISystem(SubsystemContainer& container)
     io.IniFilename = nullptr;  // 关闭存储
 
     // 构造渲染器
-    m_pRenderer = make_shared<lstg::Subsystem::DebugGUI::detail::ImGuiRenderer>(m_pRenderSystem->GetRenderDevice(), io);
+    // 渲染器直接使用 DiligentEngine 绘制，不持有原生对象的设备上无法创建，此时仍需构建字体图集以满足 ImGui 的要求
+    try
+    {
+        m_pRenderer = make_shared<lstg::Subsystem::DebugGUI::detail::ImGuiRenderer>(m_pRenderSystem->GetRenderDevice(), io);
+    }
+    catch (const lstg::Subsystem::DebugGUI::detail::ImGuiRendererInitializeFailedException& ex)
+    {
+        LSTG_LOG_WARN_CAT(DebugGUISystem, "Debug GUI will not be rendered: {}", ex.what());
+        io.Fonts->Build();
+    }
 
     // 注册剪贴板方法
     io.ClipboardUserData = this;
@@ -344,7 +353,8 @@ void DebugGUISystem::OnAfterRender(double elapsedTime) noexcept
         w.second->Render();
 
     ImGui::Render();
-    m_pRenderer->RenderDrawData(ImGui::GetDrawData());
+    if (m_pRenderer)
+        m_pRenderer->RenderDrawData(ImGui::GetDrawData());
 }
 
 void DebugGUISystem::OnEvent(SubsystemEvent& event) noexcept
@@ -7,8 +7,6 @@
 #include <lstg/Core/Subsystem/Render/ConstantBuffer.hpp>
 
 #include <Buffer.h>
-#include <RenderDevice.h>
-#include <DeviceContext.h>
 
 using namespace std;
 using namespace lstg;
@@ -42,9 +40,7 @@ ConstantBuffer::ConstantBuffer(RenderDevice& device, GraphDef::ImmutableConstant
     desc.Usage = (m_iUsage == Usage::Default ? Diligent::USAGE_DEFAULT : Diligent::USAGE_DYNAMIC);
     desc.BindFlags = Diligent::BIND_UNIFORM_BUFFER;
     desc.CPUAccessFlags = (m_iUsage == Usage::Default ? Diligent::CPU_ACCESS_NONE : Diligent::CPU_ACCESS_WRITE);
-    device.GetDevice()->CreateBuffer(desc, nullptr, &m_pNativeHandler);
-    if (!m_pNativeHandler)
-        throw system_error(make_error_code(errc::not_enough_memory));
+    device.CreateBuffer(desc, nullptr, &m_pNativeHandler).ThrowIfError();
 }
 
 ConstantBuffer::~ConstantBuffer()
@@ -63,7 +59,7 @@ const GraphDef::ImmutableConstantBufferDefinitionPtr& ConstantBuffer::GetDefinit
 
 size_t ConstantBuffer::GetSize() const noexcept
 {
-    assert(m_pDefinition->GetSize() <= m_pNativeHandler->GetDesc().Size);  // 实际申请 GPU 侧的 Buffer 由于不同的对齐，可能大于我们需要的
+    assert(!m_pNativeHandler || m_pDefinition->GetSize() <= m_pNativeHandler->GetDesc().Size);  // 实际申请 GPU 侧的 Buffer 由于不同的对齐，可能大于我们需要的
     assert(m_pDefinition->GetSize() == m_stBuffer.size());
     return m_pDefinition->GetSize();
 }
@@ -99,15 +95,14 @@ void ConstantBuffer::CopyFrom(void* src, size_t size, size_t offset) noexcept
 
 Result<void> ConstantBuffer::Commit() noexcept
 {
-    auto context = m_stDevice.GetImmediateContext();
     if (m_iUsage == Usage::Default)
     {
         if (m_stDirtyState.Region.Size == 0)
             return {};
 
         assert(m_stDirtyState.Region.Start + m_stDirtyState.Region.Size <= m_stBuffer.size());
-        context->UpdateBuffer(m_pNativeHandler, m_stDirtyState.Region.Start, m_stDirtyState.Region.Size,
-            m_stBuffer.data() + m_stDirtyState.Region.Start, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_stDevice.UpdateBuffer(m_pNativeHandler, m_stDirtyState.Region.Start,
+            { m_stBuffer.data() + m_stDirtyState.Region.Start, m_stDirtyState.Region.Size });
 
         m_stDirtyState.Region.Start = m_stDirtyState.Region.Size = 0;
     }
@@ -119,12 +114,9 @@ Result<void> ConstantBuffer::Commit() noexcept
         if (!m_stDirtyState.Flag.CommitRequired && m_stDirtyState.Flag.LastCommitFrameId == frame)
             return {};
 
-        void* data = nullptr;
-        context->MapBuffer(m_pNativeHandler, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD, data);
-        if (!data)
-            return make_error_code(errc::io_error);
-        ::memcpy(data, m_stBuffer.data(), m_stBuffer.size());
-        context->UnmapBuffer(m_pNativeHandler, Diligent::MAP_WRITE);
+        auto ret = m_stDevice.WriteBuffer(m_pNativeHandler, { m_stBuffer.data(), m_stBuffer.size() }, false);
+        if (!ret)
+            return ret.GetError();
 
         m_stDirtyState.Flag.CommitRequired = false;
         m_stDirtyState.Flag.LastCommitFrameId = frame;
@@ -6,8 +6,11 @@
  */
 #include <lstg/Core/Subsystem/Render/Drawing2D/CommandBuffer.hpp>
 
+#include <cmath>
+#include <algorithm>
 #include <glm/ext.hpp>
 #include <lstg/Core/Logging.hpp>
+#include <lstg/Core/Subsystem/Render/Drawing2D/SpriteTransform.hpp>
 
 using namespace std;
 using namespace lstg;
@@ -15,6 +18,16 @@ using namespace lstg::Subsystem::Render::Drawing2D;
 
 // LSTG_DEF_LOG_CATEGORY(CommandBuffer);
 
+namespace
+{
+    bool IsSameDrawState(const CommandBuffer::DrawCommand& lhs, const CommandBuffer::DrawCommand& rhs) noexcept
+    {
+        return lhs.Type == rhs.Type && lhs.ColorBlend == rhs.ColorBlend && lhs.NoDepth == rhs.NoDepth && lhs.FogType == rhs.FogType &&
+            lhs.FogArg1 == rhs.FogArg1 && lhs.FogArg2 == rhs.FogArg2 && lhs.FogColor == rhs.FogColor &&
+            lhs.TextureId == rhs.TextureId && lhs.MaterialId == rhs.MaterialId && lhs.BaseVertexIndex == rhs.BaseVertexIndex;
+    }
+}
+
 CommandBuffer::CommandBuffer()
     : m_stCurrentView(glm::identity<glm::mat4x4>()), m_stCurrentProjection(glm::identity<glm::mat4x4>())
 {
@@ -29,9 +42,9 @@ void CommandBuffer::Begin() noexcept
     m_stTextureMapping.clear();
     m_stMaterialReferences.clear();
     m_stMaterialMapping.clear();
-    m_uCurrentBaseVertexIndex = 0;
     m_stVertices.clear();
     m_stIndexes.clear();
+    m_stInstances.clear();
     m_stCommandGroups.clear();
     m_stCurrentGroup = {};
     m_stCurrentQueue = {};
@@ -45,16 +58,172 @@ CommandBuffer::DrawData CommandBuffer::End() noexcept
     m_stCurrentQueue = {};
     m_stCurrentDrawCommand = {};
 
+    // 重排命令
+    m_uLastCommandCountBeforeReorder = 0;
+    m_uLastCommandCountAfterReorder = 0;
+    for (auto& group : m_stCommandGroups)
+    {
+        for (auto& queue : group->Queue)
+        {
+            m_uLastCommandCountBeforeReorder += queue->Commands.size();
+            if (m_bReorderEnabled && queue->Commands.size() > 1)
+            {
+                try
+                {
+                    ReorderQueue(*queue.get());
+                }
+                catch (...)  // bad_alloc
+                {
+                    // 重排只在最后修改队列，失败时保持原有顺序即可
+                }
+            }
+            m_uLastCommandCountAfterReorder += queue->Commands.size();
+        }
+    }
+
     return {
         m_stCommandGroups,
         m_stVertices,
         m_stIndexes,
+        m_stInstances,
         m_stCameraReferences,
         m_stTextureReferences,
         m_stMaterialReferences,
     };
 }
 
+void CommandBuffer::ReorderQueue(CommandQueue& queue)
+{
+    static const size_t kNoCommand = static_cast<size_t>(-1);
+    static const float kInfinity = std::numeric_limits<float>::infinity();
+
+    auto& commands = queue.Commands;
+    assert(!commands.empty());
+    assert(queue.CameraId < m_stCameraReferences.size());
+    const auto& projectView = (*m_stCameraReferences[queue.CameraId].get())->GetProjectViewMatrix();
+
+    // 队列中的命令总是占据索引缓冲区中连续的一段
+    const auto indexStart = commands.front().IndexStart;
+    size_t indexCount = 0;
+
+    m_stReorderBatches.clear();
+    m_stReorderNextCommand.assign(commands.size(), kNoCommand);
+    for (size_t i = 0; i < commands.size(); ++i)
+    {
+        const auto& cmd = commands[i];
+        assert(cmd.IndexStart == indexStart + indexCount);
+        indexCount += cmd.IndexCount;
+
+        // 实例命令不参与合并，并视作与所有命令相交
+        if (cmd.Type != DrawCommandTypes::Quad)
+        {
+            assert(cmd.IndexCount == 0);
+            ReorderBatch current;
+            current.FirstCommand = current.LastCommand = i;
+            current.MinX = current.MinY = -kInfinity;
+            current.MaxX = current.MaxY = kInfinity;
+            m_stReorderBatches.push_back(current);
+            continue;
+        }
+        if (cmd.IndexCount == 0)
+            continue;
+
+        // 每个四边形独占 4 个连续的顶点，因此命令引用的顶点也是连续的
+        assert(cmd.IndexStart + cmd.IndexCount <= m_stIndexes.size());
+        auto minIndex = std::numeric_limits<uint32_t>::max();
+        auto maxIndex = std::numeric_limits<uint32_t>::min();
+        for (size_t j = cmd.IndexStart; j < cmd.IndexStart + cmd.IndexCount; ++j)
+        {
+            minIndex = std::min(minIndex, m_stIndexes[j]);
+            maxIndex = std::max(maxIndex, m_stIndexes[j]);
+        }
+
+        // 计算 NDC 下的包围盒，无法投影的顶点视作与所有命令相交
+        ReorderBatch current;
+        current.FirstCommand = current.LastCommand = i;
+        current.IndexCount = cmd.IndexCount;
+        current.MinX = current.MinY = kInfinity;
+        current.MaxX = current.MaxY = -kInfinity;
+        assert(cmd.BaseVertexIndex + maxIndex < m_stVertices.size());
+        for (size_t j = cmd.BaseVertexIndex + minIndex; j <= cmd.BaseVertexIndex + maxIndex; ++j)
+        {
+            auto clip = projectView * glm::vec4(m_stVertices[j].Position, 1.f);
+            auto x = clip.x / clip.w;
+            auto y = clip.y / clip.w;
+            if (!(clip.w > 0.f) || !std::isfinite(x) || !std::isfinite(y))
+            {
+                current.MinX = current.MinY = -kInfinity;
+                current.MaxX = current.MaxY = kInfinity;
+                break;
+            }
+            current.MinX = std::min(current.MinX, x);
+            current.MinY = std::min(current.MinY, y);
+            current.MaxX = std::max(current.MaxX, x);
+            current.MaxY = std::max(current.MaxY, y);
+        }
+
+        // 向前寻找状态相同的批次
+        // 合并后当前命令会在被越过的批次之前绘制，因此要求与它们都不相交
+        auto target = kNoCommand;
+        auto searchEnd = m_stReorderBatches.size() > kReorderSearchWindow ? m_stReorderBatches.size() - kReorderSearchWindow : 0;
+        for (size_t j = m_stReorderBatches.size(); j-- > searchEnd; )
+        {
+            const auto& batch = m_stReorderBatches[j];
+            if (IsSameDrawState(commands[batch.FirstCommand], cmd))
+            {
+                target = j;
+                break;
+            }
+            if (!(current.MaxX < batch.MinX || batch.MaxX < current.MinX || current.MaxY < batch.MinY || batch.MaxY < current.MinY))
+                break;
+        }
+
+        if (target == kNoCommand)
+        {
+            m_stReorderBatches.push_back(current);
+        }
+        else
+        {
+            auto& batch = m_stReorderBatches[target];
+            m_stReorderNextCommand[batch.LastCommand] = i;
+            batch.LastCommand = i;
+            batch.IndexCount += cmd.IndexCount;
+            batch.MinX = std::min(batch.MinX, current.MinX);
+            batch.MinY = std::min(batch.MinY, current.MinY);
+            batch.MaxX = std::max(batch.MaxX, current.MaxX);
+            batch.MaxY = std::max(batch.MaxY, current.MaxY);
+        }
+    }
+
+    // 没有发生合并时保持原样
+    if (m_stReorderBatches.size() == commands.size())
+        return;
+
+    // 按批次重新生成索引和命令
+    m_stReorderIndexes.clear();
+    m_stReorderIndexes.reserve(indexCount);
+    m_stReorderCommands.clear();
+    m_stReorderCommands.reserve(m_stReorderBatches.size());
+    for (const auto& batch : m_stReorderBatches)
+    {
+        auto merged = commands[batch.FirstCommand];
+        merged.IndexStart = indexStart + m_stReorderIndexes.size();
+        merged.IndexCount = batch.IndexCount;
+        for (auto i = batch.FirstCommand; i != kNoCommand; i = m_stReorderNextCommand[i])
+        {
+            const auto& cmd = commands[i];
+            m_stReorderIndexes.insert(m_stReorderIndexes.end(), m_stIndexes.begin() + cmd.IndexStart,
+                m_stIndexes.begin() + cmd.IndexStart + cmd.IndexCount);
+        }
+        m_stReorderCommands.push_back(merged);
+    }
+    assert(m_stReorderIndexes.size() == indexCount);
+
+    // 写回，此后不会再失败
+    std::copy(m_stReorderIndexes.begin(), m_stReorderIndexes.end(), m_stIndexes.begin() + indexStart);
+    commands.swap(m_stReorderCommands);
+}
+
 Subsystem::Render::TexturePtr CommandBuffer::FindTextureById(size_t id) const noexcept
 {
     if (id >= m_stTextureReferences.size())
@@ -160,6 +329,13 @@ Result<void> CommandBuffer::DrawQuad(TexturePtr tex2d, const Vertex (&arr)[4]) n
 
 Result<Span<Vertex>> CommandBuffer::DrawQuadInPlace(TexturePtr tex2d) noexcept
 {
+    return DrawQuadsInPlace(std::move(tex2d), 1);
+}
+
+Result<Span<Vertex>> CommandBuffer::DrawQuadsInPlace(TexturePtr tex2d, size_t count) noexcept
+{
+    assert(count > 0);
+
     // 创建纹理
     auto texId = AllocTexture(std::move(tex2d));
     if (!texId)
@@ -171,39 +347,18 @@ Result<Span<Vertex>> CommandBuffer::DrawQuadInPlace(TexturePtr tex2d) noexcept
         return matId.GetError();
 
     // 创建命令（若没有）
-    auto ret = InstantialCommand();
+    auto ret = InstantialCommand(DrawCommandTypes::Quad, *texId, *matId);
     if (!ret)
         return ret.GetError();
 
-    if ((*m_stCurrentDrawCommand)->TextureId == static_cast<size_t>(-1))
-    {
-        // 此时是新创建的命令，直接设置 TextureId 和 MatId
-        assert((*m_stCurrentDrawCommand)->MaterialId == static_cast<size_t>(-1));
-        assert((*m_stCurrentDrawCommand)->IndexCount == 0);
-        (*m_stCurrentDrawCommand)->TextureId = *texId;
-        (*m_stCurrentDrawCommand)->MaterialId = *matId;
-    }
-    else if ((*m_stCurrentDrawCommand)->TextureId != *texId || (*m_stCurrentDrawCommand)->MaterialId != *matId)
-    {
-        // 此时需要创建新的 Command
-        PrepareNewCommand();
-        ret = InstantialCommand();
-        if (!ret)
-            return ret.GetError();
-        assert((*m_stCurrentDrawCommand)->TextureId == static_cast<size_t>(-1));
-        assert((*m_stCurrentDrawCommand)->MaterialId == static_cast<size_t>(-1));
-        (*m_stCurrentDrawCommand)->TextureId = *texId;
-        (*m_stCurrentDrawCommand)->MaterialId = *matId;
-    }
-
     // 防止索引越界
-    assert(m_stVertices.size() + 4 - m_uCurrentBaseVertexIndex <= std::numeric_limits<uint16_t>::max());
+    assert(m_stVertices.size() + 4 * count <= std::numeric_limits<uint32_t>::max());
 
     // 分配内存
     try
     {
-        m_stVertices.resize(m_stVertices.size() + 4);
-        m_stIndexes.resize(m_stIndexes.size() + 6);
+        m_stVertices.resize(m_stVertices.size() + 4 * count);
+        m_stIndexes.resize(m_stIndexes.size() + 6 * count);
     }
     catch (...)  // bad_alloc
     {
@@ -211,29 +366,82 @@ Result<Span<Vertex>> CommandBuffer::DrawQuadInPlace(TexturePtr tex2d) noexcept
     }
 
     // 分配顶点
-    auto vertexStartIndex = m_stVertices.size() - 4;
+    auto vertexStartIndex = m_stVertices.size() - 4 * count;
     auto vertexStart = m_stVertices.data() + vertexStartIndex;
-    vertexStartIndex -= m_uCurrentBaseVertexIndex;  // 基于 BaseVertexIndex 的偏移
-//    vertexStart[0] = arr[0];
-//    vertexStart[1] = arr[1];
-//    vertexStart[2] = arr[2];
-//    vertexStart[3] = arr[3];
 
     // 生成索引
     // 0 -- 1
     // | \  |
     // |  \ |
     // 3 -- 2
-    auto indexStart = m_stIndexes.data() + m_stIndexes.size() - 6;
-    indexStart[0] = vertexStartIndex + 0;
-    indexStart[1] = vertexStartIndex + 1;
-    indexStart[2] = vertexStartIndex + 2;
-    indexStart[3] = vertexStartIndex + 0;
-    indexStart[4] = vertexStartIndex + 2;
-    indexStart[5] = vertexStartIndex + 3;
+    auto indexStart = m_stIndexes.data() + m_stIndexes.size() - 6 * count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto base = static_cast<uint32_t>(vertexStartIndex + i * 4);
+        indexStart[0] = base + 0;
+        indexStart[1] = base + 1;
+        indexStart[2] = base + 2;
+        indexStart[3] = base + 0;
+        indexStart[4] = base + 2;
+        indexStart[5] = base + 3;
+        indexStart += 6;
+    }
+
+    (*m_stCurrentDrawCommand)->IndexCount += 6 * count;
+    return Span<Vertex> { vertexStart, 4 * count };
+}
+
+Result<void> CommandBuffer::DrawSpriteInstance(TexturePtr tex2d, const SpriteInstance& instance) noexcept
+{
+    return DrawSpriteInstances(std::move(tex2d), { &instance, 1 });
+}
+
+Result<void> CommandBuffer::DrawSpriteInstances(TexturePtr tex2d, Span<const SpriteInstance> instances) noexcept
+{
+    static_assert(is_trivially_copyable_v<SpriteInstance>);
+
+    if (instances.IsEmpty())
+        return {};
+
+    // 在 CPU 上展开
+    if (!m_bInstancingEnabled || m_pCurrentMaterial)
+    {
+        auto ret = DrawQuadsInPlace(std::move(tex2d), instances.GetSize());
+        if (!ret)
+            return ret.GetError();
+        TransformSpriteInstances(*ret, instances);
+        return {};
+    }
+
+    // 创建纹理
+    auto texId = AllocTexture(std::move(tex2d));
+    if (!texId)
+        return texId.GetError();
+
+    // 创建材质
+    auto matId = AllocMaterial(m_pCurrentMaterial);
+    if (!matId)
+        return matId.GetError();
+
+    // 创建命令（若没有）
+    auto ret = InstantialCommand(DrawCommandTypes::SpriteInstance, *texId, *matId);
+    if (!ret)
+        return ret.GetError();
 
-    (*m_stCurrentDrawCommand)->IndexCount += 6;
-    return Span<Vertex> { vertexStart, 4 };
+    // 分配实例
+    try
+    {
+        m_stInstances.insert(m_stInstances.end(), instances.GetData(), instances.GetData() + instances.GetSize());
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+
+    assert((*m_stCurrentDrawCommand)->InstanceStart + (*m_stCurrentDrawCommand)->InstanceCount + instances.GetSize() ==
+        m_stInstances.size());
+    (*m_stCurrentDrawCommand)->InstanceCount += instances.GetSize();
+    return {};
 }
 
 Result<void> CommandBuffer::Clear(ColorRGBA32 color) noexcept
@@ -400,6 +608,7 @@ Result<void> CommandBuffer::InstantialCommand() noexcept
         try
         {
             auto command = DrawCommand {
+                DrawCommandTypes::Quad,
                 m_iCurrentColorBlendMode,
                 m_bNoDepth,
                 m_iCurrentFogType,
@@ -410,7 +619,9 @@ Result<void> CommandBuffer::InstantialCommand() noexcept
                 static_cast<size_t>(-1),
                 m_stIndexes.size(),
                 0,
-                m_uCurrentBaseVertexIndex,
+                0,
+                m_stInstances.size(),
+                0,
             };
             (*m_stCurrentQueue)->get()->Commands.emplace_back(command);
             m_stCurrentDrawCommand = (*m_stCurrentQueue)->get()->Commands.end() - 1;
@@ -420,13 +631,37 @@ Result<void> CommandBuffer::InstantialCommand() noexcept
             return make_error_code(errc::not_enough_memory);
         }
     }
+    return {};
+}
 
-    // 如果当前 DrawCommand 无法容纳足够数量的顶点，则创建新的 DrawCommand 并刷新 BaseVertexIndex
-    if (m_stVertices.size() + 4 - m_uCurrentBaseVertexIndex > std::numeric_limits<uint16_t>::max())
+Result<void> CommandBuffer::InstantialCommand(DrawCommandTypes type, size_t textureId, size_t materialId) noexcept
+{
+    auto ret = InstantialCommand();
+    if (!ret)
+        return ret.GetError();
+
+    if ((*m_stCurrentDrawCommand)->TextureId == static_cast<size_t>(-1))
     {
-        m_uCurrentBaseVertexIndex = m_stVertices.size();
+        // 此时是新创建的命令，直接设置类型、TextureId 和 MatId
+        assert((*m_stCurrentDrawCommand)->MaterialId == static_cast<size_t>(-1));
+        assert((*m_stCurrentDrawCommand)->IndexCount == 0 && (*m_stCurrentDrawCommand)->InstanceCount == 0);
+        (*m_stCurrentDrawCommand)->Type = type;
+        (*m_stCurrentDrawCommand)->TextureId = textureId;
+        (*m_stCurrentDrawCommand)->MaterialId = materialId;
+    }
+    else if ((*m_stCurrentDrawCommand)->Type != type || (*m_stCurrentDrawCommand)->TextureId != textureId ||
+        (*m_stCurrentDrawCommand)->MaterialId != materialId)
+    {
+        // 此时需要创建新的 Command
         PrepareNewCommand();
-        return InstantialCommand();
+        ret = InstantialCommand();
+        if (!ret)
+            return ret.GetError();
+        assert((*m_stCurrentDrawCommand)->TextureId == static_cast<size_t>(-1));
+        assert((*m_stCurrentDrawCommand)->MaterialId == static_cast<size_t>(-1));
+        (*m_stCurrentDrawCommand)->Type = type;
+        (*m_stCurrentDrawCommand)->TextureId = textureId;
+        (*m_stCurrentDrawCommand)->MaterialId = materialId;
     }
     return {};
 }
@@ -14,7 +14,7 @@ using namespace lstg;
 using namespace lstg::Subsystem::Render::Drawing2D;
 
 static const char* kDefault2DEffect = R"EFFECT(
-local vs, ps
+local vs, vsInstanced, ps
 do
     -- External CBuffer
     local cbCameraState = importConstantBuffer "_CameraState"
@@ -35,6 +35,17 @@ do
         :slot(3, SemanticNames.COLOR, 1, true)  -- uint8_t[4] -> vec4
         :build()
 
+    -- Vertex Layout (Sprite Instance)
+    local vl2dInstanced = vertexLayout()
+        :slot(0, SemanticNames.POSITION, 0)  -- vec2，四边形角点
+        :slot(1, SemanticNames.POSITION, 1)  -- vec3 + float，平移与旋转
+        :slot(2, SemanticNames.TEXCOORD, 1)  -- vec4，形状
+        :slot(3, SemanticNames.TEXCOORD, 2)  -- vec2，缩放
+        :slot(4, SemanticNames.TEXCOORD, 0)  -- vec4，纹理范围
+        :slot(5, SemanticNames.COLOR, 0, true)  -- uint8_t[4] -> vec4
+        :slot(6, SemanticNames.COLOR, 1, true)  -- uint8_t[4] -> vec4
+        :build()
+
     -- Texture
     local texMainTexture = texture2d "MainTexture"
         :build()
@@ -74,6 +85,52 @@ do
         :vertexLayout(vl2d)
         :build()
 
+    -- Vertex Shader (Sprite Instance)
+    vsInstanced = vertexShader [=[
+        struct VSInput
+        {
+            float2 Corner: ATTRIB0;  // POSITION0
+            float4 PositionRotation: ATTRIB1;  // POSITION1
+            float4 Shape: ATTRIB2;  // TEXCOORD1
+            float2 Scale: ATTRIB3;  // TEXCOORD2
+            float4 TexRect: ATTRIB4;  // TEXCOORD0
+            float4 AdditiveColor: ATTRIB5;  // COLOR0
+            float4 MultiplierColor: ATTRIB6;  // COLOR1
+        };
+
+        struct VSOutput
+        {
+            float4 Position: SV_POSITION;
+            float2 UV: TEXCOORD0;
+            float FogDepth: FOGDISTANCE;
+            float4 AdditiveColor: COLOR0;
+            float4 MultiplierColor: COLOR1;
+        };
+
+        void main(in VSInput inVert, out VSOutput outVert)
+        {
+            // 与 SpriteDrawing 一致，先按锚点生成形状，再依次缩放、旋转、平移
+            float2 local = float2(inVert.Corner.x * inVert.Shape.x - inVert.Shape.z, inVert.Shape.w - inVert.Corner.y * inVert.Shape.y);
+            local *= inVert.Scale;
+            float sinR = sin(inVert.PositionRotation.w);
+            float cosR = cos(inVert.PositionRotation.w);
+            float3 position = float3(local.x * cosR - local.y * sinR, local.x * sinR + local.y * cosR, 0.0) +
+                inVert.PositionRotation.xyz;
+
+            float4 cameraViewPos = mul(_CameraViewMatrix, float4(position, 1.0));
+            outVert.Position = mul(_CameraProjectViewMatrix, float4(position, 1.0));
+            outVert.UV = inVert.TexRect.xy + inVert.Corner * inVert.TexRect.zw;
+            outVert.FogDepth = cameraViewPos.z;
+            outVert.AdditiveColor = inVert.AdditiveColor;
+            outVert.MultiplierColor = inVert.MultiplierColor;
+        }
+    ]=]
+        :name("Default 2D Instanced Vertex Shader")
+        :entry("main")
+        :use(cbCameraState)
+        :vertexLayout(vl2dInstanced)
+        :build()
+
     -- Pixel Shader
     ps = pixelShader [=[
         #define FOG_DISABLED 0x00000000u
@@ -223,7 +280,7 @@ do
         :pixelShader(ps)
         :build()
     passGroupRevertSubtractBlend = passGroup "RevertSubtractBlend"
-        :tag("Blend", "RevertSubtract")
+        :tag("Blend", "ReverseSubtract")
         :pass(pass0)
         :build()
 end
@@ -314,14 +371,57 @@ do
         :pixelShader(ps)
         :build()
     passGroupRevertSubtractBlendNoDepth = passGroup "RevertSubtractBlendNoDepth"
-        :tag("Blend", "RevertSubtract")
+        :tag("Blend", "ReverseSubtract")
         :tag("DepthDisabled", "1")
         :pass(pass0)
         :build()
 end
 
+-- PassGroup: Sprite Instance
+-- 混合与深度状态和上面的组一一对应，仅顶点着色器不同
+local instancedPassGroups = {}
+do
+    local blendModes = {
+        { "Alpha", BlendFactors.INVERT_SOURCE_ALPHA, BlendOperations.ADD },
+        { "Add", BlendFactors.ONE, BlendOperations.ADD },
+        { "Subtract", BlendFactors.ONE, BlendOperations.SUBTRACT },
+        { "ReverseSubtract", BlendFactors.ONE, BlendOperations.REVERT_SUBTRACT },
+    }
+    for _, depthDisabled in ipairs({ false, true }) do
+        for _, mode in ipairs(blendModes) do
+            local pass0 = pass "pass0"
+                :blendState(BlendStates.ENABLE, 1)
+                :blendState(BlendStates.SOURCE_BLEND, BlendFactors.SOURCE_ALPHA)
+                :blendState(BlendStates.DEST_BLEND, mode[2])
+                :blendState(BlendStates.BLEND_OPERATION, mode[3])
+                :blendState(BlendStates.SOURCE_ALPHA_BLEND, BlendFactors.SOURCE_ALPHA)
+                :blendState(BlendStates.DEST_ALPHA_BLEND, BlendFactors.INVERT_SOURCE_ALPHA)
+                :blendState(BlendStates.ALPHA_BLEND_OPERATION, BlendOperations.ADD)
+                :rasterizerState(RasterizerStates.CULL_MODE, CullModes.NONE)
+                :vertexShader(vsInstanced)
+                :pixelShader(ps)
+            if depthDisabled then
+                pass0:depthStencilState(DepthStencilStates.DEPTH_ENABLE, 0)
+            else
+                pass0:depthStencilState(DepthStencilStates.DEPTH_ENABLE, 1)
+                    :depthStencilState(DepthStencilStates.DEPTH_WRITE_ENABLE, 1)
+                    :depthStencilState(DepthStencilStates.DEPTH_FUNCTION, ComparisionFunctions.LESS_EQUAL)
+            end
+
+            local group = passGroup(mode[1] .. "BlendInstanced" .. (depthDisabled and "NoDepth" or ""))
+                :tag("Blend", mode[1])
+                :tag("Instanced", "1")
+                :pass(pass0:build())
+            if depthDisabled then
+                group:tag("DepthDisabled", "1")
+            end
+            instancedPassGroups[#instancedPassGroups + 1] = group:build()
+        end
+    end
+end
+
 -- Effect
-return effect()
+local builder = effect()
     :passGroup(passGroupAlphaBlend)
     :passGroup(passGroupAddBlend)
     :passGroup(passGroupSubtractBlend)
@@ -330,13 +430,56 @@ return effect()
     :passGroup(passGroupAddBlendNoDepth)
     :passGroup(passGroupSubtractBlendNoDepth)
     :passGroup(passGroupRevertSubtractBlendNoDepth)
-    :build()
+for _, group in ipairs(instancedPassGroups) do
+    builder:passGroup(group)
+end
+return builder:build()
 )EFFECT";
 
 LSTG_DEF_LOG_CATEGORY(CommandExecutor);
 
 static const char* kBlendTagName = "Blend";
 static const char* kDepthDisabledTagName = "DepthDisabled";
+static const char* kFogTagName = "Fog";
+static const char* kInstancedTagName = "Instanced";
+
+// 精灵实例的四边形角点，顺序与 CommandBuffer::DrawQuadInPlace 生成的顶点一致
+static const glm::vec2 kSpriteInstanceCorners[4] = {
+    { 0.f, 0.f },
+    { 1.f, 0.f },
+    { 1.f, 1.f },
+    { 0.f, 1.f },
+};
+static const uint32_t kSpriteInstanceIndexes[6] = { 0, 1, 2, 0, 2, 3 };
+
+namespace
+{
+    std::optional<ColorBlendMode> ParseBlendTag(std::string_view tag) noexcept
+    {
+        if (tag == "Alpha")
+            return ColorBlendMode::Alpha;
+        else if (tag == "Add")
+            return ColorBlendMode::Add;
+        else if (tag == "Subtract")
+            return ColorBlendMode::Subtract;
+        else if (tag == "ReverseSubtract")
+            return ColorBlendMode::ReverseSubtract;
+        return {};
+    }
+
+    std::optional<FogTypes> ParseFogTag(std::string_view tag) noexcept
+    {
+        if (tag == "Disabled")
+            return FogTypes::Disabled;
+        else if (tag == "Linear")
+            return FogTypes::Linear;
+        else if (tag == "Exp")
+            return FogTypes::Exp;
+        else if (tag == "Exp2")
+            return FogTypes::Exp2;
+        return {};
+    }
+}
 
 CommandExecutor::CommandExecutor(RenderSystem& renderSystem)
     : m_stRenderSystem(renderSystem), m_pDefaultTexture(renderSystem.GetDefaultTexture2D())
@@ -383,13 +526,66 @@ CommandExecutor::CommandExecutor(RenderSystem& renderSystem)
             {SemanticNames::Color, 1},
             offsetof(Vertex, Color1));
     }
-    auto mesh = renderSystem.CreateDynamicMesh(meshDefinition, false);
+    auto mesh = renderSystem.CreateDynamicMesh(meshDefinition, true);
     if (!mesh)
     {
         LSTG_LOG_ERROR_CAT(CommandExecutor, "Create dynamic mesh fail: {}", mesh.GetError());
         mesh.ThrowIfError();
     }
     m_pMesh = std::move(*mesh);
+
+    // 创建精灵实例 Mesh
+    Render::GraphDef::MeshDefinition instanceMeshDefinition;
+    {
+        using ScalarTypes = Render::GraphDef::MeshDefinition::VertexElementScalarTypes;
+        using Components = Render::GraphDef::MeshDefinition::VertexElementComponents;
+        using SemanticNames = Render::GraphDef::MeshDefinition::VertexElementSemanticNames;
+        static_assert(offsetof(SpriteInstance, Rotation) == offsetof(SpriteInstance, Position) + sizeof(glm::vec3));
+        instanceMeshDefinition.SetVertexStride(sizeof(glm::vec2));
+        instanceMeshDefinition.SetInstanceStride(sizeof(SpriteInstance));
+        instanceMeshDefinition.SetPrimitiveTopologyType(Render::GraphDef::MeshDefinition::PrimitiveTopologyTypes::TriangleList);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::Float, Components::Two},
+            {SemanticNames::Position, 0},
+            0);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::Float, Components::Four},
+            {SemanticNames::Position, 1},
+            offsetof(SpriteInstance, Position),
+            true);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::Float, Components::Four},
+            {SemanticNames::TextureCoord, 1},
+            offsetof(SpriteInstance, Shape),
+            true);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::Float, Components::Two},
+            {SemanticNames::TextureCoord, 2},
+            offsetof(SpriteInstance, Scale),
+            true);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::Float, Components::Four},
+            {SemanticNames::TextureCoord, 0},
+            offsetof(SpriteInstance, TexRect),
+            true);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::UInt8, Components::Four},
+            {SemanticNames::Color, 0},
+            offsetof(SpriteInstance, Color0),
+            true);
+        instanceMeshDefinition.AddVertexElement(
+            {ScalarTypes::UInt8, Components::Four},
+            {SemanticNames::Color, 1},
+            offsetof(SpriteInstance, Color1),
+            true);
+    }
+    mesh = renderSystem.CreateDynamicMesh(instanceMeshDefinition, true);
+    if (!mesh)
+    {
+        LSTG_LOG_ERROR_CAT(CommandExecutor, "Create instance mesh fail: {}", mesh.GetError());
+        mesh.ThrowIfError();
+    }
+    m_pInstanceMesh = std::move(*mesh);
 }
 
 Result<void> CommandExecutor::Execute(CommandBuffer::DrawData& drawData) noexcept
@@ -398,18 +594,17 @@ Result<void> CommandExecutor::Execute(CommandBuffer::DrawData& drawData) noexcep
     Render::CameraPtr oldCamera;
     Render::MaterialPtr oldMaterial;
     RenderSystem::EffectGroupSelectCallback oldSelector;
+    auto oldStateKey = m_stRenderSystem.GetRenderStateKey();
     try
     {
         oldCamera = m_stRenderSystem.GetCamera();
         oldMaterial = m_stRenderSystem.GetMaterial();
         oldSelector = m_stRenderSystem.GetEffectGroupSelectCallback();
-        m_stOldBlendTag = string{ m_stRenderSystem.GetRenderTag(kBlendTagName) };
-        m_stOldDepthDisabledTag = string{ m_stRenderSystem.GetRenderTag(kDepthDisabledTagName) };
 
         // 设置新的 Selector
-        m_stRenderSystem.SetEffectGroupSelectCallback([this](const GraphDef::EffectDefinition* effect,
-            const std::map<std::string, std::string, std::less<>>& tags) {
-            return OnSelectEffectGroup(effect, tags);
+        m_stRenderSystem.SetEffectGroupSelectCallback([this](const GraphDef::EffectDefinition* effect, uint32_t stateKey,
+            const RenderSystem::TagContainer&) {
+            return OnSelectEffectGroup(effect, stateKey);
         });
     }
     catch (...)
@@ -427,6 +622,20 @@ Result<void> CommandExecutor::Execute(CommandBuffer::DrawData& drawData) noexcep
         LSTG_LOG_ERROR_CAT(CommandExecutor, "Commit mesh data fail: {}", ret.GetError());
         return ret.GetError();
     }
+    if (!drawData.InstanceBuffer.empty())
+    {
+        ret = m_pInstanceMesh->Commit(
+            {reinterpret_cast<const uint8_t*>(kSpriteInstanceCorners), sizeof(kSpriteInstanceCorners)},
+            {reinterpret_cast<const uint8_t*>(kSpriteInstanceIndexes), sizeof(kSpriteInstanceIndexes)},
+            {reinterpret_cast<const uint8_t*>(drawData.InstanceBuffer.data()),
+                drawData.InstanceBuffer.size() * sizeof(drawData.InstanceBuffer[0])}
+        );
+        if (!ret)
+        {
+            LSTG_LOG_ERROR_CAT(CommandExecutor, "Commit instance data fail: {}", ret.GetError());
+            return ret.GetError();
+        }
+    }
 
     // 遍历命令
     m_uDrawCalls = 0;
@@ -437,14 +646,15 @@ Result<void> CommandExecutor::Execute(CommandBuffer::DrawData& drawData) noexcep
     m_stRenderSystem.SetCamera(oldCamera);
     m_stRenderSystem.SetMaterial(oldMaterial);
     m_stRenderSystem.SetEffectGroupSelectCallback(std::move(oldSelector));
-    m_stRenderSystem.SetRenderTag(kBlendTagName, std::move(m_stOldBlendTag));
-    m_stRenderSystem.SetRenderTag(kDepthDisabledTagName, std::move(m_stOldDepthDisabledTag));
+    m_stRenderSystem.SetRenderStateKey(oldStateKey);
     return {};
 }
 
 const Subsystem::Render::GraphDef::EffectPassGroupDefinition* CommandExecutor::OnSelectEffectGroup(const GraphDef::EffectDefinition* effect,
-    const std::map<std::string, std::string, std::less<>>& tags) noexcept
+    uint32_t stateKey) noexcept
 {
+    assert(stateKey < kRenderStateKeyCount);
+
     // 选择 Effect 组
     SelectableEffectPassGroups* passGroups = nullptr;
     if (m_stEffectGroupSelector.Contains(effect))
@@ -456,20 +666,35 @@ const Subsystem::Render::GraphDef::EffectPassGroupDefinition* CommandExecutor::O
     {
         assert(effect);
 
-        // 构造 Effect 组并缓存
+        // 按照 Tag 预先解析所有渲染状态对应的组并缓存
+        // 未设置 Fog 标签的组适用于所有雾类型，若存在指定了雾类型的组则优先使用
         SelectableEffectPassGroups cacheGroup;
+        bool fogSpecified[kRenderStateKeyCount] = {};
         for (const auto& group : effect->GetGroups())
         {
-            auto blendTag = group->GetTag(kBlendTagName);
-            auto depthDisabledTag = group->GetTag(kDepthDisabledTagName) == "1" ? 1 : 0;
-            if (blendTag == "Alpha")
-                cacheGroup.AlphaBlendGroup[depthDisabledTag] = group.get();
-            else if (blendTag == "Add")
-                cacheGroup.AddBlendGroup[depthDisabledTag] = group.get();
-            else if (blendTag == "Subtract")
-                cacheGroup.SubtractBlendGroup[depthDisabledTag] = group.get();
-            else if (blendTag == "ReverseSubtract")
-                cacheGroup.ReverseSubtractBlendGroup[depthDisabledTag] = group.get();
+            auto blend = ParseBlendTag(group->GetTag(kBlendTagName));
+            if (!blend)
+                continue;
+            auto depthDisabled = group->GetTag(kDepthDisabledTagName) == "1";
+            auto instanced = group->GetTag(kInstancedTagName) == "1";
+            auto fogTag = group->GetTag(kFogTagName);
+            auto fog = ParseFogTag(fogTag);
+            if (!fogTag.empty() && !fog)
+                continue;
+
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                auto fogType = static_cast<FogTypes>(i);
+                if (fog && *fog != fogType)
+                    continue;
+
+                auto key = MakeRenderStateKey(*blend, depthDisabled, fogType, instanced);
+                if (!cacheGroup.Groups[key] || (fog && !fogSpecified[key]))
+                {
+                    cacheGroup.Groups[key] = group.get();
+                    fogSpecified[key] = fog.has_value();
+                }
+            }
         }
 
         try
@@ -487,41 +712,59 @@ const Subsystem::Render::GraphDef::EffectPassGroupDefinition* CommandExecutor::O
         return nullptr;
     }
 
-    // 获取当前渲染标签
-    ColorBlendMode targetBlend = ColorBlendMode::Alpha;
-    int depthDisabled = 0;
-    {
-        auto it = tags.find(kBlendTagName);
-        if (it != tags.end())
-        {
-            if (it->second == "Alpha")
-                targetBlend = ColorBlendMode::Alpha;
-            else if (it->second == "Add")
-                targetBlend = ColorBlendMode::Add;
-            else if (it->second == "Subtract")
-                targetBlend = ColorBlendMode::Subtract;
-            else if (it->second == "ReverseSubtract")
-                targetBlend = ColorBlendMode::ReverseSubtract;
-        }
+    // 取缓存的组
+    return passGroups->Groups[stateKey];
+}
 
-        it = tags.find(kDepthDisabledTagName);
-        depthDisabled = (it != tags.end() && it->second == "1") ? 1 : 0;
-    }
+CommandExecutor::MaterialSlots* CommandExecutor::GetMaterialSlots(const Render::MaterialPtr& material) noexcept
+{
+    assert(material);
+    if (material.get() == m_pLastSlotsMaterial)
+        return m_pLastSlots;
 
-    // 取缓存的组
-    switch (targetBlend)
+    auto slots = m_stMaterialSlots.TryGet(material.get());
+    if (!slots)
     {
-        case ColorBlendMode::Alpha:
-            return passGroups->AlphaBlendGroup[depthDisabled];
-        case ColorBlendMode::Add:
-            return passGroups->AddBlendGroup[depthDisabled];
-        case ColorBlendMode::Subtract:
-            return passGroups->SubtractBlendGroup[depthDisabled];
-        case ColorBlendMode::ReverseSubtract:
-            return passGroups->ReverseSubtractBlendGroup[depthDisabled];
-        default:
+        // 解析材质上的槽位，材质不含有的符号保持为空
+        MaterialSlots cacheSlots;
+        cacheSlots.Owner = material;
+
+#define RESOLVE_UNIFORM_SLOT_WITH_LOG(NAME) \
+        do \
+        { \
+            auto slot = material->GetUniformSlot(#NAME); \
+            if (slot) \
+                cacheSlots.NAME = *slot; \
+            else if (slot.GetError() != make_error_code(GraphDef::DefinitionError::SymbolNotFound)) \
+                LSTG_LOG_ERROR_CAT(CommandExecutor, "Resolve uniform '" #NAME "' fail: {}", slot.GetError()); \
+        } while (false)
+
+        RESOLVE_UNIFORM_SLOT_WITH_LOG(FogType);
+        RESOLVE_UNIFORM_SLOT_WITH_LOG(FogColorRGBA32);
+        RESOLVE_UNIFORM_SLOT_WITH_LOG(FogArg1);
+        RESOLVE_UNIFORM_SLOT_WITH_LOG(FogArg2);
+
+#undef RESOLVE_UNIFORM_SLOT_WITH_LOG
+
+        auto textureSlot = material->GetTextureSlot("MainTexture");
+        if (textureSlot)
+            cacheSlots.MainTexture = *textureSlot;
+        else
+            LSTG_LOG_ERROR_CAT(CommandExecutor, "Resolve MainTexture fail: {}", textureSlot.GetError());
+
+        try
+        {
+            slots = m_stMaterialSlots.Emplace(material.get(), std::move(cacheSlots));
+        }
+        catch (...)  // bad_alloc
+        {
             return nullptr;
+        }
     }
+
+    m_pLastSlotsMaterial = material.get();
+    m_pLastSlots = slots;
+    return slots;
 }
 
 void CommandExecutor::OnDrawGroup(CommandBuffer::DrawData& drawData, CommandBuffer::CommandGroup& groupData) noexcept
@@ -563,43 +806,33 @@ void CommandExecutor::OnDrawQueue(CommandBuffer::DrawData& drawData, CommandBuff
         if (!mat) // 没有指定材质时，fallback 到默认材质
             mat = m_pDefaultMaterial;
 
-        // 设置混合状态
-        switch (cmd.ColorBlend)
-        {
-            case ColorBlendMode::Alpha:
-                m_stRenderSystem.SetRenderTag(kBlendTagName, "Alpha");
-                break;
-            case ColorBlendMode::Add:
-                m_stRenderSystem.SetRenderTag(kBlendTagName, "Add");
-                break;
-            case ColorBlendMode::Subtract:
-                m_stRenderSystem.SetRenderTag(kBlendTagName, "Subtract");
-                break;
-            case ColorBlendMode::ReverseSubtract:
-                m_stRenderSystem.SetRenderTag(kBlendTagName, "ReverseSubtract");
-                break;
-        }
-
-        // 设置深度状态
-        m_stRenderSystem.SetRenderTag(kDepthDisabledTagName, cmd.NoDepth ? "1" : "0");
+        // 设置混合、深度、雾状态
+        auto instanced = (cmd.Type == CommandBuffer::DrawCommandTypes::SpriteInstance);
+        m_stRenderSystem.SetRenderStateKey(MakeRenderStateKey(cmd.ColorBlend, cmd.NoDepth, cmd.FogType, instanced));
 
         // 设置材质
         assert(mat);
         m_stRenderSystem.SetMaterial(mat);
 
+        // 获取预先解析的槽位
+        auto slots = GetMaterialSlots(mat);
+        if (!slots)
+        {
+            LSTG_LOG_ERROR_CAT(CommandExecutor, "Resolve material slots fail, draw skipped");
+            continue;
+        }
+
 #define SET_UNIFORM_WITH_LOG(TYPE, NAME, VALUE) \
         do \
         { \
-            if (!(ret = mat->SetUniform<TYPE>(#NAME, VALUE))) \
-            { \
-                if (ret.GetError() != make_error_code(GraphDef::DefinitionError::SymbolNotFound)) \
-                    LSTG_LOG_ERROR_CAT(CommandExecutor, "Set uniform '" #NAME "' fail: {}", ret.GetError()); \
-            } \
+            if (slots->NAME && !(ret = mat->SetUniform<TYPE>(*slots->NAME, VALUE))) \
+                LSTG_LOG_ERROR_CAT(CommandExecutor, "Set uniform '" #NAME "' fail: {}", ret.GetError()); \
         } while (false)
 
         Result<void> ret;
 
         // 设置材质参数
+        // 值未变化时材质不会变脏，连续的同状态绘制不会产生额外的数据提交
         SET_UNIFORM_WITH_LOG(uint32_t, FogType, (static_cast<uint32_t>(cmd.FogType)));
         SET_UNIFORM_WITH_LOG(uint32_t, FogColorRGBA32, (cmd.FogColor.rgba32()));
         SET_UNIFORM_WITH_LOG(float, FogArg1, (cmd.FogArg1));
@@ -607,15 +840,28 @@ void CommandExecutor::OnDrawQueue(CommandBuffer::DrawData& drawData, CommandBuff
 
         // 设置主纹理
         assert(tex2d);
-        if (!(ret = mat->SetTexture("MainTexture", tex2d)))
+        if (slots->MainTexture && !(ret = mat->SetTexture(*slots->MainTexture, tex2d)))
             LSTG_LOG_ERROR_CAT(CommandExecutor, "Set MainTexture fail: {}", ret.GetError());
 
 #undef SET_UNIFORM_WITH_LOG
 
         // 绘制
-        ret = m_stRenderSystem.Draw(m_pMesh.get(), cmd.IndexCount, cmd.BaseVertexIndex, cmd.IndexStart);
-        if (!ret)
-            LSTG_LOG_ERROR_CAT(CommandExecutor, "Draw index={}, start={} fail: {}", cmd.IndexCount, cmd.IndexStart, ret.GetError());
+        if (instanced)
+        {
+            ret = m_stRenderSystem.DrawInstanced(m_pInstanceMesh.get(), std::extent_v<decltype(kSpriteInstanceIndexes)>, cmd.InstanceCount,
+                0, 0, cmd.InstanceStart);
+            if (!ret)
+            {
+                LSTG_LOG_ERROR_CAT(CommandExecutor, "Draw instance count={}, start={} fail: {}", cmd.InstanceCount, cmd.InstanceStart,
+                    ret.GetError());
+            }
+        }
+        else
+        {
+            ret = m_stRenderSystem.Draw(m_pMesh.get(), cmd.IndexCount, cmd.BaseVertexIndex, cmd.IndexStart);
+            if (!ret)
+                LSTG_LOG_ERROR_CAT(CommandExecutor, "Draw index={}, start={} fail: {}", cmd.IndexCount, cmd.IndexStart, ret.GetError());
+        }
         ++m_uDrawCalls;
     }
 }
@@ -6,6 +6,8 @@
  */
 #include <lstg/Core/Subsystem/Render/Drawing2D/Sprite.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::Render::Drawing2D;
@@ -102,6 +104,31 @@ Result<SpriteDrawing> Sprite::Draw(CommandBuffer& buffer, std::optional<ColorBle
     return SpriteDrawing::Draw(buffer, m_pTexture ? m_pTexture->GetUnderlayTexture() : nullptr, m_stPrecomputedVertex);
 }
 
+Result<void> Sprite::DrawInstance(CommandBuffer& buffer, glm::vec3 position, float rotation, glm::vec2 scale,
+    std::optional<ColorBlendMode> blendModeOverride) const noexcept
+{
+    if (!m_bUniformColor)
+    {
+        auto drawing = Draw(buffer, blendModeOverride);
+        if (!drawing)
+            return drawing.GetError();
+        drawing->Transform(rotation, scale.x, scale.y);
+        drawing->Translate(position.x, position.y, position.z);
+        return {};
+    }
+
+    auto instance = MakeInstance(position, rotation, scale);
+    return DrawInstances(buffer, { &instance, 1 }, blendModeOverride);
+}
+
+Result<void> Sprite::DrawInstances(CommandBuffer& buffer, Span<const SpriteInstance> instances,
+    std::optional<ColorBlendMode> blendModeOverride) const noexcept
+{
+    assert(m_bUniformColor);
+    buffer.SetColorBlendMode(blendModeOverride ? *blendModeOverride : m_iBlendMode);
+    return buffer.DrawSpriteInstances(m_pTexture ? m_pTexture->GetUnderlayTexture() : nullptr, instances);
+}
+
 void Sprite::PrecomputedVertex(int what) noexcept
 {
     if ((what & SHAPE_CHANGED) == SHAPE_CHANGED)
@@ -116,6 +143,7 @@ void Sprite::PrecomputedVertex(int what) noexcept
         m_stPrecomputedVertex[1].Position = { w - cx, cy, 0.f };
         m_stPrecomputedVertex[2].Position = { w - cx, cy - h, 0.f };
         m_stPrecomputedVertex[3].Position = { -cx, cy - h, 0.f };
+        m_stPrecomputedInstance.Shape = { w, h, cx, cy };
     }
 
     if (m_pTexture && (what & UV_CHANGED) == UV_CHANGED)
@@ -131,6 +159,7 @@ void Sprite::PrecomputedVertex(int what) noexcept
         m_stPrecomputedVertex[1].TexCoord = { u + uw, v };
         m_stPrecomputedVertex[2].TexCoord = { u + uw, v + vh };
         m_stPrecomputedVertex[3].TexCoord = { u, v + vh };
+        m_stPrecomputedInstance.TexRect = { u, v, uw, vh };
     }
 
     if ((what & ADDITIVE_COLOR_CHANGED) == ADDITIVE_COLOR_CHANGED)
@@ -147,4 +176,14 @@ void Sprite::PrecomputedVertex(int what) noexcept
         m_stPrecomputedVertex[2].Color1 = m_stMultiplyBlendColor[2];
         m_stPrecomputedVertex[3].Color1 = m_stMultiplyBlendColor[3];
     }
+    if ((what & (ADDITIVE_COLOR_CHANGED | MULTIPLY_COLOR_CHANGED)) != 0)
+    {
+        m_stPrecomputedInstance.Color0 = m_stAdditiveBlendColor[0];
+        m_stPrecomputedInstance.Color1 = m_stMultiplyBlendColor[0];
+        m_bUniformColor = std::all_of(m_stAdditiveBlendColor.begin() + 1, m_stAdditiveBlendColor.end(), [&](ColorRGBA32 c) {
+            return c == m_stAdditiveBlendColor[0];
+        }) && std::all_of(m_stMultiplyBlendColor.begin() + 1, m_stMultiplyBlendColor.end(), [&](ColorRGBA32 c) {
+            return c == m_stMultiplyBlendColor[0];
+        });
+    }
 }
@@ -0,0 +1,372 @@
+/**
+ * @file
+ * @date 2022/9/18
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include <lstg/Core/Subsystem/Render/Drawing2D/SpriteTransform.hpp>
+
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <SDL_cpuinfo.h>
+#include "detail/SpriteTransformKernels.hpp"
+
+#if defined(LSTG_SPRITE_TRANSFORM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::Render::Drawing2D;
+using namespace lstg::Subsystem::Render::Drawing2D::detail;
+
+namespace
+{
+    using TransformFunction = void(*)(Vertex* output, const SpriteInstance* instances, size_t count) noexcept;
+
+    /**
+     * 写出一个四边形
+     * 坐标已经按照角点顺序排布在 x、y 中，其余属性直接由实例得到。
+     */
+    inline void WriteQuad(Vertex* dest, const float (&x)[4], const float (&y)[4], const SpriteInstance& instance) noexcept
+    {
+        auto u = instance.TexRect.x;
+        auto v = instance.TexRect.y;
+        auto uw = instance.TexRect.z;
+        auto vh = instance.TexRect.w;
+        auto z = instance.Position.z;
+
+        dest[0] = { { x[0], y[0], z }, { u, v }, instance.Color0, instance.Color1 };
+        dest[1] = { { x[1], y[1], z }, { u + uw, v }, instance.Color0, instance.Color1 };
+        dest[2] = { { x[2], y[2], z }, { u + uw, v + vh }, instance.Color0, instance.Color1 };
+        dest[3] = { { x[3], y[3], z }, { u, v + vh }, instance.Color0, instance.Color1 };
+    }
+
+    void TransformSpriteInstancesScalar(Vertex* output, const SpriteInstance* instances, size_t count) noexcept
+    {
+        float x[4];
+        float y[4];
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto& instance = instances[i];
+            auto w = instance.Shape.x;
+            auto h = instance.Shape.y;
+            auto cx = instance.Shape.z;
+            auto cy = instance.Shape.w;
+
+            // Shape & Scale
+            x[0] = x[3] = -cx * instance.Scale.x;
+            x[1] = x[2] = (w - cx) * instance.Scale.x;
+            y[0] = y[1] = cy * instance.Scale.y;
+            y[2] = y[3] = (cy - h) * instance.Scale.y;
+
+            // Rotation
+            if (instance.Rotation != 0.f)
+            {
+                auto sinR = static_cast<float>(::sin(instance.Rotation));
+                auto cosR = static_cast<float>(::cos(instance.Rotation));
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    auto tx = x[j] * cosR - y[j] * sinR;
+                    auto ty = x[j] * sinR + y[j] * cosR;
+                    x[j] = tx;
+                    y[j] = ty;
+                }
+            }
+
+            // Translate
+            for (size_t j = 0; j < 4; ++j)
+            {
+                x[j] += instance.Position.x;
+                y[j] += instance.Position.y;
+            }
+            WriteQuad(output + i * 4, x, y, instance);
+        }
+    }
+
+    static_assert(sizeof(SpriteInstance) == sizeof(float) * kSpriteInstanceFloats);
+    static_assert(offsetof(SpriteInstance, Position) == 0 && offsetof(SpriteInstance, Rotation) == sizeof(float) * 3);
+    static_assert(offsetof(SpriteInstance, Shape) == sizeof(float) * 4 && offsetof(SpriteInstance, Scale) == sizeof(float) * 8);
+    static_assert(offsetof(SpriteInstance, TexRect) == sizeof(float) * 10 && offsetof(SpriteInstance, Color0) == sizeof(float) * 14);
+    static_assert(sizeof(Vertex) == sizeof(float) * kVertexFloats);
+    static_assert(offsetof(Vertex, TexCoord) == sizeof(float) * 3 && offsetof(Vertex, Color0) == sizeof(float) * 5);
+
+    /**
+     * 以 SoA 形式处理精灵
+     * 每 N 个精灵交由 SIMD 内核转置并计算，直接写出顶点。余下不足一组的精灵使用标量版本。
+     * @tparam N 每组精灵个数
+     * @tparam TransformGroup SIMD 内核
+     */
+    template <size_t N, void(*TransformGroup)(float*, const float*, const RotationLanes<N>*) noexcept>
+    void TransformSpriteInstancesSoA(Vertex* output, const SpriteInstance* instances, size_t count) noexcept
+    {
+        RotationLanes<N> rotation;
+        size_t i = 0;
+        for (; i + N <= count; i += N)
+        {
+            // 三角函数无法向量化，只在这组精灵中存在旋转时计算
+            bool rotated = false;
+            for (size_t k = 0; k < N; ++k)
+            {
+                auto r = instances[i + k].Rotation;
+                if (r != 0.f)
+                {
+                    rotation.Sin[k] = static_cast<float>(::sin(r));
+                    rotation.Cos[k] = static_cast<float>(::cos(r));
+                    rotated = true;
+                }
+                else
+                {
+                    rotation.Sin[k] = 0.f;
+                    rotation.Cos[k] = 1.f;
+                }
+            }
+
+            TransformGroup(reinterpret_cast<float*>(output + i * 4), reinterpret_cast<const float*>(instances + i),
+                rotated ? &rotation : nullptr);
+        }
+
+        TransformSpriteInstancesScalar(output + i * 4, instances + i, count - i);
+    }
+
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+    void TransformSpriteInstancesSSE2(float* output, const float* instances, const RotationLanes<4>* rotation) noexcept
+    {
+        const auto kStride = kSpriteInstanceFloats;
+
+        // 读取并转置为每个字段一个寄存器
+        auto tx = _mm_loadu_ps(instances);
+        auto ty = _mm_loadu_ps(instances + kStride);
+        auto tz = _mm_loadu_ps(instances + 2 * kStride);
+        auto rot = _mm_loadu_ps(instances + 3 * kStride);
+        _MM_TRANSPOSE4_PS(tx, ty, tz, rot);
+        auto w = _mm_loadu_ps(instances + 4);
+        auto h = _mm_loadu_ps(instances + 4 + kStride);
+        auto cx = _mm_loadu_ps(instances + 4 + 2 * kStride);
+        auto cy = _mm_loadu_ps(instances + 4 + 3 * kStride);
+        _MM_TRANSPOSE4_PS(w, h, cx, cy);
+        auto sx = _mm_loadu_ps(instances + 8);
+        auto sy = _mm_loadu_ps(instances + 8 + kStride);
+        auto u = _mm_loadu_ps(instances + 8 + 2 * kStride);
+        auto v = _mm_loadu_ps(instances + 8 + 3 * kStride);
+        _MM_TRANSPOSE4_PS(sx, sy, u, v);
+
+        // Shape & Scale
+        auto left = _mm_mul_ps(_mm_xor_ps(cx, _mm_set1_ps(-0.f)), sx);
+        auto right = _mm_mul_ps(_mm_sub_ps(w, cx), sx);
+        auto top = _mm_mul_ps(cy, sy);
+        auto bottom = _mm_mul_ps(_mm_sub_ps(cy, h), sy);
+        __m128 x[4] = { left, right, right, left };
+        __m128 y[4] = { top, top, bottom, bottom };
+
+        // Rotation
+        if (rotation)
+        {
+            auto sinR = _mm_load_ps(rotation->Sin);
+            auto cosR = _mm_load_ps(rotation->Cos);
+            for (size_t j = 0; j < 4; ++j)
+            {
+                auto rx = _mm_sub_ps(_mm_mul_ps(x[j], cosR), _mm_mul_ps(y[j], sinR));
+                auto ry = _mm_add_ps(_mm_mul_ps(x[j], sinR), _mm_mul_ps(y[j], cosR));
+                x[j] = rx;
+                y[j] = ry;
+            }
+        }
+
+        // Translate
+        for (size_t j = 0; j < 4; ++j)
+        {
+            x[j] = _mm_add_ps(x[j], tx);
+            y[j] = _mm_add_ps(y[j], ty);
+        }
+
+        // 转置为每个精灵的 4 个角点后写出
+        _MM_TRANSPOSE4_PS(x[0], x[1], x[2], x[3]);
+        _MM_TRANSPOSE4_PS(y[0], y[1], y[2], y[3]);
+        for (size_t k = 0; k < 4; ++k)
+            StoreQuadSSE(output + k * kVertexFloats * 4, x[k], y[k], instances + k * kStride);
+    }
+#endif
+
+#if defined(LSTG_SPRITE_TRANSFORM_NEON)
+    inline void Transpose4x4NEON(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3) noexcept
+    {
+        auto t01 = vtrnq_f32(r0, r1);
+        auto t23 = vtrnq_f32(r2, r3);
+        r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+    }
+
+    void TransformSpriteInstancesNEON(float* output, const float* instances, const RotationLanes<4>* rotation) noexcept
+    {
+        const auto kStride = kSpriteInstanceFloats;
+
+        // 读取并转置为每个字段一个寄存器
+        auto tx = vld1q_f32(instances);
+        auto ty = vld1q_f32(instances + kStride);
+        auto tz = vld1q_f32(instances + 2 * kStride);
+        auto rot = vld1q_f32(instances + 3 * kStride);
+        Transpose4x4NEON(tx, ty, tz, rot);
+        auto w = vld1q_f32(instances + 4);
+        auto h = vld1q_f32(instances + 4 + kStride);
+        auto cx = vld1q_f32(instances + 4 + 2 * kStride);
+        auto cy = vld1q_f32(instances + 4 + 3 * kStride);
+        Transpose4x4NEON(w, h, cx, cy);
+        auto sx = vld1q_f32(instances + 8);
+        auto sy = vld1q_f32(instances + 8 + kStride);
+        auto u = vld1q_f32(instances + 8 + 2 * kStride);
+        auto v = vld1q_f32(instances + 8 + 3 * kStride);
+        Transpose4x4NEON(sx, sy, u, v);
+
+        // Shape & Scale
+        auto left = vmulq_f32(vnegq_f32(cx), sx);
+        auto right = vmulq_f32(vsubq_f32(w, cx), sx);
+        auto top = vmulq_f32(cy, sy);
+        auto bottom = vmulq_f32(vsubq_f32(cy, h), sy);
+        float32x4_t x[4] = { left, right, right, left };
+        float32x4_t y[4] = { top, top, bottom, bottom };
+
+        // Rotation
+        if (rotation)
+        {
+            auto sinR = vld1q_f32(rotation->Sin);
+            auto cosR = vld1q_f32(rotation->Cos);
+            for (size_t j = 0; j < 4; ++j)
+            {
+                auto rx = vsubq_f32(vmulq_f32(x[j], cosR), vmulq_f32(y[j], sinR));
+                auto ry = vaddq_f32(vmulq_f32(x[j], sinR), vmulq_f32(y[j], cosR));
+                x[j] = rx;
+                y[j] = ry;
+            }
+        }
+
+        // Translate
+        for (size_t j = 0; j < 4; ++j)
+        {
+            x[j] = vaddq_f32(x[j], tx);
+            y[j] = vaddq_f32(y[j], ty);
+        }
+
+        // 转置为每个精灵的 4 个角点后写出
+        Transpose4x4NEON(x[0], x[1], x[2], x[3]);
+        Transpose4x4NEON(y[0], y[1], y[2], y[3]);
+        float cornerX[4];
+        float cornerY[4];
+        for (size_t k = 0; k < 4; ++k)
+        {
+            vst1q_f32(cornerX, x[k]);
+            vst1q_f32(cornerY, y[k]);
+            WriteQuad(reinterpret_cast<Vertex*>(output) + k * 4, cornerX, cornerY,
+                *reinterpret_cast<const SpriteInstance*>(instances + k * kStride));
+        }
+    }
+#endif
+
+    TransformFunction GetKernelFunction(SpriteTransformKernels kernel) noexcept
+    {
+        switch (kernel)
+        {
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+            case SpriteTransformKernels::SSE2:
+                return TransformSpriteInstancesSoA<4, TransformSpriteInstancesSSE2>;
+#endif
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2)
+            case SpriteTransformKernels::AVX2:
+                return TransformSpriteInstancesSoA<8, TransformSpriteInstancesAVX2>;
+#endif
+#if defined(LSTG_SPRITE_TRANSFORM_NEON)
+            case SpriteTransformKernels::NEON:
+                return TransformSpriteInstancesSoA<4, TransformSpriteInstancesNEON>;
+#endif
+            default:
+                assert(kernel == SpriteTransformKernels::Scalar);
+                return TransformSpriteInstancesScalar;
+        }
+    }
+
+    SpriteTransformKernels DetectSpriteTransformKernel() noexcept
+    {
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2)
+        // SDL_HasAVX2 通过 CPUID 检查 CPU 支持，并通过 XGETBV 检查操作系统是否保存 YMM 寄存器
+        if (::SDL_HasAVX2())
+            return SpriteTransformKernels::AVX2;
+#endif
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+        return SpriteTransformKernels::SSE2;
+#elif defined(LSTG_SPRITE_TRANSFORM_NEON)
+        return SpriteTransformKernels::NEON;
+#else
+        return SpriteTransformKernels::Scalar;
+#endif
+    }
+
+    /**
+     * 运行时选择的内核
+     * 首次使用时检测 CPU 特性并确定函数指针，此后不再改变。
+     */
+    struct SpriteTransformDispatch
+    {
+        SpriteTransformKernels Kernel;
+        TransformFunction Function;
+
+        SpriteTransformDispatch() noexcept
+            : Kernel(DetectSpriteTransformKernel()), Function(GetKernelFunction(Kernel)) {}
+    };
+
+    const SpriteTransformDispatch& GetDispatch() noexcept
+    {
+        static const SpriteTransformDispatch kDispatch;
+        return kDispatch;
+    }
+}
+
+SpriteTransformKernels Subsystem::Render::Drawing2D::GetSpriteTransformKernel() noexcept
+{
+    return GetDispatch().Kernel;
+}
+
+bool Subsystem::Render::Drawing2D::IsSpriteTransformKernelSupported(SpriteTransformKernels kernel) noexcept
+{
+    switch (kernel)
+    {
+        case SpriteTransformKernels::Scalar:
+            return true;
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+        case SpriteTransformKernels::SSE2:
+            return true;
+#endif
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2)
+        case SpriteTransformKernels::AVX2:
+            return GetDispatch().Kernel == SpriteTransformKernels::AVX2;
+#endif
+#if defined(LSTG_SPRITE_TRANSFORM_NEON)
+        case SpriteTransformKernels::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+void Subsystem::Render::Drawing2D::TransformSpriteInstances(Span<Vertex> output, Span<const SpriteInstance> instances) noexcept
+{
+    assert(output.GetSize() == instances.GetSize() * 4);
+    if (instances.IsEmpty())
+        return;
+
+    GetDispatch().Function(output.GetData(), instances.GetData(), instances.GetSize());
+}
+
+void Subsystem::Render::Drawing2D::TransformSpriteInstances(SpriteTransformKernels kernel, Span<Vertex> output,
+    Span<const SpriteInstance> instances) noexcept
+{
+    assert(output.GetSize() == instances.GetSize() * 4);
+    assert(IsSpriteTransformKernelSupported(kernel));
+    if (instances.IsEmpty())
+        return;
+
+    GetKernelFunction(kernel)(output.GetData(), instances.GetData(), instances.GetSize());
+}
@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "SpriteTransformKernels.hpp"
+
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2)
+#include <immintrin.h>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::Render::Drawing2D;
+
+namespace
+{
+    /**
+     * 在两个 128 位通道内分别转置 4x4 矩阵
+     */
+    inline void Transpose4x4x2(__m256& r0, __m256& r1, __m256& r2, __m256& r3) noexcept
+    {
+        auto t0 = _mm256_unpacklo_ps(r0, r1);
+        auto t1 = _mm256_unpackhi_ps(r0, r1);
+        auto t2 = _mm256_unpacklo_ps(r2, r3);
+        auto t3 = _mm256_unpackhi_ps(r2, r3);
+        r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    /**
+     * 读取 8 个实例中偏移为 offset 的 4 个字段，并转置为每个字段一个寄存器
+     */
+    inline void LoadFields(const float* instances, size_t offset, __m256& f0, __m256& f1, __m256& f2, __m256& f3) noexcept
+    {
+        const auto* p = instances + offset;
+        const auto kStride = detail::kSpriteInstanceFloats;
+        f0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 4 * kStride), 1);
+        f1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + kStride)), _mm_loadu_ps(p + 5 * kStride), 1);
+        f2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 2 * kStride)), _mm_loadu_ps(p + 6 * kStride), 1);
+        f3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 3 * kStride)), _mm_loadu_ps(p + 7 * kStride), 1);
+        Transpose4x4x2(f0, f1, f2, f3);
+    }
+}
+
+void detail::TransformSpriteInstancesAVX2(float* output, const float* instances, const RotationLanes<8>* rotation) noexcept
+{
+    __m256 tx, ty, tz, rot, w, h, cx, cy, sx, sy, u, v;
+    LoadFields(instances, 0, tx, ty, tz, rot);
+    LoadFields(instances, 4, w, h, cx, cy);
+    LoadFields(instances, 8, sx, sy, u, v);
+
+    // Shape & Scale
+    auto left = _mm256_mul_ps(_mm256_xor_ps(cx, _mm256_set1_ps(-0.f)), sx);
+    auto right = _mm256_mul_ps(_mm256_sub_ps(w, cx), sx);
+    auto top = _mm256_mul_ps(cy, sy);
+    auto bottom = _mm256_mul_ps(_mm256_sub_ps(cy, h), sy);
+    __m256 x[4] = { left, right, right, left };
+    __m256 y[4] = { top, top, bottom, bottom };
+
+    // Rotation
+    // 不使用 FMA，保持与标量版本相同的舍入
+    if (rotation)
+    {
+        auto sinR = _mm256_load_ps(rotation->Sin);
+        auto cosR = _mm256_load_ps(rotation->Cos);
+        for (size_t j = 0; j < 4; ++j)
+        {
+            auto rx = _mm256_sub_ps(_mm256_mul_ps(x[j], cosR), _mm256_mul_ps(y[j], sinR));
+            auto ry = _mm256_add_ps(_mm256_mul_ps(x[j], sinR), _mm256_mul_ps(y[j], cosR));
+            x[j] = rx;
+            y[j] = ry;
+        }
+    }
+
+    // Translate
+    for (size_t j = 0; j < 4; ++j)
+    {
+        x[j] = _mm256_add_ps(x[j], tx);
+        y[j] = _mm256_add_ps(y[j], ty);
+    }
+
+    // 转置为每个精灵的 4 个角点，低 128 位为第 0~3 个精灵，高 128 位为第 4~7 个精灵
+    Transpose4x4x2(x[0], x[1], x[2], x[3]);
+    Transpose4x4x2(y[0], y[1], y[2], y[3]);
+    const auto kQuadFloats = detail::kVertexFloats * 4;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        StoreQuadSSE(output + k * kQuadFloats, _mm256_castps256_ps128(x[k]), _mm256_castps256_ps128(y[k]),
+            instances + k * detail::kSpriteInstanceFloats);
+        StoreQuadSSE(output + (k + 4) * kQuadFloats, _mm256_extractf128_ps(x[k], 1), _mm256_extractf128_ps(y[k], 1),
+            instances + (k + 4) * detail::kSpriteInstanceFloats);
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LSTG_SPRITE_TRANSFORM_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define LSTG_SPRITE_TRANSFORM_NEON
+#endif
+
+// LSTG_SPRITE_TRANSFORM_AVX2 由构建脚本在为 AVX2 内核设置了编译选项时定义
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2) && !defined(LSTG_SPRITE_TRANSFORM_SSE2)
+#undef LSTG_SPRITE_TRANSFORM_AVX2
+#endif
+
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace lstg::Subsystem::Render::Drawing2D::detail
+{
+    /**
+     * SpriteInstance 的内存布局
+     * SIMD 内核直接以 float 读取实例，每个实例 16 个 float，按 4 个一组依次为：
+     * [X, Y, Z, Rotation]、[Width, Height, CenterX, CenterY]、[ScaleX, ScaleY, U, V]、[UW, VH, Color0, Color1]。
+     */
+    static constexpr size_t kSpriteInstanceFloats = 16;
+
+    /**
+     * Vertex 的内存布局
+     * 每个顶点 7 个 float：[X, Y, Z, U, V, Color0, Color1]，颜色按位复制。
+     */
+    static constexpr size_t kVertexFloats = 7;
+
+    /**
+     * 一组精灵的旋转
+     * 未旋转的精灵使用 sin = 0、cos = 1，结果与跳过旋转一致。
+     */
+    template <size_t N>
+    struct RotationLanes
+    {
+        alignas(32) float Sin[N];
+        alignas(32) float Cos[N];
+    };
+
+#if defined(LSTG_SPRITE_TRANSFORM_SSE2)
+    namespace
+    {
+        /**
+         * 写出一个精灵的四个顶点
+         * 四个顶点共 28 个 float，恰好为 7 次 16 字节写入。先在寄存器中按照顶点布局拼接，再依次写出。
+         * 位于匿名命名空间中，AVX2 编译单元会得到自己的副本，不会与其他编译单元共享。
+         * @param dest 输出顶点
+         * @param x 四个角点的 X 坐标
+         * @param y 四个角点的 Y 坐标
+         * @param instance 实例
+         */
+        inline void StoreQuadSSE(float* dest, __m128 x, __m128 y, const float* instance) noexcept
+        {
+            auto row0 = _mm_loadu_ps(instance);  // X, Y, Z, Rotation
+            auto row2 = _mm_loadu_ps(instance + 8);  // ScaleX, ScaleY, U, V
+            auto row3 = _mm_loadu_ps(instance + 12);  // UW, VH, Color0, Color1
+
+            // U0 = U，U1 = U + UW，V0 = V，V1 = V + VH
+            auto uv0 = _mm_shuffle_ps(row2, row3, _MM_SHUFFLE(3, 2, 3, 2));  // U0, V0, Color0, Color1
+            auto uv1 = _mm_add_ps(uv0, row3);  // U1, V1, -, -
+            auto xy01 = _mm_unpacklo_ps(x, y);  // X0, Y0, X1, Y1
+            auto xy23 = _mm_unpackhi_ps(x, y);  // X2, Y2, X3, Y3
+            auto uvMix = _mm_shuffle_ps(uv1, uv0, _MM_SHUFFLE(1, 0, 1, 0));  // U1, V1, U0, V0
+            auto zzu0 = _mm_shuffle_ps(row0, uv0, _MM_SHUFFLE(0, 0, 2, 2));  // Z, Z, U0, U0
+            auto zzu1 = _mm_shuffle_ps(row0, uv1, _MM_SHUFFLE(0, 0, 2, 2));  // Z, Z, U1, U1
+            auto y1z = _mm_shuffle_ps(xy01, row0, _MM_SHUFFLE(2, 2, 3, 3));  // Y1, Y1, Z, Z
+            auto y3z = _mm_shuffle_ps(xy23, row0, _MM_SHUFFLE(2, 2, 3, 3));  // Y3, Y3, Z, Z
+            auto c1x1 = _mm_shuffle_ps(uv0, xy01, _MM_SHUFFLE(2, 2, 3, 3));  // Color1, Color1, X1, X1
+            auto c1x3 = _mm_shuffle_ps(uv0, xy23, _MM_SHUFFLE(2, 2, 3, 3));  // Color1, Color1, X3, X3
+            auto v1c0 = _mm_shuffle_ps(uv1, uv0, _MM_SHUFFLE(2, 2, 1, 1));  // V1, V1, Color0, Color0
+
+            // [X0, Y0, Z, U0, V0, C0, C1] [X1, Y1, Z, U1, V0, C0, C1] [X2, Y2, Z, U1, V1, C0, C1] [X3, Y3, Z, U0, V1, C0, C1]
+            _mm_storeu_ps(dest, _mm_shuffle_ps(xy01, zzu0, _MM_SHUFFLE(2, 1, 1, 0)));
+            _mm_storeu_ps(dest + 4, _mm_shuffle_ps(uv0, c1x1, _MM_SHUFFLE(2, 0, 2, 1)));
+            _mm_storeu_ps(dest + 8, _mm_shuffle_ps(y1z, uvMix, _MM_SHUFFLE(3, 0, 2, 0)));
+            _mm_storeu_ps(dest + 12, _mm_shuffle_ps(uv0, xy23, _MM_SHUFFLE(1, 0, 3, 2)));
+            _mm_storeu_ps(dest + 16, _mm_shuffle_ps(zzu1, v1c0, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(dest + 20, _mm_shuffle_ps(c1x3, y3z, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(dest + 24, _mm_shuffle_ps(uvMix, uv0, _MM_SHUFFLE(3, 2, 1, 2)));
+        }
+    }
+#endif
+
+#if defined(LSTG_SPRITE_TRANSFORM_AVX2)
+    /**
+     * 使用 AVX2 展开 8 个精灵
+     * 位于单独的编译单元中，只有该文件使用 AVX2 编译选项，因此该编译单元不包含任何可能被其他编译单元共享的内联函数。
+     * 调用前需要确认 CPU 支持。
+     * @param output 输出顶点，32 个
+     * @param instances 8 个连续的实例
+     * @param rotation 旋转，为 nullptr 时表示这组精灵都没有旋转
+     */
+    void TransformSpriteInstancesAVX2(float* output, const float* instances, const RotationLanes<8>* rotation) noexcept;
+#endif
+}
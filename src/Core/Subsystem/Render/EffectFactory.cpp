@@ -187,7 +187,6 @@ Result<GraphDef::ImmutableShaderDefinitionPtr> EffectFactory::CompileShader(cons
 {
     try
     {
-        auto device = m_stRenderDevice.GetDevice();
         auto ret = make_shared<GraphDef::ShaderDefinition>(def);
 
         // 生成 Shader 代码准备编译
@@ -232,13 +231,13 @@ Result<GraphDef::ImmutableShaderDefinitionPtr> EffectFactory::CompileShader(cons
                 Diligent::SHADER_TYPE_VERTEX : Diligent::SHADER_TYPE_PIXEL);
             ci.SourceLanguage = Diligent::SHADER_SOURCE_LANGUAGE_HLSL;
             ci.ppCompilerOutput = &compilerOutputBlob;
-            device->CreateShader(ci, &shaderOutput);
+            auto compileResult = m_stRenderDevice.CreateShader(ci, &shaderOutput);
 
             string_view compilerOutput = compilerOutputBlob ? reinterpret_cast<const char*>(compilerOutputBlob->GetConstDataPtr()) : "";
             string_view generatedSource = compilerOutputBlob ?
                 reinterpret_cast<const char*>(compilerOutputBlob->GetConstDataPtr()) + compilerOutput.size() + 1 : source.c_str();
             LSTG_LOG_TRACE_CAT(EffectFactory, "Shader source code for \"{}\": {}", ci.Desc.Name, generatedSource);
-            if (!shaderOutput)
+            if (!compileResult)
             {
                 LSTG_LOG_TRACE_CAT(EffectFactory, "Compile shader \"{}\" fail: {}", ci.Desc.Name, compilerOutput);
                 return make_error_code(GraphDef::DefinitionError::ShaderCompileError);
@@ -250,8 +249,7 @@ Result<GraphDef::ImmutableShaderDefinitionPtr> EffectFactory::CompileShader(cons
         }
         LSTG_LOG_TRACE_CAT(EffectFactory, "Shader \"{}\" created", ret->GetName());
 
-        ret->m_pCompiledShader = shaderOutput;
-        ret->m_pCompiledShader->AddRef();
+        ret->m_pCompiledShader = shaderOutput.Detach();
         return ret;
     }
     catch (...)  // bad_alloc
@@ -270,7 +268,6 @@ Result<GraphDef::ImmutableEffectPassDefinitionPtr> EffectFactory::CompilePass(co
 
     try
     {
-        auto device = m_stRenderDevice.GetDevice();
         auto ret = make_shared<GraphDef::EffectPassDefinition>(def);
 
         // 根据定义生成 PRS
@@ -340,31 +337,23 @@ Result<GraphDef::ImmutableEffectPassDefinitionPtr> EffectFactory::CompilePass(co
             desc.NumImmutableSamplers = samplerList.size();
             desc.UseCombinedTextureSamplers = true;
             desc.CombinedSamplerSuffix = "Sampler";
-            device->CreatePipelineResourceSignature(desc, &prs);
-            if (!prs)
+            if (!m_stRenderDevice.CreatePipelineResourceSignature(desc, &prs))
                 return make_error_code(GraphDef::DefinitionError::CreatePRSError);
 
             // 绑定静态资源
             for (const auto& shader : shaders)
             {
-                auto shaderStage = shader->GetType() == GraphDef::ShaderDefinition::ShaderTypes::VertexShader ?
-                    Diligent::SHADER_TYPE_VERTEX : Diligent::SHADER_TYPE_PIXEL;
-
                 for (const auto& ref : shader->GetGlobalConstantBuffers())
                 {
-                    auto variable = prs->GetStaticVariableByName(shaderStage, ref->GetName().c_str());
-                    assert(variable);
-
                     auto cBuffer = GetGlobalConstantBuffer(ref->GetName().c_str());
                     assert(cBuffer);
-                    variable->Set(cBuffer->m_pNativeHandler);
+                    m_stRenderDevice.SetStaticVariable(prs, *shader, ref->GetName().c_str(), cBuffer->m_pNativeHandler);
                 }
             }
         }
         LSTG_LOG_TRACE_CAT(EffectFactory, "Pass \"{}\" created", ret->GetName());
 
-        ret->m_pResourceSignature = prs;
-        ret->m_pResourceSignature->AddRef();
+        ret->m_pResourceSignature = prs.Detach();
         return ret;
     }
     catch (...)  // bad_alloc
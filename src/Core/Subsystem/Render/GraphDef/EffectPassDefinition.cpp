@@ -79,7 +79,10 @@ EffectPassDefinition::EffectPassDefinition(const EffectPassDefinition& rhs)
     if (m_pResourceSignature)
         m_pResourceSignature->AddRef();
     for (auto& p : m_stPipelineStateCaches)
-        p.second->AddRef();
+    {
+        if (p.second)  // 不持有原生对象的设备上为空
+            p.second->AddRef();
+    }
 }
 
 EffectPassDefinition::EffectPassDefinition(EffectPassDefinition&& rhs) noexcept
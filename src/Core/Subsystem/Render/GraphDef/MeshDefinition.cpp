@@ -18,25 +18,28 @@ bool MeshDefinition::operator==(const MeshDefinition& def) const noexcept
 {
     return m_iTopologyType == def.m_iTopologyType &&
         m_iVertexStride == def.m_iVertexStride &&
+        m_iInstanceStride == def.m_iInstanceStride &&
         m_stVertexElements == def.m_stVertexElements;
 }
 
-Result<void> MeshDefinition::AddVertexElement(VertexElementType type, VertexElementSemantic semantic, size_t offset) noexcept
+Result<void> MeshDefinition::AddVertexElement(VertexElementType type, VertexElementSemantic semantic, size_t offset, bool perInstance) noexcept
 {
     if (ContainsSemantic(semantic))
         return make_error_code(DefinitionError::SymbolAlreadyDefined);
 
     try
     {
-        // 我们按照 Offset 排序
-        auto it = std::lower_bound(m_stVertexElements.begin(), m_stVertexElements.end(), offset, [](const VertexElement& e, size_t offset) {
-            return e.Offset < offset;
-        });
+        // 我们按照 (PerInstance, Offset) 排序，逐顶点和逐实例数据的偏移各自独立
+        auto it = std::lower_bound(m_stVertexElements.begin(), m_stVertexElements.end(), make_tuple(perInstance, offset),
+            [](const VertexElement& e, const tuple<bool, size_t>& key) {
+                return make_tuple(e.PerInstance, e.Offset) < key;
+            });
 
         VertexElement target;
         target.Type = type;
         target.Semantic = semantic;
         target.Offset = offset;
+        target.PerInstance = perInstance;
 
         if (it == m_stVertexElements.end())
         {
@@ -45,7 +48,7 @@ Result<void> MeshDefinition::AddVertexElement(VertexElementType type, VertexElem
         else
         {
             // 不允许出现重叠
-            assert(it->Offset > offset);
+            assert(it->PerInstance != perInstance || it->Offset > offset);
             m_stVertexElements.insert(it, std::move(target));
         }
         return {};
@@ -71,6 +74,7 @@ size_t MeshDefinition::GetHashCode() const noexcept
     auto ret = std::hash<string_view>{}("Mesh");
     ret ^= std::hash<PrimitiveTopologyTypes>{}(m_iTopologyType);
     ret ^= std::hash<size_t>{}(m_iVertexStride);
+    ret ^= std::hash<size_t>{}(m_iInstanceStride) << 1;
     for (const auto& e : m_stVertexElements)
     {
         ret ^= std::hash<VertexElementScalarTypes>{}(std::get<0>(e.Type));
@@ -78,6 +82,7 @@ size_t MeshDefinition::GetHashCode() const noexcept
         ret ^= std::hash<VertexElementSemanticNames>{}(std::get<0>(e.Semantic));
         ret ^= std::hash<uint8_t>{}(std::get<1>(e.Semantic));
         ret ^= std::hash<size_t>{}(e.Offset);
+        ret ^= std::hash<bool>{}(e.PerInstance);
     }
     return ret;
 }
@@ -9,8 +9,6 @@
 #include <Buffer.h>
 #include <Texture.h>
 #include <ShaderResourceBinding.h>
-#include <PipelineResourceSignature.h>
-#include <DeviceContext.h>
 #include <RefCntAutoPtr.hpp>
 #include <lstg/Core/Logging.hpp>
 
@@ -75,12 +73,10 @@ Material::Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr
 
             // 获取 PipelineResourceSignature
             auto prs = pass->m_pResourceSignature;
-            assert(prs);
 
             // 构造 ResourceBinding
             Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> binding;
-            prs->CreateShaderResourceBinding(&binding, true);
-            if (!binding)
+            if (!device.CreateShaderResourceBinding(prs, &binding))
             {
                 LSTG_LOG_ERROR_CAT(Material, "Create SRB fail, pass {}:{}", passGroup->GetName(), pass->GetName());
                 throw system_error(make_error_code(GraphDef::DefinitionError::CreateSRBError));
@@ -90,27 +86,22 @@ Material::Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr
             const GraphDef::ShaderDefinition* shaders[]{ pass->GetVertexShader().get(), pass->GetPixelShader().get() };
             for (auto shader: shaders)
             {
-                auto shaderStage = shader->GetType() == GraphDef::ShaderDefinition::ShaderTypes::VertexShader ?
-                    Diligent::SHADER_TYPE_VERTEX : Diligent::SHADER_TYPE_PIXEL;
-
                 // 全局 CBuffer 在 EffectFactory 完成静态绑定
                 // 这里只绑定 Material 级别的 CBuffer
                 for (const auto& cb: shader->GetConstantBuffers())
                 {
-                    Diligent::IShaderResourceVariable* shaderVariable = binding->GetVariableByName(shaderStage, cb->GetName().c_str());
-                    assert(shaderVariable);
+                    auto shaderVariable = device.GetVariable(binding, *shader, cb->GetName().c_str());
 
                     auto cBufferInstance = m_stCBufferInstances.find(cb.get());
                     assert(cBufferInstance != m_stCBufferInstances.end());
 
-                    shaderVariable->Set(cBufferInstance->second->m_pNativeHandler);
+                    device.SetVariable(shaderVariable, cBufferInstance->second->m_pNativeHandler);
                 }
             }
 
             // 创建实例
             PassInstance inst;
-            inst.ResourceBinding = binding;
-            inst.ResourceBinding->AddRef();
+            inst.ResourceBinding = binding.Detach();
             m_stPassInstances.emplace(pass.get(), std::move(inst));
         }
     }
@@ -126,9 +117,6 @@ Material::Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr
             const GraphDef::ShaderDefinition* shaders[]{ pass->GetVertexShader().get(), pass->GetPixelShader().get() };
             for (auto shader: shaders)
             {
-                auto shaderStage = shader->GetType() == GraphDef::ShaderDefinition::ShaderTypes::VertexShader ?
-                    Diligent::SHADER_TYPE_VERTEX : Diligent::SHADER_TYPE_PIXEL;
-
                 for (const auto& v : shader->GetTextures())
                 {
                     // FIXME: 暂时不支持 2D 纹理以外的类型
@@ -159,25 +147,18 @@ Material::Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr
                         jt = it->second.References.end() - 1;
                     }
                     assert(jt != it->second.References.end());
-                    auto var = passInstance->ResourceBinding->GetVariableByName(shaderStage, v->GetName().c_str());
-                    assert(var);
-                    if (shaderStage == Diligent::SHADER_TYPE_VERTEX)
-                    {
+                    auto var = device.GetVariable(passInstance->ResourceBinding, *shader, v->GetName().c_str());
+                    if (shader->GetType() == GraphDef::ShaderDefinition::ShaderTypes::VertexShader)
                         jt->VertexShaderResource = var;
-                    }
                     else
-                    {
-                        assert(shaderStage == Diligent::SHADER_TYPE_PIXEL);
                         jt->PixelShaderResource = var;
-                    }
                 }
             }
         }
     }
 
     // 给所有 Texture 绑定默认的纹理
-    auto defaultTex2DView = defaultTex2D->m_pNativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
-    assert(defaultTex2DView);
+    auto defaultTex2DView = device.GetTextureView(defaultTex2D->m_pNativeHandler, TextureViewTypes::ShaderResource).ThrowIfError();
     for (auto& p : m_stTextureVariableInstances)
     {
         assert(p.first->GetType() == GraphDef::ShaderTextureDefinition::TextureTypes::Texture2D);
@@ -185,9 +166,9 @@ Material::Material(RenderDevice& device, GraphDef::ImmutableEffectDefinitionPtr
         for (auto& r : p.second.References)
         {
             if (r.VertexShaderResource)
-                r.VertexShaderResource->Set(defaultTex2DView);
+                device.SetVariable(r.VertexShaderResource, defaultTex2DView);
             if (r.PixelShaderResource)
-                r.PixelShaderResource->Set(defaultTex2DView);
+                device.SetVariable(r.PixelShaderResource, defaultTex2DView);
             r.Pass->SRBDirty = true;
         }
     }
@@ -199,33 +180,42 @@ Result<void> Material::SetTexture(std::string_view symbol, const TexturePtr& tex
 {
     if (!texture)
         return make_error_code(errc::invalid_argument);
-    auto* nativeHandler = texture->m_pNativeHandler;
 
-    // 获取符号定义
-    auto info = m_pDefinition->GetSymbol(symbol);
-    if (!info)
-        return make_error_code(GraphDef::DefinitionError::SymbolNotFound);
-    if (info->Type != GraphDef::ShaderDefinition::SymbolTypes::Texture)
-        return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
+    auto slot = GetTextureSlot(symbol);
+    if (!slot)
+        return slot.GetError();
+    return SetTexture(*slot, texture);
+}
+
+Result<void> Material::SetTexture(const TextureSlot& slot, const TexturePtr& texture) noexcept
+{
+    assert(slot.Definition && slot.State);
+    if (!texture)
+        return make_error_code(errc::invalid_argument);
+
+    // 纹理的原生句柄在其生命周期内不变，因此同一个纹理无需重新绑定
+    if (slot.State->BindingTexture == texture)
+        return {};
+    auto* nativeHandler = texture->m_pNativeHandler;
+    const auto& desc = texture->GetNativeDesc();
 
     // 检查类型
-    const auto& assoc = std::get<GraphDef::EffectDefinition::TextureOrSamplerSymbolInfo>(info->AssocInfo);
-    switch (assoc.Definition->GetType())
+    switch (slot.Definition->GetType())
     {
         case GraphDef::ShaderTextureDefinition::TextureTypes::Texture1D:
-            if (nativeHandler->GetDesc().Type != Diligent::RESOURCE_DIM_TEX_1D)
+            if (desc.Type != Diligent::RESOURCE_DIM_TEX_1D)
                 return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
             break;
         case GraphDef::ShaderTextureDefinition::TextureTypes::Texture2D:
-            if (nativeHandler->GetDesc().Type != Diligent::RESOURCE_DIM_TEX_2D)
+            if (desc.Type != Diligent::RESOURCE_DIM_TEX_2D)
                 return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
             break;
         case GraphDef::ShaderTextureDefinition::TextureTypes::Texture3D:
-            if (nativeHandler->GetDesc().Type != Diligent::RESOURCE_DIM_TEX_3D)
+            if (desc.Type != Diligent::RESOURCE_DIM_TEX_3D)
                 return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
             break;
         case GraphDef::ShaderTextureDefinition::TextureTypes::TextureCube:
-            if (nativeHandler->GetDesc().Type != Diligent::RESOURCE_DIM_TEX_CUBE)
+            if (desc.Type != Diligent::RESOURCE_DIM_TEX_CUBE)
                 return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
             break;
         default:
@@ -234,28 +224,60 @@ Result<void> Material::SetTexture(std::string_view symbol, const TexturePtr& tex
     }
 
     // 赋值
-    auto view = nativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_SHADER_RESOURCE);
+    auto view = m_stRenderDevice.GetTextureView(nativeHandler, TextureViewTypes::ShaderResource);
     if (!view)
     {
-        LSTG_LOG_ERROR_CAT(Material, "GetDefaultView from texture {} fail", symbol);
-        return make_error_code(errc::io_error);
+        LSTG_LOG_ERROR_CAT(Material, "GetDefaultView from texture {} fail", slot.Definition->GetName());
+        return view.GetError();
     }
-    auto it = m_stTextureVariableInstances.find(assoc.Definition.get());
-    assert(it != m_stTextureVariableInstances.end());
-    it->second.BindingTexture = texture;
-    for (auto& r : it->second.References)
+    slot.State->BindingTexture = texture;
+    for (auto& r : slot.State->References)
     {
-        assert(r.VertexShaderResource || r.PixelShaderResource);
         if (r.VertexShaderResource)
-            r.VertexShaderResource->Set(view);
+            m_stRenderDevice.SetVariable(r.VertexShaderResource, *view);
         if (r.PixelShaderResource)
-            r.PixelShaderResource->Set(view);
+            m_stRenderDevice.SetVariable(r.PixelShaderResource, *view);
         r.Pass->SRBDirty = true;
     }
     m_bSRBDirty = true;
     return {};
 }
 
+Result<Material::UniformSlot> Material::GetUniformSlot(std::string_view symbol) const noexcept
+{
+    auto info = m_pDefinition->GetSymbol(symbol);
+    if (!info)
+        return make_error_code(GraphDef::DefinitionError::SymbolNotFound);
+
+    // 只能设置 Uniform
+    // Global Uniform 需要在外部进行设置
+    if (info->Type != GraphDef::ShaderDefinition::SymbolTypes::Uniform)
+        return make_error_code(std::errc::invalid_argument);
+
+    // 找到对应的 CBuffer
+    const auto& assoc = std::get<GraphDef::EffectDefinition::UniformSymbolInfo>(info->AssocInfo);
+    auto it = m_stCBufferInstances.find(assoc.Definition.get());
+    assert(it != m_stCBufferInstances.end());
+    assert(assoc.FieldDesc);
+    return UniformSlot { it->second.get(), assoc.FieldDesc };
+}
+
+Result<Material::TextureSlot> Material::GetTextureSlot(std::string_view symbol) noexcept
+{
+    // 获取符号定义
+    auto info = m_pDefinition->GetSymbol(symbol);
+    if (!info)
+        return make_error_code(GraphDef::DefinitionError::SymbolNotFound);
+    if (info->Type != GraphDef::ShaderDefinition::SymbolTypes::Texture)
+        return make_error_code(GraphDef::DefinitionError::SymbolTypeMismatched);
+
+    // 找到对应的纹理变量
+    const auto& assoc = std::get<GraphDef::EffectDefinition::TextureOrSamplerSymbolInfo>(info->AssocInfo);
+    auto it = m_stTextureVariableInstances.find(assoc.Definition.get());
+    assert(it != m_stTextureVariableInstances.end());
+    return TextureSlot { assoc.Definition.get(), &it->second };
+}
+
 Result<void> Material::Commit() noexcept
 {
     if (m_bCBufferDirty)
@@ -275,8 +297,7 @@ Result<void> Material::Commit() noexcept
         {
             if (pass.second.SRBDirty)
             {
-                m_stRenderDevice.GetImmediateContext()->CommitShaderResources(pass.second.ResourceBinding,
-                    Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                m_stRenderDevice.CommitShaderResources(pass.second.ResourceBinding);
                 pass.second.SRBDirty = false;
             }
         }
@@ -7,8 +7,9 @@
 #include <lstg/Core/Subsystem/Render/Mesh.hpp>
 
 #include <Buffer.h>
-#include <MapHelper.hpp>
-#include <RenderDevice.h>
+#include <Fence.h>
+#include <RefCntAutoPtr.hpp>
+#include <DeviceContext.h>
 
 using namespace std;
 using namespace lstg;
@@ -30,21 +31,92 @@ namespace
         n++;
         return n;
     }
+
+    /**
+     * 保证动态缓冲区至少可以容纳指定大小的数据
+     * 空间不足时以 2 的幂次重新创建缓冲区，旧的数据不会保留。
+     * @param bufferSize 缓冲区当前的大小，为 0 表示尚未创建
+     */
+    Result<void> ReserveDynamicBuffer(RenderDevice& device, Diligent::IBuffer*& buffer, size_t& bufferSize, Diligent::BIND_FLAGS bindFlags,
+        size_t size) noexcept
+    {
+        if (bufferSize != 0 && bufferSize >= size)
+            return {};
+
+        Diligent::RefCntAutoPtr<Diligent::IBuffer> newBuffer;
+
+        // 计算需要的大小，总是取 2 的幂次
+        auto desiredSize = ::max(16u, ::NextPowerOf2(size));
+        assert(desiredSize > bufferSize);
+
+        Diligent::BufferDesc desc;
+        desc.Name = buffer ? buffer->GetDesc().Name : "";
+        desc.BindFlags = bindFlags;
+        desc.Size = desiredSize;
+        desc.Usage = Diligent::USAGE_DYNAMIC;
+        desc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
+        auto ret = device.CreateBuffer(desc, nullptr, &newBuffer);
+        if (!ret)
+            return make_error_code(errc::io_error);
+
+        if (buffer)
+            buffer->Release();
+        buffer = newBuffer.Detach();
+        bufferSize = desiredSize;
+        return {};
+    }
 }
 
 Mesh::Mesh(Render::RenderDevice& device, GraphDef::ImmutableMeshDefinitionPtr definition, Diligent::IBuffer* vertexBuffer,
-    Diligent::IBuffer* indexBuffer, bool use32BitsIndex, Usage usage)
+    size_t vertexBufferSize, Diligent::IBuffer* indexBuffer, size_t indexBufferSize, bool use32BitsIndex, Usage usage,
+    size_t dynamicBufferCount)
     : m_stDevice(device), m_pDefinition(std::move(definition)), m_bUse32BitsIndex(use32BitsIndex), m_iUsage(usage),
-    m_pVertexBuffer(vertexBuffer), m_pIndexBuffer(indexBuffer)
+    m_pVertexBuffer(vertexBuffer), m_pIndexBuffer(indexBuffer), m_stBufferSizes { vertexBufferSize, indexBufferSize, 0 }
 {
-    assert(m_pVertexBuffer);
-    assert(m_pIndexBuffer);
-    m_pVertexBuffer->AddRef();
-    m_pIndexBuffer->AddRef();
+    assert(dynamicBufferCount >= 1);
+
+    // 只有动态网格需要轮换，其余的缓冲区组在首次使用时按需创建
+    if (m_iUsage == Usage::Dynamic && dynamicBufferCount > 1)
+        m_stDynamicBuffers.resize(dynamicBufferCount);
+
+    if (m_pVertexBuffer)
+        m_pVertexBuffer->AddRef();
+    if (m_pIndexBuffer)
+        m_pIndexBuffer->AddRef();
+
+    if (!m_stDynamicBuffers.empty())
+    {
+        Diligent::FenceDesc desc;
+        desc.Name = "Dynamic mesh fence";
+        auto ret = m_stDevice.CreateFence(desc, &m_pFence);
+        if (!ret)
+        {
+            if (m_pVertexBuffer)
+                m_pVertexBuffer->Release();
+            if (m_pIndexBuffer)
+                m_pIndexBuffer->Release();
+            throw system_error(ret.GetError());
+        }
+    }
 }
 
 Mesh::~Mesh()
 {
+    for (auto& buffers : m_stDynamicBuffers)
+    {
+        if (buffers.VertexBuffer)
+            buffers.VertexBuffer->Release();
+        if (buffers.IndexBuffer)
+            buffers.IndexBuffer->Release();
+        if (buffers.InstanceBuffer)
+            buffers.InstanceBuffer->Release();
+    }
+    m_stDynamicBuffers.clear();
+    if (m_pFence)
+    {
+        m_pFence->Release();
+        m_pFence = nullptr;
+    }
     if (m_pVertexBuffer)
     {
         m_pVertexBuffer->Release();
@@ -55,23 +127,36 @@ Mesh::~Mesh()
         m_pIndexBuffer->Release();
         m_pIndexBuffer = nullptr;
     }
+    if (m_pInstanceBuffer)
+    {
+        m_pInstanceBuffer->Release();
+        m_pInstanceBuffer = nullptr;
+    }
 }
 
 size_t Mesh::GetVertexCount() const noexcept
 {
+    // 轮换中的 Dynamic Mesh 在 Commit 失败后可能没有缓冲区，此时大小为 0
     // Dynamic Mesh 顶点个数可以和 Buffer 大小无关（总是2的幂次），此时取整，含义为可以存放的最大顶点个数
-    assert(m_iUsage == Usage::Dynamic || m_pVertexBuffer->GetDesc().Size % m_pDefinition->GetVertexStride() == 0);
-    return m_pVertexBuffer->GetDesc().Size / m_pDefinition->GetVertexStride();
+    assert(m_iUsage == Usage::Dynamic || m_stBufferSizes.Vertex % m_pDefinition->GetVertexStride() == 0);
+    return m_stBufferSizes.Vertex / m_pDefinition->GetVertexStride();
 }
 
 size_t Mesh::GetIndexCount() const noexcept
 {
     // Dynamic Mesh 索引个数可以和单个索引大小无关（总是2的幂次），此时取整，含义为可以存放的最大索引个数
-    assert(m_iUsage == Usage::Dynamic || m_pIndexBuffer->GetDesc().Size % (m_bUse32BitsIndex ? 4 : 2) == 0);
-    return m_pIndexBuffer->GetDesc().Size / (m_bUse32BitsIndex ? 4 : 2);
+    assert(m_iUsage == Usage::Dynamic || m_stBufferSizes.Index % (m_bUse32BitsIndex ? 4 : 2) == 0);
+    return m_stBufferSizes.Index / (m_bUse32BitsIndex ? 4 : 2);
 }
 
-Result<void> Mesh::Commit(Span<const uint8_t> vertexData, Span<const uint8_t> indexData) noexcept
+size_t Mesh::GetInstanceCount() const noexcept
+{
+    if (m_pDefinition->GetInstanceStride() == 0)
+        return 0;
+    return m_stBufferSizes.Instance / m_pDefinition->GetInstanceStride();
+}
+
+Result<void> Mesh::Commit(Span<const uint8_t> vertexData, Span<const uint8_t> indexData, Span<const uint8_t> instanceData) noexcept
 {
     // 参数检查
     if (m_iUsage != Usage::Dynamic)
@@ -80,73 +165,82 @@ Result<void> Mesh::Commit(Span<const uint8_t> vertexData, Span<const uint8_t> in
         return make_error_code(errc::invalid_argument);
     if (indexData.size() % (m_bUse32BitsIndex ? sizeof(uint32_t) : sizeof(uint16_t)) != 0)
         return make_error_code(errc::invalid_argument);
+    if (!instanceData.IsEmpty() && (m_pDefinition->GetInstanceStride() == 0 || instanceData.size() % m_pDefinition->GetInstanceStride() != 0))
+        return make_error_code(errc::invalid_argument);
+
+    // 切换到 GPU 已经不再使用的缓冲区组
+    if (!m_stDynamicBuffers.empty())
+        SwitchDynamicBuffers();
 
     // 检查是否需要申请更大的空间
-    if (!m_pVertexBuffer || m_pVertexBuffer->GetDesc().Size < vertexData.size())
+    auto ret = ReserveDynamicBuffer(m_stDevice, m_pVertexBuffer, m_stBufferSizes.Vertex, Diligent::BIND_VERTEX_BUFFER,
+        vertexData.size());
+    if (!ret)
+        return ret.GetError();
+    ret = ReserveDynamicBuffer(m_stDevice, m_pIndexBuffer, m_stBufferSizes.Index, Diligent::BIND_INDEX_BUFFER, indexData.size());
+    if (!ret)
+        return ret.GetError();
+    if (!instanceData.IsEmpty())
     {
-        Diligent::RefCntAutoPtr<Diligent::IBuffer> vertexBuffer;
-
-        // 计算需要的大小，总是取 2 的幂次
-        auto desiredSize = ::max(16u, ::NextPowerOf2(vertexData.size()));
-        assert(!m_pVertexBuffer || desiredSize > m_pVertexBuffer->GetDesc().Size);
-
-        Diligent::BufferDesc vertexBufferDesc;
-        vertexBufferDesc.Name = m_pVertexBuffer ? m_pVertexBuffer->GetDesc().Name : "";
-        vertexBufferDesc.BindFlags = Diligent::BIND_VERTEX_BUFFER;
-        vertexBufferDesc.Size = desiredSize;
-        vertexBufferDesc.Usage = Diligent::USAGE_DYNAMIC;
-        vertexBufferDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
-        m_stDevice.GetDevice()->CreateBuffer(vertexBufferDesc, nullptr, &vertexBuffer);
-        if (!vertexBuffer)
-            return make_error_code(errc::io_error);
-
-        if (m_pVertexBuffer)
-            m_pVertexBuffer->Release();
-        m_pVertexBuffer = vertexBuffer;
-        m_pVertexBuffer->AddRef();
-    }
-    if (!m_pIndexBuffer || m_pIndexBuffer->GetDesc().Size < indexData.size())
-    {
-        Diligent::RefCntAutoPtr<Diligent::IBuffer> indexBuffer;
-
-        // 计算需要的大小，总是取 2 的幂次
-        auto desiredSize = ::max(16u, ::NextPowerOf2(indexData.size()));
-        assert(!m_pIndexBuffer || desiredSize > m_pIndexBuffer->GetDesc().Size);
-
-        Diligent::BufferDesc indexBufferDesc;
-        indexBufferDesc.Name = m_pIndexBuffer ? m_pIndexBuffer->GetDesc().Name : "";
-        indexBufferDesc.BindFlags = Diligent::BIND_INDEX_BUFFER;
-        indexBufferDesc.Size = desiredSize;
-        indexBufferDesc.Usage = Diligent::USAGE_DYNAMIC;
-        indexBufferDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
-        m_stDevice.GetDevice()->CreateBuffer(indexBufferDesc, nullptr, &indexBuffer);
-        if (!indexBuffer)
-            return make_error_code(errc::io_error);
-
-        if (m_pIndexBuffer)
-            m_pIndexBuffer->Release();
-        m_pIndexBuffer = indexBuffer;
-        m_pIndexBuffer->AddRef();
+        ret = ReserveDynamicBuffer(m_stDevice, m_pInstanceBuffer, m_stBufferSizes.Instance, Diligent::BIND_VERTEX_BUFFER,
+            instanceData.size());
+        if (!ret)
+            return ret.GetError();
     }
 
     // 复制数据
+    // 受 Fence 保护的缓冲区组在切换时已确认 GPU 不再使用，以 NoOverwrite 方式映射，避免驱动孤立缓冲区或等待 GPU。
+    // 只有一组缓冲区时以 Discard 方式映射，由驱动完成重命名。
+    auto noOverwrite = !m_stDynamicBuffers.empty();
+    ret = m_stDevice.WriteBuffer(m_pVertexBuffer, vertexData, noOverwrite);
+    if (!ret)
+        return ret.GetError();
+    ret = m_stDevice.WriteBuffer(m_pIndexBuffer, indexData, noOverwrite);
+    if (!ret)
+        return ret.GetError();
+    if (!instanceData.IsEmpty())
     {
-        assert(m_pVertexBuffer && m_pIndexBuffer);
-        assert(m_pVertexBuffer->GetDesc().Size >= vertexData.size() && m_pIndexBuffer->GetDesc().Size >= indexData.size());
-        auto context = m_stDevice.GetImmediateContext();
-
-        void* data = nullptr;
-        context->MapBuffer(m_pVertexBuffer, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD, data);
-        if (!data)
-            return make_error_code(errc::io_error);
-        ::memcpy(data, vertexData.data(), vertexData.size());
-        context->UnmapBuffer(m_pVertexBuffer, Diligent::MAP_WRITE);
-
-        context->MapBuffer(m_pIndexBuffer, Diligent::MAP_WRITE, Diligent::MAP_FLAG_DISCARD, data);
-        if (!data)
-            return make_error_code(errc::io_error);
-        ::memcpy(data, indexData.data(), indexData.size());
-        context->UnmapBuffer(m_pIndexBuffer, Diligent::MAP_WRITE);
+        ret = m_stDevice.WriteBuffer(m_pInstanceBuffer, instanceData, noOverwrite);
+        if (!ret)
+            return ret.GetError();
     }
     return {};
 }
+
+void Mesh::SwitchDynamicBuffers() noexcept
+{
+    assert(m_pFence && m_stDynamicBuffers.size() > 1);
+    auto context = m_stDevice.GetImmediateContext();
+
+    // 当前缓冲区组在此前提交的命令之后即可重用
+    auto& current = m_stDynamicBuffers[m_uCurrentBuffers];
+    assert(!current.VertexBuffer && !current.IndexBuffer && !current.InstanceBuffer);
+    context->EnqueueSignal(m_pFence, ++m_ullLastFenceValue);
+    current.VertexBuffer = m_pVertexBuffer;
+    current.IndexBuffer = m_pIndexBuffer;
+    current.InstanceBuffer = m_pInstanceBuffer;
+    current.Sizes = m_stBufferSizes;
+    current.FenceValue = m_ullLastFenceValue;
+    m_pVertexBuffer = nullptr;
+    m_pIndexBuffer = nullptr;
+    m_pInstanceBuffer = nullptr;
+    m_stBufferSizes = {};
+
+    // 取出下一组缓冲区，GPU 落后超过缓冲区组数时才需要等待
+    m_uCurrentBuffers = (m_uCurrentBuffers + 1) % m_stDynamicBuffers.size();
+    auto& next = m_stDynamicBuffers[m_uCurrentBuffers];
+    if (next.FenceValue > m_pFence->GetCompletedValue())
+    {
+        context->Flush();
+        m_pFence->Wait(next.FenceValue);
+    }
+    m_pVertexBuffer = next.VertexBuffer;
+    m_pIndexBuffer = next.IndexBuffer;
+    m_pInstanceBuffer = next.InstanceBuffer;
+    m_stBufferSizes = next.Sizes;
+    next.VertexBuffer = nullptr;
+    next.IndexBuffer = nullptr;
+    next.InstanceBuffer = nullptr;
+    next.Sizes = {};
+    next.FenceValue = 0;
+}
@@ -7,14 +7,27 @@
 #include <lstg/Core/Subsystem/Render/RenderDevice.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <RenderDevice.h>
 #include <DeviceContext.h>
 #include <SwapChain.h>
+#include <RefCntAutoPtr.hpp>
+#include <lstg/Core/Subsystem/Render/Texture.hpp>
+#include <lstg/Core/Subsystem/Render/GraphDef/ShaderDefinition.hpp>
 
 using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::Render;
 
+namespace
+{
+    Diligent::SHADER_TYPE ToShaderType(const GraphDef::ShaderDefinition& shader) noexcept
+    {
+        return shader.GetType() == GraphDef::ShaderDefinition::ShaderTypes::VertexShader ? Diligent::SHADER_TYPE_VERTEX :
+            Diligent::SHADER_TYPE_PIXEL;
+    }
+}
+
 RenderDevice::~RenderDevice() noexcept
 {
     if (m_pSwapChain)
@@ -52,14 +65,12 @@ void RenderDevice::SetVerticalSyncEnabled(bool enable) noexcept
 
 uint32_t RenderDevice::GetRenderOutputWidth() const noexcept
 {
-    assert(m_pSwapChain);
-    return m_pSwapChain->GetDesc().Width;
+    return GetSwapChainDesc().Width;
 }
 
 uint32_t RenderDevice::GetRenderOutputHeight() const noexcept
 {
-    assert(m_pSwapChain);
-    return m_pSwapChain->GetDesc().Height;
+    return GetSwapChainDesc().Height;
 }
 
 void RenderDevice::Present() noexcept
@@ -68,3 +79,262 @@ void RenderDevice::Present() noexcept
     m_pSwapChain->Present(m_bVerticalSync ? 1 : 0);
     ++m_uPresentedCount;
 }
+
+// <editor-fold desc="交换链">
+
+const Diligent::SwapChainDesc& RenderDevice::GetSwapChainDesc() const noexcept
+{
+    assert(m_pSwapChain);
+    return m_pSwapChain->GetDesc();
+}
+
+void RenderDevice::ResizeSwapChain(uint32_t width, uint32_t height) noexcept
+{
+    assert(m_pSwapChain);
+    m_pSwapChain->Resize(width, height);
+}
+
+Diligent::ITextureView* RenderDevice::GetBackBufferRenderTargetView() noexcept
+{
+    assert(m_pSwapChain);
+    return m_pSwapChain->GetCurrentBackBufferRTV();
+}
+
+Diligent::ITextureView* RenderDevice::GetBackBufferDepthStencilView() noexcept
+{
+    assert(m_pSwapChain);
+    return m_pSwapChain->GetDepthBufferDSV();
+}
+
+// </editor-fold>
+// <editor-fold desc="资源">
+
+size_t RenderDevice::GetDynamicMeshBufferCount() const noexcept
+{
+    return 1;
+}
+
+Result<void> RenderDevice::CreateBuffer(const Diligent::BufferDesc& desc, const Diligent::BufferData* data,
+    Diligent::IBuffer** buffer) noexcept
+{
+    assert(buffer && !*buffer);
+    m_pRenderDevice->CreateBuffer(desc, data, buffer);
+    if (!*buffer)
+        return make_error_code(errc::not_enough_memory);
+    return {};
+}
+
+Result<std::shared_ptr<Texture>> RenderDevice::CreateTexture(const Diligent::TextureDesc& desc, const Diligent::TextureData* data) noexcept
+{
+    Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
+    m_pRenderDevice->CreateTexture(desc, data, &texture);
+    if (!texture)
+        return make_error_code(errc::not_enough_memory);
+
+    try
+    {
+        return make_shared<Texture>(*this, texture->GetDesc(), texture);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+Result<void> RenderDevice::CreateFence(const Diligent::FenceDesc& desc, Diligent::IFence** fence) noexcept
+{
+    assert(fence && !*fence);
+    m_pRenderDevice->CreateFence(desc, fence);
+    if (!*fence)
+        return make_error_code(errc::not_enough_memory);
+    return {};
+}
+
+Result<void> RenderDevice::CreateShader(const Diligent::ShaderCreateInfo& createInfo, Diligent::IShader** shader) noexcept
+{
+    assert(shader && !*shader);
+    m_pRenderDevice->CreateShader(createInfo, shader);
+    if (!*shader)
+        return make_error_code(errc::io_error);
+    return {};
+}
+
+Result<void> RenderDevice::CreatePipelineResourceSignature(const Diligent::PipelineResourceSignatureDesc& desc,
+    Diligent::IPipelineResourceSignature** signature) noexcept
+{
+    assert(signature && !*signature);
+    m_pRenderDevice->CreatePipelineResourceSignature(desc, signature);
+    if (!*signature)
+        return make_error_code(errc::io_error);
+    return {};
+}
+
+Result<void> RenderDevice::CreateShaderResourceBinding(Diligent::IPipelineResourceSignature* signature,
+    Diligent::IShaderResourceBinding** binding) noexcept
+{
+    assert(signature);
+    assert(binding && !*binding);
+    signature->CreateShaderResourceBinding(binding, true);
+    if (!*binding)
+        return make_error_code(errc::io_error);
+    return {};
+}
+
+Result<void> RenderDevice::CreateGraphicsPipelineState(const Diligent::GraphicsPipelineStateCreateInfo& createInfo,
+    Diligent::IPipelineState** pipelineState) noexcept
+{
+    assert(createInfo.ResourceSignaturesCount == 0 || createInfo.ppResourceSignatures[0]);
+    assert(createInfo.pVS && createInfo.pPS);
+    assert(pipelineState && !*pipelineState);
+    m_pRenderDevice->CreateGraphicsPipelineState(createInfo, pipelineState);
+    if (!*pipelineState)
+        return make_error_code(errc::io_error);
+    return {};
+}
+
+void RenderDevice::SetStaticVariable(Diligent::IPipelineResourceSignature* signature, const GraphDef::ShaderDefinition& shader,
+    const char* name, Diligent::IDeviceObject* object) noexcept
+{
+    assert(signature);
+    auto variable = signature->GetStaticVariableByName(ToShaderType(shader), name);
+    assert(variable);
+    variable->Set(object);
+}
+
+Diligent::IShaderResourceVariable* RenderDevice::GetVariable(Diligent::IShaderResourceBinding* binding,
+    const GraphDef::ShaderDefinition& shader, const char* name) noexcept
+{
+    assert(binding);
+    auto variable = binding->GetVariableByName(ToShaderType(shader), name);
+    assert(variable);
+    return variable;
+}
+
+void RenderDevice::SetVariable(Diligent::IShaderResourceVariable* variable, Diligent::IDeviceObject* object) noexcept
+{
+    assert(variable);
+    variable->Set(object);
+}
+
+Result<Diligent::ITextureView*> RenderDevice::GetTextureView(Diligent::ITexture* texture, TextureViewTypes type) noexcept
+{
+    assert(texture);
+    Diligent::TEXTURE_VIEW_TYPE viewType = Diligent::TEXTURE_VIEW_SHADER_RESOURCE;
+    switch (type)
+    {
+        case TextureViewTypes::ShaderResource:
+            viewType = Diligent::TEXTURE_VIEW_SHADER_RESOURCE;
+            break;
+        case TextureViewTypes::RenderTarget:
+            viewType = Diligent::TEXTURE_VIEW_RENDER_TARGET;
+            break;
+        case TextureViewTypes::DepthStencil:
+            viewType = Diligent::TEXTURE_VIEW_DEPTH_STENCIL;
+            break;
+        default:
+            assert(false);
+            break;
+    }
+
+    auto view = texture->GetDefaultView(viewType);
+    if (!view)
+        return make_error_code(errc::io_error);
+    return view;
+}
+
+// </editor-fold>
+// <editor-fold desc="命令">
+
+void RenderDevice::SetRenderTargets(Diligent::ITextureView* renderTarget, Diligent::ITextureView* depthStencil) noexcept
+{
+    m_pRenderContext->SetRenderTargets(1, &renderTarget, depthStencil, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::ResetRenderTargets() noexcept
+{
+    m_pRenderContext->SetRenderTargets(0, nullptr, nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_NONE);
+}
+
+void RenderDevice::SetViewport(const Diligent::Viewport& viewport) noexcept
+{
+    m_pRenderContext->SetViewports(1, &viewport, 0, 0);
+}
+
+void RenderDevice::SetScissorRect(const Diligent::Rect& rect, uint32_t width, uint32_t height) noexcept
+{
+    m_pRenderContext->SetScissorRects(1, &rect, width, height);
+}
+
+void RenderDevice::ClearRenderTarget(Diligent::ITextureView* view, const float* color) noexcept
+{
+    m_pRenderContext->ClearRenderTarget(view, color, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::ClearDepthStencil(Diligent::ITextureView* view, std::optional<float> depth, std::optional<uint8_t> stencil) noexcept
+{
+    Diligent::CLEAR_DEPTH_STENCIL_FLAGS flag = Diligent::CLEAR_DEPTH_FLAG_NONE;
+    if (depth)
+        flag |= Diligent::CLEAR_DEPTH_FLAG;
+    if (stencil)
+        flag |= Diligent::CLEAR_STENCIL_FLAG;
+    if (flag == Diligent::CLEAR_DEPTH_FLAG_NONE)
+        return;
+    m_pRenderContext->ClearDepthStencil(view, flag, depth ? *depth : 1.f, stencil ? *stencil : 0,
+        Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::UpdateBuffer(Diligent::IBuffer* buffer, size_t offset, Span<const uint8_t> data) noexcept
+{
+    assert(buffer);
+    m_pRenderContext->UpdateBuffer(buffer, offset, data.size(), data.data(), Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+Result<void> RenderDevice::WriteBuffer(Diligent::IBuffer* buffer, Span<const uint8_t> data, bool noOverwrite) noexcept
+{
+    assert(buffer && buffer->GetDesc().Size >= data.size());
+
+    void* dest = nullptr;
+    m_pRenderContext->MapBuffer(buffer, Diligent::MAP_WRITE, noOverwrite ? Diligent::MAP_FLAG_NO_OVERWRITE : Diligent::MAP_FLAG_DISCARD,
+        dest);
+    if (!dest)
+        return make_error_code(errc::io_error);
+    ::memcpy(dest, data.data(), data.size());
+    m_pRenderContext->UnmapBuffer(buffer, Diligent::MAP_WRITE);
+    return {};
+}
+
+void RenderDevice::UpdateTexture(Diligent::ITexture* texture, uint32_t mipLevel, uint32_t slice, const Diligent::Box& box,
+    const Diligent::TextureSubResData& data) noexcept
+{
+    assert(texture);
+    m_pRenderContext->UpdateTexture(texture, mipLevel, slice, box, data, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+        Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::SetVertexBuffers(uint32_t count, Diligent::IBuffer* const* buffers, const uint64_t* offsets) noexcept
+{
+    m_pRenderContext->SetVertexBuffers(0, count, buffers, offsets, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+        Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
+}
+
+void RenderDevice::SetIndexBuffer(Diligent::IBuffer* buffer, uint64_t offset) noexcept
+{
+    m_pRenderContext->SetIndexBuffer(buffer, offset, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::SetPipelineState(Diligent::IPipelineState* pipelineState) noexcept
+{
+    m_pRenderContext->SetPipelineState(pipelineState);
+}
+
+void RenderDevice::CommitShaderResources(Diligent::IShaderResourceBinding* binding) noexcept
+{
+    m_pRenderContext->CommitShaderResources(binding, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+void RenderDevice::DrawIndexed(const Diligent::DrawIndexedAttribs& attribs) noexcept
+{
+    m_pRenderContext->DrawIndexed(attribs);
+}
+
+// </editor-fold>
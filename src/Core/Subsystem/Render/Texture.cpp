@@ -8,7 +8,6 @@
 
 #include <cassert>
 #include <Texture.h>
-#include <DeviceContext.h>
 #include <lstg/Core/Logging.hpp>
 #include <lstg/Core/Subsystem/Render/RenderDevice.hpp>
 #include "detail/Texture2DFormats.hpp"
@@ -19,11 +18,12 @@ using namespace lstg::Subsystem::Render;
 
 LSTG_DEF_LOG_CATEGORY(Texture);
 
-Texture::Texture(RenderDevice& device, Diligent::ITexture* handler)
-    : m_stDevice(device), m_pNativeHandler(handler)
+Texture::Texture(RenderDevice& device, const Diligent::TextureDesc& desc, Diligent::ITexture* handler)
+    : m_stDevice(device), m_pNativeHandler(handler), m_pDesc(make_unique<Diligent::TextureDesc>(desc))
 {
-    assert(handler);
-    m_pNativeHandler->AddRef();
+    m_pDesc->Name = nullptr;  // 不持有名称字符串
+    if (m_pNativeHandler)
+        m_pNativeHandler->AddRef();
 }
 
 Texture::~Texture()
@@ -37,32 +37,28 @@ Texture::~Texture()
 
 uint32_t Texture::GetWidth() const noexcept
 {
-    assert(m_pNativeHandler);
-    return m_pNativeHandler->GetDesc().GetWidth();
+    return GetNativeDesc().GetWidth();
 }
 
 uint32_t Texture::GetHeight() const noexcept
 {
-    assert(m_pNativeHandler);
-    return m_pNativeHandler->GetDesc().GetHeight();
+    return GetNativeDesc().GetHeight();
 }
 
 bool Texture::IsRenderTarget() const noexcept
 {
-    assert(m_pNativeHandler);
-    return (m_pNativeHandler->GetDesc().BindFlags & Diligent::BIND_RENDER_TARGET) == Diligent::BIND_RENDER_TARGET;
+    return (GetNativeDesc().BindFlags & Diligent::BIND_RENDER_TARGET) == Diligent::BIND_RENDER_TARGET;
 }
 
 bool Texture::IsDepthStencil() const noexcept
 {
-    assert(m_pNativeHandler);
-    return (m_pNativeHandler->GetDesc().BindFlags & Diligent::BIND_DEPTH_STENCIL) == Diligent::BIND_DEPTH_STENCIL;
+    return (GetNativeDesc().BindFlags & Diligent::BIND_DEPTH_STENCIL) == Diligent::BIND_DEPTH_STENCIL;
 }
 
 Result<void> Texture::Commit(Math::ImageRectangle range, Span<const uint8_t> data, size_t stride, size_t mipmapLevel,
     size_t arrayIndex) noexcept
 {
-    const auto& desc = m_pNativeHandler->GetDesc();
+    const auto& desc = GetNativeDesc();
 
     // 检查是否允许进行操作
     if (desc.Usage == Diligent::USAGE_IMMUTABLE)
@@ -120,7 +116,12 @@ Result<void> Texture::Commit(Math::ImageRectangle range, Span<const uint8_t> dat
     Diligent::TextureSubResData subResData;
     subResData.pData = data.GetData();
     subResData.Stride = stride;
-    m_stDevice.GetImmediateContext()->UpdateTexture(m_pNativeHandler, mipmapLevel, arrayIndex, updateRange, subResData,
-        Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    m_stDevice.UpdateTexture(m_pNativeHandler, mipmapLevel, arrayIndex, updateRange, subResData);
     return {};
 }
+
+const Diligent::TextureDesc& Texture::GetNativeDesc() const noexcept
+{
+    assert(m_pDesc);
+    return *m_pDesc;
+}
@@ -6,8 +6,7 @@
 */
 #include "ClearHelper.hpp"
 
-#include <MapHelper.hpp>
-#include <RenderDevice.h>
+#include <Shader.h>
 #include <SwapChain.h>
 
 using namespace std;
@@ -59,8 +58,7 @@ static const char* kViewportClearPixelShaderHLSL = R"(
 ClearHelper::ClearHelper(RenderDevice* device)
     : m_pDevice(device)
 {
-    auto renderDevice = m_pDevice->GetDevice();
-    auto swapChain = m_pDevice->GetSwapChain();
+    const auto& swapChainDesc = m_pDevice->GetSwapChainDesc();
 
     // 创建 Shader
     RefCntAutoPtr<IShader> vertexShader;
@@ -71,8 +69,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         shaderCreateInfo.Desc.ShaderType = SHADER_TYPE_VERTEX;
         shaderCreateInfo.Desc.Name = "Viewport Clear VS";
         shaderCreateInfo.Source = kViewportClearVertexShaderHLSL;
-        renderDevice->CreateShader(shaderCreateInfo, &vertexShader);
-        if (!vertexShader)
+        if (!m_pDevice->CreateShader(shaderCreateInfo, &vertexShader))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create vertex shader fail");
     }
 
@@ -84,8 +81,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         shaderCreateInfo.Desc.ShaderType = SHADER_TYPE_PIXEL;
         shaderCreateInfo.Desc.Name = "Viewport Clear PS";
         shaderCreateInfo.Source = kViewportClearPixelShaderHLSL;
-        renderDevice->CreateShader(shaderCreateInfo, &pixelShader);
-        if (!pixelShader)
+        if (!m_pDevice->CreateShader(shaderCreateInfo, &pixelShader))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create pixel shader fail");
     }
 
@@ -97,8 +93,8 @@ ClearHelper::ClearHelper(RenderDevice* device)
         // 光栅化参数
         auto& graphicsPipeline = pipelineCreateInfo.GraphicsPipeline;
         graphicsPipeline.NumRenderTargets = 1;
-        graphicsPipeline.RTVFormats[0] = swapChain->GetDesc().ColorBufferFormat;
-        graphicsPipeline.DSVFormat = swapChain->GetDesc().DepthBufferFormat;
+        graphicsPipeline.RTVFormats[0] = swapChainDesc.ColorBufferFormat;
+        graphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
         graphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         graphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
         graphicsPipeline.RasterizerDesc.ScissorEnable = true;
@@ -122,8 +118,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         pipelineCreateInfo.pVS = vertexShader;
         pipelineCreateInfo.pPS = pixelShader;
 
-        renderDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pColorDepthClearPSO);
-        if (!m_pColorDepthClearPSO)
+        if (!m_pDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pColorDepthClearPSO))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create pipeline state fail");
     }
     {
@@ -133,8 +128,8 @@ ClearHelper::ClearHelper(RenderDevice* device)
         // 光栅化参数
         auto& graphicsPipeline = pipelineCreateInfo.GraphicsPipeline;
         graphicsPipeline.NumRenderTargets = 1;
-        graphicsPipeline.RTVFormats[0] = swapChain->GetDesc().ColorBufferFormat;
-        graphicsPipeline.DSVFormat = swapChain->GetDesc().DepthBufferFormat;
+        graphicsPipeline.RTVFormats[0] = swapChainDesc.ColorBufferFormat;
+        graphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
         graphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         graphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
         graphicsPipeline.RasterizerDesc.ScissorEnable = true;
@@ -158,8 +153,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         pipelineCreateInfo.pVS = vertexShader;
         pipelineCreateInfo.pPS = pixelShader;
 
-        renderDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pColorOnlyClearPSO);
-        if (!m_pColorOnlyClearPSO)
+        if (!m_pDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pColorOnlyClearPSO))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create pipeline state fail");
     }
     {
@@ -169,8 +163,8 @@ ClearHelper::ClearHelper(RenderDevice* device)
         // 光栅化参数
         auto& graphicsPipeline = pipelineCreateInfo.GraphicsPipeline;
         graphicsPipeline.NumRenderTargets = 1;
-        graphicsPipeline.RTVFormats[0] = swapChain->GetDesc().ColorBufferFormat;
-        graphicsPipeline.DSVFormat = swapChain->GetDesc().DepthBufferFormat;
+        graphicsPipeline.RTVFormats[0] = swapChainDesc.ColorBufferFormat;
+        graphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
         graphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
         graphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
         graphicsPipeline.RasterizerDesc.ScissorEnable = true;
@@ -194,8 +188,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         pipelineCreateInfo.pVS = vertexShader;
         pipelineCreateInfo.pPS = pixelShader;
 
-        renderDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pDepthOnlyClearPSO);
-        if (!m_pDepthOnlyClearPSO)
+        if (!m_pDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &m_pDepthOnlyClearPSO))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create pipeline state fail");
     }
 
@@ -207,8 +200,7 @@ ClearHelper::ClearHelper(RenderDevice* device)
         vertexBufferDesc.Size = 4 * sizeof(QuadVert);
         vertexBufferDesc.Usage = USAGE_DYNAMIC;
         vertexBufferDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        renderDevice->CreateBuffer(vertexBufferDesc, nullptr, &m_pVertexBuffer);
-        if (!m_pVertexBuffer)
+        if (!m_pDevice->CreateBuffer(vertexBufferDesc, nullptr, &m_pVertexBuffer))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create VB fail");
     }
     {
@@ -228,20 +220,16 @@ ClearHelper::ClearHelper(RenderDevice* device)
         data.pData = kFixedIndex;
         data.DataSize = sizeof(kFixedIndex);
         data.pContext = m_pDevice->GetImmediateContext();
-        renderDevice->CreateBuffer(indexBufferDesc, &data, &m_pIndexBuffer);
-        if (!m_pIndexBuffer)
+        if (!m_pDevice->CreateBuffer(indexBufferDesc, &data, &m_pIndexBuffer))
             LSTG_THROW(ClearHelperInitializeFailedException, "Create IB fail");
     }
 }
 
 void ClearHelper::ClearColor(ColorRGBA32 color) noexcept
 {
-    auto renderContext = m_pDevice->GetImmediateContext();
-
     // 准备顶点
     {
-        MapHelper<QuadVert> vertices(renderContext, m_pVertexBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
-        QuadVert* vertexDest = vertices;
+        QuadVert vertexDest[4];
         vertexDest[0].x = -1.f; vertexDest[0].y = -1.f; vertexDest[0].z = 0.5f;
         vertexDest[1].x = 1.f; vertexDest[1].y = -1.f; vertexDest[1].z = 0.5f;
         vertexDest[2].x = -1.f; vertexDest[2].y = 1.f; vertexDest[2].z = 0.5f;
@@ -253,25 +241,24 @@ void ClearHelper::ClearColor(ColorRGBA32 color) noexcept
             vertexDest[i].rgba[2] = color.b();
             vertexDest[i].rgba[3] = color.a();
         }
+        if (!m_pDevice->WriteBuffer(m_pVertexBuffer, { reinterpret_cast<const uint8_t*>(vertexDest), sizeof(vertexDest) }, false))
+            return;
     }
 
     // 设置 Shader 和 Buffer
     IBuffer* vertexBuffers[] = { m_pVertexBuffer };
-    renderContext->SetVertexBuffers(0, 1, vertexBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-    renderContext->SetIndexBuffer(m_pIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    renderContext->SetPipelineState(m_pColorOnlyClearPSO);
+    m_pDevice->SetVertexBuffers(1, vertexBuffers, nullptr);
+    m_pDevice->SetIndexBuffer(m_pIndexBuffer, 0);
+    m_pDevice->SetPipelineState(m_pColorOnlyClearPSO);
     DrawIndexedAttribs drawAttrs { 6, VT_UINT16, DRAW_FLAG_VERIFY_STATES };
-    renderContext->DrawIndexed(drawAttrs);
+    m_pDevice->DrawIndexed(drawAttrs);
 }
 
 void ClearHelper::ClearDepth(float depth) noexcept
 {
-    auto renderContext = m_pDevice->GetImmediateContext();
-
     // 准备顶点
     {
-        MapHelper<QuadVert> vertices(renderContext, m_pVertexBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
-        QuadVert* vertexDest = vertices;
+        QuadVert vertexDest[4];
         vertexDest[0].x = -1.f; vertexDest[0].y = -1.f; vertexDest[0].z = depth;
         vertexDest[1].x = 1.f; vertexDest[1].y = -1.f; vertexDest[1].z = depth;
         vertexDest[2].x = -1.f; vertexDest[2].y = 1.f; vertexDest[2].z = depth;
@@ -283,25 +270,24 @@ void ClearHelper::ClearDepth(float depth) noexcept
             vertexDest[i].rgba[2] = 0;
             vertexDest[i].rgba[3] = 0;
         }
+        if (!m_pDevice->WriteBuffer(m_pVertexBuffer, { reinterpret_cast<const uint8_t*>(vertexDest), sizeof(vertexDest) }, false))
+            return;
     }
 
     // 设置 Shader 和 Buffer
     IBuffer* vertexBuffers[] = { m_pVertexBuffer };
-    renderContext->SetVertexBuffers(0, 1, vertexBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-    renderContext->SetIndexBuffer(m_pIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    renderContext->SetPipelineState(m_pColorOnlyClearPSO);
+    m_pDevice->SetVertexBuffers(1, vertexBuffers, nullptr);
+    m_pDevice->SetIndexBuffer(m_pIndexBuffer, 0);
+    m_pDevice->SetPipelineState(m_pColorOnlyClearPSO);
     DrawIndexedAttribs drawAttrs { 6, VT_UINT16, DRAW_FLAG_VERIFY_STATES };
-    renderContext->DrawIndexed(drawAttrs);
+    m_pDevice->DrawIndexed(drawAttrs);
 }
 
 void ClearHelper::ClearDepthColor(ColorRGBA32 color, float depth) noexcept
 {
-    auto renderContext = m_pDevice->GetImmediateContext();
-
     // 准备顶点
     {
-        MapHelper<QuadVert> vertices(renderContext, m_pVertexBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
-        QuadVert* vertexDest = vertices;
+        QuadVert vertexDest[4];
         vertexDest[0].x = -1.f; vertexDest[0].y = -1.f; vertexDest[0].z = depth;
         vertexDest[1].x = 1.f; vertexDest[1].y = -1.f; vertexDest[1].z = depth;
         vertexDest[2].x = -1.f; vertexDest[2].y = 1.f; vertexDest[2].z = depth;
@@ -313,13 +299,15 @@ void ClearHelper::ClearDepthColor(ColorRGBA32 color, float depth) noexcept
             vertexDest[i].rgba[2] = color.b();
             vertexDest[i].rgba[3] = color.a();
         }
+        if (!m_pDevice->WriteBuffer(m_pVertexBuffer, { reinterpret_cast<const uint8_t*>(vertexDest), sizeof(vertexDest) }, false))
+            return;
     }
 
     // 设置 Shader 和 Buffer
     IBuffer* vertexBuffers[] = { m_pVertexBuffer };
-    renderContext->SetVertexBuffers(0, 1, vertexBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-    renderContext->SetIndexBuffer(m_pIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    renderContext->SetPipelineState(m_pColorDepthClearPSO);
+    m_pDevice->SetVertexBuffers(1, vertexBuffers, nullptr);
+    m_pDevice->SetIndexBuffer(m_pIndexBuffer, 0);
+    m_pDevice->SetPipelineState(m_pColorDepthClearPSO);
     DrawIndexedAttribs drawAttrs { 6, VT_UINT16, DRAW_FLAG_VERIFY_STATES };
-    renderContext->DrawIndexed(drawAttrs);
+    m_pDevice->DrawIndexed(drawAttrs);
 }
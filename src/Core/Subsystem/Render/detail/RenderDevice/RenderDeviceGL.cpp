@@ -106,4 +106,12 @@ void RenderDeviceGL::Present() noexcept
 #endif
 }
 
+size_t RenderDeviceGL::GetDynamicMeshBufferCount() const noexcept
+{
+    // OpenGL 下 Discard 映射依赖驱动对缓冲区进行孤立（orphaning），部分驱动会等待 GPU 使用完毕，因此自行轮换多组缓冲区，
+    // 并以 NoOverwrite 方式写入已由 Fence 确认空闲的缓冲区组。
+    // D3D11 由驱动完成重命名，D3D12/Vulkan 的动态缓冲区本身就从按帧回收的环形堆上分配，不需要轮换。
+    return 3;
+}
+
 #endif
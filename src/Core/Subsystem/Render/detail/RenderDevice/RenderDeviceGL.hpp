@@ -30,6 +30,7 @@ namespace lstg::Subsystem::Render::detail::RenderDevice
         bool IsVerticalSyncEnabled() const noexcept override;
         void SetVerticalSyncEnabled(bool enable) noexcept override;
         void Present() noexcept override;
+        size_t GetDynamicMeshBufferCount() const noexcept override;
 
     private:
 #ifdef LSTG_PLATFORM_MACOS
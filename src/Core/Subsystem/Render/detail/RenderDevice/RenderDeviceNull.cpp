@@ -0,0 +1,210 @@
+/**
+ * @file
+ * @date 2022/9/18
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "RenderDeviceNull.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <SwapChain.h>
+#include <DeviceContext.h>
+#include <lstg/Core/Subsystem/Render/Texture.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::Render::detail::RenderDevice;
+
+RenderDeviceNull::RenderDeviceNull(WindowSystem* window)
+{
+    assert(window);
+    auto renderSize = window->GetRenderSize();
+
+    m_pSwapChainDesc = make_unique<Diligent::SwapChainDesc>();
+    m_pSwapChainDesc->Width = static_cast<uint32_t>(std::max(0, std::get<0>(renderSize)));
+    m_pSwapChainDesc->Height = static_cast<uint32_t>(std::max(0, std::get<1>(renderSize)));
+    m_pSwapChainDesc->ColorBufferFormat = Diligent::TEX_FORMAT_RGBA8_UNORM_SRGB;
+    m_pSwapChainDesc->DepthBufferFormat = Diligent::TEX_FORMAT_D32_FLOAT;
+}
+
+RenderDeviceNull::~RenderDeviceNull() noexcept = default;
+
+void RenderDeviceNull::Present() noexcept
+{
+    ++m_uPresentedCount;
+}
+
+// <editor-fold desc="交换链">
+
+const Diligent::SwapChainDesc& RenderDeviceNull::GetSwapChainDesc() const noexcept
+{
+    return *m_pSwapChainDesc;
+}
+
+void RenderDeviceNull::ResizeSwapChain(uint32_t width, uint32_t height) noexcept
+{
+    m_pSwapChainDesc->Width = width;
+    m_pSwapChainDesc->Height = height;
+}
+
+Diligent::ITextureView* RenderDeviceNull::GetBackBufferRenderTargetView() noexcept
+{
+    return nullptr;
+}
+
+Diligent::ITextureView* RenderDeviceNull::GetBackBufferDepthStencilView() noexcept
+{
+    return nullptr;
+}
+
+// </editor-fold>
+// <editor-fold desc="资源">
+
+Result<void> RenderDeviceNull::CreateBuffer(const Diligent::BufferDesc& desc, const Diligent::BufferData* data,
+    Diligent::IBuffer** buffer) noexcept
+{
+    assert(buffer && !*buffer);
+    return {};
+}
+
+Result<std::shared_ptr<Render::Texture>> RenderDeviceNull::CreateTexture(const Diligent::TextureDesc& desc,
+    const Diligent::TextureData* data) noexcept
+{
+    try
+    {
+        return make_shared<Render::Texture>(*this, desc, nullptr);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+Result<void> RenderDeviceNull::CreateFence(const Diligent::FenceDesc& desc, Diligent::IFence** fence) noexcept
+{
+    // 不存在 GPU 时间线，GetDynamicMeshBufferCount 总是 1，不应使用 Fence
+    return make_error_code(errc::not_supported);
+}
+
+Result<void> RenderDeviceNull::CreateShader(const Diligent::ShaderCreateInfo& createInfo, Diligent::IShader** shader) noexcept
+{
+    assert(shader && !*shader);
+    return {};
+}
+
+Result<void> RenderDeviceNull::CreatePipelineResourceSignature(const Diligent::PipelineResourceSignatureDesc& desc,
+    Diligent::IPipelineResourceSignature** signature) noexcept
+{
+    assert(signature && !*signature);
+    return {};
+}
+
+Result<void> RenderDeviceNull::CreateShaderResourceBinding(Diligent::IPipelineResourceSignature* signature,
+    Diligent::IShaderResourceBinding** binding) noexcept
+{
+    assert(binding && !*binding);
+    return {};
+}
+
+Result<void> RenderDeviceNull::CreateGraphicsPipelineState(const Diligent::GraphicsPipelineStateCreateInfo& createInfo,
+    Diligent::IPipelineState** pipelineState) noexcept
+{
+    assert(pipelineState && !*pipelineState);
+    ++m_stStatistics.PipelineStates;
+    return {};
+}
+
+void RenderDeviceNull::SetStaticVariable(Diligent::IPipelineResourceSignature* signature, const GraphDef::ShaderDefinition& shader,
+    const char* name, Diligent::IDeviceObject* object) noexcept
+{
+}
+
+Diligent::IShaderResourceVariable* RenderDeviceNull::GetVariable(Diligent::IShaderResourceBinding* binding,
+    const GraphDef::ShaderDefinition& shader, const char* name) noexcept
+{
+    return nullptr;
+}
+
+void RenderDeviceNull::SetVariable(Diligent::IShaderResourceVariable* variable, Diligent::IDeviceObject* object) noexcept
+{
+}
+
+Result<Diligent::ITextureView*> RenderDeviceNull::GetTextureView(Diligent::ITexture* texture, TextureViewTypes type) noexcept
+{
+    return static_cast<Diligent::ITextureView*>(nullptr);
+}
+
+// </editor-fold>
+// <editor-fold desc="命令">
+
+void RenderDeviceNull::SetRenderTargets(Diligent::ITextureView* renderTarget, Diligent::ITextureView* depthStencil) noexcept
+{
+}
+
+void RenderDeviceNull::ResetRenderTargets() noexcept
+{
+}
+
+void RenderDeviceNull::SetViewport(const Diligent::Viewport& viewport) noexcept
+{
+}
+
+void RenderDeviceNull::SetScissorRect(const Diligent::Rect& rect, uint32_t width, uint32_t height) noexcept
+{
+}
+
+void RenderDeviceNull::ClearRenderTarget(Diligent::ITextureView* view, const float* color) noexcept
+{
+    ++m_stStatistics.Clears;
+}
+
+void RenderDeviceNull::ClearDepthStencil(Diligent::ITextureView* view, std::optional<float> depth, std::optional<uint8_t> stencil) noexcept
+{
+    if (depth || stencil)
+        ++m_stStatistics.Clears;
+}
+
+void RenderDeviceNull::UpdateBuffer(Diligent::IBuffer* buffer, size_t offset, Span<const uint8_t> data) noexcept
+{
+    ++m_stStatistics.BufferWrites;
+    m_stStatistics.BufferWriteBytes += data.size();
+}
+
+Result<void> RenderDeviceNull::WriteBuffer(Diligent::IBuffer* buffer, Span<const uint8_t> data, bool noOverwrite) noexcept
+{
+    ++m_stStatistics.BufferWrites;
+    m_stStatistics.BufferWriteBytes += data.size();
+    return {};
+}
+
+void RenderDeviceNull::UpdateTexture(Diligent::ITexture* texture, uint32_t mipLevel, uint32_t slice, const Diligent::Box& box,
+    const Diligent::TextureSubResData& data) noexcept
+{
+}
+
+void RenderDeviceNull::SetVertexBuffers(uint32_t count, Diligent::IBuffer* const* buffers, const uint64_t* offsets) noexcept
+{
+}
+
+void RenderDeviceNull::SetIndexBuffer(Diligent::IBuffer* buffer, uint64_t offset) noexcept
+{
+}
+
+void RenderDeviceNull::SetPipelineState(Diligent::IPipelineState* pipelineState) noexcept
+{
+}
+
+void RenderDeviceNull::CommitShaderResources(Diligent::IShaderResourceBinding* binding) noexcept
+{
+}
+
+void RenderDeviceNull::DrawIndexed(const Diligent::DrawIndexedAttribs& attribs) noexcept
+{
+    ++m_stStatistics.DrawCalls;
+    m_stStatistics.DrawIndices += static_cast<uint64_t>(attribs.NumIndices) * attribs.NumInstances;
+    if (attribs.NumInstances > 1)
+        m_stStatistics.DrawInstances += attribs.NumInstances;
+}
+
+// </editor-fold>
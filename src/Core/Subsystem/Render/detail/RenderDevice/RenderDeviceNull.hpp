@@ -0,0 +1,89 @@
+/**
+ * @file
+ * @date 2022/9/18
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <lstg/Core/Subsystem/WindowSystem.hpp>
+#include <lstg/Core/Subsystem/Render/RenderDevice.hpp>
+
+namespace lstg::Subsystem::Render::detail::RenderDevice
+{
+    /**
+     * 无头渲染设备
+     * 不持有任何 DiligentEngine 对象，渲染画面大小跟随窗口。用于在没有 GPU 的环境中运行完整的帧循环。
+     * 资源创建成功返回空的原生对象，命令不做任何事，只进行计数。
+     */
+    class RenderDeviceNull :
+        public Render::RenderDevice
+    {
+    public:
+        /**
+         * 统计数据
+         */
+        struct Statistics
+        {
+            uint64_t PipelineStates = 0;  ///< @brief 创建的 PSO 个数
+            uint64_t BufferWrites = 0;  ///< @brief 缓冲区写入次数
+            uint64_t BufferWriteBytes = 0;  ///< @brief 缓冲区写入的字节数
+            uint64_t Clears = 0;  ///< @brief 清屏次数，颜色和深度分别计数
+            uint64_t DrawCalls = 0;  ///< @brief 绘制调用次数，每个 Pass 计一次
+            uint64_t DrawIndices = 0;  ///< @brief 绘制的索引个数，实例化绘制时乘以实例个数
+            uint64_t DrawInstances = 0;  ///< @brief 实例化绘制的实例个数
+        };
+
+    public:
+        RenderDeviceNull(WindowSystem* window);
+        ~RenderDeviceNull() noexcept override;
+
+    public:
+        /**
+         * 获取统计数据
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept { return m_stStatistics; }
+
+    protected:  // RenderDevice
+        void Present() noexcept override;
+        const Diligent::SwapChainDesc& GetSwapChainDesc() const noexcept override;
+        void ResizeSwapChain(uint32_t width, uint32_t height) noexcept override;
+        Diligent::ITextureView* GetBackBufferRenderTargetView() noexcept override;
+        Diligent::ITextureView* GetBackBufferDepthStencilView() noexcept override;
+        Result<void> CreateBuffer(const Diligent::BufferDesc& desc, const Diligent::BufferData* data,
+            Diligent::IBuffer** buffer) noexcept override;
+        Result<std::shared_ptr<Texture>> CreateTexture(const Diligent::TextureDesc& desc, const Diligent::TextureData* data) noexcept override;
+        Result<void> CreateFence(const Diligent::FenceDesc& desc, Diligent::IFence** fence) noexcept override;
+        Result<void> CreateShader(const Diligent::ShaderCreateInfo& createInfo, Diligent::IShader** shader) noexcept override;
+        Result<void> CreatePipelineResourceSignature(const Diligent::PipelineResourceSignatureDesc& desc,
+            Diligent::IPipelineResourceSignature** signature) noexcept override;
+        Result<void> CreateShaderResourceBinding(Diligent::IPipelineResourceSignature* signature,
+            Diligent::IShaderResourceBinding** binding) noexcept override;
+        Result<void> CreateGraphicsPipelineState(const Diligent::GraphicsPipelineStateCreateInfo& createInfo,
+            Diligent::IPipelineState** pipelineState) noexcept override;
+        void SetStaticVariable(Diligent::IPipelineResourceSignature* signature, const GraphDef::ShaderDefinition& shader,
+            const char* name, Diligent::IDeviceObject* object) noexcept override;
+        Diligent::IShaderResourceVariable* GetVariable(Diligent::IShaderResourceBinding* binding, const GraphDef::ShaderDefinition& shader,
+            const char* name) noexcept override;
+        void SetVariable(Diligent::IShaderResourceVariable* variable, Diligent::IDeviceObject* object) noexcept override;
+        Result<Diligent::ITextureView*> GetTextureView(Diligent::ITexture* texture, TextureViewTypes type) noexcept override;
+        void SetRenderTargets(Diligent::ITextureView* renderTarget, Diligent::ITextureView* depthStencil) noexcept override;
+        void ResetRenderTargets() noexcept override;
+        void SetViewport(const Diligent::Viewport& viewport) noexcept override;
+        void SetScissorRect(const Diligent::Rect& rect, uint32_t width, uint32_t height) noexcept override;
+        void ClearRenderTarget(Diligent::ITextureView* view, const float* color) noexcept override;
+        void ClearDepthStencil(Diligent::ITextureView* view, std::optional<float> depth, std::optional<uint8_t> stencil) noexcept override;
+        void UpdateBuffer(Diligent::IBuffer* buffer, size_t offset, Span<const uint8_t> data) noexcept override;
+        Result<void> WriteBuffer(Diligent::IBuffer* buffer, Span<const uint8_t> data, bool noOverwrite) noexcept override;
+        void UpdateTexture(Diligent::ITexture* texture, uint32_t mipLevel, uint32_t slice, const Diligent::Box& box,
+            const Diligent::TextureSubResData& data) noexcept override;
+        void SetVertexBuffers(uint32_t count, Diligent::IBuffer* const* buffers, const uint64_t* offsets) noexcept override;
+        void SetIndexBuffer(Diligent::IBuffer* buffer, uint64_t offset) noexcept override;
+        void SetPipelineState(Diligent::IPipelineState* pipelineState) noexcept override;
+        void CommitShaderResources(Diligent::IShaderResourceBinding* binding) noexcept override;
+        void DrawIndexed(const Diligent::DrawIndexedAttribs& attribs) noexcept override;
+
+    private:
+        std::unique_ptr<Diligent::SwapChainDesc> m_pSwapChainDesc;
+        Statistics m_stStatistics;
+    };
+}
@@ -24,9 +24,9 @@ ScreenCaptureHelper::ScreenCaptureHelper(RenderDevice* device)
 {
     FenceDesc desc;
     desc.Name = "Screen capture fence";
-    m_pDevice->GetDevice()->CreateFence(desc, &m_pFence);
-    if (!m_pFence)
-        LSTG_THROW(ScreenCaptureHelperInitializeFailedException, "Create fence fail");
+    auto ret = m_pDevice->CreateFence(desc, &m_pFence);
+    if (!ret)
+        LSTG_THROW(ScreenCaptureHelperInitializeFailedException, "Create fence fail: {}", ret.GetError());
 }
 
 Result<void> ScreenCaptureHelper::AddCaptureTask(ScreenCaptureCallback callback, bool clearAlpha) noexcept
@@ -6,6 +6,8 @@
  */
 #include "Texture2DDataImpl.hpp"
 
+#include <limits>
+#include <optional>
 #include <stb_image.h>
 #include <GraphicsAccessories.hpp>
 #include <GraphicsUtilities.h>
@@ -52,6 +54,23 @@ namespace
         return *ret;
     }
 
+    /**
+     * 获取流从当前位置开始的内存视图
+     * 当流的数据常驻内存时，可以直接交由 stb_image 解码，不必经过回调复制
+     */
+    std::optional<Span<const uint8_t>> GetRemainingMemoryView(Subsystem::VFS::IStream* stream) noexcept
+    {
+        auto view = stream->GetMemoryView();
+        if (!view)
+            return {};
+        auto position = stream->GetPosition();
+        if (!position || *position > view->GetSize())
+            return {};
+        if (view->GetSize() - *position > static_cast<size_t>(numeric_limits<int>::max()))
+            return {};
+        return view->Slice(static_cast<size_t>(*position), view->GetSize());
+    }
+
     struct StbImageMemoryDeleter
     {
         template <typename T>
@@ -77,7 +96,15 @@ Result<void> Texture2DDataImpl::ReadImageInfoFromStream(uint32_t& width, uint32_
         StbImageIsEofStreamBridge,
     };
     int x, y, channels;
-    auto ret = ::stbi_info_from_callbacks(&callbacks, seekableStream->get(), &x, &y, &channels);
+    int ret = 0;
+    if (auto view = GetRemainingMemoryView(seekableStream->get()))
+    {
+        ret = ::stbi_info_from_memory(view->GetData(), static_cast<int>(view->GetSize()), &x, &y, &channels);
+    }
+    else
+    {
+        ret = ::stbi_info_from_callbacks(&callbacks, seekableStream->get(), &x, &y, &channels);
+    }
     if (ret != 1)
     {
         LSTG_LOG_ERROR_CAT(Texture2DDataImpl, "stbi_load_from_callbacks fail: {}", ::stbi_failure_reason());
@@ -102,7 +129,10 @@ Texture2DDataImpl::Texture2DDataImpl(VFS::StreamPtr stream, bool convertToRGBA32
         StbImageSkipStreamBridge,
         StbImageIsEofStreamBridge,
     };
-    data.reset(::stbi_load_from_callbacks(&callbacks, seekableStream->get(), &x, &y, &channels, 0));
+    if (auto view = GetRemainingMemoryView(seekableStream->get()))
+        data.reset(::stbi_load_from_memory(view->GetData(), static_cast<int>(view->GetSize()), &x, &y, &channels, 0));
+    else
+        data.reset(::stbi_load_from_callbacks(&callbacks, seekableStream->get(), &x, &y, &channels, 0));
     if (!data)
     {
         LSTG_LOG_ERROR_CAT(Texture2DDataImpl, "stbi_load_from_callbacks fail: {}", ::stbi_failure_reason());
@@ -22,6 +22,7 @@
 #include "Render/detail/RenderDevice/RenderDeviceVulkan.hpp"
 #include "Render/detail/RenderDevice/RenderDeviceD3D11.hpp"
 #include "Render/detail/RenderDevice/RenderDeviceD3D12.hpp"
+#include "Render/detail/RenderDevice/RenderDeviceNull.hpp"
 
 using namespace std;
 using namespace lstg;
@@ -109,6 +110,15 @@ namespace
 
         // 优先使用命令行选择的渲染器
         auto cmdGraphics = AppBase::GetCmdline().GetOption<string_view>("graphics", "");
+
+        // 无头设备只能显式选择，不参与回退
+        if (cmdGraphics == "null")
+        {
+            out.emplace_back("null", [](WindowSystem* windowSystem) -> Render::RenderDevicePtr {
+                return make_shared<Render::detail::RenderDevice::RenderDeviceNull>(windowSystem);
+            });
+        }
+
         if (!cmdGraphics.empty())
         {
             std::stable_sort(out.begin(), out.end(), [&](const auto& left, const auto& right) {
@@ -260,9 +270,6 @@ RenderSystem::RenderSystem(SubsystemContainer& container)
         m_pGammaCorrectHelper = make_shared<Render::detail::GammaCorrectHelper>(m_pRenderDevice.get());
     }
 #endif
-
-    // 创建截图工具
-    m_pScreenCaptureHelper = make_shared<Render::detail::ScreenCaptureHelper>(m_pRenderDevice.get());
 }
 
 // <editor-fold desc="资源分配">
@@ -286,9 +293,9 @@ Result<Render::MeshPtr> RenderSystem::CreateDynamicMesh(const Render::GraphDef::
             vertexBufferDesc.Size = def.GetVertexStride();
             vertexBufferDesc.Usage = Diligent::USAGE_DYNAMIC;
             vertexBufferDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
-            m_pRenderDevice->GetDevice()->CreateBuffer(vertexBufferDesc, nullptr, &vertexBuffer);
-            if (!vertexBuffer)
-                return make_error_code(errc::not_enough_memory);
+            auto ret = m_pRenderDevice->CreateBuffer(vertexBufferDesc, nullptr, &vertexBuffer);
+            if (!ret)
+                return ret.GetError();
         }
 
         // 创建 IndexBuffer
@@ -299,14 +306,16 @@ Result<Render::MeshPtr> RenderSystem::CreateDynamicMesh(const Render::GraphDef::
             indexBufferDesc.Size = use32BitIndex ? sizeof(uint32_t) : sizeof(uint16_t);
             indexBufferDesc.Usage = Diligent::USAGE_DYNAMIC;
             indexBufferDesc.CPUAccessFlags = Diligent::CPU_ACCESS_WRITE;
-            m_pRenderDevice->GetDevice()->CreateBuffer(indexBufferDesc, nullptr, &indexBuffer);
-            if (!indexBuffer)
-                return make_error_code(errc::not_enough_memory);
+            auto ret = m_pRenderDevice->CreateBuffer(indexBufferDesc, nullptr, &indexBuffer);
+            if (!ret)
+                return ret.GetError();
         }
 
         // 创建 Mesh 对象
-        return make_shared<Render::Mesh>(*m_pRenderDevice, sharedDef, vertexBuffer, indexBuffer, use32BitIndex,
-            Render::Mesh::Usage::Dynamic);
+        // 轮换的缓冲区组数由设备决定，见 RenderDevice::GetDynamicMeshBufferCount
+        return make_shared<Render::Mesh>(*m_pRenderDevice, sharedDef, vertexBuffer, def.GetVertexStride(), indexBuffer,
+            use32BitIndex ? sizeof(uint32_t) : sizeof(uint16_t), use32BitIndex, Render::Mesh::Usage::Dynamic,
+            m_pRenderDevice->GetDynamicMeshBufferCount());
     }
     catch (...)  // bad_alloc
     {
@@ -353,11 +362,7 @@ Result<Render::TexturePtr> RenderSystem::CreateTexture2D(const Render::Texture2D
     texData.pContext = m_pRenderDevice->GetImmediateContext();
     texData.NumSubresources = data.m_pImpl->m_stSubResources.size();
     texData.pSubResources = data.m_pImpl->m_stSubResources.data();
-    Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
-    m_pRenderDevice->GetDevice()->CreateTexture(desc, &texData, &texture);
-    if (!texture)
-        return make_error_code(errc::not_enough_memory);
-    return make_shared<Render::Texture>(*m_pRenderDevice, texture);
+    return m_pRenderDevice->CreateTexture(desc, &texData);
 }
 
 Result<Render::TexturePtr> RenderSystem::CreateDynamicTexture2D(uint32_t width, uint32_t height, Render::Texture2DFormats format) noexcept
@@ -388,11 +393,7 @@ Result<Render::TexturePtr> RenderSystem::CreateDynamicTexture2D(uint32_t width,
         texData.NumSubresources = 1;
         texData.pSubResources = &subResData;
 
-        Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
-        m_pRenderDevice->GetDevice()->CreateTexture(desc, &texData, &texture);
-        if (!texture)
-            return make_error_code(errc::not_enough_memory);
-        return make_shared<Render::Texture>(*m_pRenderDevice, texture);
+        return m_pRenderDevice->CreateTexture(desc, &texData);
     }
     catch (...)
     {
@@ -409,18 +410,14 @@ Result<Render::TexturePtr> RenderSystem::CreateRenderTarget(uint32_t width, uint
     desc.MipLevels = 1;
     desc.BindFlags = Diligent::BIND_SHADER_RESOURCE | Diligent::BIND_RENDER_TARGET;
     desc.Usage = Diligent::USAGE_DEFAULT;
-    desc.Format = m_pRenderDevice->GetSwapChain()->GetDesc().ColorBufferFormat;  // 需要和 SwapChain 一致
+    desc.Format = m_pRenderDevice->GetSwapChainDesc().ColorBufferFormat;  // 需要和 SwapChain 一致
     desc.ClearValue.Format = desc.Format;
     desc.ClearValue.Color[0] = 0.f;
     desc.ClearValue.Color[1] = 0.f;
     desc.ClearValue.Color[2] = 0.f;
     desc.ClearValue.Color[3] = 0.f;
 
-    Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
-    m_pRenderDevice->GetDevice()->CreateTexture(desc, nullptr, &texture);
-    if (!texture)
-        return make_error_code(errc::not_enough_memory);
-    return make_shared<Render::Texture>(*m_pRenderDevice, texture);
+    return m_pRenderDevice->CreateTexture(desc, nullptr);
 }
 
 Result<Render::TexturePtr> RenderSystem::CreateDepthStencil(uint32_t width, uint32_t height) noexcept
@@ -432,16 +429,12 @@ Result<Render::TexturePtr> RenderSystem::CreateDepthStencil(uint32_t width, uint
     desc.MipLevels = 1;
     desc.BindFlags = Diligent::BIND_SHADER_RESOURCE | Diligent::BIND_DEPTH_STENCIL;
     desc.Usage = Diligent::USAGE_DEFAULT;
-    desc.Format = m_pRenderDevice->GetSwapChain()->GetDesc().DepthBufferFormat;
+    desc.Format = m_pRenderDevice->GetSwapChainDesc().DepthBufferFormat;
     desc.ClearValue.Format = desc.Format;
     desc.ClearValue.DepthStencil.Depth = 1;
     desc.ClearValue.DepthStencil.Stencil = 0;
 
-    Diligent::RefCntAutoPtr<Diligent::ITexture> texture;
-    m_pRenderDevice->GetDevice()->CreateTexture(desc, nullptr, &texture);
-    if (!texture)
-        return make_error_code(errc::not_enough_memory);
-    return make_shared<Render::Texture>(*m_pRenderDevice, texture);
+    return m_pRenderDevice->CreateTexture(desc, nullptr);
 }
 
 Result<Render::MeshPtr> RenderSystem::CreateStaticMesh(const Render::GraphDef::MeshDefinition& def, Span<const uint8_t> vertexData,
@@ -476,9 +469,9 @@ Result<Render::MeshPtr> RenderSystem::CreateStaticMesh(const Render::GraphDef::M
             vertexDataDesc.DataSize = vertexData.size();
             vertexDataDesc.pContext = m_pRenderDevice->GetImmediateContext();
             vertexDataDesc.pData = vertexData.data();
-            m_pRenderDevice->GetDevice()->CreateBuffer(vertexBufferDesc, &vertexDataDesc, &vertexBuffer);
-            if (!vertexBuffer)
-                return make_error_code(errc::not_enough_memory);
+            auto ret = m_pRenderDevice->CreateBuffer(vertexBufferDesc, &vertexDataDesc, &vertexBuffer);
+            if (!ret)
+                return ret.GetError();
         }
 
         // 创建 IndexBuffer
@@ -493,14 +486,14 @@ Result<Render::MeshPtr> RenderSystem::CreateStaticMesh(const Render::GraphDef::M
             indexDataDesc.DataSize = indexData.size();
             indexDataDesc.pContext = m_pRenderDevice->GetImmediateContext();
             indexDataDesc.pData = indexData.data();
-            m_pRenderDevice->GetDevice()->CreateBuffer(indexBufferDesc, &indexDataDesc, &indexBuffer);
-            if (!indexBuffer)
-                return make_error_code(errc::not_enough_memory);
+            auto ret = m_pRenderDevice->CreateBuffer(indexBufferDesc, &indexDataDesc, &indexBuffer);
+            if (!ret)
+                return ret.GetError();
         }
 
         // 创建 Mesh 对象
-        return make_shared<Render::Mesh>(*m_pRenderDevice, sharedDef, vertexBuffer, indexBuffer, use32BitIndex,
-            Render::Mesh::Usage::Static);
+        return make_shared<Render::Mesh>(*m_pRenderDevice, sharedDef, vertexBuffer, vertexData.size(), indexBuffer, indexData.size(),
+            use32BitIndex, Render::Mesh::Usage::Static);
     }
     catch (...)  // bad_alloc
     {
@@ -513,19 +506,17 @@ Result<Render::MeshPtr> RenderSystem::CreateStaticMesh(const Render::GraphDef::M
 
 Result<void> RenderSystem::BeginFrame() noexcept
 {
-    auto swapChain = m_pRenderDevice->GetSwapChain();
-    auto context = m_pRenderDevice->GetImmediateContext();
-
 #ifdef LSTG_PLATFORM_EMSCRIPTEN
-    auto* renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() : swapChain->GetCurrentBackBufferRTV();
+    auto* renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() :
+        m_pRenderDevice->GetBackBufferRenderTargetView();
 #else
-    auto* renderTargetView = swapChain->GetCurrentBackBufferRTV();
+    auto* renderTargetView = m_pRenderDevice->GetBackBufferRenderTargetView();
 #endif
-    auto* depthStencilView = swapChain->GetDepthBufferDSV();
+    auto* depthStencilView = m_pRenderDevice->GetBackBufferDepthStencilView();
 
     // 在帧开始切换 RT 到 SwapChain 上的 Buffer
     {
-        context->SetRenderTargets(1, &renderTargetView, depthStencilView, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pRenderDevice->SetRenderTargets(renderTargetView, depthStencilView);
         m_stCurrentOutputViews = {};
     }
 
@@ -539,7 +530,7 @@ Result<void> RenderSystem::BeginFrame() noexcept
         vp.Height = static_cast<float>(std::get<1>(sz));
         vp.TopLeftX = 0.f;
         vp.TopLeftY = 0.f;
-        context->SetViewports(1, &vp, 0, 0);
+        m_pRenderDevice->SetViewport(vp);
         m_stCurrentViewport = { 0.f, 0.f, vp.Width, vp.Height };  // 这里必须强制写出大小
     }
 
@@ -551,44 +542,39 @@ Result<void> RenderSystem::BeginFrame() noexcept
             static_cast<int32_t>(std::get<0>(sz)),
             static_cast<int32_t>(std::get<1>(sz)),
         };
-        context->SetScissorRects(1, &scissor, std::get<0>(sz), std::get<1>(sz));
+        m_pRenderDevice->SetScissorRect(scissor, std::get<0>(sz), std::get<1>(sz));
     }
 
     // 清空 RT
     {
         static const float kClearColor[4] = { 0.f, 0.f, 0.f, 0.f };
-        context->ClearRenderTarget(renderTargetView, kClearColor, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-        context->ClearDepthStencil(depthStencilView, Diligent::CLEAR_DEPTH_FLAG /* | Diligent::CLEAR_STENCIL_FLAG */, 1.0f, 0,
-            Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pRenderDevice->ClearRenderTarget(renderTargetView, kClearColor);
+        m_pRenderDevice->ClearDepthStencil(depthStencilView, 1.0f, std::nullopt);
     }
     return {};
 }
 
 void RenderSystem::EndFrame() noexcept
 {
-    auto context = m_pRenderDevice->GetImmediateContext();
-
 #ifdef LSTG_PLATFORM_EMSCRIPTEN
     // 切换到默认 RT，完成 Gamma 校准步骤
     if (m_pGammaCorrectHelper)
     {
-        auto swapChain = m_pRenderDevice->GetSwapChain();
-        auto* renderTargetView = swapChain->GetCurrentBackBufferRTV();
-        auto* depthStencilView = swapChain->GetDepthBufferDSV();
-
-        context->SetRenderTargets(1, &renderTargetView, depthStencilView, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pRenderDevice->SetRenderTargets(m_pRenderDevice->GetBackBufferRenderTargetView(),
+            m_pRenderDevice->GetBackBufferDepthStencilView());
         m_pGammaCorrectHelper->DrawFrameBuffer();
     }
 #endif
 
     // 此时需要撇去 RT，进行后续的截屏动作
     {
-        context->SetRenderTargets(0, nullptr, nullptr, Diligent::RESOURCE_STATE_TRANSITION_MODE_NONE);
+        m_pRenderDevice->ResetRenderTargets();
         m_stCurrentOutputViews = {};
     }
 
     // 执行截屏任务
-    m_pScreenCaptureHelper->ProcessCaptureTasks();
+    if (m_pScreenCaptureHelper)
+        m_pScreenCaptureHelper->ProcessCaptureTasks();
 
     // 执行 Present
     m_pRenderDevice->Present();
@@ -596,6 +582,19 @@ void RenderSystem::EndFrame() noexcept
 
 Result<void> RenderSystem::CaptureScreen(std::function<void(Result<const Render::Texture2DData*>)> callback, bool clearAlpha) noexcept
 {
+    // 截图工具在首次截图时创建，不支持 Fence 的设备上无法截图
+    if (!m_pScreenCaptureHelper)
+    {
+        try
+        {
+            m_pScreenCaptureHelper = make_shared<Render::detail::ScreenCaptureHelper>(m_pRenderDevice.get());
+        }
+        catch (const std::exception& ex)
+        {
+            LSTG_LOG_WARN_CAT(RenderSystem, "Screen capture not available: {}", ex.what());
+            return make_error_code(errc::not_supported);
+        }
+    }
     return m_pScreenCaptureHelper->AddCaptureTask(std::move(callback), clearAlpha);
 }
 
@@ -670,32 +669,36 @@ Result<void> RenderSystem::Clear(std::optional<Render::ColorRGBA32> clearColor,
         return ret.GetError();
     }
 
-    auto context = m_pRenderDevice->GetImmediateContext();
-    auto swapChain = m_pRenderDevice->GetSwapChain();
-
     Diligent::ITextureView* renderTargetView = nullptr;
     Diligent::ITextureView* depthStencilView = nullptr;
     if (m_stCurrentOutputViews.ColorView)
     {
-        renderTargetView = m_stCurrentOutputViews.ColorView->m_pNativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_RENDER_TARGET);
-        assert(renderTargetView);
+        auto view = m_pRenderDevice->GetTextureView(m_stCurrentOutputViews.ColorView->m_pNativeHandler,
+            Render::TextureViewTypes::RenderTarget);
+        if (!view)
+            return view.GetError();
+        renderTargetView = *view;
     }
     else
     {
 #ifdef LSTG_PLATFORM_EMSCRIPTEN
-        renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() : swapChain->GetCurrentBackBufferRTV();
+        renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() :
+            m_pRenderDevice->GetBackBufferRenderTargetView();
 #else
-        renderTargetView = swapChain->GetCurrentBackBufferRTV();
+        renderTargetView = m_pRenderDevice->GetBackBufferRenderTargetView();
 #endif
     }
     if (m_stCurrentOutputViews.DepthStencilView)
     {
-        depthStencilView = m_stCurrentOutputViews.DepthStencilView->m_pNativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_DEPTH_STENCIL);
-        assert(depthStencilView);
+        auto view = m_pRenderDevice->GetTextureView(m_stCurrentOutputViews.DepthStencilView->m_pNativeHandler,
+            Render::TextureViewTypes::DepthStencil);
+        if (!view)
+            return view.GetError();
+        depthStencilView = *view;
     }
     else
     {
-        depthStencilView = swapChain->GetDepthBufferDSV();
+        depthStencilView = m_pRenderDevice->GetBackBufferDepthStencilView();
     }
 
     // 全屏清可以直接清 RT
@@ -706,15 +709,14 @@ Result<void> RenderSystem::Clear(std::optional<Render::ColorRGBA32> clearColor,
         if (clearColor)
         {
             const float color[4] = { clearColor->r() / 255.f, clearColor->g() / 255.f, clearColor->b() / 255.f, clearColor->a() / 255.f };
-            context->ClearRenderTarget(renderTargetView, color, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            m_pRenderDevice->ClearRenderTarget(renderTargetView, color);
         }
         if (clearZDepth || clearStencil)
         {
-            auto flag = static_cast<Diligent::CLEAR_DEPTH_STENCIL_FLAGS>((clearZDepth ? Diligent::CLEAR_DEPTH_FLAG : 0) |
-                                                                         (clearStencil ? Diligent::CLEAR_STENCIL_FLAG : 0));
-            auto depth = clearZDepth ? *clearZDepth : 1.0f;
-            auto stencil = clearStencil ? *clearStencil : 0;
-            context->ClearDepthStencil(depthStencilView, flag, depth, stencil, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            std::optional<uint8_t> stencil;
+            if (clearStencil)
+                stencil = static_cast<uint8_t>(*clearStencil);
+            m_pRenderDevice->ClearDepthStencil(depthStencilView, clearZDepth, stencil);
         }
     }
     else
@@ -735,12 +737,31 @@ Result<void> RenderSystem::Clear(std::optional<Render::ColorRGBA32> clearColor,
 
 Result<void> RenderSystem::Draw(Render::Mesh* mesh, size_t indexCount, size_t vertexOffset, size_t indexOffset) noexcept
 {
-    if (!mesh)
+    // 包含逐实例数据的网格只能通过 DrawInstanced 绘制
+    if (!mesh || mesh->GetDefinition()->GetInstanceStride() != 0)
+        return make_error_code(errc::invalid_argument);
+    return DrawImpl(mesh, indexCount, vertexOffset, indexOffset, {});
+}
+
+Result<void> RenderSystem::DrawInstanced(Render::Mesh* mesh, size_t indexCount, size_t instanceCount, size_t vertexOffset,
+    size_t indexOffset, size_t instanceOffset) noexcept
+{
+    if (!mesh || mesh->GetDefinition()->GetInstanceStride() == 0 || mesh->GetInstanceCount() == 0)
+        return make_error_code(errc::invalid_argument);
+    if (instanceCount == 0)
+        return {};
+    return DrawImpl(mesh, indexCount, vertexOffset, indexOffset, std::make_tuple(instanceCount, instanceOffset));
+}
+
+Result<void> RenderSystem::DrawImpl(Render::Mesh* mesh, size_t indexCount, size_t vertexOffset, size_t indexOffset,
+    std::optional<std::tuple<size_t, size_t>> instances) noexcept
+{
+    assert(mesh);
+    if (mesh->GetVertexCount() == 0 || mesh->GetIndexCount() == 0)
         return make_error_code(errc::invalid_argument);
     if (!m_pCurrentCamera || !m_pCurrentMaterial)
         return make_error_code(errc::invalid_argument);
 
-    auto context = m_pRenderDevice->GetImmediateContext();
     auto meshDef = mesh->GetDefinition();
 
     // 准备 Camera、Material 数据
@@ -760,15 +781,19 @@ Result<void> RenderSystem::Draw(Render::Mesh* mesh, size_t indexCount, size_t ve
     }
 
     // 准备 VB,IB
+    // 实例数据绑定在槽 1 上，与顶点偏移一样通过缓冲区偏移实现实例偏移，不依赖 BaseInstance 支持
     {
         assert(vertexOffset < mesh->GetVertexCount());
         assert(indexOffset < mesh->GetIndexCount());
-        Diligent::IBuffer* vertexBuffers[] = {mesh->m_pVertexBuffer};
-        Uint64 vertexOffsets[] = {mesh->GetDefinition()->GetVertexStride() * vertexOffset};
-        context->SetVertexBuffers(0, 1, vertexBuffers, vertexOffsets, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
-            Diligent::SET_VERTEX_BUFFERS_FLAG_RESET);
-        context->SetIndexBuffer(mesh->m_pIndexBuffer, indexOffset * (mesh->Is32BitsIndex() ? 4 : 2),
-            Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Diligent::IBuffer* vertexBuffers[] = {mesh->m_pVertexBuffer, mesh->m_pInstanceBuffer};
+        uint64_t vertexOffsets[] = {meshDef->GetVertexStride() * vertexOffset, 0};
+        if (instances)
+        {
+            assert(std::get<1>(*instances) + std::get<0>(*instances) <= mesh->GetInstanceCount());
+            vertexOffsets[1] = meshDef->GetInstanceStride() * std::get<1>(*instances);
+        }
+        m_pRenderDevice->SetVertexBuffers(instances ? 2 : 1, vertexBuffers, vertexOffsets);
+        m_pRenderDevice->SetIndexBuffer(mesh->m_pIndexBuffer, indexOffset * (mesh->Is32BitsIndex() ? 4 : 2));
     }
 
     // 依次渲染 Pass
@@ -776,6 +801,8 @@ Result<void> RenderSystem::Draw(Render::Mesh* mesh, size_t indexCount, size_t ve
     drawAttrs.NumIndices = indexCount;
     drawAttrs.IndexType = mesh->Is32BitsIndex() ? Diligent::VT_UINT32 : Diligent::VT_UINT16;
     drawAttrs.Flags = Diligent::DRAW_FLAG_VERIFY_STATES;
+    if (instances)
+        drawAttrs.NumInstances = std::get<0>(*instances);
     for (const auto& pass : m_pCurrentPassGroup->GetPasses())
     {
         // 找到实例
@@ -791,10 +818,10 @@ Result<void> RenderSystem::Draw(Render::Mesh* mesh, size_t indexCount, size_t ve
         }
 
         // 提交 SRB
-        context->CommitShaderResources(it->second.ResourceBinding, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pRenderDevice->CommitShaderResources(it->second.ResourceBinding);
 
         // 渲染
-        context->DrawIndexed(drawAttrs);
+        m_pRenderDevice->DrawIndexed(drawAttrs);
     }
     return {};
 }
@@ -807,9 +834,7 @@ std::tuple<uint32_t, uint32_t> RenderSystem::GetCurrentOutputViewSize() noexcept
     }
     else
     {
-        auto texture = m_stCurrentOutputViews.ColorView->m_pNativeHandler;
-        assert(texture);
-        return { texture->GetDesc().Width, texture->GetDesc().Height };
+        return { m_stCurrentOutputViews.ColorView->GetWidth(), m_stCurrentOutputViews.ColorView->GetHeight() };
     }
 }
 
@@ -825,7 +850,7 @@ const Render::GraphDef::EffectPassGroupDefinition* RenderSystem::SelectPassGroup
         return groups[0].get();
 
     // 通知选择器进行选择
-    auto group = m_stCurrentEffectGroupSelector(def.get(), m_stEffectRenderTag);
+    auto group = m_stCurrentEffectGroupSelector(def.get(), m_uRenderStateKey, m_stEffectRenderTag);
 
     // 没有选出来，则 fallback 到第一个结果
     if (!group)
@@ -836,8 +861,6 @@ const Render::GraphDef::EffectPassGroupDefinition* RenderSystem::SelectPassGroup
 Result<void> RenderSystem::CommitCamera() noexcept
 {
     assert(m_pCurrentCamera);
-    auto swapChain = m_pRenderDevice->GetSwapChain();
-    auto context = m_pRenderDevice->GetImmediateContext();
 
     const auto& outputViews = m_pCurrentCamera->GetOutputViews();
     const auto& viewport = m_pCurrentCamera->GetViewport();
@@ -851,29 +874,35 @@ Result<void> RenderSystem::CommitCamera() noexcept
         Diligent::ITextureView* depthStencilView = nullptr;
         if (outputViews.ColorView)
         {
-            renderTargetView = outputViews.ColorView->m_pNativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_RENDER_TARGET);
-            assert(renderTargetView);
+            auto view = m_pRenderDevice->GetTextureView(outputViews.ColorView->m_pNativeHandler, Render::TextureViewTypes::RenderTarget);
+            if (!view)
+                return view.GetError();
+            renderTargetView = *view;
         }
         else
         {
 #ifdef LSTG_PLATFORM_EMSCRIPTEN
-            renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() : swapChain->GetCurrentBackBufferRTV();
+            renderTargetView = m_pGammaCorrectHelper ? m_pGammaCorrectHelper->GetRenderTargetView() :
+                m_pRenderDevice->GetBackBufferRenderTargetView();
 #else
-            renderTargetView = swapChain->GetCurrentBackBufferRTV();
+            renderTargetView = m_pRenderDevice->GetBackBufferRenderTargetView();
 #endif
         }
         if (outputViews.DepthStencilView)
         {
-            depthStencilView = outputViews.DepthStencilView->m_pNativeHandler->GetDefaultView(Diligent::TEXTURE_VIEW_DEPTH_STENCIL);
-            assert(depthStencilView);
+            auto view = m_pRenderDevice->GetTextureView(outputViews.DepthStencilView->m_pNativeHandler,
+                Render::TextureViewTypes::DepthStencil);
+            if (!view)
+                return view.GetError();
+            depthStencilView = *view;
         }
         else
         {
-            depthStencilView = swapChain->GetDepthBufferDSV();
+            depthStencilView = m_pRenderDevice->GetBackBufferDepthStencilView();
         }
 
         // 切换 RT
-        context->SetRenderTargets(1, &renderTargetView, depthStencilView, Diligent::RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        m_pRenderDevice->SetRenderTargets(renderTargetView, depthStencilView);
         m_stCurrentOutputViews = outputViews;
 
         // 同时调整 Viewport
@@ -893,7 +922,7 @@ Result<void> RenderSystem::CommitCamera() noexcept
             vp.Height = ::floor(viewport.Height);
             vp.TopLeftX = ::floor(viewport.Left);
             vp.TopLeftY = ::floor(viewport.Top);
-            m_pRenderDevice->GetImmediateContext()->SetViewports(1, &vp, 0, 0);
+            m_pRenderDevice->SetViewport(vp);
             m_stCurrentViewport = viewport;
             viewportChanged = true;
         }
@@ -909,7 +938,7 @@ Result<void> RenderSystem::CommitCamera() noexcept
                 vp.Height = ::floor(targetViewport.Height);
                 vp.TopLeftX = ::floor(targetViewport.Left);
                 vp.TopLeftY = ::floor(targetViewport.Top);
-                m_pRenderDevice->GetImmediateContext()->SetViewports(1, &vp, 0, 0);
+                m_pRenderDevice->SetViewport(vp);
                 m_stCurrentViewport = viewport;
                 viewportChanged = true;
             }
@@ -924,7 +953,7 @@ Result<void> RenderSystem::CommitCamera() noexcept
             static_cast<int32_t>(std::get<0>(sz)),
             static_cast<int32_t>(std::get<1>(sz)),
         };
-        context->SetScissorRects(1, &scissor, std::get<0>(sz), std::get<1>(sz));
+        m_pRenderDevice->SetScissorRect(scissor, std::get<0>(sz), std::get<1>(sz));
     }
 
     // 提交相机参数
@@ -968,17 +997,18 @@ Result<void> RenderSystem::PreparePipeline(const Render::GraphDef::EffectPassDef
     const Render::GraphDef::MeshDefinition* meshDef)
 {
     assert(pass && meshDef);
-    auto swapChain = m_pRenderDevice->GetSwapChain();
+
+    const auto& swapChainDesc = m_pRenderDevice->GetSwapChainDesc();
 
     // 选择 PSO
-    Diligent::RefCntAutoPtr<Diligent::IPipelineState> pso;
+    Diligent::IPipelineState* pso = nullptr;
 
     // 检查是否已经存在 PSO
     Render::GraphDef::EffectPassDefinition::PipelineCacheKey key;
-    key.ColorBufferFormat = (m_stCurrentOutputViews.ColorView == nullptr ? swapChain->GetDesc().ColorBufferFormat :
-        m_stCurrentOutputViews.ColorView->m_pNativeHandler->GetDesc().Format);
-    key.DepthBufferFormat = (m_stCurrentOutputViews.DepthStencilView == nullptr ? swapChain->GetDesc().DepthBufferFormat :
-        m_stCurrentOutputViews.DepthStencilView->m_pNativeHandler->GetDesc().Format);
+    key.ColorBufferFormat = (m_stCurrentOutputViews.ColorView == nullptr ? swapChainDesc.ColorBufferFormat :
+        m_stCurrentOutputViews.ColorView->GetNativeDesc().Format);
+    key.DepthBufferFormat = (m_stCurrentOutputViews.DepthStencilView == nullptr ? swapChainDesc.DepthBufferFormat :
+        m_stCurrentOutputViews.DepthStencilView->GetNativeDesc().Format);
     key.MeshDef = meshDef;
     auto it = pass->m_stPipelineStateCaches.find(key);
     if (it != pass->m_stPipelineStateCaches.end())
@@ -994,7 +1024,6 @@ Result<void> RenderSystem::PreparePipeline(const Render::GraphDef::EffectPassDef
             string name = fmt::format("PSO #{}", key.GetHashCode());
 
             Diligent::IPipelineResourceSignature* prs[] = { pass->m_pResourceSignature };
-            assert(prs[0]);
 
             Diligent::GraphicsPipelineStateCreateInfo pipelineCreateInfo;
             pipelineCreateInfo.PSODesc.Name = name.c_str();
@@ -1023,14 +1052,18 @@ Result<void> RenderSystem::PreparePipeline(const Render::GraphDef::EffectPassDef
                 {
                     if (vm.Semantic == s.second.Semantic)
                     {
+                        // 逐实例数据位于槽 1
                         vertexLayout.emplace_back(Diligent::LayoutElement {
                             s.second.SlotIndex,  // _InputIndex
-                            0,  // _BufferSlot
+                            vm.PerInstance ? 1u : 0u,  // _BufferSlot
                             static_cast<unsigned>(std::get<1>(vm.Type)),  // _NumComponents
                             Render::GraphDef::detail::ToDiligent(std::get<0>(vm.Type)),  // _ValueType
                             s.second.Normalized,  // _IsNormalized
                             static_cast<unsigned>(vm.Offset),  // _RelativeOffset
-                            static_cast<unsigned>(meshDef->GetVertexStride())  // _Stride
+                            static_cast<unsigned>(vm.PerInstance ? meshDef->GetInstanceStride() : meshDef->GetVertexStride()),  // _Stride
+                            vm.PerInstance ? Diligent::INPUT_ELEMENT_FREQUENCY_PER_INSTANCE :
+                                Diligent::INPUT_ELEMENT_FREQUENCY_PER_VERTEX,  // _Frequency
+                            1u  // _InstanceDataStepRate
                         });
                         found = true;
                         break;
@@ -1048,29 +1081,28 @@ Result<void> RenderSystem::PreparePipeline(const Render::GraphDef::EffectPassDef
             // Shader
             pipelineCreateInfo.pVS = pass->GetVertexShader()->m_pCompiledShader;
             pipelineCreateInfo.pPS = pass->GetPixelShader()->m_pCompiledShader;
-            assert(pipelineCreateInfo.pVS && pipelineCreateInfo.pPS);
 
-            m_pRenderDevice->GetDevice()->CreateGraphicsPipelineState(pipelineCreateInfo, &pso);
-            if (!pso)
+            Diligent::RefCntAutoPtr<Diligent::IPipelineState> createdPSO;
+            if (!m_pRenderDevice->CreateGraphicsPipelineState(pipelineCreateInfo, &createdPSO))
             {
                 LSTG_LOG_ERROR_CAT(RenderSystem, "Create pso fail, pass \"{}\", key #{}", pass->GetName(), key.GetHashCode());
                 return make_error_code(errc::io_error);
             }
 
             // 记录
+            // 缓存持有 PSO 的引用，不持有原生对象的设备上为空
             LSTG_LOG_TRACE_CAT(RenderSystem, "PSO #{} created", key.GetHashCode());
-            pass->m_stPipelineStateCaches.emplace(key, pso);
-            pso->AddRef();
+            auto jt = pass->m_stPipelineStateCaches.emplace(key, nullptr).first;
+            pso = jt->second = createdPSO.Detach();
         }
         catch (...)  // bad_alloc
         {
             return make_error_code(errc::not_enough_memory);
         }
     }
-    assert(pso);
 
     // 设置 PSO
-    m_pRenderDevice->GetImmediateContext()->SetPipelineState(pso);
+    m_pRenderDevice->SetPipelineState(pso);
     return {};
 }
 
@@ -1089,12 +1121,11 @@ void RenderSystem::OnEvent(SubsystemEvent& event) noexcept
         auto newHeight = std::get<1>(renderSize);
         if (newWidth > 0 && newHeight > 0)
         {
-            auto swapChain = m_pRenderDevice->GetSwapChain();
-            const auto& desc = swapChain->GetDesc();
+            const auto& desc = m_pRenderDevice->GetSwapChainDesc();
             if (desc.Width != static_cast<uint32_t>(newWidth) || desc.Height != static_cast<uint32_t>(newHeight))
             {
                 LSTG_LOG_INFO_CAT(RenderSystem, "Swap chain resize {}x{} -> {}x{}", desc.Width, desc.Height, newWidth, newHeight);
-                swapChain->Resize(newWidth, newHeight);
+                m_pRenderDevice->ResizeSwapChain(newWidth, newHeight);
 #ifdef LSTG_PLATFORM_EMSCRIPTEN
                 m_pGammaCorrectHelper->ResizeFrameBuffer();
 #endif
@@ -734,6 +734,7 @@ struct LoadFileInfo
     std::variant<FILE*, Subsystem::VFS::StreamPtr> File;
     std::optional<uint8_t> PeekBuffer;
     uint8_t Buffer[LUAL_BUFFERSIZE];
+    const uint8_t* Data = nullptr;  // 指向 Buffer 或流的内存视图
     std::error_code ReadError {};
 
     Result<uint8_t> GetChar() noexcept
@@ -782,6 +783,7 @@ struct LoadFileInfo
     Result<bool> Read(size_t& sz) noexcept
     {
         sz = 0;
+        Data = Buffer;
         if (File.index() == 0)
         {
             auto fp = std::get<0>(File);
@@ -798,6 +800,30 @@ struct LoadFileInfo
         {
             assert(File.index() == 1);
             auto s = std::get<1>(File);
+
+            // 数据常驻内存时一次交出剩余部分，不经过缓冲区
+            auto view = s->GetMemoryView();
+            if (view)
+            {
+                auto position = s->GetPosition();
+                if (!position)
+                {
+                    ReadError = position.GetError();
+                    return ReadError;
+                }
+                if (*position >= view->GetSize())
+                    return false;
+                Data = view->GetData() + *position;
+                sz = view->GetSize() - static_cast<size_t>(*position);
+                auto seek = s->Seek(0, Subsystem::VFS::StreamSeekOrigins::End);
+                if (!seek)
+                {
+                    ReadError = seek.GetError();
+                    return ReadError;
+                }
+                return true;
+            }
+
             auto ret = s->Read(Buffer, sizeof(Buffer));
             if (!ret)
             {
@@ -829,7 +855,7 @@ static const char* FileReader(lua_State* L, void* ud, size_t* size) noexcept
         return nullptr;
     if (!*ret)  // EOF
         return nullptr;
-    return reinterpret_cast<const char*>(lf->Buffer);
+    return reinterpret_cast<const char*>(lf->Data);
 }
 
 static int ReportFileErr(lua_State* L, const char* what, int filenameIndex, std::error_code ec)
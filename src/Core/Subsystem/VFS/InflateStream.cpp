@@ -6,9 +6,11 @@
  */
 #include <lstg/Core/Subsystem/VFS/InflateStream.hpp>
 
+#include <algorithm>
 #include <lstg/Core/Logging.hpp>
 #include "detail/ZStream.hpp"
 #include "detail/ZLibError.hpp"
+#include "detail/InflateCheckpointIndex.hpp"
 
 LSTG_DEF_LOG_CATEGORY(InflateStream);
 
@@ -16,18 +18,23 @@ using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::VFS;
 
-InflateStream::InflateStream(StreamPtr underlayStream, std::optional<uint64_t> uncompressedSize)
+static const size_t kInflateWindowSize = 32 * 1024;
+
+InflateStream::InflateStream(StreamPtr underlayStream, std::optional<uint64_t> uncompressedSize, uint64_t checkpointInterval)
     : m_pZStream(std::make_shared<detail::ZStream>(detail::InflateInitTag{}, true)), m_pUnderlayStream(std::move(underlayStream)),
     m_stUncompressedSize(uncompressedSize)
 {
     assert(m_pUnderlayStream);
+    if (checkpointInterval)
+        m_pCheckpointIndex = std::make_shared<detail::InflateCheckpointIndex>(checkpointInterval);
     (**m_pZStream)->next_in = m_stChunk;
     (**m_pZStream)->avail_in = 0;
 }
 
 InflateStream::InflateStream(const InflateStream& org)
     : m_pZStream(std::make_shared<detail::ZStream>(*org.m_pZStream)), m_bFinished(org.m_bFinished),
-    m_stUncompressedSize(org.m_stUncompressedSize)
+    m_stUncompressedSize(org.m_stUncompressedSize), m_pCheckpointIndex(org.m_pCheckpointIndex),
+    m_ullInputBase(org.m_ullInputBase), m_ullOutputBase(org.m_ullOutputBase)
 {
     auto clone = org.m_pUnderlayStream->Clone();
     m_pUnderlayStream = clone.ThrowIfError();
@@ -61,7 +68,7 @@ bool InflateStream::IsWriteable() const noexcept
 
 bool InflateStream::IsSeekable() const noexcept
 {
-    return false;
+    return m_pCheckpointIndex && m_pUnderlayStream->IsSeekable();
 }
 
 Result<uint64_t> InflateStream::GetLength() const noexcept
@@ -78,12 +85,76 @@ Result<void> InflateStream::SetLength(uint64_t length) noexcept
 
 Result<uint64_t> InflateStream::GetPosition() const noexcept
 {
-    return (**m_pZStream)->total_out;
+    return m_ullOutputBase + (**m_pZStream)->total_out;
 }
 
 Result<void> InflateStream::Seek(int64_t offset, StreamSeekOrigins origin) noexcept
 {
-    return make_error_code(errc::not_supported);
+    if (!IsSeekable())
+        return make_error_code(errc::not_supported);
+
+    // 计算目标位置，越界时截断到 [0, Length]
+    uint64_t position = m_ullOutputBase + (**m_pZStream)->total_out;
+    uint64_t target = 0;
+    switch (origin)
+    {
+        case StreamSeekOrigins::Begin:
+            target = static_cast<uint64_t>(std::max<int64_t>(0, offset));
+            break;
+        case StreamSeekOrigins::Current:
+            if (offset < 0)
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                target = (positive >= position) ? 0 : position - positive;
+            }
+            else
+            {
+                target = position + static_cast<uint64_t>(offset);
+            }
+            break;
+        case StreamSeekOrigins::End:
+            if (!m_stUncompressedSize)
+                return make_error_code(errc::not_supported);
+            if (offset >= 0)
+            {
+                target = *m_stUncompressedSize;
+            }
+            else
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                target = (positive >= *m_stUncompressedSize) ? 0 : *m_stUncompressedSize - positive;
+            }
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    if (m_stUncompressedSize)
+        target = std::min(target, *m_stUncompressedSize);
+
+    // 向后 Seek，或者检查点比当前位置更近时，从检查点（或起始处）恢复
+    auto checkpoint = m_pCheckpointIndex->Find(target);
+    auto checkpointOutput = checkpoint ? checkpoint->Output : 0;
+    if (target < position || checkpointOutput > position)
+    {
+        auto ret = checkpoint ? RestoreCheckpoint(*checkpoint) : Reset();
+        if (!ret)
+            return ret.GetError();
+        position = checkpointOutput;
+    }
+
+    // 解压并丢弃数据直到目标位置，途经的块边界会继续建立检查点
+    uint8_t discard[16 * 1024];
+    while (position < target)
+    {
+        auto count = Read(discard, static_cast<size_t>(std::min<uint64_t>(sizeof(discard), target - position)));
+        if (!count)
+            return count.GetError();
+        if (*count == 0)
+            break;
+        position += *count;
+    }
+    return {};
 }
 
 Result<bool> InflateStream::IsEof() const noexcept
@@ -125,7 +196,8 @@ Result<size_t> InflateStream::Read(uint8_t* buffer, size_t length) noexcept
         }
 
         // 进行解压操作
-        auto ret = ::zng_inflate(z, Z_NO_FLUSH);
+        // 需要建立检查点时，在每个块边界处返回
+        auto ret = ::zng_inflate(z, m_pCheckpointIndex ? Z_BLOCK : Z_NO_FLUSH);
         switch (ret)
         {
             case Z_NEED_DICT:
@@ -142,6 +214,10 @@ Result<size_t> InflateStream::Read(uint8_t* buffer, size_t length) noexcept
                 break;
         }
 
+        // 位于块边界（且不是最后一个块之后）
+        if (m_pCheckpointIndex && (z->data_type & 128) && !(z->data_type & 64))
+            RecordCheckpoint();
+
         if (ret == Z_STREAM_END)
         {
             m_bFinished = true;
@@ -179,7 +255,7 @@ Result<void> InflateStream::Reset() noexcept
     detail::ZStreamPtr reset;
     try
     {
-        reset = std::make_shared<detail::ZStream>(detail::InflateInitTag{});
+        reset = std::make_shared<detail::ZStream>(detail::InflateInitTag{}, true);
     }
     catch (...)  // bad_alloc
     {
@@ -190,7 +266,84 @@ Result<void> InflateStream::Reset() noexcept
     if (!ret)
         return ret.GetError();
 
+    (**reset)->next_in = m_stChunk;
+    (**reset)->avail_in = 0;
     m_pZStream = reset;
     m_bFinished = false;
+    m_ullInputBase = 0;
+    m_ullOutputBase = 0;
     return {};
 }
+
+Result<void> InflateStream::RestoreCheckpoint(const detail::InflateCheckpoint& checkpoint) noexcept
+{
+    detail::ZStreamPtr restore;
+    try
+    {
+        restore = std::make_shared<detail::ZStream>(detail::InflateInitTag{}, true);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+
+    // 检查点不在字节边界时，需要先喂入前一个字节剩余的位
+    auto ret = m_pUnderlayStream->Seek(static_cast<int64_t>(checkpoint.Input - (checkpoint.Bits ? 1 : 0)),
+        StreamSeekOrigins::Begin);
+    if (!ret)
+        return ret.GetError();
+    if (checkpoint.Bits)
+    {
+        uint8_t byte = 0;
+        auto count = m_pUnderlayStream->Read(&byte, 1);
+        if (!count)
+            return count.GetError();
+        if (*count != 1)
+            return make_error_code(errc::io_error);
+        auto err = ::zng_inflatePrime(**restore, checkpoint.Bits, byte >> (8 - checkpoint.Bits));
+        if (err != Z_OK)
+            return make_error_code(static_cast<detail::ZLibError>(err));
+    }
+
+    // 恢复滑动窗口
+    auto err = ::zng_inflateSetDictionary(**restore, checkpoint.Window.data(), static_cast<uint32_t>(checkpoint.Window.size()));
+    if (err != Z_OK)
+        return make_error_code(static_cast<detail::ZLibError>(err));
+
+    (**restore)->next_in = m_stChunk;
+    (**restore)->avail_in = 0;
+    m_pZStream = restore;
+    m_bFinished = false;
+    m_ullInputBase = checkpoint.Input;
+    m_ullOutputBase = checkpoint.Output;
+    return {};
+}
+
+void InflateStream::RecordCheckpoint() noexcept
+{
+    assert(m_pCheckpointIndex);
+    auto z = (**m_pZStream);
+    auto position = m_ullOutputBase + z->total_out;
+    if (!m_pCheckpointIndex->IsCheckpointRequired(position))
+        return;
+
+    // 检查点只用于加速，失败时直接忽略
+    try
+    {
+        auto checkpoint = std::make_shared<detail::InflateCheckpoint>();
+        checkpoint->Input = m_ullInputBase + z->total_in;
+        checkpoint->Output = position;
+        checkpoint->Bits = static_cast<uint8_t>(z->data_type & 7);
+        checkpoint->Window.resize(kInflateWindowSize);
+
+        auto windowSize = static_cast<uint32_t>(kInflateWindowSize);
+        if (Z_OK != ::zng_inflateGetDictionary(z, checkpoint->Window.data(), &windowSize))
+            return;
+        assert(windowSize <= kInflateWindowSize);
+        checkpoint->Window.resize(windowSize);
+        m_pCheckpointIndex->Add(std::move(checkpoint));
+    }
+    catch (...)  // bad_alloc
+    {
+    }
+}
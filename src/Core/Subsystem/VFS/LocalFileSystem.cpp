@@ -7,6 +7,7 @@
 #include <lstg/Core/Subsystem/VFS/LocalFileSystem.hpp>
 
 #include <lstg/Core/Subsystem/VFS/FileStream.hpp>
+#include <lstg/Core/Subsystem/VFS/MappedFileStream.hpp>
 
 using namespace std;
 using namespace lstg;
@@ -226,6 +227,18 @@ Result<StreamPtr> LocalFileSystem::OpenFile(Path path, FileAccessMode access, Fi
     try
     {
         auto target = MakeLocalPath(path);
+
+        // 映射失败时（如 32 位平台地址空间不足）回退到普通文件流
+        if (access == FileAccessMode::Read && (flags & FileOpenFlags::MemoryMapped))
+        {
+            try
+            {
+                return std::make_shared<MappedFileStream>(target);
+            }
+            catch (const system_error&)
+            {
+            }
+        }
         return std::make_shared<FileStream>(target, access, flags);
     }
     catch (const system_error& ex)
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @date 2022/9/20
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include <lstg/Core/Subsystem/VFS/MappedFileStream.hpp>
+
+#include <limits>
+
+#ifndef LSTG_PLATFORM_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::VFS;
+
+namespace
+{
+    /**
+     * 文件映射
+     * 映射建立后即可关闭文件句柄，映射在对象析构时解除。
+     */
+    class FileMapping
+    {
+    public:
+        explicit FileMapping(const std::filesystem::path& path)
+        {
+#ifndef LSTG_PLATFORM_WIN32
+            auto fd = ::open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+                throw system_error(error_code(errno, generic_category()));
+
+            struct ::stat buf {};
+            if (-1 == ::fstat(fd, &buf))
+            {
+                auto ec = error_code(errno, generic_category());
+                ::close(fd);
+                throw system_error(ec);
+            }
+            if (static_cast<uint64_t>(buf.st_size) > numeric_limits<size_t>::max())
+            {
+                ::close(fd);
+                throw system_error(make_error_code(errc::file_too_large));
+            }
+
+            // 空文件无法映射，视作空视图
+            m_uSize = static_cast<size_t>(buf.st_size);
+            if (m_uSize > 0)
+            {
+                auto p = ::mmap(nullptr, m_uSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED)
+                {
+                    auto ec = error_code(errno, generic_category());
+                    ::close(fd);
+                    throw system_error(ec);
+                }
+                m_pData = static_cast<const uint8_t*>(p);
+            }
+            ::close(fd);
+#else
+            auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw system_error(error_code(::GetLastError(), system_category()));
+
+            LARGE_INTEGER largeInteger {};
+            if (FALSE == ::GetFileSizeEx(file, &largeInteger))
+            {
+                auto ec = error_code(::GetLastError(), system_category());
+                ::CloseHandle(file);
+                throw system_error(ec);
+            }
+            if (static_cast<uint64_t>(largeInteger.QuadPart) > numeric_limits<size_t>::max())
+            {
+                ::CloseHandle(file);
+                throw system_error(make_error_code(errc::file_too_large));
+            }
+
+            // 空文件无法映射，视作空视图
+            m_uSize = static_cast<size_t>(largeInteger.QuadPart);
+            if (m_uSize > 0)
+            {
+                auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping)
+                {
+                    auto ec = error_code(::GetLastError(), system_category());
+                    ::CloseHandle(file);
+                    throw system_error(ec);
+                }
+                auto p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (!p)
+                {
+                    auto ec = error_code(::GetLastError(), system_category());
+                    ::CloseHandle(mapping);
+                    ::CloseHandle(file);
+                    throw system_error(ec);
+                }
+                ::CloseHandle(mapping);
+                m_pData = static_cast<const uint8_t*>(p);
+            }
+            ::CloseHandle(file);
+#endif
+        }
+
+        FileMapping(const FileMapping&) = delete;
+        FileMapping& operator=(const FileMapping&) = delete;
+
+        ~FileMapping()
+        {
+            if (!m_pData)
+                return;
+#ifndef LSTG_PLATFORM_WIN32
+            ::munmap(const_cast<uint8_t*>(m_pData), m_uSize);
+#else
+            ::UnmapViewOfFile(m_pData);
+#endif
+        }
+
+    public:
+        [[nodiscard]] Span<const uint8_t> GetView() const noexcept { return { m_pData, m_uSize }; }
+
+    private:
+        const uint8_t* m_pData = nullptr;
+        size_t m_uSize = 0;
+    };
+}
+
+MappedFileStream::MappedFileStream(const std::filesystem::path& path)
+{
+    auto mapping = make_shared<FileMapping>(path);
+    m_stView = mapping->GetView();
+    m_pOwner = std::move(mapping);
+}
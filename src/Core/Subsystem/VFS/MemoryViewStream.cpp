@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @date 2022/9/20
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include <lstg/Core/Subsystem/VFS/MemoryViewStream.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::VFS;
+
+MemoryViewStream::MemoryViewStream(Span<const uint8_t> view, std::shared_ptr<const void> owner) noexcept
+    : m_stView(view), m_pOwner(std::move(owner))
+{
+}
+
+bool MemoryViewStream::IsReadable() const noexcept
+{
+    return true;
+}
+
+bool MemoryViewStream::IsWriteable() const noexcept
+{
+    return false;
+}
+
+bool MemoryViewStream::IsSeekable() const noexcept
+{
+    return true;
+}
+
+Result<uint64_t> MemoryViewStream::GetLength() const noexcept
+{
+    return static_cast<uint64_t>(m_stView.GetSize());
+}
+
+Result<void> MemoryViewStream::SetLength(uint64_t length) noexcept
+{
+    return make_error_code(errc::not_supported);
+}
+
+Result<uint64_t> MemoryViewStream::GetPosition() const noexcept
+{
+    return m_ullPosition;
+}
+
+Result<void> MemoryViewStream::Seek(int64_t offset, StreamSeekOrigins origin) noexcept
+{
+    // 与 ContainerStream 一致，越界时截断到 [0, Length]
+    auto length = static_cast<uint64_t>(m_stView.GetSize());
+    switch (origin)
+    {
+        case StreamSeekOrigins::Begin:
+            m_ullPosition = std::min<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(0, offset)), length);
+            break;
+        case StreamSeekOrigins::Current:
+            if (offset < 0)
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                m_ullPosition = (positive >= m_ullPosition) ? 0 : m_ullPosition - positive;
+            }
+            else
+            {
+                m_ullPosition = std::min<uint64_t>(m_ullPosition + static_cast<uint64_t>(offset), length);
+            }
+            break;
+        case StreamSeekOrigins::End:
+            if (offset >= 0)
+            {
+                m_ullPosition = length;
+            }
+            else
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                m_ullPosition = (positive >= length) ? 0 : length - positive;
+            }
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    return {};
+}
+
+Result<bool> MemoryViewStream::IsEof() const noexcept
+{
+    return m_ullPosition >= m_stView.GetSize();
+}
+
+Result<void> MemoryViewStream::Flush() noexcept
+{
+    return {};
+}
+
+Result<size_t> MemoryViewStream::Read(uint8_t* buffer, size_t length) noexcept
+{
+    assert(m_ullPosition <= m_stView.GetSize());
+    length = static_cast<size_t>(std::min<uint64_t>(length, m_stView.GetSize() - m_ullPosition));
+    if (length == 0)
+        return static_cast<size_t>(0u);
+
+    assert(buffer);
+    ::memcpy(buffer, m_stView.GetData() + m_ullPosition, length);
+    m_ullPosition += length;
+    return length;
+}
+
+Result<void> MemoryViewStream::Write(const uint8_t* buffer, size_t length) noexcept
+{
+    return make_error_code(errc::not_supported);
+}
+
+Result<StreamPtr> MemoryViewStream::Clone() const noexcept
+{
+    try
+    {
+        auto ret = make_shared<MemoryViewStream>(m_stView, m_pOwner);
+        ret->m_ullPosition = m_ullPosition;
+        return ret;
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+Result<Span<const uint8_t>> MemoryViewStream::GetMemoryView() const noexcept
+{
+    return m_stView;
+}
@@ -8,13 +8,21 @@
 
 #include <set>
 #include <algorithm>
+#include <lstg/Core/Hash.hpp>
 
 using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::VFS;
 
+static const size_t kMinPathIndexCapacity = 64;
+
 namespace
 {
+    uint32_t HashPath(std::string_view path) noexcept
+    {
+        return MurmurHash3({ reinterpret_cast<const uint8_t*>(path.data()), path.size() });
+    }
+
     /**
      * 分层文件系统的文件夹迭代器
      *
@@ -162,6 +170,7 @@ namespace
 void OverlayFileSystem::PushFileSystem(FileSystemPtr fs)
 {
     m_stFileSystems.emplace_back(std::move(fs));
+    RebuildPathIndex();
 }
 
 bool OverlayFileSystem::PopFileSystem() noexcept
@@ -169,6 +178,7 @@ bool OverlayFileSystem::PopFileSystem() noexcept
     if (m_stFileSystems.empty())
         return false;
     m_stFileSystems.pop_back();
+    RebuildPathIndex();
     return true;
 }
 
@@ -178,6 +188,7 @@ bool OverlayFileSystem::RemoveFileSystem(const FileSystemPtr& fs) noexcept
     if (it != m_stFileSystems.end())
     {
         m_stFileSystems.erase(it);
+        RebuildPathIndex();
         return true;
     }
     return false;
@@ -187,6 +198,7 @@ void OverlayFileSystem::RemoveFileSystemAt(size_t index) noexcept
 {
     assert(index < m_stFileSystems.size());
     m_stFileSystems.erase(m_stFileSystems.begin() + index);
+    RebuildPathIndex();
 }
 
 size_t OverlayFileSystem::GetFileSystemCount() const noexcept
@@ -250,10 +262,26 @@ Result<void> OverlayFileSystem::Rename(Path from, Path to) noexcept
 
 Result<FileAttribute> OverlayFileSystem::GetFileAttribute(Path path) noexcept
 {
+    PathIndexSlot indexed;
+    auto lookup = LookupPathIndex(path, indexed);
     auto ec = make_error_code(errc::no_such_file_or_directory);
-    for (auto it = m_stFileSystems.rbegin(); it != m_stFileSystems.rend(); ++it)
+    for (size_t i = m_stFileSystems.size(); i-- > 0;)
     {
-        auto ret = (*it)->GetFileAttribute(path);
+        Result<FileAttribute> ret = make_error_code(errc::no_such_file_or_directory);
+        if (lookup != PathIndexLookupResult::Unavailable && m_stIndexedLayers[i])
+        {
+            // 索引表明只有记录的那一层包含该路径
+            if (lookup == PathIndexLookupResult::NotFound || indexed.Layer != i)
+                continue;
+            ret = m_stFileSystems[i]->GetImmutableEntryAttribute(indexed.Entry);
+
+            // 失败时与原有行为一致，继续在下层按路径查找
+            lookup = PathIndexLookupResult::Unavailable;
+        }
+        else
+        {
+            ret = m_stFileSystems[i]->GetFileAttribute(path);
+        }
         if (ret)
             return ret;
         if (ret.GetError() != make_error_code(errc::not_supported) &&
@@ -287,10 +315,26 @@ Result<DirectoryIteratorPtr> OverlayFileSystem::VisitDirectory(Path path) noexce
 
 Result<StreamPtr> OverlayFileSystem::OpenFile(Path path, FileAccessMode access, FileOpenFlags flags) noexcept
 {
+    PathIndexSlot indexed;
+    auto lookup = LookupPathIndex(path, indexed);
     auto ec = make_error_code(errc::no_such_file_or_directory);
-    for (auto it = m_stFileSystems.rbegin(); it != m_stFileSystems.rend(); ++it)
+    for (size_t i = m_stFileSystems.size(); i-- > 0;)
     {
-        auto ret = (*it)->OpenFile(path, access, flags);
+        Result<StreamPtr> ret = make_error_code(errc::no_such_file_or_directory);
+        if (lookup != PathIndexLookupResult::Unavailable && m_stIndexedLayers[i])
+        {
+            // 索引表明只有记录的那一层包含该路径
+            if (lookup == PathIndexLookupResult::NotFound || indexed.Layer != i)
+                continue;
+            ret = m_stFileSystems[i]->OpenImmutableEntry(indexed.Entry, access, flags);
+
+            // 失败时（如以写方式打开）与原有行为一致，继续在下层按路径查找
+            lookup = PathIndexLookupResult::Unavailable;
+        }
+        else
+        {
+            ret = m_stFileSystems[i]->OpenFile(path, access, flags);
+        }
         if (ret)
             return ret;
         if (ret.GetError() != make_error_code(errc::not_supported) &&
@@ -311,3 +355,84 @@ void OverlayFileSystem::SetUserData(std::string ud) noexcept
 {
     m_stUserData = std::move(ud);
 }
+
+void OverlayFileSystem::RebuildPathIndex() noexcept
+{
+    m_stPathIndex.clear();
+    m_stIndexedLayers.clear();
+
+    try
+    {
+        m_stIndexedLayers.resize(m_stFileSystems.size(), 0);
+
+        // 先收集所有层的路径以确定容量
+        std::vector<PathIndexSlot> entries;
+        for (size_t i = 0; i < m_stFileSystems.size(); ++i)
+        {
+            auto ret = m_stFileSystems[i]->VisitImmutablePaths([&](std::string_view p, ImmutableEntryHandle entry) {
+                assert(!p.empty() && entry);
+                entries.push_back({ p, entry, HashPath(p), static_cast<uint32_t>(i) });
+            });
+            if (ret)
+                m_stIndexedLayers[i] = 1;
+        }
+        if (entries.empty())
+            return;
+
+        // 负载因子不超过 1/2，保证探测序列总能遇到空槽位
+        auto capacity = kMinPathIndexCapacity;
+        while (capacity < entries.size() * 2)
+            capacity *= 2;
+        m_stPathIndex.resize(capacity);
+
+        // 自底向上插入，上层覆盖下层的记录
+        auto mask = capacity - 1;
+        for (const auto& e : entries)
+        {
+            auto i = static_cast<size_t>(e.Hash) & mask;
+            while (m_stPathIndex[i].Entry && !(m_stPathIndex[i].Hash == e.Hash && m_stPathIndex[i].Path == e.Path))
+                i = (i + 1) & mask;
+            m_stPathIndex[i] = e;
+        }
+    }
+    catch (...)  // bad_alloc
+    {
+        // 索引不完整时所有层都要按路径查找
+        m_stPathIndex.clear();
+        std::fill(m_stIndexedLayers.begin(), m_stIndexedLayers.end(), 0);
+    }
+}
+
+OverlayFileSystem::PathIndexLookupResult OverlayFileSystem::LookupPathIndex(const Path& path, PathIndexSlot& entry) const noexcept
+{
+    if (m_stPathIndex.empty())
+        return PathIndexLookupResult::Unavailable;
+
+    try
+    {
+        string buffer;
+        auto key = path.ToNormalizedStringView(buffer);
+
+        // 根目录存在于每一层中，不收录在索引里
+        if (key.empty())
+            return PathIndexLookupResult::Unavailable;
+
+        auto hash = HashPath(key);
+        auto mask = m_stPathIndex.size() - 1;
+        for (auto i = static_cast<size_t>(hash) & mask; ; i = (i + 1) & mask)
+        {
+            const auto& slot = m_stPathIndex[i];
+            if (!slot.Entry)
+                return PathIndexLookupResult::NotFound;
+            if (slot.Hash == hash && slot.Path == key)
+            {
+                entry = slot;
+                return PathIndexLookupResult::Found;
+            }
+        }
+    }
+    catch (...)  // bad_alloc
+    {
+        return PathIndexLookupResult::Unavailable;
+    }
+}
@@ -379,3 +379,38 @@ std::string_view Path::ToStringView() const noexcept
     assert(end > begin);
     return {begin, static_cast<size_t>(end - begin)};
 }
+
+std::string_view Path::ToNormalizedStringView(std::string& buffer) const
+{
+    auto view = ToStringView();
+
+    // 大多数情况下路径已经规格化，此时不需要复制
+    bool normalized = view.empty() || view[0] != kSeperator;
+    for (size_t i = 0; normalized && i < GetSegmentCount(); ++i)
+    {
+        auto segment = GetSegment(i);
+        if (segment == "." || segment == "..")
+            normalized = false;
+    }
+    if (normalized)
+        return view;
+
+    // 过滤 '.' 和 '..'
+    buffer.clear();
+    for (size_t i = 0; i < GetSegmentCount(); ++i)
+    {
+        auto segment = GetSegment(i);
+        if (segment == ".")
+            continue;
+        if (segment == "..")
+        {
+            auto pos = buffer.rfind(kSeperator);
+            buffer.resize(pos == string::npos ? 0 : pos);
+            continue;
+        }
+        if (!buffer.empty())
+            buffer.push_back(kSeperator);
+        buffer.append(segment);
+    }
+    return buffer;
+}
@@ -6,6 +6,8 @@
  */
 #include <lstg/Core/Subsystem/VFS/RootFileSystem.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem::VFS;
@@ -13,6 +15,7 @@ using namespace lstg::Subsystem::VFS;
 void RootFileSystem::Mount(Path path, FileSystemPtr fs)
 {
     auto* mp = &m_stRoot;
+    size_t depth = 0;
 
     // 从根文件系统开始找 path，匹配最长前缀
     for (size_t i = 0; i < path.GetSegmentCount(); ++i)
@@ -27,12 +30,25 @@ void RootFileSystem::Mount(Path path, FileSystemPtr fs)
         {
             MountingPoint nmp;
             nmp.Name = path[i];
+            nmp.FullPath = mp->FullPath.empty() ? nmp.Name : (mp->FullPath + Path::kSeperator + nmp.Name);
             mp->SubNodes[nmp.Name] = std::move(nmp);
 
             it = mp->SubNodes.find(path[i]);
             assert(it != mp->SubNodes.end());
         }
         mp = &(it->second);
+        ++depth;
+    }
+
+    // 加入索引，根节点不参与
+    if (depth > 0)
+    {
+        m_stMountPointIndex.emplace(mp->FullPath, mp);
+        if (std::find(m_stMountPointDepths.begin(), m_stMountPointDepths.end(), depth) == m_stMountPointDepths.end())
+        {
+            m_stMountPointDepths.push_back(depth);
+            std::sort(m_stMountPointDepths.begin(), m_stMountPointDepths.end(), std::greater<size_t>());
+        }
     }
 
     // 插入末端
@@ -68,7 +84,7 @@ Result<void> RootFileSystem::CreateDirectory(Path path) noexcept
 
     if (!fs)
         return make_error_code(errc::no_such_device);
-    return fs->CreateDirectory(postfix);
+    return fs->CreateDirectory(std::move(postfix));
 }
 
 Result<void> RootFileSystem::Remove(Path path) noexcept
@@ -77,7 +93,7 @@ Result<void> RootFileSystem::Remove(Path path) noexcept
 
     if (!fs)
         return make_error_code(errc::no_such_device);
-    return fs->Remove(postfix);
+    return fs->Remove(std::move(postfix));
 }
 
 Result<void> RootFileSystem::Rename(Path from, Path to) noexcept
@@ -98,7 +114,7 @@ Result<FileAttribute> RootFileSystem::GetFileAttribute(Path path) noexcept
 
     if (!fs)
         return make_error_code(errc::no_such_device);
-    return fs->GetFileAttribute(postfix);
+    return fs->GetFileAttribute(std::move(postfix));
 }
 
 Result<DirectoryIteratorPtr> RootFileSystem::VisitDirectory(Path path) noexcept
@@ -107,7 +123,7 @@ Result<DirectoryIteratorPtr> RootFileSystem::VisitDirectory(Path path) noexcept
 
     if (!fs)
         return make_error_code(errc::no_such_device);
-    return fs->VisitDirectory(postfix);
+    return fs->VisitDirectory(std::move(postfix));
 }
 
 Result<StreamPtr> RootFileSystem::OpenFile(Path path, FileAccessMode access, FileOpenFlags flags) noexcept
@@ -116,11 +132,40 @@ Result<StreamPtr> RootFileSystem::OpenFile(Path path, FileAccessMode access, Fil
 
     if (!fs)
         return make_error_code(errc::no_such_device);
-    return fs->OpenFile(postfix, access, flags);
+    return fs->OpenFile(std::move(postfix), access, flags);
 }
 
 std::tuple<FileSystemPtr, Path> RootFileSystem::FindMountPoint(const Path& path) const noexcept
 {
+    // 规格化的相对路径的前 N 段就是挂载点的完整路径，直接在索引中查找，从最深的挂载点开始
+    auto view = path.ToStringView();
+    auto normalized = view.empty() || view[0] != Path::kSeperator;
+    for (size_t i = 0; normalized && i < path.GetSegmentCount(); ++i)
+    {
+        // 我们允许 path 中存在 '.' 但是不允许存在 '..'
+        assert(path[i] != "..");
+        normalized = (path[i] != ".");
+    }
+    if (normalized)
+    {
+        for (auto depth : m_stMountPointDepths)
+        {
+            if (depth > path.GetSegmentCount())
+                continue;
+
+            auto last = path[depth - 1];
+            auto it = m_stMountPointIndex.find(view.substr(0, last.data() + last.size() - view.data()));
+            if (it == m_stMountPointIndex.end() || !it->second->FileSystem)
+                continue;
+
+            auto postfix = path.Slice(depth);
+            if (postfix.IsEmpty())
+                postfix = Path(".");
+            return make_tuple(it->second->FileSystem, postfix);
+        }
+    }
+
+    // 路径中含有 '.'，或者没有匹配的挂载点（此时只可能落在根节点上）时逐段匹配
     auto* mp = &m_stRoot;
     auto* longest = mp;
     size_t longestIndex = 0;
@@ -85,11 +85,22 @@ ZipArchiveFileSystem::ZipArchiveFileSystem(StreamPtr underlayStream, std::string
     auto ret = m_pZipFile->ReadFileEntries(entries);
     ret.ThrowIfError();
 
-    // 构造文件树
+    // 构造文件树和索引
     try
     {
+        m_stPathIndex.reserve(entries.size());
+
+        string buffer;
         for (auto& entry : entries)
         {
+            // 文件名统一为规格化的完整路径，作为索引的键
+            // 返回的视图可能指向 Path 自身的存储，因此 Path 需要存活到赋值之后
+            Path original {entry.FileName};
+            auto normalized = original.ToNormalizedStringView(buffer);
+            if (normalized.empty())
+                continue;
+            entry.FileName.assign(normalized.data(), normalized.size());
+
             Path p {entry.FileName};
             auto dir = CreateTree(p);
             assert(dir);
@@ -99,7 +110,8 @@ ZipArchiveFileSystem::ZipArchiveFileSystem(StreamPtr underlayStream, std::string
             auto it = dir->Files.find(filename);
             if (it != dir->Files.end())
                 throw system_error(detail::ZipFileReadError::DuplicatedFile);
-            dir->Files.emplace(filename, std::move(entry));
+            it = dir->Files.emplace(filename, std::move(entry)).first;
+            m_stPathIndex.emplace(it->second.FileName, &it->second);
         }
     }
     catch (...)
@@ -138,8 +150,11 @@ Result<void> ZipArchiveFileSystem::Rename(Path from, Path to) noexcept
 
 Result<FileAttribute> ZipArchiveFileSystem::GetFileAttribute(Path path) noexcept
 {
-    auto entry = LocatePath(path);
+    return GetEntryAttribute(LocatePath(path));
+}
 
+Result<FileAttribute> ZipArchiveFileSystem::GetEntryAttribute(const ConstZipEntry& entry) const noexcept
+{
     if (entry.index() == 0)
     {
         auto dir = get<0>(entry);
@@ -198,7 +213,11 @@ Result<StreamPtr> ZipArchiveFileSystem::OpenFile(Path path, FileAccessMode acces
     if (flags & FileOpenFlags::Truncate)
         return make_error_code(errc::invalid_argument);
 
-    auto entry = LocatePath(path);
+    return OpenEntry(LocatePath(path), access, flags);
+}
+
+Result<StreamPtr> ZipArchiveFileSystem::OpenEntry(const ConstZipEntry& entry, FileAccessMode access, FileOpenFlags flags) noexcept
+{
     if (entry.index() == 0)
     {
         auto dir = get<0>(entry);
@@ -213,7 +232,7 @@ Result<StreamPtr> ZipArchiveFileSystem::OpenFile(Path path, FileAccessMode acces
 
         // 构造流
         // FIXME: 这种接口会造成只能使用单一密码
-        return m_pZipFile->OpenEntry(*file, m_stPassword);
+        return m_pZipFile->OpenEntry(*file, m_stPassword, flags & FileOpenFlags::RandomAccess);
     }
 }
 
@@ -227,53 +246,60 @@ void ZipArchiveFileSystem::SetUserData(std::string ud) noexcept
     m_stUserData = std::move(ud);
 }
 
+Result<void> ZipArchiveFileSystem::VisitImmutablePaths(const std::function<void(std::string_view, ImmutableEntryHandle)>& visitor) const
+{
+    for (const auto& p : m_stPathIndex)
+        visitor(p.first, &p.second);
+    return {};
+}
+
+Result<FileAttribute> ZipArchiveFileSystem::GetImmutableEntryAttribute(ImmutableEntryHandle entry) noexcept
+{
+    assert(entry);
+    return GetEntryAttribute(*static_cast<const ConstZipEntry*>(entry));
+}
+
+Result<StreamPtr> ZipArchiveFileSystem::OpenImmutableEntry(ImmutableEntryHandle entry, FileAccessMode access, FileOpenFlags flags) noexcept
+{
+    assert(entry);
+    if (access == FileAccessMode::ReadWrite || access == FileAccessMode::Write)
+        return make_error_code(errc::permission_denied);
+    if (flags & FileOpenFlags::Truncate)
+        return make_error_code(errc::invalid_argument);
+
+    return OpenEntry(*static_cast<const ConstZipEntry*>(entry), access, flags);
+}
+
 ConstZipEntry ZipArchiveFileSystem::LocatePath(const Path& path) const noexcept
 {
     // 空路径直接返回
     if (path.IsEmpty())
         return static_cast<ZipDirectoryEntry*>(nullptr);
 
-    // 访问所有的文件夹节点
-    const ZipDirectoryEntry* entry = &m_stRoot;
-    for (size_t i = 0; i + 1 < path.GetSegmentCount(); ++i)
+    try
     {
-        // 处理 '.' 的情况
-        auto dir = path.GetSegment(i);
-        assert(dir != "..");
-        if (dir == ".")
-            continue;
-
-        auto it = entry->Directories.find(path.GetSegment(i));
-        if (it == entry->Directories.end())
-            return static_cast<ZipDirectoryEntry*>(nullptr);
-        entry = it->second;
-    }
-
-    // 获取文件名
-    auto filename = path.GetSegment(path.GetSegmentCount() - 1);
+        string buffer;
+        auto key = path.ToNormalizedStringView(buffer);
 
-    // 如果文件名是'.'，直接返回 entry
-    if (filename == ".")
-        return entry;
+        // 根目录
+        if (key.empty())
+            return &m_stRoot;
 
-    // 查找下是否是文件夹
-    {
-        auto it = entry->Directories.find(filename);
-        if (it != entry->Directories.end())
-            return it->second;
+        auto it = m_stPathIndex.find(key);
+        if (it == m_stPathIndex.end())
+            return static_cast<ZipDirectoryEntry*>(nullptr);
+        return it->second;
     }
-
-    // 查找下是否是文件
+    catch (...)  // bad_alloc
     {
-        auto it = entry->Files.find(filename);
-        if (it != entry->Files.end())
-            return &(it->second);
+        return static_cast<ZipDirectoryEntry*>(nullptr);
     }
-    return static_cast<ZipDirectoryEntry*>(nullptr);
 }
 
 void ZipArchiveFileSystem::ClearFileTree()
 {
+    m_stPathIndex.clear();
+
     queue<ZipDirectoryEntry*> clearQueue;
     clearQueue.push(&m_stRoot);
 
@@ -305,7 +331,18 @@ ZipDirectoryEntry* ZipArchiveFileSystem::CreateTree(const Path& path)
             auto ret = current->Directories.emplace(seg, new ZipDirectoryEntry());
             it = ret.first;
 
-            it->second->Name = seg;
+            auto dir = it->second;
+            dir->Name = seg;
+            if (current != &m_stRoot)
+            {
+                dir->FullPath.reserve(current->FullPath.size() + 1 + seg.size());
+                dir->FullPath.append(current->FullPath);
+                dir->FullPath.push_back(Path::kSeperator);
+            }
+            dir->FullPath.append(seg);
+
+            // 文件夹优先于同名文件
+            m_stPathIndex[dir->FullPath] = dir;
         }
 
         current = it->second;
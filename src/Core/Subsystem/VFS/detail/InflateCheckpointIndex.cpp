@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @date 2022/9/22
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "InflateCheckpointIndex.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Subsystem::VFS::detail;
+
+InflateCheckpointIndex::InflateCheckpointIndex(uint64_t interval) noexcept
+    : m_ullInterval(interval)
+{
+    assert(interval > 0);
+}
+
+InflateCheckpointPtr InflateCheckpointIndex::Find(uint64_t position) const noexcept
+{
+    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+    return FindNoLock(position);
+}
+
+bool InflateCheckpointIndex::IsCheckpointRequired(uint64_t position) const noexcept
+{
+    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+
+    // 起始处总是隐含一个检查点
+    auto prev = FindNoLock(position);
+    auto prevOutput = prev ? prev->Output : 0;
+    return position >= prevOutput + m_ullInterval;
+}
+
+void InflateCheckpointIndex::Add(InflateCheckpointPtr checkpoint)
+{
+    assert(checkpoint);
+    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+
+    // 其他流可能已经在附近放置了检查点，此时放弃
+    auto prev = FindNoLock(checkpoint->Output);
+    auto prevOutput = prev ? prev->Output : 0;
+    if (checkpoint->Output < prevOutput + m_ullInterval)
+        return;
+
+    auto it = std::upper_bound(m_stCheckpoints.begin(), m_stCheckpoints.end(), checkpoint->Output,
+        [](uint64_t position, const InflateCheckpointPtr& p) { return position < p->Output; });
+    m_stCheckpoints.emplace(it, std::move(checkpoint));
+}
+
+InflateCheckpointPtr InflateCheckpointIndex::FindNoLock(uint64_t position) const noexcept
+{
+    auto it = std::upper_bound(m_stCheckpoints.begin(), m_stCheckpoints.end(), position,
+        [](uint64_t position, const InflateCheckpointPtr& p) { return position < p->Output; });
+    if (it == m_stCheckpoints.begin())
+        return nullptr;
+    return *(it - 1);
+}
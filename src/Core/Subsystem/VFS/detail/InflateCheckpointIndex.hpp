@@ -0,0 +1,73 @@
+/**
+ * @file
+ * @date 2022/9/22
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace lstg::Subsystem::VFS::detail
+{
+    /**
+     * 解压检查点
+     * 记录 deflate 块边界处的解压状态，从检查点恢复后即可从该位置继续解压。
+     */
+    struct InflateCheckpoint
+    {
+        uint64_t Input = 0;  // 压缩数据中的位置（字节），若 Bits 不为 0，则前一个字节的高 Bits 位也属于该块
+        uint64_t Output = 0;  // 解压后数据中的位置
+        uint8_t Bits = 0;  // 前一个字节中尚未消耗的位数
+        std::vector<uint8_t> Window;  // 滑动窗口（最多 32k）
+    };
+
+    using InflateCheckpointPtr = std::shared_ptr<const InflateCheckpoint>;
+
+    /**
+     * 解压检查点索引
+     * 在解压过程中按照间隔逐步建立，可以在多个 Clone 出的流之间共享（线程安全）。
+     */
+    class InflateCheckpointIndex
+    {
+    public:
+        InflateCheckpointIndex(uint64_t interval) noexcept;
+
+    public:
+        /**
+         * 获取检查点间隔
+         */
+        [[nodiscard]] uint64_t GetInterval() const noexcept { return m_ullInterval; }
+
+        /**
+         * 查找不超过给定位置的最后一个检查点
+         * @param position 解压后数据中的位置
+         * @return 检查点，不存在时返回空
+         */
+        InflateCheckpointPtr Find(uint64_t position) const noexcept;
+
+        /**
+         * 检查给定位置是否需要放置检查点
+         * @param position 解压后数据中的位置
+         */
+        bool IsCheckpointRequired(uint64_t position) const noexcept;
+
+        /**
+         * 添加检查点
+         * @param checkpoint 检查点
+         */
+        void Add(InflateCheckpointPtr checkpoint);
+
+    private:
+        InflateCheckpointPtr FindNoLock(uint64_t position) const noexcept;
+
+    private:
+        const uint64_t m_ullInterval;
+        mutable std::mutex m_stMutex;
+        std::vector<InflateCheckpointPtr> m_stCheckpoints;  // 按照 Output 升序
+    };
+
+    using InflateCheckpointIndexPtr = std::shared_ptr<InflateCheckpointIndex>;
+}
@@ -9,6 +9,7 @@
 #include <lstg/Core/Subsystem/VFS/ContainerStream.hpp>
 #include <lstg/Core/Subsystem/VFS/WindowedStream.hpp>
 #include <lstg/Core/Subsystem/VFS/InflateStream.hpp>
+#include <lstg/Core/Subsystem/VFS/MemoryViewStream.hpp>
 #include "ZipPkDecryptStream.hpp"
 
 #include <limits>
@@ -267,14 +268,33 @@ Result<void> ZipFile::ReadFileEntries(ZipFileEntryContainer& out) noexcept
     return {};
 }
 
-Result<StreamPtr> ZipFile::OpenEntry(const ZipFileEntry& entry, std::string_view password) noexcept
+Result<StreamPtr> ZipFile::OpenEntry(const ZipFileEntry& entry, std::string_view password, bool randomAccess) noexcept
 {
-    // 复制以保证多线程使用安全
-    auto clone = m_pUnderlayStream->Clone();
-    if (!clone)
-        return clone.GetError();
+    // 底层数据常驻内存时（如内存映射文件），直接在视图上构造流
+    // 此时未加密且未压缩的条目可以零复制地访问
+    auto view = m_pUnderlayStream->GetMemoryView();
 
-    StreamPtr stream = static_pointer_cast<IStream>(std::move(*clone));
+    StreamPtr stream;
+    if (view)
+    {
+        try
+        {
+            stream = make_shared<MemoryViewStream>(*view, m_pUnderlayStream);
+        }
+        catch (...)  // bad_alloc
+        {
+            return make_error_code(errc::not_enough_memory);
+        }
+    }
+    else
+    {
+        // 复制以保证多线程使用安全
+        auto clone = m_pUnderlayStream->Clone();
+        if (!clone)
+            return clone.GetError();
+
+        stream = static_pointer_cast<IStream>(std::move(*clone));
+    }
 
     // 定位到范围
     auto ret = stream->Seek(static_cast<int64_t>(entry.LocalFileHeaderOffset), StreamSeekOrigins::Begin);
@@ -289,6 +309,19 @@ Result<StreamPtr> ZipFile::OpenEntry(const ZipFileEntry& entry, std::string_view
     try
     {
         // 封装范围
+        if (view)
+        {
+            auto dataOffset = stream->GetPosition();
+            if (!dataOffset)
+                return dataOffset.GetError();
+            if (*dataOffset + entry.CompressedSize > view->GetSize())
+                return make_error_code(ZipFileReadError::UnexpectedEndOfStream);
+
+            auto start = static_cast<size_t>(*dataOffset);
+            auto end = static_cast<size_t>(*dataOffset + entry.CompressedSize);
+            stream = make_shared<MemoryViewStream>(view->Slice(start, end), m_pUnderlayStream);
+        }
+        else
         {
             auto windowedStream = make_shared<WindowedStream>(std::move(stream), entry.CompressedSize);
             stream = static_pointer_cast<IStream>(std::move(windowedStream));
@@ -300,13 +333,15 @@ Result<StreamPtr> ZipFile::OpenEntry(const ZipFileEntry& entry, std::string_view
             shared_ptr<ZipPkDecryptStream> decryptStream;
             if (entry.EncryptMethod == ZipEncryptMethods::ZipCrypto)
             {
-                decryptStream = make_shared<ZipPkDecryptStream>(std::move(stream), password, GenPkVerifier(entry.Crc32));
+                decryptStream = make_shared<ZipPkDecryptStream>(std::move(stream), password, GenPkVerifier(entry.Crc32),
+                    randomAccess);
             }
             else
             {
                 assert(entry.EncryptMethod == ZipEncryptMethods::ZipCrypto2);
                 auto [dosTime, dosDate] = UnixTimestampToDosDateTime(entry.LastModified);
-                decryptStream = make_shared<ZipPkDecryptStream>(std::move(stream), password, GenPkVerifier2(dosTime, dosDate));
+                decryptStream = make_shared<ZipPkDecryptStream>(std::move(stream), password, GenPkVerifier2(dosTime, dosDate),
+                    randomAccess);
             }
             stream = static_pointer_cast<IStream>(std::move(decryptStream));
         }
@@ -314,7 +349,8 @@ Result<StreamPtr> ZipFile::OpenEntry(const ZipFileEntry& entry, std::string_view
         // 是否有压缩
         if (entry.CompressionMethod == ZipCompressionMethods::Deflate)
         {
-            auto decompressStream = make_shared<InflateStream>(std::move(stream), entry.UncompressedSize);
+            auto decompressStream = make_shared<InflateStream>(std::move(stream), entry.UncompressedSize,
+                randomAccess ? InflateStream::kDefaultCheckpointInterval : 0);
             stream = static_pointer_cast<IStream>(std::move(decompressStream));
         }
 
@@ -86,9 +86,10 @@ namespace lstg::Subsystem::VFS::detail
          * 打开文件
          * @param entry 条目
          * @param password 密码
+         * @param randomAccess 是否需要随机访问，压缩的条目会建立检查点索引
          * @return 错误码
          */
-        Result<StreamPtr> OpenEntry(const ZipFileEntry& entry, std::string_view password) noexcept;
+        Result<StreamPtr> OpenEntry(const ZipFileEntry& entry, std::string_view password, bool randomAccess = false) noexcept;
 
     private:
         Result<void> LocateCentralDirectory() noexcept;
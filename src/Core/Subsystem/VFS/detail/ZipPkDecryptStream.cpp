@@ -6,7 +6,8 @@
  */
 #include "ZipPkDecryptStream.hpp"
 
-#include <zlib-ng.h>
+#include <array>
+#include <algorithm>
 #include "ZipFileReadError.hpp"
 
 using namespace std;
@@ -17,7 +18,103 @@ using StreamPtr = lstg::Subsystem::VFS::StreamPtr;
 
 static const unsigned kPkCryptHeaderSize = 12;
 
-ZipPkDecryptStream::ZipPkDecryptStream(StreamPtr underlayStream, std::string_view password, uint16_t verify)
+namespace
+{
+    /**
+     * CRC32 查找表（多项式 0xEDB88320）
+     * 密钥更新每次只处理一个字节，直接查表比调用 crc32 函数快得多。
+     */
+    constexpr std::array<uint32_t, 256> MakeCrc32Table() noexcept
+    {
+        std::array<uint32_t, 256> table {};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1u) ? (0xEDB88320u ^ (c >> 1u)) : (c >> 1u);
+            table[i] = c;
+        }
+        return table;
+    }
+
+    constexpr std::array<uint32_t, 256> kCrc32Table = MakeCrc32Table();
+
+    inline uint32_t Crc32UpdateByte(uint32_t crc, uint8_t c) noexcept
+    {
+        return kCrc32Table[(crc ^ c) & 0xFFu] ^ (crc >> 8u);
+    }
+
+    inline void PkCryptUpdateKeys(uint32_t& key0, uint32_t& key1, uint32_t& key2, uint8_t c) noexcept
+    {
+        key0 = Crc32UpdateByte(key0, c);
+        key1 = (key1 + (key0 & 0xFFu)) * 134775813u + 1u;
+        key2 = Crc32UpdateByte(key2, static_cast<uint8_t>(key1 >> 24u));
+    }
+
+    /**
+     * 原地解密一段数据
+     * 密钥放在局部变量中，避免每个字节都读写内存。
+     * @param keys 密钥
+     * @param buffer 缓冲区
+     * @param length 长度
+     */
+    inline void PkCryptDecode(uint32_t (&keys)[3], uint8_t* buffer, size_t length) noexcept
+    {
+        auto key0 = keys[0];
+        auto key1 = keys[1];
+        auto key2 = keys[2];
+        for (size_t i = 0; i < length; ++i)
+        {
+            auto t = key2 | 2u;
+            auto c = static_cast<uint8_t>(buffer[i] ^ static_cast<uint8_t>(((t * (t ^ 1u)) >> 8u) & 0xFFu));
+            buffer[i] = c;
+            PkCryptUpdateKeys(key0, key1, key2, c);
+        }
+        keys[0] = key0;
+        keys[1] = key1;
+        keys[2] = key2;
+    }
+}
+
+// <editor-fold desc="ZipPkKeyIndex">
+
+ZipPkKeyIndex::ZipPkKeyIndex(const Keys& initialKeys)
+{
+    m_stKeys.push_back(initialKeys);
+}
+
+uint64_t ZipPkKeyIndex::Find(uint64_t position, Keys& keys) const noexcept
+{
+    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+    assert(!m_stKeys.empty());
+    auto index = static_cast<size_t>(std::min<uint64_t>(position / kInterval, m_stKeys.size() - 1));
+    keys = m_stKeys[index];
+    return index * kInterval;
+}
+
+void ZipPkKeyIndex::Add(uint64_t position, const Keys& keys) noexcept
+{
+    assert(position % kInterval == 0);
+    std::unique_lock<std::mutex> lockGuard(m_stMutex);
+
+    // 其他流可能已经记录过，或者中间的记录因为内存不足而缺失，此时放弃
+    if (position != m_stKeys.size() * kInterval)
+        return;
+
+    // 索引只用于加速，失败时直接忽略
+    try
+    {
+        m_stKeys.push_back(keys);
+    }
+    catch (...)  // bad_alloc
+    {
+    }
+}
+
+// </editor-fold>
+// <editor-fold desc="ZipPkDecryptStream">
+
+ZipPkDecryptStream::ZipPkDecryptStream(StreamPtr underlayStream, std::string_view password, uint16_t verify, bool randomAccess)
     : m_pUnderlayStream(std::move(underlayStream))
 {
     assert(m_pUnderlayStream);
@@ -30,7 +127,7 @@ ZipPkDecryptStream::ZipPkDecryptStream(StreamPtr underlayStream, std::string_vie
     m_uKeys[1] = 591751049u;
     m_uKeys[2] = 878082192u;
     for (char ch : password)
-        PkCryptUpdateKeys(static_cast<uint8_t>(ch));
+        PkCryptUpdateKeys(m_uKeys[0], m_uKeys[1], m_uKeys[2], static_cast<uint8_t>(ch));
 
     // 校验头
     uint8_t header[kPkCryptHeaderSize];
@@ -39,11 +136,9 @@ ZipPkDecryptStream::ZipPkDecryptStream(StreamPtr underlayStream, std::string_vie
     if (*ret != sizeof(header))
         throw system_error(ZipFileReadError::UnexpectedEndOfStream);
 
-    size_t i = 0;
-    for (; i < kPkCryptHeaderSize - 2; ++i)
-        header[i] = DecodeByte(header[i]);
-    auto calcVerify1 = DecodeByte(header[i++]);
-    auto calcVerify2 = DecodeByte(header[i++]);
+    PkCryptDecode(m_uKeys, header, sizeof(header));
+    auto calcVerify1 = header[kPkCryptHeaderSize - 2];
+    auto calcVerify2 = header[kPkCryptHeaderSize - 1];
 
     // 新版本只用一个字节进行校验
     static_cast<void>(verify1);
@@ -51,7 +146,8 @@ ZipPkDecryptStream::ZipPkDecryptStream(StreamPtr underlayStream, std::string_vie
     if ((calcVerify2 != 0) && (calcVerify2 != verify2))
         throw system_error(ZipFileReadError::BadPassword);
 
-    m_uReadCount += kPkCryptHeaderSize;
+    if (randomAccess)
+        m_pKeyIndex = make_shared<ZipPkKeyIndex>(ZipPkKeyIndex::Keys { m_uKeys[0], m_uKeys[1], m_uKeys[2] });
 }
 
 ZipPkDecryptStream::ZipPkDecryptStream(const ZipPkDecryptStream& org)
@@ -62,6 +158,11 @@ ZipPkDecryptStream::ZipPkDecryptStream(const ZipPkDecryptStream& org)
     m_uVerify1 = org.m_uVerify1;
     m_uVerify2 = org.m_uVerify2;
     m_uReadCount = org.m_uReadCount;
+    m_uDecodeCount = org.m_uDecodeCount;
+    m_pKeyIndex = org.m_pKeyIndex;
+    m_uReadAheadPosition = org.m_uReadAheadPosition;
+    m_uReadAheadSize = org.m_uReadAheadSize;
+    ::memcpy(m_stReadAhead, org.m_stReadAhead, m_uReadAheadSize);
 }
 
 bool ZipPkDecryptStream::IsReadable() const noexcept
@@ -76,7 +177,7 @@ bool ZipPkDecryptStream::IsWriteable() const noexcept
 
 bool ZipPkDecryptStream::IsSeekable() const noexcept
 {
-    return false;
+    return m_pKeyIndex && m_pUnderlayStream->IsSeekable();
 }
 
 Result<uint64_t> ZipPkDecryptStream::GetLength() const noexcept
@@ -102,11 +203,93 @@ Result<uint64_t> ZipPkDecryptStream::GetPosition() const noexcept
 
 Result<void> ZipPkDecryptStream::Seek(int64_t offset, StreamSeekOrigins origin) noexcept
 {
-    return make_error_code(errc::not_supported);
+    if (!IsSeekable())
+        return make_error_code(errc::not_supported);
+
+    auto length = GetLength();
+    if (!length)
+        return length.GetError();
+
+    // 计算目标位置，越界时截断到 [0, Length]
+    uint64_t target = 0;
+    switch (origin)
+    {
+        case StreamSeekOrigins::Begin:
+            target = static_cast<uint64_t>(std::max<int64_t>(0, offset));
+            break;
+        case StreamSeekOrigins::Current:
+            if (offset < 0)
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                target = (positive >= m_uReadCount) ? 0 : m_uReadCount - positive;
+            }
+            else
+            {
+                target = m_uReadCount + static_cast<uint64_t>(offset);
+            }
+            break;
+        case StreamSeekOrigins::End:
+            if (offset >= 0)
+            {
+                target = *length;
+            }
+            else
+            {
+                auto positive = static_cast<uint64_t>(-offset);
+                target = (positive >= *length) ? 0 : *length - positive;
+            }
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    target = std::min(target, *length);
+
+    // 预读缓冲区总是对应已解密数据的末尾，目标位于其中时只需移动读取位置
+    assert(m_uReadAheadSize <= m_uDecodeCount);
+    auto bufferStart = m_uDecodeCount - m_uReadAheadSize;
+    if (target >= bufferStart && target <= m_uDecodeCount)
+    {
+        m_uReadAheadPosition = static_cast<size_t>(target - bufferStart);
+        m_uReadCount = target;
+        return {};
+    }
+
+    // 向后 Seek，或者索引中的记录比当前位置更近时，从记录处恢复密钥
+    ZipPkKeyIndex::Keys keys;
+    auto indexed = m_pKeyIndex->Find(target, keys);
+    if (target < m_uDecodeCount || indexed > m_uDecodeCount)
+    {
+        auto ret = m_pUnderlayStream->Seek(static_cast<int64_t>(kPkCryptHeaderSize + indexed), StreamSeekOrigins::Begin);
+        if (!ret)
+            return ret.GetError();
+        m_uKeys[0] = keys[0];
+        m_uKeys[1] = keys[1];
+        m_uKeys[2] = keys[2];
+        m_uDecodeCount = indexed;
+    }
+    m_uReadAheadPosition = 0;
+    m_uReadAheadSize = 0;
+
+    // 解密并丢弃数据直到目标位置，途经的间隔会继续记录密钥
+    while (m_uDecodeCount < target)
+    {
+        auto count = m_pUnderlayStream->Read(m_stReadAhead,
+            static_cast<size_t>(std::min<uint64_t>(sizeof(m_stReadAhead), target - m_uDecodeCount)));
+        if (!count)
+            return count.GetError();
+        if (*count == 0)
+            break;
+        Decode(m_stReadAhead, *count);
+    }
+    m_uReadCount = m_uDecodeCount;
+    return {};
 }
 
 Result<bool> ZipPkDecryptStream::IsEof() const noexcept
 {
+    if (m_uReadAheadPosition < m_uReadAheadSize)
+        return false;
     return m_pUnderlayStream->IsEof();
 }
 
@@ -117,14 +300,55 @@ Result<void> ZipPkDecryptStream::Flush() noexcept
 
 Result<size_t> ZipPkDecryptStream::Read(uint8_t* buffer, size_t length) noexcept
 {
-    auto ret = m_pUnderlayStream->Read(buffer, length);
-    if (ret)
+    size_t total = 0;
+    while (total < length)
     {
-        length = *ret;
-        for (size_t i = 0; i < length; ++i)
-            buffer[i] = DecodeByte(buffer[i]);
+        // 先消耗预读缓冲区
+        if (m_uReadAheadPosition < m_uReadAheadSize)
+        {
+            auto count = std::min(length - total, m_uReadAheadSize - m_uReadAheadPosition);
+            ::memcpy(buffer + total, m_stReadAhead + m_uReadAheadPosition, count);
+            m_uReadAheadPosition += count;
+            total += count;
+            continue;
+        }
+
+        // 大块读取直接读入调用方的缓冲区，原地解密
+        auto remaining = length - total;
+        if (remaining >= sizeof(m_stReadAhead))
+        {
+            auto ret = m_pUnderlayStream->Read(buffer + total, remaining);
+            if (!ret)
+            {
+                m_uReadCount += total;
+                return ret;
+            }
+            Decode(buffer + total, *ret);
+            total += *ret;
+
+            // 预读缓冲区中的数据不再紧接着当前解密位置
+            m_uReadAheadPosition = 0;
+            m_uReadAheadSize = 0;
+            if (*ret == 0)
+                break;
+            continue;
+        }
+
+        // 小块读取时预读一整块
+        auto ret = m_pUnderlayStream->Read(m_stReadAhead, sizeof(m_stReadAhead));
+        if (!ret)
+        {
+            m_uReadCount += total;
+            return ret;
+        }
+        Decode(m_stReadAhead, *ret);
+        m_uReadAheadPosition = 0;
+        m_uReadAheadSize = *ret;
+        if (*ret == 0)
+            break;
     }
-    return ret;
+    m_uReadCount += total;
+    return total;
 }
 
 Result<void> ZipPkDecryptStream::Write(const uint8_t* buffer, size_t length) noexcept
@@ -148,24 +372,27 @@ Result<StreamPtr> ZipPkDecryptStream::Clone() const noexcept
     }
 }
 
-void ZipPkDecryptStream::PkCryptUpdateKeys(uint8_t c) noexcept
+void ZipPkDecryptStream::Decode(uint8_t* buffer, size_t length) noexcept
 {
-    uint8_t buf = c;
-    m_uKeys[0] = static_cast<uint32_t>(~::zng_crc32(static_cast<uint32_t>(~m_uKeys[0]), &buf, 1));
-
-    m_uKeys[1] += m_uKeys[0] & 0xFF;
-    m_uKeys[1] *= 134775813u;
-    m_uKeys[1] += 1;
+    if (!m_pKeyIndex)
+    {
+        PkCryptDecode(m_uKeys, buffer, length);
+        m_uDecodeCount += length;
+        return;
+    }
 
-    buf = static_cast<uint8_t>(m_uKeys[1] >> 24u);
-    m_uKeys[2] = static_cast<uint32_t>(~::zng_crc32(static_cast<uint32_t>(~m_uKeys[2]), &buf, 1));
+    // 在记录间隔处切开，记录密钥
+    while (length > 0)
+    {
+        auto next = (m_uDecodeCount / ZipPkKeyIndex::kInterval + 1) * ZipPkKeyIndex::kInterval;
+        auto count = static_cast<size_t>(std::min<uint64_t>(length, next - m_uDecodeCount));
+        PkCryptDecode(m_uKeys, buffer, count);
+        buffer += count;
+        length -= count;
+        m_uDecodeCount += count;
+        if (m_uDecodeCount == next)
+            m_pKeyIndex->Add(next, ZipPkKeyIndex::Keys { m_uKeys[0], m_uKeys[1], m_uKeys[2] });
+    }
 }
 
-uint8_t ZipPkDecryptStream::DecodeByte(uint8_t c) noexcept
-{
-    auto t = m_uKeys[2] | 2;
-    auto d = static_cast<uint8_t>(((t * (t ^ 1)) >> 8) & 0xFF);
-    c ^= d;
-    PkCryptUpdateKeys(c);
-    return c;
-}
+// </editor-fold>
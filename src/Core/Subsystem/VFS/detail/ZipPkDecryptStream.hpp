@@ -5,15 +5,75 @@
  * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
  */
 #pragma once
+#include <array>
+#include <mutex>
+#include <memory>
+#include <vector>
 #include <lstg/Core/Subsystem/VFS/IStream.hpp>
 
 namespace lstg::Subsystem::VFS::detail
 {
+    /**
+     * ZipCrypto 密钥索引
+     * 解密过程中每隔固定长度记录一次密钥，可以在多个 Clone 出的流之间共享（线程安全）。
+     */
+    class ZipPkKeyIndex
+    {
+    public:
+        /**
+         * 记录间隔
+         */
+        static const uint64_t kInterval = 4 * 1024;
+
+        using Keys = std::array<uint32_t, 3>;
+
+    public:
+        /**
+         * 构造索引
+         * @param initialKeys 加密数据起始处（加密头之后）的密钥
+         */
+        ZipPkKeyIndex(const Keys& initialKeys);
+
+    public:
+        /**
+         * 查找不超过给定位置的最后一个记录
+         * @param position 加密数据中的位置（不含加密头）
+         * @param keys 输出密钥
+         * @return 记录所在的位置
+         */
+        uint64_t Find(uint64_t position, Keys& keys) const noexcept;
+
+        /**
+         * 添加记录
+         * 只接受紧跟在最后一个记录之后的位置。
+         * @param position 位置，必须为间隔的整数倍
+         * @param keys 该位置的密钥
+         */
+        void Add(uint64_t position, const Keys& keys) noexcept;
+
+    private:
+        mutable std::mutex m_stMutex;
+        std::vector<Keys> m_stKeys;  // 第 i 项为位置 i * kInterval 处的密钥
+    };
+
+    using ZipPkKeyIndexPtr = std::shared_ptr<ZipPkKeyIndex>;
+
+    /**
+     * ZipCrypto 解密流
+     * 指定随机访问时会建立密钥索引，此时若底层流支持 Seek，则解密流支持随机访问，任意一次 Seek 最多需要解密一个记录间隔的数据。
+     */
     class ZipPkDecryptStream :
         public IStream
     {
     public:
-        ZipPkDecryptStream(StreamPtr underlayStream, std::string_view password, uint16_t verify);
+        /**
+         * 构造解密流
+         * @param underlayStream 底层流，当前位置须位于加密头起始处
+         * @param password 密码
+         * @param verify 校验值
+         * @param randomAccess 是否建立密钥索引以支持随机访问
+         */
+        ZipPkDecryptStream(StreamPtr underlayStream, std::string_view password, uint16_t verify, bool randomAccess = false);
         ZipPkDecryptStream(const ZipPkDecryptStream& org);
 
     public:  // IStream
@@ -31,8 +91,7 @@ namespace lstg::Subsystem::VFS::detail
         Result<StreamPtr> Clone() const noexcept override;
 
     private:
-        void PkCryptUpdateKeys(uint8_t c) noexcept;
-        uint8_t DecodeByte(uint8_t c) noexcept;
+        void Decode(uint8_t* buffer, size_t length) noexcept;
 
     private:
         StreamPtr m_pUnderlayStream;
@@ -40,5 +99,10 @@ namespace lstg::Subsystem::VFS::detail
         uint8_t m_uVerify1 = 0;
         uint8_t m_uVerify2 = 0;
         uint64_t m_uReadCount = 0;
+        uint64_t m_uDecodeCount = 0;  // 已从底层流读入并解密的字节数（不含加密头）
+        ZipPkKeyIndexPtr m_pKeyIndex;  // 为空时不支持随机访问
+        size_t m_uReadAheadPosition = 0;  // 预读缓冲区中下一个未读字节的位置
+        size_t m_uReadAheadSize = 0;  // 预读缓冲区中已解密的字节数
+        uint8_t m_stReadAhead[64 * 1024];  // 64k，小块读取时一次从底层流读入并解密较大的块
     };
 }
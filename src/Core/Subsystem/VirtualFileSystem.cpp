@@ -6,10 +6,16 @@
  */
 #include <lstg/Core/Subsystem/VirtualFileSystem.hpp>
 
+#include <algorithm>
+#include <lstg/Core/Logging.hpp>
+#include <lstg/Core/Subsystem/VFS/MemoryViewStream.hpp>
+
 using namespace std;
 using namespace lstg;
 using namespace lstg::Subsystem;
 
+LSTG_DEF_LOG_CATEGORY(VirtualFileSystem);
+
 namespace
 {
     Result<VFS::Path> NormalizePath(std::string_view path) noexcept
@@ -43,6 +49,7 @@ Result<void> VirtualFileSystem::Remove(std::string_view path) noexcept
     auto npath = NormalizePath(path);
     if (!npath)
         return npath.GetError();
+    ClearPrefetchCache();
     return m_stRootFileSystem.Remove(*npath);
 }
 
@@ -54,6 +61,7 @@ Result<void> VirtualFileSystem::Rename(std::string_view from, std::string_view t
     auto nto = NormalizePath(to);
     if (!nto)
         return nto.GetError();
+    ClearPrefetchCache();
     return m_stRootFileSystem.Rename(*nfrom, *nto);
 }
 
@@ -78,9 +86,174 @@ Result<VFS::StreamPtr> VirtualFileSystem::OpenFile(std::string_view path, VFS::F
     auto npath = NormalizePath(path);
     if (!npath)
         return npath.GetError();
+
+    // 优先使用预取的数据
+    if (m_uPrefetchCacheCount.load(memory_order_acquire) > 0)
+    {
+        if (access == VFS::FileAccessMode::Read)
+        {
+            auto ret = TakePrefetchedFile(*npath);
+            if (ret)
+                return ret;
+        }
+        else
+        {
+            InvalidatePrefetchedFile(*npath);
+        }
+    }
     return m_stRootFileSystem.OpenFile(*npath, access, flags);
 }
 
+Result<size_t> VirtualFileSystem::Prefetch(Span<const std::string> paths) noexcept
+{
+    struct PrefetchTask
+    {
+        VFS::Path Path;
+        std::shared_ptr<const std::vector<uint8_t>> Data;
+    };
+
+    if (paths.IsEmpty() || m_uPrefetchCacheLimit == 0)
+        return static_cast<size_t>(0u);
+
+    // 规格化路径，剔除重复的和已经缓存的文件
+    std::vector<PrefetchTask> tasks;
+    size_t budget = 0;
+    try
+    {
+        tasks.reserve(paths.GetSize());
+        for (size_t i = 0; i < paths.GetSize(); ++i)
+            tasks.push_back({ VFS::Path::Normalize(paths[i]), {} });
+        std::sort(tasks.begin(), tasks.end(), [](const PrefetchTask& lhs, const PrefetchTask& rhs) {
+            return lhs.Path.ToStringView() < rhs.Path.ToStringView();
+        });
+        tasks.erase(std::unique(tasks.begin(), tasks.end(), [](const PrefetchTask& lhs, const PrefetchTask& rhs) {
+            return lhs.Path.ToStringView() == rhs.Path.ToStringView();
+        }), tasks.end());
+
+        std::unique_lock<std::mutex> lockGuard(m_stPrefetchCacheMutex);
+        if (m_uPrefetchCacheBytes >= m_uPrefetchCacheLimit)
+            return static_cast<size_t>(0u);
+        budget = m_uPrefetchCacheLimit - m_uPrefetchCacheBytes;
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [this](const PrefetchTask& task) {
+            return m_stPrefetchCache.find(string{task.Path.ToStringView()}) != m_stPrefetchCache.end();
+        }), tasks.end());
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+
+    // 惰性创建工作线程，当前线程同样参与执行
+    // 单核时并行只会带来额外的线程切换，直接串行执行；核心数未知（为 0）时按双核处理
+    auto systemThreads = ThreadPool<>::GetSystemThreadCount();
+    if (!m_pPrefetchThreads && systemThreads != 1)
+    {
+        try
+        {
+            m_pPrefetchThreads = make_unique<ThreadPool<>>(std::max(2u, systemThreads) - 1);
+        }
+        catch (...)
+        {
+            LSTG_LOG_WARN_CAT(VirtualFileSystem, "Cannot create prefetch threads, prefetching serially");
+        }
+    }
+
+    // 并行读取，缓存空间通过原子变量领取
+    std::atomic<size_t> remaining { budget };
+    auto job = [&](size_t index) noexcept {
+        auto& task = tasks[index];
+
+        auto stream = m_stRootFileSystem.OpenFile(task.Path, VFS::FileAccessMode::Read, VFS::FileOpenFlags::None);
+        if (!stream)
+            return;
+
+        // 数据常驻内存时无需缓存
+        if ((*stream)->GetMemoryView())
+            return;
+
+        // 长度已知时提前跳过放不下的文件
+        auto length = (*stream)->GetLength();
+        if (length && *length > remaining.load(memory_order_relaxed))
+            return;
+
+        try
+        {
+            auto data = make_shared<std::vector<uint8_t>>();
+            if (length)
+                data->reserve(static_cast<size_t>(*length));
+            if (!VFS::ReadAll(*data, stream->get()))
+                return;
+
+            auto size = data->size();
+            auto avail = remaining.load(memory_order_relaxed);
+            do
+            {
+                if (avail < size)
+                    return;
+            } while (!remaining.compare_exchange_weak(avail, avail - size, memory_order_relaxed));
+
+            task.Data = std::move(data);
+        }
+        catch (...)  // bad_alloc
+        {
+        }
+    };
+    if (m_pPrefetchThreads)
+    {
+        m_pPrefetchThreads->ParallelFor(tasks.size(), job);
+    }
+    else
+    {
+        for (size_t i = 0; i < tasks.size(); ++i)
+            job(i);
+    }
+
+    // 放入缓存
+    size_t count = 0;
+    size_t cacheBytes = 0;
+    {
+        std::unique_lock<std::mutex> lockGuard(m_stPrefetchCacheMutex);
+        for (auto& task : tasks)
+        {
+            if (!task.Data)
+                continue;
+
+            // 期间缓存只会因为打开文件而减少，这里再做一次防御性检查
+            auto size = task.Data->size();
+            if (m_uPrefetchCacheBytes + size > m_uPrefetchCacheLimit)
+                continue;
+
+            try
+            {
+                auto ret = m_stPrefetchCache.emplace(task.Path.ToStringView(), std::move(task.Data));
+                if (!ret.second)
+                    continue;
+            }
+            catch (...)  // bad_alloc
+            {
+                break;
+            }
+            m_uPrefetchCacheBytes += size;
+            ++count;
+        }
+        m_uPrefetchCacheCount.store(m_stPrefetchCache.size(), memory_order_release);
+        cacheBytes = m_uPrefetchCacheBytes;
+    }
+    LSTG_LOG_TRACE_CAT(VirtualFileSystem, "{} of {} file(s) prefetched, cache size {} bytes", count, tasks.size(), cacheBytes);
+    return count;
+}
+
+void VirtualFileSystem::ClearPrefetchCache() noexcept
+{
+    if (m_uPrefetchCacheCount.load(memory_order_acquire) == 0)
+        return;
+
+    std::unique_lock<std::mutex> lockGuard(m_stPrefetchCacheMutex);
+    m_stPrefetchCache.clear();
+    m_uPrefetchCacheBytes = 0;
+    m_uPrefetchCacheCount.store(0, memory_order_release);
+}
+
 Result<size_t> VirtualFileSystem::ReadFile(std::vector<uint8_t>& out, std::string_view path)
 {
     out.clear();
@@ -90,6 +263,22 @@ Result<size_t> VirtualFileSystem::ReadFile(std::vector<uint8_t>& out, std::strin
     if (!stream)
         return stream.GetError();
 
+    // 数据常驻内存时直接复制
+    auto view = (*stream)->GetMemoryView();
+    if (view)
+    {
+        try
+        {
+            out.assign(view->GetData(), view->GetData() + view->GetSize());
+        }
+        catch (...)  // bad_alloc
+        {
+            out.clear();
+            return make_error_code(errc::not_enough_memory);
+        }
+        return out.size();
+    }
+
     // 发起读操作
     static const unsigned kExpandSize = 16 * 1024;  // 16k
 
@@ -129,6 +318,7 @@ Result<void> VirtualFileSystem::Mount(std::string_view path, VFS::FileSystemPtr
     auto npath = NormalizePath(path);
     if (!npath)
         return npath.GetError();
+    ClearPrefetchCache();
     try
     {
         m_stRootFileSystem.Mount(*npath, std::move(fs));
@@ -145,5 +335,59 @@ Result<bool> VirtualFileSystem::Unmount(std::string_view path) noexcept
     auto npath = NormalizePath(path);
     if (!npath)
         return npath.GetError();
+    ClearPrefetchCache();
     return m_stRootFileSystem.Unmount(*npath);
 }
+
+Result<VFS::StreamPtr> VirtualFileSystem::TakePrefetchedFile(const VFS::Path& path) noexcept
+{
+    std::shared_ptr<const std::vector<uint8_t>> data;
+    try
+    {
+        std::unique_lock<std::mutex> lockGuard(m_stPrefetchCacheMutex);
+        auto it = m_stPrefetchCache.find(string{path.ToStringView()});
+        if (it == m_stPrefetchCache.end())
+            return make_error_code(errc::no_such_file_or_directory);
+
+        data = std::move(it->second);
+        m_stPrefetchCache.erase(it);
+        assert(m_uPrefetchCacheBytes >= data->size());
+        m_uPrefetchCacheBytes -= data->size();
+        m_uPrefetchCacheCount.store(m_stPrefetchCache.size(), memory_order_release);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+
+    try
+    {
+        Span<const uint8_t> view { data->data(), data->size() };
+        return make_shared<VFS::MemoryViewStream>(view, std::move(data));
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+void VirtualFileSystem::InvalidatePrefetchedFile(const VFS::Path& path) noexcept
+{
+    try
+    {
+        std::unique_lock<std::mutex> lockGuard(m_stPrefetchCacheMutex);
+        auto it = m_stPrefetchCache.find(string{path.ToStringView()});
+        if (it == m_stPrefetchCache.end())
+            return;
+
+        assert(m_uPrefetchCacheBytes >= it->second->size());
+        m_uPrefetchCacheBytes -= it->second->size();
+        m_stPrefetchCache.erase(it);
+        m_uPrefetchCacheCount.store(m_stPrefetchCache.size(), memory_order_release);
+    }
+    catch (...)  // bad_alloc
+    {
+        // 无法定位时清空整个缓存，保证不会读到旧数据
+        ClearPrefetchCache();
+    }
+}
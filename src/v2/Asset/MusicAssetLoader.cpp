@@ -39,7 +39,8 @@ Result<void> MusicAssetLoader::PreLoad() noexcept
     }
 
     // 在主线程打开文件流
-    auto stream = AssetSystem::GetInstance().OpenAssetStream(asset->GetPath());
+    // 音频解码器会随机访问，要求压缩的条目支持 Seek，避免整个解压到内存中
+    auto stream = AssetSystem::GetInstance().OpenAssetStream(asset->GetPath(), VFS::FileOpenFlags::RandomAccess);
     if (!stream)
     {
         LSTG_LOG_ERROR_CAT(MusicAssetLoader, "Open asset stream from \"{}\" fail: {}", asset->GetPath(), stream.GetError());
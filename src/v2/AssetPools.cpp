@@ -65,6 +65,47 @@ Subsystem::Asset::AssetPtr AssetPools::FindAsset(AssetTypes type, std::string_vi
     return OnResolveAsset(m_stTmpNameBuffer);
 }
 
+Subsystem::Asset::Asset* AssetPools::FindAssetInterned(AssetTypes type, const char* name) const noexcept
+{
+    assert(name);
+
+    // 直接映射，冲突时覆盖旧的条目
+    auto hash = reinterpret_cast<uintptr_t>(name);
+    hash = (hash >> 4) ^ (hash >> 12) ^ static_cast<uintptr_t>(type);
+    auto& entry = m_stInternedLookupCache[hash % kInternedLookupCacheSize];
+
+    auto stageGeneration = m_pStageAssetPool->GetGeneration();
+    auto globalGeneration = m_pGlobalAssetPool->GetGeneration();
+    if (entry.Key == name && entry.Type == type && entry.StageGeneration == stageGeneration &&
+        entry.GlobalGeneration == globalGeneration && entry.Name == name)
+    {
+        assert(entry.Asset);
+        return entry.Asset;
+    }
+
+    auto asset = FindAsset(type, name);
+    if (!asset)
+        return nullptr;
+
+    // 缓存只保存裸指针，不能影响资产的引用计数，否则 Clear(Unused) 无法回收
+    // 资产被删除时资源池的世代号一定会变化，因此命中时指针总是有效的
+    try
+    {
+        entry.Name = name;
+        entry.Key = name;
+        entry.Type = type;
+        entry.StageGeneration = stageGeneration;
+        entry.GlobalGeneration = globalGeneration;
+        entry.Asset = asset.get();
+    }
+    catch (...)  // bad_alloc
+    {
+        entry.Key = nullptr;
+        entry.Asset = nullptr;
+    }
+    return asset.get();
+}
+
 std::tuple<AssetPoolTypes, Subsystem::Asset::AssetPoolPtr> AssetPools::LocateAsset(AssetTypes type, std::string_view name) const noexcept
 {
     auto ret = MakeFullAssetName(m_stTmpNameBuffer, type, name);
@@ -141,8 +182,10 @@ void AssetPools::ClearAssetPool(AssetPoolTypes pool) noexcept
 Subsystem::Asset::AssetPtr AssetPools::OnResolveAsset(std::string_view name) const noexcept
 {
     // OnResolveAsset 是内部使用的方法，故这里已经带上了前缀
-    auto ret = m_pStageAssetPool->GetAsset(name);
+    // 两个池子使用相同的哈希函数，只需计算一次
+    auto hash = Subsystem::Asset::AssetPool::HashName(name);
+    auto ret = m_pStageAssetPool->GetAsset(name, hash);
     if (!ret)
-        ret = m_pGlobalAssetPool->GetAsset(name);
+        ret = m_pGlobalAssetPool->GetAsset(name, hash);
     return ret;
 }
@@ -205,7 +205,7 @@ GameObjectModule::Unpack<double, double> GameObjectModule::GetObjectVelocity(Lua
         stack.Error("invalid lstg object for 'GetV'.");
 
     // 返回速度大小和方向
-    auto v = movementComponent->Velocity;
+    Vec2 v = movementComponent->Velocity;
     auto vlen = glm::length(v);
     double angle = 0;
     if (vlen != 0)
@@ -241,12 +241,12 @@ void GameObjectModule::SetObjectVelocity(LuaStack& stack, AbsIndex object, doubl
         stack.Error("invalid lstg object for 'SetV'.");
 
     angle = glm::radians(angle);
-    movementComponent->Velocity.x = velocity * ::cos(angle);
-    movementComponent->Velocity.y = velocity * ::sin(angle);
+    movementComponent->Velocity.x = static_cast<ComponentScalar>(velocity * ::cos(angle));
+    movementComponent->Velocity.y = static_cast<ComponentScalar>(velocity * ::sin(angle));
     if (track && *track)
     {
         assert(transformComponent);
-        transformComponent->Rotation = angle;
+        transformComponent->Rotation = static_cast<ComponentScalar>(angle);
     }
 }
 
@@ -337,7 +337,7 @@ double GameObjectModule::CalculateAngle(LuaStack& stack, std::variant<double, Ab
             stack.Error("invalid lstg object #2 for 'Angle'.");
 
         // 计算结果
-        auto dt = transformComponent2->Location - transformComponent1->Location;
+        auto dt = Vec2 { transformComponent2->Location } - Vec2 { transformComponent1->Location };
         return dt.x == 0 && dt.y == 0 ? 0 : glm::degrees(::atan2(dt.y, dt.x));
     }
     else
@@ -385,7 +385,7 @@ double GameObjectModule::CalculateDistance(LuaStack& stack, std::variant<double,
             stack.Error("invalid lstg object #2 for 'Dist'.");
 
         // 计算结果
-        auto dt = transformComponent2->Location - transformComponent1->Location;
+        auto dt = Vec2 { transformComponent2->Location } - Vec2 { transformComponent1->Location };
         return glm::length(dt);
     }
     else
@@ -420,7 +420,7 @@ bool GameObjectModule::BoxCheck(LuaStack& stack, AbsIndex object, double left, d
     if (!transformComponent)
         stack.Error("invalid lstg object for 'BoxCheck'.");
 
-    auto loc = transformComponent->Location;
+    Vec2 loc = transformComponent->Location;
     return (loc.x > left && loc.x < right && loc.y > bottom && loc.y < top);
 }
 
@@ -112,26 +112,22 @@ void RenderModule::Render(LuaStack& stack, const char* imageName, double x, doub
     auto assetPools = detail::GetGlobalApp().GetAssetPools();
 
     // 获取精灵对象
-    auto asset = assetPools->FindAsset(AssetTypes::Image, imageName);
+    auto asset = assetPools->FindAssetInterned(AssetTypes::Image, imageName);
     if (!asset)
         stack.Error("image '%s' not found.", imageName);
     assert(asset);
     assert(asset->GetAssetTypeId() == Asset::SpriteAsset::GetAssetTypeIdStatic());
 
-    auto spriteAsset = static_pointer_cast<Asset::SpriteAsset>(asset);
+    auto spriteAsset = static_cast<Asset::SpriteAsset*>(asset);
 
     // 准备渲染
     auto& cmdBuffer = detail::GetGlobalApp().GetCommandBuffer();
-    auto drawing = spriteAsset->GetDrawingSprite().Draw(cmdBuffer);
-    if (!drawing)
-    {
-        LSTG_LOG_ERROR_CAT(RenderModule, "draw image '%s' fail: %s", imageName, drawing.GetError().message().c_str());
-        return;
-    }
-
-    drawing->Transform(rot ? static_cast<float>(glm::radians(*rot)) : 0.f, hscale ? static_cast<float>(*hscale) : 1.f,
-        vscale ? static_cast<float>(*vscale) : 1.f);
-    drawing->Translate(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z ? *z : 0.5));
+    auto ret = spriteAsset->GetDrawingSprite().DrawInstance(cmdBuffer,
+        { static_cast<float>(x), static_cast<float>(y), static_cast<float>(z ? *z : 0.5) },
+        rot ? static_cast<float>(glm::radians(*rot)) : 0.f,
+        { hscale ? static_cast<float>(*hscale) : 1.f, vscale ? static_cast<float>(*vscale) : 1.f });
+    if (!ret)
+        LSTG_LOG_ERROR_CAT(RenderModule, "draw image '%s' fail: %s", imageName, ret.GetError().message().c_str());
 }
 
 void RenderModule::RenderRect(LuaStack& stack, const char* imageName, double left, double right, double bottom, double top)
@@ -139,13 +135,13 @@ void RenderModule::RenderRect(LuaStack& stack, const char* imageName, double lef
     auto assetPools = detail::GetGlobalApp().GetAssetPools();
 
     // 获取精灵对象
-    auto asset = assetPools->FindAsset(AssetTypes::Image, imageName);
+    auto asset = assetPools->FindAssetInterned(AssetTypes::Image, imageName);
     if (!asset)
         stack.Error("image '%s' not found.", imageName);
     assert(asset);
     assert(asset->GetAssetTypeId() == Asset::SpriteAsset::GetAssetTypeIdStatic());
 
-    auto spriteAsset = static_pointer_cast<Asset::SpriteAsset>(asset);
+    auto spriteAsset = static_cast<Asset::SpriteAsset*>(asset);
 
     // 准备渲染
     auto& cmdBuffer = detail::GetGlobalApp().GetCommandBuffer();
@@ -166,13 +162,13 @@ void RenderModule::RenderVertex(LuaStack& stack, const char* imageName, double x
     auto assetPools = detail::GetGlobalApp().GetAssetPools();
 
     // 获取精灵对象
-    auto asset = assetPools->FindAsset(AssetTypes::Image, imageName);
+    auto asset = assetPools->FindAssetInterned(AssetTypes::Image, imageName);
     if (!asset)
         stack.Error("image '%s' not found.", imageName);
     assert(asset);
     assert(asset->GetAssetTypeId() == Asset::SpriteAsset::GetAssetTypeIdStatic());
 
-    auto spriteAsset = static_pointer_cast<Asset::SpriteAsset>(asset);
+    auto spriteAsset = static_cast<Asset::SpriteAsset*>(asset);
 
     // 准备渲染
     auto& cmdBuffer = detail::GetGlobalApp().GetCommandBuffer();
@@ -198,13 +194,13 @@ void RenderModule::RenderTexture(LuaStack& stack, const char* textureName, const
     auto assetPools = app.GetAssetPools();
 
     // 获取纹理对象
-    auto asset = assetPools->FindAsset(AssetTypes::Texture, textureName);
+    auto asset = assetPools->FindAssetInterned(AssetTypes::Texture, textureName);
     if (!asset)
         stack.Error("texture '%s' not found.", textureName);
     assert(asset);
     assert(asset->GetAssetTypeId() == Asset::TextureAsset::GetAssetTypeIdStatic());
 
-    auto textureAsset = static_pointer_cast<Asset::TextureAsset>(asset);
+    auto textureAsset = static_cast<Asset::TextureAsset*>(asset);
     auto tex = textureAsset->GetDrawingTexture().GetUnderlayTexture();
     auto width = textureAsset->GetWidth();
     auto height = textureAsset->GetHeight();
@@ -8,6 +8,7 @@
 
 #include <cassert>
 #include <lstg/Core/Logging.hpp>
+#include <lstg/Core/Subsystem/AssetSystem.hpp>
 #include <lstg/Core/Subsystem/ProfileSystem.hpp>
 #include <lstg/Core/Subsystem/RenderSystem.hpp>
 #include <lstg/Core/Subsystem/ScriptSystem.hpp>
@@ -168,6 +169,31 @@ void SystemModule::ExtractRes(const char* path, const char* target)
     LSTG_LOG_DEPRECATED(SystemModule, ExtractRes);
 }
 
+void SystemModule::PrefetchRes(LuaStack& stack, AbsIndex paths)
+{
+    if (stack.TypeOf(paths) != LUA_TTABLE)
+        stack.Error("table expected");
+
+    std::vector<std::string_view> list;
+    auto cnt = lua_objlen(stack, paths);
+    list.reserve(cnt);
+    for (size_t i = 1; i <= cnt; ++i)
+    {
+        stack.RawGet(paths, static_cast<int>(i));  // t ... s
+        size_t len = 0;
+        auto str = lua_tolstring(stack, -1, &len);
+        lua_pop(stack, 1);
+
+        // 字符串仍然被表引用，出栈后依然有效
+        if (str)
+            list.emplace_back(str, len);
+    }
+
+    auto ret = GetApp().GetSubsystem<AssetSystem>()->PrefetchAssetStreams(Span<const std::string_view>{list});
+    if (!ret)
+        LSTG_LOG_WARN_CAT(SystemModule, "Prefetch resources fail: {}", ret.GetError());
+}
+
 void SystemModule::DoFile(LuaStack& stack, const char* path)
 {
     auto ec = GetApp().GetSubsystem<ScriptSystem>()->LoadScript(detail::ResolveAbsoluteOrRelativePath(stack, path));
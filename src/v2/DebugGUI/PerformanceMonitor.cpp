@@ -31,6 +31,11 @@ PerformanceMonitor::PerformanceMonitor()
     AddInstrument("GameWorld - Time", "Run Loop Method Time", "UpdateXY", "GameWorld_UpdateXY");
     AddInstrument("GameWorld - Time", "Run Loop Method Time", "AfterFrame", "GameWorld_AfterFrame");
     AddInstrument("GameWorld - Time", "Run Loop Method Time", "CollisionCheck", "GameWorld_CollisionCheck");
+    AddInstrument("GameWorld - Collision", "Collision Pairs", "Potential", "GameWorld_CollisionPotentialPairs");
+    AddInstrument("GameWorld - Collision", "Collision Pairs", "Candidate", "GameWorld_CollisionCandidatePairs");
+    AddInstrument("GameWorld - Collision", "Collision Pairs", "NarrowPhase", "GameWorld_CollisionNarrowPhaseTests");
+    AddInstrument("GameWorld - Render", "Render Calls", "Native", "GameWorld_RenderNativeCalls");
+    AddInstrument("GameWorld - Render", "Render Calls", "Script", "GameWorld_RenderScriptCalls");
     AddInstrument("GameWorld - Memory", "Entity Count", "Allocated", "GameWorld_ECSAllocatedCount");
     AddInstrument("GameWorld - Memory", "Entity Count", "Used", "GameWorld_ECSUsedCount");
     AddInstrument("GameWorld - Memory", "Memory Usage (KB)", "ECSAllocated", "GameWorld_ECSAllocated");
@@ -41,6 +46,7 @@ PerformanceMonitor::PerformanceMonitor()
     AddInstrument("Draw", "Primitives", "Vertex", "Draw_VertexCount");
     AddInstrument("Draw", "Primitives", "Primitive", "Draw_PrimitiveCount");
     AddInstrument("Draw", "Draw Calls", "Count", "Draw_DrawCallCount");
+    AddInstrument("Draw", "Draw Calls", "BeforeMerge", "Draw_DrawCallCountBeforeMerge");
 
     // ScriptSystem.cpp
     AddInstrument("ScriptSystem", "VM Memory Usage (KB)", "Usage", "ScriptSystem_VMHeapSize");
@@ -22,6 +22,7 @@
 #include <lstg/Core/Subsystem/DebugGUI/ConsoleWindow.hpp>
 #include <lstg/Core/Subsystem/VFS/FileStream.hpp>
 #include <lstg/Core/Subsystem/VFS/LocalFileSystem.hpp>
+#include <lstg/Core/Subsystem/VFS/MappedFileStream.hpp>
 #include <lstg/Core/Subsystem/VFS/ZipArchiveFileSystem.hpp>
 #include <lstg/Core/Subsystem/Script/LuaStack.hpp>
 #include <lstg/Core/Subsystem/AudioSystem.hpp>
@@ -171,6 +172,20 @@ GameApp::GameApp(int argc, const char* argv[])
                                       static_cast<float>(m_stViewportBound.Width()), static_cast<float>(m_stViewportBound.Height()));
         m_stCommandBuffer.End();
 
+        // 是否开启精灵实例化绘制
+        if (GetCmdline().GetOption<bool>("sprite-instancing", false))
+        {
+            LSTG_LOG_INFO_CAT(GameApp, "Sprite instancing is enabled");
+            m_stCommandBuffer.SetInstancingEnabled(true);
+        }
+
+        // 是否开启绘制命令重排
+        if (GetCmdline().GetOption<bool>("command-reorder", false))
+        {
+            LSTG_LOG_INFO_CAT(GameApp, "Draw command reordering is enabled");
+            m_stCommandBuffer.SetReorderEnabled(true);
+        }
+
         // 初始化文字渲染组件
         m_pTextShaper = Subsystem::Render::Font::CreateHarfBuzzTextShaper();
         m_pFontGlyphAtlas = make_shared<Subsystem::Render::Font::DynamicFontGlyphAtlas>(renderSystem);
@@ -305,9 +320,17 @@ Result<void> GameApp::MountAssetPack(std::string_view path, std::optional<std::s
         {
             try
             {
-                auto fsStream = make_shared<Subsystem::VFS::FileStream>(path, Subsystem::VFS::FileAccessMode::Read,
-                    Subsystem::VFS::FileOpenFlags::None);
-                packageStream = std::move(fsStream);
+                // 优先使用内存映射，失败时回退到普通文件流
+                try
+                {
+                    packageStream = make_shared<Subsystem::VFS::MappedFileStream>(path);
+                }
+                catch (const std::system_error& ex)
+                {
+                    LSTG_LOG_WARN_CAT(GameApp, "Map asset pack \"{}\" fail, fallback to file stream: {}", path, ex.code());
+                    packageStream = make_shared<Subsystem::VFS::FileStream>(path, Subsystem::VFS::FileAccessMode::Read,
+                        Subsystem::VFS::FileOpenFlags::None);
+                }
             }
             catch (const std::system_error& ex)
             {
@@ -324,7 +347,8 @@ Result<void> GameApp::MountAssetPack(std::string_view path, std::optional<std::s
         {
             // 尝试加载流
             auto fullPath = fmt::format("{}/{}", GetSubsystem<Subsystem::VirtualFileSystem>()->GetAssetBaseDirectory(), path);
-            auto stream = GetSubsystem<Subsystem::VirtualFileSystem>()->OpenFile(fullPath, Subsystem::VFS::FileAccessMode::Read);
+            auto stream = GetSubsystem<Subsystem::VirtualFileSystem>()->OpenFile(fullPath, Subsystem::VFS::FileAccessMode::Read,
+                Subsystem::VFS::FileOpenFlags::MemoryMapped);
             if (!stream)
             {
                 LSTG_LOG_ERROR_CAT(GameApp, "Open asset pack from \"{}\" fail: {}", path, stream.GetError());
@@ -798,6 +822,7 @@ void GameApp::OnRender(double elapsed) noexcept
         ADD_COUNTER(Draw_VertexCount, static_cast<double>(drawData.VertexBuffer.size()));
         ADD_COUNTER(Draw_PrimitiveCount, static_cast<double>(drawData.IndexBuffer.size() / 6));
         ADD_COUNTER(Draw_DrawCallCount, static_cast<double>(m_stCommandExecutor.GetLastExecutedDrawCalls()));
+        ADD_COUNTER(Draw_DrawCallCountBeforeMerge, static_cast<double>(m_stCommandBuffer.GetLastCommandCountBeforeReorder()));
 #undef ADD_COUNTER
 #endif
     }
@@ -55,7 +55,7 @@ bool BentLaser::Update(ScriptObjectId id, int32_t length, double width) noexcept
     if (m_stQueue.GetSize() < static_cast<size_t>(length))
     {
         LaserNode node;
-        node.Location = transformComponent->Location;
+        node.Location = Vec2 { transformComponent->Location };
         node.HalfWidth = width / 2.;
         m_stQueue.Push(node);
 
@@ -0,0 +1,218 @@
+/**
+ * @file
+ * @date 2022/9/3
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include <lstg/v2/GamePlay/CollisionBroadPhase.hpp>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::v2::GamePlay;
+
+static const double kMinCellSize = 8.;  // 单元格最小尺寸
+static const double kCellSizeScale = 2.;  // 单元格尺寸相对于平均对象尺寸的倍数
+static const uint32_t kMaxGridDimension = 128;  // 网格在单个方向上的最大单元格数
+static const uint32_t kOversizedCell = std::numeric_limits<uint32_t>::max();
+
+namespace
+{
+    /**
+     * 计算坐标区间覆盖的单元格范围
+     * @return 是否覆盖了至少一个单元格
+     */
+    bool GetCellRange(double lower, double upper, double origin, double cellSize, uint32_t count, uint32_t& first,
+        uint32_t& last) noexcept
+    {
+        assert(count > 0);
+        auto f = std::floor((lower - origin) / cellSize);
+        auto l = std::floor((upper - origin) / cellSize);
+        if (l < 0. || f > static_cast<double>(count - 1))
+            return false;
+        first = static_cast<uint32_t>(std::max(f, 0.));
+        last = static_cast<uint32_t>(std::min(l, static_cast<double>(count - 1)));
+        return true;
+    }
+}
+
+void CollisionBroadPhase::Reset(uint64_t version) noexcept
+{
+    m_uVersion = version;
+    m_stProxies.clear();
+    m_uColumns = m_uRows = 0;
+    m_stCellStart.clear();
+    m_stCellItems.clear();
+    m_stOversizedItems.clear();
+}
+
+Result<void> CollisionBroadPhase::AddProxy(ECS::Entity entity, double x, double y, double halfWidth, double halfHeight) noexcept
+{
+    assert(m_stProxies.size() < kOversizedCell);
+    try
+    {
+        Proxy proxy;
+        proxy.BindingEntity = entity;
+        proxy.X = x;
+        proxy.Y = y;
+        proxy.HalfWidth = halfWidth;
+        proxy.HalfHeight = halfHeight;
+        m_stProxies.push_back(proxy);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    return {};
+}
+
+Result<void> CollisionBroadPhase::Build() noexcept
+{
+    m_uColumns = m_uRows = 0;
+    m_stCellStart.clear();
+    m_stCellItems.clear();
+    m_stOversizedItems.clear();
+    if (m_stProxies.empty())
+        return {};
+
+    try
+    {
+        // 根据对象的平均大小决定单元格尺寸
+        double totalSize = 0.;
+        size_t totalCount = 0;
+        for (const auto& proxy : m_stProxies)
+        {
+            auto size = std::max(proxy.HalfWidth, proxy.HalfHeight) * 2.;
+            if (std::isfinite(size) && size >= 0.)
+            {
+                totalSize += size;
+                ++totalCount;
+            }
+        }
+        auto cellSize = std::max(kMinCellSize, totalCount ? totalSize / static_cast<double>(totalCount) * kCellSizeScale : 0.);
+
+        // 区分普通对象和超大对象，只有普通对象参与网格划分
+        // 对于普通对象，其外接矩形不超过单元格大小，因此查询时外扩半个单元格即可覆盖所有可能相交的对象
+        auto minX = std::numeric_limits<double>::max();
+        auto minY = std::numeric_limits<double>::max();
+        auto maxX = std::numeric_limits<double>::lowest();
+        auto maxY = std::numeric_limits<double>::lowest();
+        m_stProxyCells.resize(m_stProxies.size());
+        for (size_t i = 0; i < m_stProxies.size(); ++i)
+        {
+            const auto& proxy = m_stProxies[i];
+            auto oversized = !std::isfinite(proxy.X) || !std::isfinite(proxy.Y) || !(proxy.HalfWidth >= 0.) ||
+                !(proxy.HalfHeight >= 0.) || proxy.HalfWidth * 2. > cellSize || proxy.HalfHeight * 2. > cellSize;
+            if (oversized)
+            {
+                m_stProxyCells[i] = kOversizedCell;
+                m_stOversizedItems.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+            m_stProxyCells[i] = 0;
+            minX = std::min(minX, proxy.X);
+            minY = std::min(minY, proxy.Y);
+            maxX = std::max(maxX, proxy.X);
+            maxY = std::max(maxY, proxy.Y);
+        }
+        if (m_stOversizedItems.size() == m_stProxies.size())
+            return {};
+
+        // 计算网格尺寸，过大的区域通过放大单元格来限制网格数量
+        auto width = maxX - minX;
+        auto height = maxY - minY;
+        m_dOriginX = minX;
+        m_dOriginY = minY;
+        m_dCellWidth = std::max(cellSize, width / (kMaxGridDimension - 1));
+        m_dCellHeight = std::max(cellSize, height / (kMaxGridDimension - 1));
+        m_dQueryExpand = cellSize / 2.;
+        m_uColumns = std::min(kMaxGridDimension, static_cast<uint32_t>(width / m_dCellWidth) + 1);
+        m_uRows = std::min(kMaxGridDimension, static_cast<uint32_t>(height / m_dCellHeight) + 1);
+
+        // 计数排序，保证单元格内对象维持加入顺序
+        m_stCellStart.resize(m_uColumns * m_uRows + 1);
+        std::fill(m_stCellStart.begin(), m_stCellStart.end(), 0);
+        for (size_t i = 0; i < m_stProxies.size(); ++i)
+        {
+            if (m_stProxyCells[i] == kOversizedCell)
+                continue;
+            const auto& proxy = m_stProxies[i];
+            auto column = std::min(m_uColumns - 1, static_cast<uint32_t>((proxy.X - m_dOriginX) / m_dCellWidth));
+            auto row = std::min(m_uRows - 1, static_cast<uint32_t>((proxy.Y - m_dOriginY) / m_dCellHeight));
+            auto cell = row * m_uColumns + column;
+            m_stProxyCells[i] = cell;
+            ++m_stCellStart[cell + 1];
+        }
+        for (size_t i = 1; i < m_stCellStart.size(); ++i)
+            m_stCellStart[i] += m_stCellStart[i - 1];
+        m_stCellItems.resize(m_stProxies.size() - m_stOversizedItems.size());
+        for (size_t i = 0; i < m_stProxies.size(); ++i)
+        {
+            auto cell = m_stProxyCells[i];
+            if (cell == kOversizedCell)
+                continue;
+            m_stCellItems[m_stCellStart[cell]++] = static_cast<uint32_t>(i);
+        }
+
+        // 此时 m_stCellStart[i] 指向单元格 i 的末尾，整体右移一位还原为起始位置
+        for (size_t i = m_stCellStart.size() - 1; i > 0; --i)
+            m_stCellStart[i] = m_stCellStart[i - 1];
+        m_stCellStart[0] = 0;
+    }
+    catch (...)  // bad_alloc
+    {
+        m_uColumns = m_uRows = 0;
+        m_stCellStart.clear();
+        m_stCellItems.clear();
+        m_stOversizedItems.clear();
+        return make_error_code(errc::not_enough_memory);
+    }
+    return {};
+}
+
+Result<void> CollisionBroadPhase::Query(double left, double right, double top, double bottom,
+    std::vector<uint32_t>& out) const noexcept
+{
+    out.clear();
+    if (m_stProxies.empty())
+        return {};
+
+    try
+    {
+        // 对于非法的查询区域（如 NaN），无法进行剔除，保守地返回所有对象
+        if (!(left <= right) || !(bottom <= top))
+        {
+            out.resize(m_stProxies.size());
+            for (size_t i = 0; i < out.size(); ++i)
+                out[i] = static_cast<uint32_t>(i);
+            return {};
+        }
+
+        uint32_t firstColumn = 0, lastColumn = 0, firstRow = 0, lastRow = 0;
+        if (m_uColumns > 0 && m_uRows > 0 &&
+            GetCellRange(left - m_dQueryExpand, right + m_dQueryExpand, m_dOriginX, m_dCellWidth, m_uColumns, firstColumn,
+                lastColumn) &&
+            GetCellRange(bottom - m_dQueryExpand, top + m_dQueryExpand, m_dOriginY, m_dCellHeight, m_uRows, firstRow, lastRow))
+        {
+            for (auto row = firstRow; row <= lastRow; ++row)
+            {
+                auto begin = m_stCellStart[row * m_uColumns + firstColumn];
+                auto end = m_stCellStart[row * m_uColumns + lastColumn + 1];
+                out.insert(out.end(), m_stCellItems.begin() + begin, m_stCellItems.begin() + end);
+            }
+        }
+        out.insert(out.end(), m_stOversizedItems.begin(), m_stOversizedItems.end());
+
+        // 保持与遍历链表时一致的顺序
+        std::sort(out.begin(), out.end());
+    }
+    catch (...)  // bad_alloc
+    {
+        out.clear();
+        return make_error_code(errc::not_enough_memory);
+    }
+    return {};
+}
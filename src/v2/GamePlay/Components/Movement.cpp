@@ -10,10 +10,14 @@ using namespace std;
 using namespace lstg;
 using namespace lstg::v2::GamePlay::Components;
 
-void Movement::Reset() noexcept
+template <typename TScalar>
+void BasicMovement<TScalar>::Reset() noexcept
 {
     AngularVelocity = 0.;
     Velocity = { 0., 0. };
     AccelVelocity = { 0., 0. };
     RotateToSpeedDirection = false;
 }
+
+template struct lstg::v2::GamePlay::Components::BasicMovement<float>;
+template struct lstg::v2::GamePlay::Components::BasicMovement<double>;
@@ -6,33 +6,24 @@
  */
 #include <lstg/v2/GamePlay/Components/Renderer.hpp>
 
+#include <lstg/v2/GamePlay/RenderLayerIndex.hpp>
+
 using namespace std;
 using namespace lstg;
 using namespace lstg::v2::GamePlay::Components;
 
-// <editor-fold desc="Renderer">
-
-Renderer* Renderer::FromSkipListNode(IntrusiveSkipListNode<kRendererSkipListNodeDepth>* n) noexcept
-{
-    if (n)
-    {
-        auto ret = reinterpret_cast<Renderer*>(reinterpret_cast<uint8_t*>(n) - offsetof(Renderer, SkipListNode));
-        assert(&ret->SkipListNode == n);
-        return ret;
-    }
-    return nullptr;
-}
-
 Renderer::Renderer(Renderer&& org) noexcept
-    : Invisible(org.Invisible), Scale(org.Scale), Layer(org.Layer), RenderData(std::move(org.RenderData)), BindingEntity(org.BindingEntity),
-    SkipListNode(std::move(org.SkipListNode))
+    : Invisible(org.Invisible), Scale(org.Scale), Layer(org.Layer), RenderData(std::move(org.RenderData)), BindingEntity(org.BindingEntity)
 {
+    // 索引持有组件地址，不应该发生内存迁移
+    assert(!org.LayerSlot.Owner);
 }
 
 void Renderer::Reset() noexcept
 {
-    // 从链表脱开
-    SkipListRemove(&SkipListNode);
+    // 从索引脱开
+    RenderLayerIndex::Remove(*this);
+    LayerSlot.VisitEpoch = 0;
 
     // 重置
     Invisible = false;
@@ -63,50 +54,3 @@ std::string_view Renderer::GetAssetName() noexcept
             return {};
     }
 }
-
-Renderer* Renderer::NextNode() noexcept
-{
-    auto n = SkipListNode.Adj[0].Next;
-    return FromSkipListNode(n);
-}
-
-Renderer* Renderer::PrevNode() noexcept
-{
-    auto n = SkipListNode.Adj[0].Prev;
-    return FromSkipListNode(n);
-}
-
-// </editor-fold>
-// <editor-fold desc="RendererRoot">
-
-RendererRoot::RendererRoot() noexcept
-{
-    // Header <-> Tailer
-    for (size_t i = 0; i < kRendererSkipListNodeDepth; ++i)
-    {
-        RendererHeader.SkipListNode.Adj[i].Next = &RendererTailer.SkipListNode;
-        RendererTailer.SkipListNode.Adj[i].Prev = &RendererHeader.SkipListNode;
-    }
-}
-
-RendererRoot::RendererRoot(RendererRoot&&) noexcept
-{
-    // 不应该发生内存迁移
-    assert(false);
-}
-
-void RendererRoot::Reset() noexcept
-{
-    // 将链表脱开
-    RendererHeader.Reset();
-    RendererTailer.Reset();
-
-    // Header <-> Tailer
-    for (size_t i = 0; i < kRendererSkipListNodeDepth; ++i)
-    {
-        RendererHeader.SkipListNode.Adj[i].Next = &RendererTailer.SkipListNode;
-        RendererTailer.SkipListNode.Adj[i].Prev = &RendererHeader.SkipListNode;
-    }
-}
-
-// </editor-fold>
@@ -15,7 +15,11 @@ using namespace lstg::v2::GamePlay::Components;
 void Script::Reset() noexcept
 {
     if (Pool)
+    {
+        Pool->ReleaseClass(ScriptClassId);
         Pool->Free(Pool->GetState(), ScriptObjectId);
+    }
     ScriptObjectId = 0;
+    ScriptClassId = 0;
     Pool = nullptr;
 }
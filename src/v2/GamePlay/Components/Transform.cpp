@@ -10,10 +10,14 @@ using namespace std;
 using namespace lstg;
 using namespace lstg::v2::GamePlay::Components;
 
-void Transform::Reset() noexcept
+template <typename TScalar>
+void BasicTransform<TScalar>::Reset() noexcept
 {
     Location = { 0., 0. };
     LastLocation = { 0., 0. };
     LocationDelta = { 0., 0. };
     Rotation = 0.;
 }
+
+template struct lstg::v2::GamePlay::Components::BasicTransform<float>;
+template struct lstg::v2::GamePlay::Components::BasicTransform<double>;
@@ -14,6 +14,7 @@
 #include <lstg/Core/Subsystem/Script/LuaRead.hpp>
 #include <lstg/Core/Subsystem/Render/Drawing2D/SpriteDrawing.hpp>
 #include <lstg/v2/GameApp.hpp>
+#include <lstg/v2/GamePlay/Motion.hpp>
 #include <lstg/v2/GamePlay/Components/Collider.hpp>
 #include <lstg/v2/GamePlay/Components/LifeTime.hpp>
 #include <lstg/v2/GamePlay/Components/Movement.hpp>
@@ -34,8 +35,20 @@ using namespace lstg::v2::GamePlay::Components;
 
 LSTG_DEF_LOG_CATEGORY(GameWorld);
 
+static const size_t kBroadPhaseMinQueries = 8;  // 启用碰撞粗检测所需的最少 A 组对象数
+
 namespace
 {
+    /**
+     * 决定并行更新线程数量
+     * 当前线程同样参与执行，因此比逻辑核心数少一个，最多使用 7 个工作线程
+     */
+    uint32_t DetermineParallelVisitThreads() noexcept
+    {
+        auto count = ThreadPool<>::GetSystemThreadCount();
+        return std::min(7u, std::max(1u, count > 1 ? count - 1 : 1u));
+    }
+
     inline bool ColliderSortFunction(IntrusiveSkipListNode<kColliderSkipListNodeDepth>* lhs,
         IntrusiveSkipListNode<kColliderSkipListNodeDepth>* rhs) noexcept
     {
@@ -49,38 +62,129 @@ namespace
         return (lhsScript ? lhsScript->ScriptObjectId : 0) < (rhsScript ? rhsScript->ScriptObjectId : 0);
     }
 
-    inline bool RendererSortFunction(IntrusiveSkipListNode<kRendererSkipListNodeDepth>* lhs,
-        IntrusiveSkipListNode<kRendererSkipListNodeDepth>* rhs) noexcept
+    inline void RenderLayerIndexInsert(RenderLayerIndex& index, ECS::Entity entity, Renderer& renderer) noexcept
     {
-        assert(lhs && rhs);
-        auto left = Renderer::FromSkipListNode(lhs);
-        auto right = Renderer::FromSkipListNode(rhs);
+        // Layer 小的靠前，相同时比较对象ID
+        auto script = entity.TryGetComponent<Script>();
+        auto ret = index.Insert(renderer, renderer.Layer, script ? script->ScriptObjectId : 0);
+        if (!ret)
+            LSTG_LOG_ERROR_CAT(GameWorld, "Insert renderer into layer index fail, ret={}", ret.GetError());
+    }
 
-        // Layer 小的靠前
-        if (left->Layer < right->Layer)
-            return true;
+    inline void UpdateParticle(const Transform& transform, Renderer& renderer) noexcept
+    {
+        if (renderer.RenderData.index() != 3)
+            return;
+
+        auto& particleData = std::get<Renderer::ParticleRenderer>(renderer.RenderData);
 
-        // 相同时比较对象ID
-        if (left->Layer == right->Layer)
+        // 刷新默认发射器状态
+        if (particleData.Emitter)
         {
-            auto lhsScript = left->BindingEntity.TryGetComponent<Script>();
-            auto rhsScript = right->BindingEntity.TryGetComponent<Script>();
-            return (lhsScript ? lhsScript->ScriptObjectId : 0) < (rhsScript ? rhsScript->ScriptObjectId : 0);
+            assert(particleData.Pool);
+            auto emitter = particleData.Emitter;
+            if (emitter->IsAlive())
+                emitter->SetAlive();  // 只要粒子保持存活状态，就一直激活粒子
+            emitter->SetPosition(transform.Location);
+            emitter->SetRotation(static_cast<float>(transform.Rotation));
+            emitter->SetScale(renderer.Scale);
+        }
+
+        // 更新所有发射器
+        if (particleData.Pool)
+            particleData.Pool->Update(1.f / 60.f);  // 总是使用 60fps 的速度 Tick
+    }
+
+    const Subsystem::Render::Drawing2D::Sprite* GetDefaultDrawingSprite(const Renderer& renderer) noexcept
+    {
+        switch (renderer.RenderData.index())
+        {
+            case 1:
+                {
+                    auto& spriteRenderer = std::get<1>(renderer.RenderData);
+                    assert(spriteRenderer.Asset);
+                    return &spriteRenderer.Asset->GetDrawingSprite();
+                }
+            case 2:
+                {
+                    auto& spriteSequenceRenderer = std::get<2>(renderer.RenderData);
+                    auto& asset = spriteSequenceRenderer.Asset;
+                    assert(asset && !asset->GetSequences().empty());
+                    auto frame = (renderer.AnimationTimer / asset->GetInterval()) % asset->GetSequences().size();
+                    return &asset->GetSequences()[frame];
+                }
+            default:
+                return nullptr;
+        }
+    }
+
+    void DrawEntityDefault(Subsystem::Render::Drawing2D::CommandBuffer& cmdBuffer, const Transform& transform,
+        const Renderer& renderer) noexcept
+    {
+        switch (renderer.RenderData.index())
+        {
+            case 0:
+                break;
+            case 1:
+                {
+                    auto& spriteRenderer = std::get<1>(renderer.RenderData);
+                    assert(spriteRenderer.Asset);
+                    auto loc = transform.Location;
+                    auto ret = spriteRenderer.Asset->GetDrawingSprite().DrawInstance(cmdBuffer,
+                        { static_cast<float>(loc.x), static_cast<float>(loc.y), 0.5f }, static_cast<float>(transform.Rotation),
+                        { static_cast<float>(renderer.Scale.x), static_cast<float>(renderer.Scale.y) });
+                    if (!ret)
+                        LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", spriteRenderer.Asset->GetName(), ret.GetError());
+                }
+                break;
+            case 2:
+                {
+                    auto& spriteSequenceRenderer = std::get<2>(renderer.RenderData);
+                    auto& asset = spriteSequenceRenderer.Asset;
+                    assert(asset && !asset->GetSequences().empty());
+                    auto frame = (renderer.AnimationTimer / asset->GetInterval()) % asset->GetSequences().size();
+                    auto loc = transform.Location;
+                    auto ret = asset->GetSequences()[frame].DrawInstance(cmdBuffer,
+                        { static_cast<float>(loc.x), static_cast<float>(loc.y), 0.5f }, static_cast<float>(transform.Rotation),
+                        { static_cast<float>(renderer.Scale.x), static_cast<float>(renderer.Scale.y) });
+                    if (!ret)
+                        LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", asset->GetName(), ret.GetError());
+                }
+                break;
+            case 3:
+                {
+                    auto& particleRenderer = std::get<3>(renderer.RenderData);
+                    assert(particleRenderer.Emitter);
+                    auto ret = particleRenderer.Emitter->Draw(cmdBuffer);
+                    if (!ret)
+                        LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", particleRenderer.Asset->GetName(), ret.GetError());
+                }
+                break;
+            default:
+                assert(false);
+                break;
         }
-        return false;
     }
 }
 
 GameWorld::GameWorld(GameApp& app)
-    : m_stApp(app), m_stScriptObjectPool(app.GetSubsystem<Subsystem::ScriptSystem>()->GetState(), this)
+    : m_stApp(app), m_stScriptObjectPool(app.GetSubsystem<Subsystem::ScriptSystem>()->GetState(), this),
+    m_stParallelVisitThreads(DetermineParallelVisitThreads())
 {
     // 创建根 Entity
-    m_stRootEntity = m_stWorld.CreateEntity<LifeTimeRoot, ColliderRoot, RendererRoot>().ThrowIfError();
+    m_stRootEntity = m_stWorld.CreateEntity<LifeTimeRoot, ColliderRoot>().ThrowIfError();
 
-    // 保存 Component 的引用，当且仅当 XXXRoot 所在 Chunk 不发生 Expand
+    // 保存 Component 的引用，Chunk 保证 Component 地址在 Entity 生命周期内不变
     m_pLifeTimeRoot = &m_stRootEntity.GetComponent<LifeTimeRoot>();
     m_pColliderRoot = &m_stRootEntity.GetComponent<ColliderRoot>();
-    m_pRendererRoot = &m_stRootEntity.GetComponent<RendererRoot>();
+
+    // 是否默认开启批量运动积分
+    auto cmdBatchMotionIntegration = AppBase::GetCmdline().GetOption<bool>("batch-motion-integration", false);
+    if (cmdBatchMotionIntegration)
+    {
+        LSTG_LOG_INFO_CAT(GameWorld, "Batch motion integration is enabled");
+        m_bBatchMotionIntegration = true;
+    }
 }
 
 Result<LuaStack::AbsIndex> GameWorld::CreateEntity(LuaStack stack, LuaStack::AbsIndex classIndex) noexcept
@@ -119,13 +223,17 @@ Result<LuaStack::AbsIndex> GameWorld::CreateEntity(LuaStack stack, LuaStack::Abs
         collider.BindingEntity = *entity;
         SkipListInsert(&(m_pColliderRoot->ColliderGroupTailers[collider.Group].SkipListNode), &collider.SkipListNode, ColliderSortFunction,
             m_stSkipListRandomizer);
+        InvalidateCollisionBroadPhase();
         renderer.BindingEntity = *entity;
-        SkipListInsert(&(m_pRendererRoot->RendererTailer.SkipListNode), &renderer.SkipListNode, RendererSortFunction,
-            m_stSkipListRandomizer);
         lifeTime.BindingEntity = *entity;
         ListInsertBefore(&m_pLifeTimeRoot->LifeTimeTailer.ListNode, &lifeTime.ListNode);
         script.Pool = &m_stScriptObjectPool;
         script.ScriptObjectId = std::get<0>(*scriptObject);
+        auto classId = m_stScriptObjectPool.AcquireClass(stack, classIndex);
+        if (!classId)
+            LSTG_LOG_WARN_CAT(GameWorld, "Cache script class fail, ret={}", classId.GetError());  // 退化为每次查找回调
+        script.ScriptClassId = classId ? *classId : kInvalidScriptClassId;
+        RenderLayerIndexInsert(m_stRenderLayerIndex, *entity, renderer);  // 依赖对象ID，需要在 Script 初始化之后
     }
 
     // 调用 Init 事件
@@ -134,9 +242,8 @@ Result<LuaStack::AbsIndex> GameWorld::CreateEntity(LuaStack stack, LuaStack::Abs
     assert(luaStackTop - initCallArgs + 1 == stack.GetTop());
 
     // Init 执行后，更新上一帧位置 X, Y
-    // 注意这里 transform 可能失效
     {
-        auto& transform = entity->GetComponent<Transform>();
+        auto transform = entity->GetComponent<Transform>();
         transform.LastLocation = transform.Location;
     }
 
@@ -224,6 +331,9 @@ void GameWorld::Frame() noexcept
 
     // 为了保证与 luastg 行为的兼容性，这里通过 LifeTime 上的链表更新所有对象
     // 这并不符合 ECS 的使用规范，无法得到 cache friendly 的优势
+    // 开启批量运动积分时，链表上只调用脚本方法，纯数值的更新随后按 Archetype 连续遍历完成
+    auto batchMotionIntegration = m_bBatchMotionIntegration;
+    m_stScriptObjectPool.RefreshClassCache(m_stScriptObjectPool.GetState());
     assert(m_pLifeTimeRoot);
     LifeTime* p = m_pLifeTimeRoot->LifeTimeHeader.NextNode();
     assert(p);
@@ -237,48 +347,42 @@ void GameWorld::Frame() noexcept
         {
             assert(scriptComponent->Pool == &m_stScriptObjectPool);
             m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), scriptComponent->ScriptObjectId,
-                ScriptCallbackFunctions::OnFrame, 0);
-
-            // 由于内存分配，此时迭代器可能失效
-            p = &entity.GetComponent<LifeTime>();
+                scriptComponent->ScriptClassId, ScriptCallbackFunctions::OnFrame, 0);
         }
 
-        // 更新对象运动状态
-        auto transformComponent = entity.TryGetComponent<Transform>();
-        auto movementComponent = entity.TryGetComponent<Movement>();
-        if (transformComponent && movementComponent)
+        if (!batchMotionIntegration)
         {
-            movementComponent->Velocity += movementComponent->AccelVelocity;
-            transformComponent->Location += movementComponent->Velocity;
-            transformComponent->Rotation += movementComponent->AngularVelocity;
-        }
-
-        // 更新粒子系统（若有）
-        auto rendererComponent = entity.TryGetComponent<Renderer>();
-        if (transformComponent && rendererComponent && rendererComponent->RenderData.index() == 3)
-        {
-            auto& particleData = std::get<Renderer::ParticleRenderer>(rendererComponent->RenderData);
-
-            // 刷新默认发射器状态
-            if (particleData.Emitter)
+            // 更新对象运动状态
+            auto transformComponent = entity.TryGetComponent<Transform>();
+            auto movementComponent = entity.TryGetComponent<Movement>();
+            if (transformComponent && movementComponent)
             {
-                assert(particleData.Pool);
-                auto emitter = particleData.Emitter;
-                if (emitter->IsAlive())
-                    emitter->SetAlive();  // 只要粒子保持存活状态，就一直激活粒子
-                emitter->SetPosition(transformComponent->Location);
-                emitter->SetRotation(static_cast<float>(transformComponent->Rotation));
-                emitter->SetScale(rendererComponent->Scale);
+                IntegrateMotion(*transformComponent, *movementComponent);
+                InvalidateCollisionBroadPhase();
             }
 
-            // 更新所有发射器
-            if (particleData.Pool)
-                particleData.Pool->Update(1.f / 60.f);  // 总是使用 60fps 的速度 Tick
+            // 更新粒子系统（若有）
+            auto rendererComponent = entity.TryGetComponent<Renderer>();
+            if (transformComponent && rendererComponent)
+                UpdateParticle(*transformComponent, *rendererComponent);
         }
 
         assert(p->NextNode());
         p = p->NextNode();
     }
+
+    if (batchMotionIntegration)
+    {
+        // 此时所有对象的 OnFrame 均已执行完毕，包括本帧新创建的对象，因此与链表遍历覆盖的对象集合一致
+        // 与逐个更新的区别在于，OnFrame 中观察到的其他对象的坐标总是上一帧的结果
+        BatchIntegrateMotion<ComponentScalar>(m_stWorld, m_stParallelVisitThreads);
+        InvalidateCollisionBroadPhase();
+
+        // 粒子池各自持有随机数发生器，更新顺序不影响结果
+        m_stWorld.VisitEntities<tuple<Transform, Renderer>>([](ECS::Entity ent, Transform transform, Renderer& renderer) {
+            UpdateParticle(transform, renderer);
+        });
+    }
 }
 
 void GameWorld::Render() noexcept
@@ -287,35 +391,68 @@ void GameWorld::Render() noexcept
     LSTG_PER_FRAME_PROFILE(GameWorld_ObjRender);
 #endif
 
-    assert(m_pRendererRoot);
-    Renderer* p = m_pRendererRoot->RendererHeader.NextNode();
-    assert(p);
-    while (p != &m_pRendererRoot->RendererTailer)
-    {
-        auto entity = p->BindingEntity;
+    // 类上的回调可能在上一帧被脚本修改，遍历前重新读取，遍历中途的修改从下一轮遍历开始生效
+    m_stScriptObjectPool.RefreshClassCache(m_stScriptObjectPool.GetState());
 
-        if (!p->Invisible)
+    auto& cmdBuffer = m_stApp.GetCommandBuffer();
+    size_t nativeCalls = 0, scriptCalls = 0;
+    m_stRenderLayerIndex.Traverse([&](Renderer& renderer) {
+        if (renderer.Invisible)
+            return;
+
+        auto entity = renderer.BindingEntity;
+        auto scriptComponent = entity.TryGetComponent<Script>();
+        if (scriptComponent)
         {
-            // 调用 Render 方法
-            auto scriptComponent = entity.TryGetComponent<Script>();
-            if (scriptComponent)
+            assert(scriptComponent->Pool == &m_stScriptObjectPool);
+
+            // 类上没有定义渲染方法时，直接在原生侧绘制，不再进入 Lua
+            if (!m_stScriptObjectPool.IsCallbackDefined(scriptComponent->ScriptClassId, ScriptCallbackFunctions::OnRender))
             {
-                assert(scriptComponent->Pool == &m_stScriptObjectPool);
-                if (m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), scriptComponent->ScriptObjectId,
-                    ScriptCallbackFunctions::OnRender, 0) == ScriptCallbackInvokeResult::CallbackNotDefined)
+                auto transformComponent = entity.TryGetComponent<Transform>();
+                if (transformComponent)
                 {
-                    // 当没有用户定义渲染方法时，调用默认渲染方法
-                    RenderEntityDefault(entity);
+                    auto sprite = GetDefaultDrawingSprite(renderer);
+                    if (sprite && sprite->IsUniformColor())
+                    {
+                        AppendSpriteBatch(cmdBuffer, *sprite, *transformComponent, renderer);
+                    }
+                    else
+                    {
+                        FlushSpriteBatch(cmdBuffer);
+                        DrawEntityDefault(cmdBuffer, *transformComponent, renderer);
+                    }
                 }
+                ++nativeCalls;
+                return;
+            }
+
+            // 脚本可能修改绘制状态，需要先提交之前的批次
+            FlushSpriteBatch(cmdBuffer);
 
-                // 由于内存分配，此时迭代器可能失效
-                p = &entity.GetComponent<Renderer>();
+            // 调用 Render 方法
+            ++scriptCalls;
+            if (m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), scriptComponent->ScriptObjectId,
+                scriptComponent->ScriptClassId, ScriptCallbackFunctions::OnRender, 0) == ScriptCallbackInvokeResult::CallbackNotDefined)
+            {
+                // 当没有用户定义渲染方法时，调用默认渲染方法
+                RenderEntityDefault(entity);
             }
         }
+    });
+    FlushSpriteBatch(cmdBuffer);
 
-        assert(p->NextNode());
-        p = p->NextNode();
-    }
+#ifdef LSTG_DEVELOPMENT
+#define ADD_COUNTER(NAME, WHAT) \
+    Subsystem::ProfileSystem::GetInstance().IncrementPerformanceCounter(Subsystem::PerformanceCounterTypes::PerFrame, #NAME, WHAT)
+
+    ADD_COUNTER(GameWorld_RenderNativeCalls, static_cast<double>(nativeCalls));
+    ADD_COUNTER(GameWorld_RenderScriptCalls, static_cast<double>(scriptCalls));
+#undef ADD_COUNTER
+#else
+    static_cast<void>(nativeCalls);
+    static_cast<void>(scriptCalls);
+#endif
 }
 
 void GameWorld::UpdateCoordinate() noexcept
@@ -324,13 +461,8 @@ void GameWorld::UpdateCoordinate() noexcept
     LSTG_PER_FRAME_PROFILE(GameWorld_UpdateXY);
 #endif
 
-    m_stWorld.VisitEntities<tuple<Transform, Movement>>(
-        [](ECS::Entity ent, Transform& transform, Movement& movement) {
-            transform.LocationDelta = transform.Location - transform.LastLocation;
-            transform.LastLocation = transform.Location;
-            if (movement.RotateToSpeedDirection && (transform.LocationDelta.x != 0 && transform.LocationDelta.y != 0))
-                transform.Rotation = ::atan2(transform.LocationDelta.y, transform.LocationDelta.x);
-        });
+    // 只涉及对象自身的数值计算，可以安全地并行执行
+    BatchUpdateMotionDelta<ComponentScalar>(m_stWorld, m_stParallelVisitThreads);
 }
 
 void GameWorld::AfterFrame() noexcept
@@ -340,14 +472,16 @@ void GameWorld::AfterFrame() noexcept
 #endif
 
     // 更新生命周期
-    m_stWorld.VisitEntities<tuple<LifeTime>>([](ECS::Entity ent, LifeTime& lifeTime) {
+    // 迭代过程中只登记需要销毁的对象，在遍历结束后统一销毁
+    m_stWorld.VisitEntities<tuple<LifeTime>>([this](ECS::Entity ent, LifeTime& lifeTime) {
         ++lifeTime.Timer;
         if (lifeTime.Status != LifeTimeStatus::Alive)
-            ent.Destroy();
+            m_stWorld.DeferDestroy(ent);
     });
+    m_stWorld.FlushDeferredDestroy();
 
     // 更新动画计时器
-    m_stWorld.VisitEntities<tuple<Renderer>>([](ECS::Entity ent, Renderer& renderer) {
+    m_stWorld.ParallelVisitEntities<tuple<Renderer>>(m_stParallelVisitThreads, [](ECS::Entity ent, Renderer& renderer) {
         ++renderer.AnimationTimer;
     });
 }
@@ -357,6 +491,7 @@ void GameWorld::DeleteOutOfBoundaryEntities() noexcept
     auto topLeft = m_stBoundary.GetTopLeft();
     auto bottomRight = m_stBoundary.GetBottomRight();
 
+    m_stScriptObjectPool.RefreshClassCache(m_stScriptObjectPool.GetState());
     assert(m_pLifeTimeRoot);
     LifeTime* p = m_pLifeTimeRoot->LifeTimeHeader.NextNode();
     assert(p);
@@ -382,10 +517,7 @@ void GameWorld::DeleteOutOfBoundaryEntities() noexcept
                     {
                         assert(scriptComponent->Pool == &m_stScriptObjectPool);
                         m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), scriptComponent->ScriptObjectId,
-                            ScriptCallbackFunctions::OnDelete, 0);
-
-                        // 由于内存分配，此时迭代器可能失效
-                        p = &entity.GetComponent<LifeTime>();
+                            scriptComponent->ScriptClassId, ScriptCallbackFunctions::OnDelete, 0);
                     }
                 }
             }
@@ -403,65 +535,50 @@ void GameWorld::RenderEntityDefault(ECS::Entity entity) noexcept
     {
         auto rendererComponent = entity.TryGetComponent<Renderer>();
         if (rendererComponent && !rendererComponent->Invisible)
-        {
-            auto& cmdBuffer = m_stApp.GetCommandBuffer();
+            DrawEntityDefault(m_stApp.GetCommandBuffer(), *transformComponent, *rendererComponent);
+    }
+}
 
-            switch (rendererComponent->RenderData.index())
-            {
-                case 0:
-                    break;
-                case 1:
-                    {
-                        auto& spriteRenderer = std::get<1>(rendererComponent->RenderData);
-                        assert(spriteRenderer.Asset);
-                        auto draw = spriteRenderer.Asset->GetDrawingSprite().Draw(cmdBuffer);
-                        if (!draw)
-                        {
-                            LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", spriteRenderer.Asset->GetName(), draw.GetError());
-                            return;
-                        }
+void GameWorld::AppendSpriteBatch(Subsystem::Render::Drawing2D::CommandBuffer& cmdBuffer, const Subsystem::Render::Drawing2D::Sprite& sprite,
+    const Transform& transform, const Renderer& renderer) noexcept
+{
+    if (m_pSpriteBatchSprite != &sprite)
+    {
+        FlushSpriteBatch(cmdBuffer);
+        m_pSpriteBatchSprite = &sprite;
+    }
 
-                        auto loc = transformComponent->Location;
-                        draw->Transform(static_cast<float>(transformComponent->Rotation), static_cast<float>(rendererComponent->Scale.x),
-                            static_cast<float>(rendererComponent->Scale.y));
-                        draw->Translate(static_cast<float>(loc.x), static_cast<float>(loc.y), 0.5f);
-                    }
-                    break;
-                case 2:
-                    {
-                        auto& spriteSequenceRenderer = std::get<2>(rendererComponent->RenderData);
-                        auto& asset = spriteSequenceRenderer.Asset;
-                        assert(asset && !asset->GetSequences().empty());
-                        auto frame = (rendererComponent->AnimationTimer / spriteSequenceRenderer.Asset->GetInterval()) %
-                            asset->GetSequences().size();
-                        auto draw = spriteSequenceRenderer.Asset->GetSequences()[frame].Draw(cmdBuffer);
-                        if (!draw)
-                        {
-                            LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", asset->GetName(), draw.GetError());
-                            return;
-                        }
+    auto loc = transform.Location;
+    auto instance = sprite.MakeInstance({ static_cast<float>(loc.x), static_cast<float>(loc.y), 0.5f },
+        static_cast<float>(transform.Rotation), { static_cast<float>(renderer.Scale.x), static_cast<float>(renderer.Scale.y) });
+    try
+    {
+        m_stSpriteBatchInstances.push_back(instance);
+    }
+    catch (...)  // bad_alloc
+    {
+        // 退化为逐个绘制
+        FlushSpriteBatch(cmdBuffer);
+        auto ret = sprite.DrawInstances(cmdBuffer, { &instance, 1 });
+        if (!ret)
+            LSTG_LOG_ERROR_CAT(GameWorld, "Draw sprite fail: {}", ret.GetError());
+    }
+}
 
-                        auto loc = transformComponent->Location;
-                        draw->Transform(static_cast<float>(transformComponent->Rotation), static_cast<float>(rendererComponent->Scale.x),
-                            static_cast<float>(rendererComponent->Scale.y));
-                        draw->Translate(static_cast<float>(loc.x), static_cast<float>(loc.y), 0.5f);
-                    }
-                    break;
-                case 3:
-                    {
-                        auto& particleRenderer = std::get<3>(rendererComponent->RenderData);
-                        assert(particleRenderer.Emitter);
-                        auto ret = particleRenderer.Emitter->Draw(cmdBuffer);
-                        if (!ret)
-                            LSTG_LOG_ERROR_CAT(GameWorld, "Draw asset {} fail: {}", particleRenderer.Asset->GetName(), ret.GetError());
-                    }
-                    break;
-                default:
-                    assert(false);
-                    break;
-            }
+void GameWorld::FlushSpriteBatch(Subsystem::Render::Drawing2D::CommandBuffer& cmdBuffer) noexcept
+{
+    if (!m_stSpriteBatchInstances.empty())
+    {
+        assert(m_pSpriteBatchSprite);
+        auto ret = m_pSpriteBatchSprite->DrawInstances(cmdBuffer, { m_stSpriteBatchInstances.data(), m_stSpriteBatchInstances.size() });
+        if (!ret)
+        {
+            LSTG_LOG_ERROR_CAT(GameWorld, "Draw sprite batch of {} instances fail: {}", m_stSpriteBatchInstances.size(),
+                ret.GetError());
         }
+        m_stSpriteBatchInstances.clear();
     }
+    m_pSpriteBatchSprite = nullptr;
 }
 
 void GameWorld::CollisionCheck(uint32_t groupA, uint32_t groupB) noexcept
@@ -471,126 +588,84 @@ void GameWorld::CollisionCheck(uint32_t groupA, uint32_t groupB) noexcept
 #endif
 
     assert(groupA < kColliderGroupCount && groupB < kColliderGroupCount);
+    m_stScriptObjectPool.RefreshClassCache(m_stScriptObjectPool.GetState());
 
     assert(m_pColliderRoot);
-    Collider* pA = m_pColliderRoot->ColliderGroupHeaders[groupA].NextNode();
-    ECS::Entity entityA = pA->BindingEntity;
-    Collider* pNextA = pA->NextNode();
-    ECS::Entity entityAfterA = pNextA ? pNextA->BindingEntity : ECS::Entity {};
-    assert(pA);
-    while (pA != &m_pColliderRoot->ColliderGroupTailers[groupA])
+    auto tailerA = &m_pColliderRoot->ColliderGroupTailers[groupA];
+
+    // 仅当 A 组对象足够多时才使用粗检测，否则构建网格的开销无法被摊平
+    // 回调中嵌套调用时，外层仍在使用网格数据，此时总是逐个检查
+    bool useBroadPhase = false;
+    if (m_uCollisionCheckDepth == 0)
+    {
+        size_t count = 0;
+        for (auto p = m_pColliderRoot->ColliderGroupHeaders[groupA].NextNode(); p != tailerA && count < kBroadPhaseMinQueries;
+            p = p->NextNode())
+        {
+            if (p->Enabled)
+                ++count;
+        }
+        useBroadPhase = (count >= kBroadPhaseMinQueries);
+    }
+    ++m_uCollisionCheckDepth;
+
+    CollisionCheckState state;
+    state.GroupA = groupA;
+    state.GroupB = groupB;
+    state.ColliderA = m_pColliderRoot->ColliderGroupHeaders[groupA].NextNode();
+    assert(state.ColliderA);
+    state.EntityA = state.ColliderA->BindingEntity;
+    state.NextColliderA = state.ColliderA->NextNode();
+    while (state.ColliderA != tailerA)
     {
-        if (pA->Enabled)  // 忽略未开启碰撞的对象
+        if (state.ColliderA->Enabled)  // 忽略未开启碰撞的对象
         {
-            auto transformComponentA = entityA.TryGetComponent<Transform>();
-            if (!transformComponentA)
+            state.TransformA = state.EntityA.TryGetComponent<Transform>();
+            if (!state.TransformA)
                 goto CONTINUE_A;
 
-            auto scriptComponentA = entityA.TryGetComponent<Script>();
-            if (!scriptComponentA)  // 对于没有脚本系统的对象，不予进行碰撞检测（因为无法传递事件，下同）
+            state.ScriptA = state.EntityA.TryGetComponent<Script>();
+            if (!state.ScriptA)  // 对于没有脚本系统的对象，不予进行碰撞检测（因为无法传递事件，下同）
                 goto CONTINUE_A;
-            assert(scriptComponentA->Pool == &m_stScriptObjectPool);
-
-            // 计算对象 A 的 AABB 范围
-            auto leftA = transformComponentA->Location.x - pA->AABBHalfSize.x;
-            auto rightA = transformComponentA->Location.x + pA->AABBHalfSize.x;
-            auto topA = transformComponentA->Location.y + pA->AABBHalfSize.y;
-            auto bottomA = transformComponentA->Location.y - pA->AABBHalfSize.y;
-
-            // 沿着 groupB 的链表进行逐个碰撞检查
-            Collider* pB = m_pColliderRoot->ColliderGroupHeaders[groupB].NextNode();
-            ECS::Entity entityB = pB->BindingEntity;
-            Collider* pNextB = pB->NextNode();
-            ECS::Entity entityAfterB = pNextB ? pNextB->BindingEntity : ECS::Entity {};
-            assert(pB);
-            while (pB != &m_pColliderRoot->ColliderGroupTailers[groupB])
-            {
-                if (pB->Enabled)  // 忽略未开启碰撞的对象
-                {
-                    auto transformComponentB = entityB.TryGetComponent<Transform>();
-                    if (!transformComponentB)
-                        goto CONTINUE_B;
-
-                    auto scriptComponentB = entityB.TryGetComponent<Script>();
-                    if (!scriptComponentB)
-                        goto CONTINUE_B;
-                    assert(scriptComponentB->Pool == &m_stScriptObjectPool);
-
-                    // 计算对象 B 的 AABB 范围
-                    auto leftB = transformComponentB->Location.x - pB->AABBHalfSize.x;
-                    auto rightB = transformComponentB->Location.x + pB->AABBHalfSize.x;
-                    auto topB = transformComponentB->Location.y + pB->AABBHalfSize.y;
-                    auto bottomB = transformComponentB->Location.y - pB->AABBHalfSize.y;
-
-                    // 使用 AABB 进行快速判断
-                    Vec2 na { std::max(leftA, leftB), std::min(topA, topB) };
-                    Vec2 nb { std::min(rightA , rightB), std::max(bottomA, bottomB) };
-                    if (na.x <= nb.x && na.y >= nb.y)
-                    {
-                        // 执行碰撞检查
-                        if (Math::Collider2D::IsIntersect(transformComponentA->Location, transformComponentA->Rotation, pA->Shape,
-                            transformComponentB->Location, transformComponentB->Rotation, pB->Shape))
-                        {
-                            // 产生脚本事件
-                            m_stScriptObjectPool.PushScriptObject(m_stScriptObjectPool.GetState(), scriptComponentB->ScriptObjectId);
-                            m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), scriptComponentA->ScriptObjectId,
-                                ScriptCallbackFunctions::OnCollision, 1);
-
-                            // 由于内存分配，此时迭代器可能失效
-                            // 恢复 EntityA 相关数据
-                            assert(entityA);  // 此时 EntityA 一定有效
-                            auto newColliderA = &entityA.GetComponent<Collider>();
-                            if (newColliderA != pA)
-                            {
-                                // 只有当 Collider 内存发生变化，才刷新后面的其他 Component
-                                pA = newColliderA;
-                                transformComponentA = entityA.TryGetComponent<Transform>();
-                                scriptComponentA = entityA.TryGetComponent<Script>();
-
-                                // 恢复 EntityAfterA
-                                assert(pNextA);  // 此时 A 一定不是 Tailer 节点
-                                if (pNextA != &m_pColliderRoot->ColliderGroupTailers[groupA])
-                                {
-                                    assert(entityAfterA);  // 此时 EntityAfterA 一定有效
-                                    pNextA = &entityAfterA.GetComponent<Collider>();
-                                }
-
-                                // EntityB 已经用不到了，不需要刷新
-                                // 恢复 EntityAfterB
-                                assert(pNextB);  // 此时 B 一定不是 Tailer 节点
-                                if (pNextB != &m_pColliderRoot->ColliderGroupTailers[groupB])
-                                {
-                                    assert(entityAfterB);  // 此时 EntityAfterB 一定有效
-                                    pNextB = &entityAfterB.GetComponent<Collider>();
-                                }
-                            }
+            assert(state.ScriptA->Pool == &m_stScriptObjectPool);
 
-                            if (pA->Group != groupA || !pA->Enabled)
-                                break;  // 如果对象 A 的碰撞状态变化，则结束这次比较
-                        }
-                    }
-                }
+            // 碰撞检查除了触发 A 的回调外没有其他作用，类上没有定义碰撞方法时可以直接跳过
+            if (!m_stScriptObjectPool.IsCallbackDefined(state.ScriptA->ScriptClassId, ScriptCallbackFunctions::OnCollision))
+                goto CONTINUE_A;
 
-            CONTINUE_B:
-                assert(pNextB);
-                if (pNextB->Group != groupB)
-                    break;  // 极端情况，在碰撞方法中改了其他对象的 Group
-                pB = pNextB;
-                entityB = entityAfterB;
-                pNextB = pB->NextNode();
-                entityAfterB = pNextB ? pNextB->BindingEntity : ECS::Entity {};
-            }
+            // 计算对象 A 的 AABB 范围
+            state.LeftA = state.TransformA->Location.x - state.ColliderA->AABBHalfSize.x;
+            state.RightA = state.TransformA->Location.x + state.ColliderA->AABBHalfSize.x;
+            state.TopA = state.TransformA->Location.y + state.ColliderA->AABBHalfSize.y;
+            state.BottomA = state.TransformA->Location.y - state.ColliderA->AABBHalfSize.y;
+
+            // 通过网格筛选 groupB 中的候选者，失败时退化为沿着 groupB 的链表进行逐个碰撞检查
+            if (!useBroadPhase || !CollisionCheckBroadPhase(state))
+                CollisionCheckLinear(state, m_pColliderRoot->ColliderGroupHeaders[groupB].NextNode());
         }
 
     CONTINUE_A:
-        assert(pNextA);
-        if (pNextA->Group != groupA)
+        assert(state.NextColliderA);
+        if (state.NextColliderA->Group != groupA)
             break;  // 极端情况，在碰撞方法中改了其他对象的 Group
-        pA = pNextA;
-        entityA = entityAfterA;
-        pNextA = pA->NextNode();
-        entityAfterA = pNextA ? pNextA->BindingEntity : ECS::Entity {};
+        state.ColliderA = state.NextColliderA;
+        state.EntityA = state.ColliderA->BindingEntity;
+        state.NextColliderA = state.ColliderA->NextNode();
     }
+
+    assert(m_uCollisionCheckDepth > 0);
+    --m_uCollisionCheckDepth;
+
+#ifdef LSTG_DEVELOPMENT
+#define ADD_COUNTER(NAME, WHAT) \
+    Subsystem::ProfileSystem::GetInstance().IncrementPerformanceCounter(Subsystem::PerformanceCounterTypes::PerFrame, #NAME, WHAT)
+
+    // 粗检测统计
+    ADD_COUNTER(GameWorld_CollisionPotentialPairs, static_cast<double>(state.PotentialPairs));
+    ADD_COUNTER(GameWorld_CollisionCandidatePairs, static_cast<double>(state.CandidatePairs));
+    ADD_COUNTER(GameWorld_CollisionNarrowPhaseTests, static_cast<double>(state.NarrowPhaseTests));
+#undef ADD_COUNTER
+#endif
 }
 
 void GameWorld::Clear() noexcept
@@ -600,16 +675,164 @@ void GameWorld::Clear() noexcept
     assert(p);
     while (p != &m_pLifeTimeRoot->LifeTimeTailer)
     {
-        auto next = p->NextNode();
         p->Status = LifeTimeStatus::Deleted;
-        // FIXME: 如果在迭代过程中调用 Destroy，可能会造成问题？
-        // FIXME: 暂时没有测试这种情况，但是如果不 Destroy，会出现很多奇妙的问题
-        p->BindingEntity.Destroy();
-        p = next;
+        m_stWorld.DeferDestroy(p->BindingEntity);  // 销毁会将对象从链表断开，因此在遍历结束后统一进行
+        p = p->NextNode();
     }
+    m_stWorld.FlushDeferredDestroy();
     assert(m_stScriptObjectPool.GetCurrentObjects() == 0);
 }
 
+bool GameWorld::CollisionCheckPair(CollisionCheckState& state, ECS::Entity entityB, Collider& colliderB) noexcept
+{
+    auto transformComponentB = entityB.TryGetComponent<Transform>();
+    if (!transformComponentB)
+        return false;
+
+    auto scriptComponentB = entityB.TryGetComponent<Script>();
+    if (!scriptComponentB)
+        return false;
+    assert(scriptComponentB->Pool == &m_stScriptObjectPool);
+    ++state.CandidatePairs;
+
+    // 计算对象 B 的 AABB 范围
+    auto leftB = transformComponentB->Location.x - colliderB.AABBHalfSize.x;
+    auto rightB = transformComponentB->Location.x + colliderB.AABBHalfSize.x;
+    auto topB = transformComponentB->Location.y + colliderB.AABBHalfSize.y;
+    auto bottomB = transformComponentB->Location.y - colliderB.AABBHalfSize.y;
+
+    // 使用 AABB 进行快速判断
+    Vec2 na { std::max(state.LeftA, leftB), std::min(state.TopA, topB) };
+    Vec2 nb { std::min(state.RightA, rightB), std::max(state.BottomA, bottomB) };
+    if (!(na.x <= nb.x && na.y >= nb.y))
+        return false;
+
+    // 执行碰撞检查
+    ++state.NarrowPhaseTests;
+    if (!Math::Collider2D::IsIntersect(Vec2 { state.TransformA->Location }, static_cast<double>(state.TransformA->Rotation),
+        state.ColliderA->Shape, Vec2 { transformComponentB->Location }, static_cast<double>(transformComponentB->Rotation),
+        colliderB.Shape))
+    {
+        return false;
+    }
+
+    // 产生脚本事件
+    m_stScriptObjectPool.PushScriptObject(m_stScriptObjectPool.GetState(), scriptComponentB->ScriptObjectId);
+    m_stScriptObjectPool.InvokeCallback(m_stScriptObjectPool.GetState(), state.ScriptA->ScriptObjectId, state.ScriptA->ScriptClassId,
+        ScriptCallbackFunctions::OnCollision, 1);
+    assert(state.EntityA);  // 此时 EntityA 一定有效
+    return true;
+}
+
+void GameWorld::CollisionCheckLinear(CollisionCheckState& state, Collider* colliderB) noexcept
+{
+    auto tailerB = &m_pColliderRoot->ColliderGroupTailers[state.GroupB];
+
+    Collider* pB = colliderB;
+    assert(pB);
+    Collider* pNextB = pB->NextNode();
+    while (pB != tailerB)
+    {
+        if (pB->Enabled)  // 忽略未开启碰撞的对象
+        {
+            ++state.PotentialPairs;
+            if (CollisionCheckPair(state, pB->BindingEntity, *pB))
+            {
+                if (state.ColliderA->Group != state.GroupA || !state.ColliderA->Enabled)
+                    break;  // 如果对象 A 的碰撞状态变化，则结束这次比较
+            }
+        }
+
+        assert(pNextB);
+        if (pNextB->Group != state.GroupB)
+            break;  // 极端情况，在碰撞方法中改了其他对象的 Group
+        pB = pNextB;
+        pNextB = pB->NextNode();
+    }
+}
+
+bool GameWorld::CollisionCheckBroadPhase(CollisionCheckState& state) noexcept
+{
+    auto& broadPhase = m_stColliderBroadPhases[state.GroupB];
+    if (broadPhase.GetVersion() != m_uColliderVersion)
+    {
+        if (!RebuildCollisionBroadPhase(state.GroupB))
+            return false;
+    }
+    assert(broadPhase.GetVersion() == m_uColliderVersion);
+
+    if (!broadPhase.Query(state.LeftA, state.RightA, state.TopA, state.BottomA, m_stCollisionCandidates))
+        return false;
+    state.PotentialPairs += broadPhase.GetProxyCount();
+
+    // 候选者总是按照链表顺序给出，因此回调顺序与逐个检查时一致
+    auto version = m_uColliderVersion;
+    for (auto index : m_stCollisionCandidates)
+    {
+        auto entityB = broadPhase.GetProxy(index).BindingEntity;
+        if (!entityB)
+            continue;  // 对象已经被销毁
+        auto pB = entityB.TryGetComponent<Collider>();
+        if (!pB || pB->Group != state.GroupB || !pB->Enabled)
+            continue;
+
+        auto pNextB = pB->NextNode();
+        assert(pNextB);
+        if (!CollisionCheckPair(state, entityB, *pB))
+            continue;
+
+        if (state.ColliderA->Group != state.GroupA || !state.ColliderA->Enabled)
+            break;  // 如果对象 A 的碰撞状态变化，则结束这次比较
+
+        if (version != m_uColliderVersion)
+        {
+            // 回调中修改了对象位置或碰撞组，网格数据已经过时
+            // 剩余部分从 B 的后继开始沿链表逐个检查，与不使用粗检测时的行为保持一致
+            if (pNextB->Group == state.GroupB)
+                CollisionCheckLinear(state, pNextB);
+            break;
+        }
+    }
+    return true;
+}
+
+Result<void> GameWorld::RebuildCollisionBroadPhase(uint32_t group) noexcept
+{
+    assert(group < kColliderGroupCount);
+    auto& broadPhase = m_stColliderBroadPhases[group];
+    broadPhase.Reset(m_uColliderVersion);
+
+    // 按照链表顺序加入所有可能参与碰撞的对象
+    auto tailer = &m_pColliderRoot->ColliderGroupTailers[group];
+    for (auto p = m_pColliderRoot->ColliderGroupHeaders[group].NextNode(); p != tailer; p = p->NextNode())
+    {
+        assert(p);
+        if (!p->Enabled)
+            continue;
+
+        auto entity = p->BindingEntity;
+        auto transformComponent = entity.TryGetComponent<Transform>();
+        if (!transformComponent || !entity.HasComponent<Script>())
+            continue;
+
+        auto ret = broadPhase.AddProxy(entity, transformComponent->Location.x, transformComponent->Location.y, p->AABBHalfSize.x,
+            p->AABBHalfSize.y);
+        if (!ret)
+        {
+            broadPhase.Reset(0);
+            return ret.GetError();
+        }
+    }
+
+    auto ret = broadPhase.Build();
+    if (!ret)
+    {
+        broadPhase.Reset(0);
+        return ret.GetError();
+    }
+    return {};
+}
+
 void GameWorld::Update(double elapsedTime) noexcept
 {
 #define ADD_COUNTER(NAME, WHAT) \
@@ -640,8 +863,8 @@ int GameWorld::OnGetAttribute(LuaStack stack, ECS::EntityId id, std::string_view
         return 0;
 
     ECS::Entity ent {&m_stWorld, id};
-    Transform* transformComponent = nullptr;
-    Movement* movementComponent = nullptr;
+    ECS::ComponentPointer<Transform> transformComponent;
+    ECS::ComponentPointer<Movement> movementComponent;
     LifeTime* lifeTimeComponent = nullptr;
     Renderer* rendererComponent = nullptr;
     Collider* colliderComponent = nullptr;
@@ -846,8 +1069,8 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
         return false;
 
     ECS::Entity ent {&m_stWorld, id};
-    Transform* transformComponent = nullptr;
-    Movement* movementComponent = nullptr;
+    ECS::ComponentPointer<Transform> transformComponent;
+    ECS::ComponentPointer<Movement> movementComponent;
     LifeTime* lifeTimeComponent = nullptr;
     Renderer* rendererComponent = nullptr;
     Collider* colliderComponent = nullptr;
@@ -858,12 +1081,14 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
         case ScriptObjectAttributes::X:
             if (!(transformComponent = ent.TryGetComponent<Transform>()))
                 return false;
-            transformComponent->Location.x = stack.ReadValue<double>(value);
+            transformComponent->Location.x = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
+            InvalidateCollisionBroadPhase();
             return true;
         case ScriptObjectAttributes::Y:
             if (!(transformComponent = ent.TryGetComponent<Transform>()))
                 return false;
-            transformComponent->Location.y = stack.ReadValue<double>(value);
+            transformComponent->Location.y = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
+            InvalidateCollisionBroadPhase();
             return true;
         case ScriptObjectAttributes::DeltaX:
             stack.Error("property 'dx' is readonly");
@@ -874,12 +1099,12 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
         case ScriptObjectAttributes::Rotation:
             if (!(transformComponent = ent.TryGetComponent<Transform>()))
                 return false;
-            transformComponent->Rotation = glm::radians(stack.ReadValue<double>(value));
+            transformComponent->Rotation = static_cast<ComponentScalar>(glm::radians(stack.ReadValue<double>(value)));
             return true;
         case ScriptObjectAttributes::AngularVelocity:
             if (!(movementComponent = ent.TryGetComponent<Movement>()))
                 return false;
-            movementComponent->AngularVelocity = glm::radians(stack.ReadValue<double>(value));
+            movementComponent->AngularVelocity = static_cast<ComponentScalar>(glm::radians(stack.ReadValue<double>(value)));
             return true;
         case ScriptObjectAttributes::Timer:
             if (!(lifeTimeComponent = ent.TryGetComponent<LifeTime>()))
@@ -889,30 +1114,29 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
         case ScriptObjectAttributes::VelocityX:
             if (!(movementComponent = ent.TryGetComponent<Movement>()))
                 return false;
-            movementComponent->Velocity.x = stack.ReadValue<double>(value);
+            movementComponent->Velocity.x = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
             return true;
         case ScriptObjectAttributes::VelocityY:
             if (!(movementComponent = ent.TryGetComponent<Movement>()))
                 return false;
-            movementComponent->Velocity.y = stack.ReadValue<double>(value);
+            movementComponent->Velocity.y = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
             return true;
         case ScriptObjectAttributes::AccelVelocityX:
             if (!(movementComponent = ent.TryGetComponent<Movement>()))
                 return false;
-            movementComponent->AccelVelocity.x = stack.ReadValue<double>(value);
+            movementComponent->AccelVelocity.x = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
             return true;
         case ScriptObjectAttributes::AccelVelocityY:
             if (!(movementComponent = ent.TryGetComponent<Movement>()))
                 return false;
-            movementComponent->AccelVelocity.y = stack.ReadValue<double>(value);
+            movementComponent->AccelVelocity.y = static_cast<ComponentScalar>(stack.ReadValue<double>(value));
             return true;
         case ScriptObjectAttributes::Layer:
             if (!(rendererComponent = ent.TryGetComponent<Renderer>()))
                 return false;
-            SkipListRemove(&rendererComponent->SkipListNode);  // 从跳表脱离
+            RenderLayerIndex::Remove(*rendererComponent);  // 从索引脱离
             rendererComponent->Layer = stack.ReadValue<double>(value);
-            SkipListInsert(&(m_pRendererRoot->RendererTailer.SkipListNode), &rendererComponent->SkipListNode, RendererSortFunction,
-                m_stSkipListRandomizer);  // 重新插入
+            RenderLayerIndexInsert(m_stRenderLayerIndex, ent, *rendererComponent);  // 重新插入
             return true;
         case ScriptObjectAttributes::Group:
             if (!(colliderComponent = ent.TryGetComponent<Collider>()))
@@ -931,6 +1155,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                     colliderComponent->Group = group;
                     SkipListInsert(&(m_pColliderRoot->ColliderGroupTailers[group].SkipListNode), &colliderComponent->SkipListNode,
                         ColliderSortFunction, m_stSkipListRandomizer);  // 插入新的组
+                    InvalidateCollisionBroadPhase();
                 }
             }
             return true;
@@ -953,6 +1178,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
             if (!(colliderComponent = ent.TryGetComponent<Collider>()))
                 return false;
             colliderComponent->Enabled = stack.ReadValue<bool>(value);
+            InvalidateCollisionBroadPhase();
             return true;
         case ScriptObjectAttributes::Status:
             if (!(lifeTimeComponent = ent.TryGetComponent<LifeTime>()))
@@ -996,6 +1222,14 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
             stack.PushValue(value);
             stack.RawSet(-2, kIndexOfClassInObject);
             stack.Pop(1);
+            {
+                // 同步类缓存
+                auto classId = m_stScriptObjectPool.AcquireClass(stack, value);
+                if (!classId)
+                    LSTG_LOG_WARN_CAT(GameWorld, "Cache script class fail, ret={}", classId.GetError());
+                m_stScriptObjectPool.ReleaseClass(scriptComponent->ScriptClassId);
+                scriptComponent->ScriptClassId = classId ? *classId : kInvalidScriptClassId;
+            }
             return true;
         case ScriptObjectAttributes::ColliderX:
             if (!(colliderComponent = ent.TryGetComponent<Collider>()))
@@ -1035,6 +1269,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                     return false;
             }
             colliderComponent->RefreshAABB();
+            InvalidateCollisionBroadPhase();
             return true;
         case ScriptObjectAttributes::ColliderY:
             if (!(colliderComponent = ent.TryGetComponent<Collider>()))
@@ -1074,6 +1309,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                     return false;
             }
             colliderComponent->RefreshAABB();
+            InvalidateCollisionBroadPhase();
             return true;
         case ScriptObjectAttributes::RectangleCollider:
             if (!(colliderComponent = ent.TryGetComponent<Collider>()))
@@ -1129,6 +1365,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                         return false;
                 }
                 colliderComponent->RefreshAABB();
+                InvalidateCollisionBroadPhase();
                 return true;
             }
         case ScriptObjectAttributes::Image:
@@ -1164,6 +1401,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                         {
                             colliderComponent->Shape = spriteRenderer.Asset->GetColliderShape();
                             colliderComponent->RefreshAABB();
+                            InvalidateCollisionBroadPhase();
                         }
                         rendererComponent->RenderData = std::move(spriteRenderer);
                         return true;
@@ -1178,6 +1416,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                         {
                             colliderComponent->Shape = spriteSequenceRenderer.Asset->GetColliderShape();
                             colliderComponent->RefreshAABB();
+                            InvalidateCollisionBroadPhase();
                         }
                         rendererComponent->RenderData = std::move(spriteSequenceRenderer);
                         return true;
@@ -1203,6 +1442,7 @@ bool GameWorld::OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_vie
                         {
                             colliderComponent->Shape = particleRenderer.Asset->GetColliderShape();
                             colliderComponent->RefreshAABB();
+                            InvalidateCollisionBroadPhase();
                         }
                         rendererComponent->RenderData = std::move(particleRenderer);
                         return true;
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @date 2022/9/10
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include <lstg/v2/GamePlay/RenderLayerIndex.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::v2::GamePlay;
+
+void RenderLayerIndex::Remove(Components::Renderer& renderer) noexcept
+{
+    auto& slot = renderer.LayerSlot;
+    if (!slot.Owner)
+        return;
+
+    auto& items = slot.Owner->Items;
+    assert(slot.Index < items.size());
+    assert(items[slot.Index].Renderer == &renderer);
+    items[slot.Index].Renderer = nullptr;
+    ++slot.Owner->RemovedCount;
+
+    slot.Owner = nullptr;
+    slot.Index = 0;
+}
+
+RenderLayerIndex::~RenderLayerIndex() noexcept
+{
+    Clear();
+}
+
+Result<void> RenderLayerIndex::Insert(Components::Renderer& renderer, double layer, uint64_t sortKey) noexcept
+{
+    assert(!renderer.LayerSlot.Owner);
+    try
+    {
+        auto& bucket = m_stBuckets[layer];
+        auto& items = bucket.Items;
+
+        // 总是追加到末尾，顺序在下一次遍历前整理，因此不会影响正在进行的遍历的游标
+        if (!items.empty() && items.back().SortKey > sortKey)
+            bucket.Unsorted = true;
+        items.push_back({ sortKey, &renderer });
+        renderer.LayerSlot.Owner = &bucket;
+        renderer.LayerSlot.Index = static_cast<uint32_t>(items.size() - 1);
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    return {};
+}
+
+void RenderLayerIndex::Clear() noexcept
+{
+    assert(!m_pTopCursor);
+    for (auto& pair : m_stBuckets)
+    {
+        for (auto& item : pair.second.Items)
+        {
+            if (item.Renderer)
+            {
+                item.Renderer->LayerSlot.Owner = nullptr;
+                item.Renderer->LayerSlot.Index = 0;
+            }
+        }
+    }
+    m_stBuckets.clear();
+}
+
+void RenderLayerIndex::Compact() noexcept
+{
+    assert(!m_pTopCursor);
+    for (auto it = m_stBuckets.begin(); it != m_stBuckets.end(); )
+    {
+        auto& bucket = it->second;
+        auto& items = bucket.Items;
+        if (bucket.RemovedCount != 0)
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                if (!items[i].Renderer)
+                    continue;
+                items[count] = items[i];
+                items[count].Renderer->LayerSlot.Index = static_cast<uint32_t>(count);
+                ++count;
+            }
+            items.resize(count);
+            bucket.RemovedCount = 0;
+        }
+        if (bucket.Unsorted)
+        {
+            // 排序键相同时保持插入顺序
+            std::stable_sort(items.begin(), items.end(), [](const RenderLayerBucket::Item& lhs, const RenderLayerBucket::Item& rhs) {
+                return lhs.SortKey < rhs.SortKey;
+            });
+            for (size_t i = 0; i < items.size(); ++i)
+                items[i].Renderer->LayerSlot.Index = static_cast<uint32_t>(i);
+            bucket.Unsorted = false;
+        }
+
+        if (items.empty())
+            it = m_stBuckets.erase(it);
+        else
+            ++it;
+    }
+}
@@ -286,6 +286,63 @@ ScriptCallbackInvokeResult ScriptObjectPool::InvokeCallback(Subsystem::Script::L
     return ScriptCallbackInvokeResult::Ok;
 }
 
+ScriptCallbackInvokeResult ScriptObjectPool::InvokeCallback(Subsystem::Script::LuaStack stack, ScriptObjectId scriptId,
+    ScriptClassId classId, ScriptCallbackFunctions callback, unsigned args) noexcept
+{
+    if (classId == kInvalidScriptClassId)
+        return InvokeCallback(stack, scriptId, callback, args);
+
+#ifdef LSTG_DEVELOPMENT
+    auto checkTop = stack.GetTop();
+#endif
+
+    // 检查缓存
+    // 注意回调执行期间缓存可能发生扩容，因此不能跨越调用持有条目的引用
+    assert(classId <= m_stClasses.size() && m_stClasses[classId - 1].RefCount > 0);
+    auto bit = 1u << static_cast<unsigned>(callback);
+    const auto& entry = m_stClasses[classId - 1];
+    if (!(entry.CallbackMask & bit))
+    {
+        lua_pop(stack, args);
+        return ScriptCallbackInvokeResult::CallbackNotDefined;
+    }
+    else if (!(entry.FunctionMask & bit))
+    {
+        LSTG_LOG_ERROR_CAT(ScriptObjectPool, "Attempt to call non-function callback \"{}\" on entity, sid={}", ToString(callback),
+            scriptId);
+        lua_pop(stack, args);
+        return ScriptCallbackInvokeResult::InvalidCallback;
+    }
+
+    // 准备调用
+    lua_checkstack(stack, 3);
+    auto top = stack.GetTop();
+    assert(top >= args);
+    entry.Callbacks[static_cast<size_t>(callback) - 1].Push(stack);  // ... {args...} f(callback)
+    stack.Insert(top - args + 1);  // ... f(callback) {args...}
+    PushScriptObject(stack, scriptId);  // ... f(callback) {args...} t(object)
+    if (stack.TypeOf(-1) != LUA_TTABLE)
+    {
+        LSTG_LOG_ERROR_CAT(ScriptObjectPool, "Entity is already disposed, sid={}", scriptId);
+        lua_pop(stack, args + 2);
+        return ScriptCallbackInvokeResult::Disposed;
+    }
+    stack.Insert(top - args + 2);  // ... f(callback) t(object) {args...}
+    auto ret = stack.ProtectedCallWithTraceback(args + 1, 0);  // ...
+    if (!ret)
+    {
+        LSTG_LOG_ERROR_CAT(ScriptObjectPool, "Uncaught error in callback \"{}\" on entity {}: {}", ToString(callback), scriptId,
+            lua_tostring(stack, -1));
+        lua_pop(stack, 1);
+        return ScriptCallbackInvokeResult::CallError;
+    }
+
+#ifdef LSTG_DEVELOPMENT
+    assert(stack.GetTop() == checkTop - args);
+#endif
+    return ScriptCallbackInvokeResult::Ok;
+}
+
 std::optional<ECS::EntityId> ScriptObjectPool::GetEntityId(ScriptObjectId scriptObjectId) noexcept
 {
     auto it = m_stEntityIdMapping.find(scriptObjectId);
@@ -293,3 +350,122 @@ std::optional<ECS::EntityId> ScriptObjectPool::GetEntityId(ScriptObjectId script
         return nullopt;
     return it->second;
 }
+
+Result<ScriptClassId> ScriptObjectPool::AcquireClass(Subsystem::Script::LuaStack stack,
+    Subsystem::Script::LuaStack::AbsIndex classIndex) noexcept
+{
+    if (stack.TypeOf(classIndex) != LUA_TTABLE)
+        return kInvalidScriptClassId;
+
+    auto key = ::lua_topointer(stack, classIndex);
+    assert(key);
+    auto it = m_stClassMapping.find(key);
+    if (it != m_stClassMapping.end())
+    {
+        auto& entry = m_stClasses[it->second - 1];
+        assert(entry.Key == key && entry.RefCount > 0);
+        ++entry.RefCount;
+        return it->second;
+    }
+
+    // 类的数量很少，直接查找空闲的条目
+    size_t index = 0;
+    for (; index < m_stClasses.size(); ++index)
+    {
+        if (m_stClasses[index].RefCount == 0)
+            break;
+    }
+
+    try
+    {
+        if (index == m_stClasses.size())
+            m_stClasses.emplace_back();
+        m_stClassMapping.emplace(key, static_cast<ScriptClassId>(index + 1));
+    }
+    catch (...)  // bad_alloc
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+
+    auto& entry = m_stClasses[index];
+    lua_checkstack(stack, 2);
+    entry.ClassRef = LuaReference(stack, classIndex);
+    entry.Key = key;
+    entry.RefCount = 1;
+    stack.PushValue(classIndex);  // ... t(class)
+    LoadClassCallbacks(stack, entry);
+    stack.Pop(1);
+    return static_cast<ScriptClassId>(index + 1);
+}
+
+void ScriptObjectPool::ReleaseClass(ScriptClassId classId) noexcept
+{
+    if (classId == kInvalidScriptClassId)
+        return;
+
+    assert(classId <= m_stClasses.size());
+    auto& entry = m_stClasses[classId - 1];
+    assert(entry.RefCount > 0);
+    if (--entry.RefCount == 0)
+    {
+        m_stClassMapping.erase(entry.Key);
+        entry.ClassRef.Reset();
+        entry.Key = nullptr;
+        entry.CallbackMask = 0;
+        entry.FunctionMask = 0;
+        for (auto& ref : entry.Callbacks)
+            ref.Reset();
+    }
+}
+
+void ScriptObjectPool::RefreshClassCache(Subsystem::Script::LuaStack stack) noexcept
+{
+#ifdef LSTG_DEVELOPMENT
+    LuaStack::BalanceChecker checker(stack);
+#endif
+
+    lua_checkstack(stack, 3);
+    for (auto& entry : m_stClasses)
+    {
+        if (entry.RefCount == 0)
+            continue;
+        stack.PushValue(entry.ClassRef);  // ... t(class)
+        assert(stack.TypeOf(-1) == LUA_TTABLE);
+        LoadClassCallbacks(stack, entry);
+        stack.Pop(1);
+    }
+}
+
+void ScriptObjectPool::LoadClassCallbacks(Subsystem::Script::LuaStack stack, ClassCacheEntry& entry) noexcept
+{
+    // 与 InvokeCallback 保持一致，只要槽位非空就认为定义了回调，非函数的情况在调用时报告
+    for (size_t i = 0; i < kCallbackCount; ++i)
+    {
+        auto slot = static_cast<int>(i + 1);
+        auto bit = 1u << static_cast<unsigned>(slot);
+        auto& ref = entry.Callbacks[i];
+        stack.RawGet(-1, slot);  // ... t(class) f(callback)
+        auto type = stack.TypeOf(-1);
+        if (type == LUA_TNIL)
+            entry.CallbackMask &= ~bit;
+        else
+            entry.CallbackMask |= bit;
+        if (type != LUA_TFUNCTION)
+        {
+            entry.FunctionMask &= ~bit;
+            ref.Reset();
+        }
+        else
+        {
+            entry.FunctionMask |= bit;
+
+            // 回调未发生变化时复用已有的引用
+            ref.Push(stack);  // ... t(class) f(callback) f(cached)
+            auto same = ::lua_rawequal(stack, -1, -2);
+            stack.Pop(1);  // ... t(class) f(callback)
+            if (!same)
+                ref = LuaReference(stack, -1);
+        }
+        stack.Pop(1);  // ... t(class)
+    }
+}
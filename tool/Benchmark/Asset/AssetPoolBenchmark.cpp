@@ -0,0 +1,98 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/Asset/AssetPool.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::Asset;
+
+namespace
+{
+    class DummyAsset :
+        public Asset
+    {
+    public:
+        using Asset::Asset;
+
+        AssetTypeId GetAssetTypeId() const noexcept override
+        {
+            return 0;
+        }
+    };
+}
+
+LSTG_BENCHMARK_CASE(Asset, AssetPool)
+{
+    const size_t kAssetCount = context.IsQuick() ? 1000 : 10000;
+    const size_t kLookups = context.Scale(1000000);
+
+    vector<string> names;
+    names.reserve(kAssetCount);
+    for (size_t i = 0; i < kAssetCount; ++i)
+        names.emplace_back(fmt::format("stage{}_bullet{}", i % 16, i));
+
+    // 添加
+    auto pool = make_shared<AssetPool>();
+    vector<AssetPtr> assets;
+    assets.reserve(kAssetCount);
+    for (const auto& name : names)
+        assets.emplace_back(make_shared<DummyAsset>(name));
+
+    Stopwatch watch;
+    for (auto& asset : assets)
+    {
+        if (!context.Check(static_cast<bool>(pool->AddAsset(asset)), "AddAsset"))
+            return;
+    }
+    context.Report("AddAsset", static_cast<double>(kAssetCount), watch.GetElapsed(), "asset");
+
+    // 按名称查找，命中与未命中交替
+    size_t hits = 0;
+    watch.Restart();
+    for (size_t i = 0; i < kLookups; ++i)
+    {
+        auto& name = names[(i * 7919u) % kAssetCount];
+        hits += pool->GetAsset(name) ? 1 : 0;
+    }
+    context.Report("GetAsset(name) hit", static_cast<double>(kLookups), watch.GetElapsed(), "lookup");
+    context.Check(hits == kLookups, "every lookup hits");
+
+    vector<string> missNames;
+    missNames.reserve(kAssetCount);
+    for (size_t i = 0; i < kAssetCount; ++i)
+        missNames.emplace_back(fmt::format("stage{}_laser{}", i % 16, i));
+    hits = 0;
+    watch.Restart();
+    for (size_t i = 0; i < kLookups; ++i)
+        hits += pool->GetAsset(missNames[(i * 7919u) % kAssetCount]) ? 1 : 0;
+    context.Report("GetAsset(name) miss", static_cast<double>(kLookups), watch.GetElapsed(), "lookup");
+    context.Check(hits == 0, "no lookup of an absent name hits");
+
+    // 只保留一半资产的外部引用，Clear(Unused) 应当回收另一半
+    for (size_t i = 0; i < kAssetCount; i += 2)
+        assets[i].reset();
+    watch.Restart();
+    pool->Clear(AssetPool::AssetClearTypes::Unused);
+    context.Report("Clear(Unused)", static_cast<double>(kAssetCount), watch.GetElapsed(), "asset");
+    bool clearedUnused = true;
+    for (size_t i = 0; i < kAssetCount; ++i)
+        clearedUnused &= (pool->ContainsAsset(names[i]) == (i % 2 == 1));
+    context.Check(clearedUnused, "Clear(Unused) removes exactly the unreferenced assets");
+
+    // 按名称删除剩余资产
+    watch.Restart();
+    size_t removed = 0;
+    for (size_t i = 1; i < kAssetCount; i += 2)
+        removed += pool->RemoveAsset(names[i]) ? 1 : 0;
+    context.Report("RemoveAsset(name)", static_cast<double>(removed), watch.GetElapsed(), "asset");
+    context.Check(removed == kAssetCount / 2, "every remaining asset is removed");
+    context.Check(!pool->ContainsAsset(names[1]), "removed asset is not found");
+}
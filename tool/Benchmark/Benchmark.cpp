@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "Benchmark.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <fmt/format.h>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+
+void Context::Report(std::string_view what, double count, double seconds, std::string_view unit)
+{
+    auto perSecond = seconds > 0 ? count / seconds : 0.;
+    auto nsPerOp = count > 0 ? seconds * 1e9 / count : 0.;
+    fmt::print("  {:<48} {:>14.0f} {}/s {:>12.2f} ns/{}\n", what, perSecond, unit, nsPerOp, unit);
+}
+
+void Context::Note(std::string_view what, double value)
+{
+    fmt::print("  {:<48} {:>14.6g}\n", what, value);
+}
+
+bool Context::Check(bool condition, std::string_view what)
+{
+    if (!condition)
+    {
+        ++m_uFailedChecks;
+        fmt::print("  CHECK FAILED: {}\n", what);
+    }
+    return condition;
+}
+
+std::vector<Case>& lstg::Benchmark::GetCases() noexcept
+{
+    static std::vector<Case> kCases;
+    return kCases;
+}
+
+CaseRegistration::CaseRegistration(const char* name, CaseFunction func) noexcept
+{
+    GetCases().push_back({ name, func });
+}
+
+int main(int argc, const char* argv[])
+{
+    // 用法：LuaSTGPlusBenchmark [--list] [--quick] [用例名前缀...]
+    bool list = false, quick = false;
+    vector<string_view> filters;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (::strcmp(argv[i], "--list") == 0)
+            list = true;
+        else if (::strcmp(argv[i], "--quick") == 0)
+            quick = true;
+        else
+            filters.emplace_back(argv[i]);
+    }
+
+    auto cases = GetCases();
+    std::sort(cases.begin(), cases.end(), [](const Case& lhs, const Case& rhs) { return ::strcmp(lhs.Name, rhs.Name) < 0; });
+
+    size_t executed = 0, failed = 0;
+    for (const auto& c : cases)
+    {
+        string_view name = c.Name;
+        if (!filters.empty() && std::none_of(filters.begin(), filters.end(), [&](string_view f) { return name.substr(0, f.size()) == f; }))
+            continue;
+
+        if (list)
+        {
+            fmt::print("{}\n", name);
+            continue;
+        }
+
+        fmt::print("[{}]\n", name);
+        Context context(quick);
+        c.Function(context);
+        ++executed;
+        if (context.IsFailed())
+            ++failed;
+    }
+
+    if (list)
+        return 0;
+    if (executed == 0)
+    {
+        fmt::print("No case matched\n");
+        return 1;
+    }
+    if (failed > 0)
+    {
+        fmt::print("{} of {} case(s) failed\n", failed, executed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lstg::Benchmark
+{
+    /**
+     * 用例运行上下文
+     */
+    class Context
+    {
+    public:
+        explicit Context(bool quick) noexcept
+            : m_bQuick(quick) {}
+
+    public:
+        /**
+         * 是否为快速模式
+         * 快速模式下（如由 ctest 调用）只需验证正确性，用例应缩小规模。
+         */
+        bool IsQuick() const noexcept { return m_bQuick; }
+
+        /**
+         * 按照运行模式缩放迭代次数
+         * @param count 完整模式下的次数
+         * @return 实际次数
+         */
+        size_t Scale(size_t count) const noexcept { return m_bQuick ? std::max<size_t>(1u, count / 100u) : count; }
+
+        /**
+         * 报告一项测量结果
+         * @param what 测量项
+         * @param count 完成的操作数
+         * @param seconds 耗时
+         * @param unit 操作单位
+         */
+        void Report(std::string_view what, double count, double seconds, std::string_view unit = "op");
+
+        /**
+         * 报告一项数值
+         * @param what 测量项
+         * @param value 数值
+         */
+        void Note(std::string_view what, double value);
+
+        /**
+         * 检查条件
+         * 条件不成立时记录失败，用例会继续执行。
+         * @param condition 条件
+         * @param what 说明
+         * @return 条件
+         */
+        bool Check(bool condition, std::string_view what);
+
+        /**
+         * 是否存在失败的检查
+         */
+        bool IsFailed() const noexcept { return m_uFailedChecks > 0; }
+
+    private:
+        bool m_bQuick = false;
+        size_t m_uFailedChecks = 0;
+    };
+
+    /**
+     * 计时器
+     */
+    class Stopwatch
+    {
+    public:
+        Stopwatch() noexcept
+            : m_stStart(std::chrono::steady_clock::now()) {}
+
+    public:
+        /**
+         * 获取经过的秒数
+         */
+        double GetElapsed() const noexcept
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_stStart).count();
+        }
+
+        /**
+         * 重新开始计时
+         */
+        void Restart() noexcept { m_stStart = std::chrono::steady_clock::now(); }
+
+    private:
+        std::chrono::steady_clock::time_point m_stStart;
+    };
+
+    /**
+     * 阻止编译器优化掉计算结果
+     * @param value 值
+     */
+    template <typename T>
+    inline void DoNotOptimize(const T& value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* s_pSink = nullptr;
+        s_pSink = &value;
+#endif
+    }
+
+    using CaseFunction = void(*)(Context&);
+
+    /**
+     * 用例
+     */
+    struct Case
+    {
+        const char* Name = nullptr;
+        CaseFunction Function = nullptr;
+    };
+
+    /**
+     * 获取所有注册的用例
+     */
+    std::vector<Case>& GetCases() noexcept;
+
+    /**
+     * 用例注册器
+     */
+    struct CaseRegistration
+    {
+        CaseRegistration(const char* name, CaseFunction func) noexcept;
+    };
+}
+
+/**
+ * 定义用例
+ * 用例名为 GROUP.NAME，可以在命令行上按照前缀选择执行。
+ */
+#define LSTG_BENCHMARK_CASE(GROUP, NAME) \
+    static void Benchmark_##GROUP##_##NAME(::lstg::Benchmark::Context& context); \
+    static const ::lstg::Benchmark::CaseRegistration kBenchmarkRegistration_##GROUP##_##NAME { \
+        #GROUP "." #NAME, Benchmark_##GROUP##_##NAME }; \
+    static void Benchmark_##GROUP##_##NAME(::lstg::Benchmark::Context& context)
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <lstg/Core/ECS/World.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+
+namespace
+{
+    template <ECS::ComponentId Id, size_t Size>
+    struct DummyComponent
+    {
+        uint8_t Payload[Size] {};
+
+        void Reset() noexcept {}
+    };
+
+    template <ECS::ComponentId Id, size_t Size>
+    constexpr ECS::ComponentId GetComponentId(DummyComponent<Id, Size>*) noexcept
+    {
+        return Id;
+    }
+
+    // 与 v2 的对象布局相近：六个组件，其中部分实例缺少尾部的组件
+    using C0 = DummyComponent<0, 56>;
+    using C1 = DummyComponent<1, 64>;
+    using C2 = DummyComponent<2, 24>;
+    using C3 = DummyComponent<3, 48>;
+    using C4 = DummyComponent<4, 32>;
+    using C5 = DummyComponent<5, 16>;
+}
+
+LSTG_BENCHMARK_CASE(ECS, TryGetComponent)
+{
+    const size_t kEntityCount = context.IsQuick() ? 1000 : 100000;
+    const size_t kPasses = context.Scale(200);
+
+    ECS::World world;
+    vector<ECS::Entity> entities;
+    entities.reserve(kEntityCount);
+    for (size_t i = 0; i < kEntityCount; ++i)
+    {
+        auto ret = (i % 5 == 4) ? world.CreateEntity<C0, C1, C3>() : world.CreateEntity<C0, C1, C2, C3, C4, C5>();
+        if (!context.Check(static_cast<bool>(ret), "CreateEntity"))
+            return;
+        entities.push_back(*ret);
+    }
+
+    // 存在的组件与不存在的组件混合查询
+    size_t found = 0;
+    Stopwatch watch;
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        for (auto& ent : entities)
+        {
+            found += (ent.TryGetComponent<C0>() != nullptr);
+            found += (ent.TryGetComponent<C3>() != nullptr);
+            found += (ent.TryGetComponent<C5>() != nullptr);
+        }
+    }
+    auto elapsed = watch.GetElapsed();
+    DoNotOptimize(found);
+
+    auto expected = kPasses * (kEntityCount * 2 + (kEntityCount - kEntityCount / 5));
+    context.Check(found == expected, "component presence");
+    context.Report("Entity::TryGetComponent", static_cast<double>(kPasses * kEntityCount * 3), elapsed, "lookup");
+
+    for (auto& ent : entities)
+        ent.Destroy();
+}
@@ -0,0 +1,17 @@
+### 以 -graphics=null 运行 LuaSTGPlus2 的帧循环
+# 发布模式下资源从主程序所在目录查找，因此将主程序与测试脚本复制到同一个目录中，并在该目录下运行
+# 参数：LSTG_EXECUTABLE 主程序路径，LSTG_ASSETS_DIR 脚本目录，LSTG_WORK_DIR 运行目录
+
+file(REMOVE_RECURSE "${LSTG_WORK_DIR}")
+file(MAKE_DIRECTORY "${LSTG_WORK_DIR}")
+file(COPY "${LSTG_EXECUTABLE}" DESTINATION "${LSTG_WORK_DIR}")
+file(COPY "${LSTG_ASSETS_DIR}/" DESTINATION "${LSTG_WORK_DIR}")
+
+get_filename_component(LSTG_EXECUTABLE_NAME "${LSTG_EXECUTABLE}" NAME)
+execute_process(
+    COMMAND "${LSTG_WORK_DIR}/${LSTG_EXECUTABLE_NAME}" -graphics=null
+    WORKING_DIRECTORY "${LSTG_WORK_DIR}"
+    RESULT_VARIABLE LSTG_RESULT)
+if(NOT LSTG_RESULT EQUAL 0)
+    message(FATAL_ERROR "LuaSTGPlus2 exited with ${LSTG_RESULT}")
+endif()
@@ -0,0 +1,76 @@
+-- 无头设备帧循环测试
+-- 创建 RT 与引用 RT 的精灵，生成若干运动的对象并逐帧绘制，运行指定帧数后退出主循环。
+-- 任何脚本错误都会以 error 级别写入日志，由 ctest 判定失败。
+
+local kFrames = 120
+local kObjects = 64
+
+local frame = 0
+local spawned = 0
+
+local Mover = { is_class = true }
+Mover[1] = function(self)  -- init
+    local i = spawned
+    spawned = spawned + 1
+    self.img = "null_device_quad"
+    self.layer = 0
+    self.group = 0
+    self.x = (i % 8) * 64 - 224
+    self.y = math.floor(i / 8) * 48 - 168
+    lstg.SetV(self, 1, i * 360 / kObjects)
+end
+Mover[2] = function(self) end  -- del
+Mover[3] = function(self)  -- frame
+    self.rot = self.rot + 3
+end
+Mover[4] = function(self)  -- render
+    lstg.DefaultRenderFunc(self)
+end
+Mover[5] = function(self, other) end  -- colli
+Mover[6] = function(self) end  -- kill
+
+function GameInit()
+    lstg.CreateRenderTarget("null_device_rt")
+    lstg.LoadImage("null_device_quad", "null_device_rt", 0, 0, 16, 16)
+    lstg.SetBound(-320, 320, -240, 240)
+    for _ = 1, kObjects do
+        lstg.New(Mover)
+    end
+end
+
+function FocusGainFunc()
+end
+
+function FocusLoseFunc()
+end
+
+function FrameFunc()
+    frame = frame + 1
+    lstg.ObjFrame()
+    lstg.BoundCheck()
+    lstg.CollisionCheck(0, 0)
+    lstg.UpdateXY()
+    lstg.AfterFrame()
+
+    if frame >= kFrames then
+        lstg.SystemLog(string.format("Null device frame loop finished, %d frames, %d objects alive", frame, lstg.GetnObj()))
+        return true
+    end
+    return false
+end
+
+function RenderFunc()
+    lstg.BeginScene()
+
+    -- 先绘制 RT，再把 RT 作为纹理绘制到屏幕上
+    lstg.PushRenderTarget("null_device_rt")
+    lstg.RenderClear(lstg.Color(255, 32, 64, 128))
+    lstg.PopRenderTarget()
+
+    lstg.RenderClear(lstg.Color(255, 0, 0, 0))
+    lstg.SetViewport(0, 640, 0, 480)
+    lstg.SetOrtho(-320, 320, -240, 240)
+    lstg.ObjRender()
+
+    lstg.EndScene()
+end
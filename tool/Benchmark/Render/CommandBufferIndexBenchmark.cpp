@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/Render/Drawing2D/CommandBuffer.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::Render::Drawing2D;
+
+using Subsystem::Render::ColorRGBA32;
+
+namespace
+{
+    struct RecordStatistics
+    {
+        size_t ExpandedQuads = 0;  // 以顶点形式记录的四边形
+        size_t Instances = 0;  // 以实例形式记录的精灵
+    };
+
+    /**
+     * 混合使用三种绘制接口录制四边形
+     * 每个四边形的 Color0 记录其编号，用于校验索引没有跨越四边形。
+     */
+    Result<RecordStatistics> RecordQuads(CommandBuffer& buffer, size_t quads) noexcept
+    {
+        RecordStatistics stat;
+        SpriteInstance instances[4];
+        size_t i = 0;
+        while (i < quads)
+        {
+            // 每隔一段切换混合模式以产生多个命令，位置分散使得重排可以跨越命令合并
+            buffer.SetColorBlendMode(((i / 7) % 2) ? ColorBlendMode::Add : ColorBlendMode::Alpha);
+            auto x = static_cast<float>(i % 97) / 48.5f - 1.f;
+            auto y = static_cast<float>((i / 97) % 89) / 44.5f - 1.f;
+            auto count = std::min<size_t>(1 + i % 4, quads - i);
+
+            switch (i % 3)
+            {
+                case 0:
+                    {
+                        auto ret = buffer.DrawQuadInPlace(nullptr);
+                        if (!ret)
+                            return ret.GetError();
+                        for (auto& v : *ret)
+                            v = { { x, y, 0.5f }, { 0.f, 0.f }, ColorRGBA32(static_cast<uint32_t>(i)), 0xFFFFFFFF };
+                        stat.ExpandedQuads += 1;
+                        i += 1;
+                    }
+                    break;
+                case 1:
+                    {
+                        auto ret = buffer.DrawQuadsInPlace(nullptr, count);
+                        if (!ret)
+                            return ret.GetError();
+                        for (size_t j = 0; j < ret->GetSize(); ++j)
+                            (*ret)[j] = { { x, y, 0.5f }, { 0.f, 0.f }, ColorRGBA32(static_cast<uint32_t>(i + j / 4)), 0xFFFFFFFF };
+                        stat.ExpandedQuads += count;
+                        i += count;
+                    }
+                    break;
+                default:
+                    {
+                        for (size_t j = 0; j < count; ++j)
+                        {
+                            instances[j].Position = { x, y, 0.5f };
+                            instances[j].Shape = { 0.01f, 0.01f, 0.005f, 0.005f };
+                            instances[j].TexRect = { 0.f, 0.f, 1.f, 1.f };
+                            instances[j].Color0 = ColorRGBA32(static_cast<uint32_t>(i + j));
+                        }
+                        auto ret = buffer.DrawSpriteInstances(nullptr, { instances, count });
+                        if (!ret)
+                            return ret.GetError();
+                        if (buffer.IsInstancingEnabled())
+                            stat.Instances += count;
+                        else
+                            stat.ExpandedQuads += count;
+                        i += count;
+                    }
+                    break;
+            }
+        }
+        return stat;
+    }
+
+    /**
+     * 校验所有命令引用的索引和顶点
+     */
+    void ValidateDrawData(Context& context, const CommandBuffer::DrawData& drawData, const RecordStatistics& stat)
+    {
+        const auto& vertices = drawData.VertexBuffer;
+        const auto& indices = drawData.IndexBuffer;
+        vector<uint8_t> referenced(vertices.size(), 0);
+        size_t indexCount = 0, instanceCount = 0;
+        bool rangeValid = true, vertexValid = true, quadIntact = true;
+
+        for (const auto& group : drawData.CommandGroup)
+        {
+            for (const auto& queue : group->Queue)
+            {
+                for (const auto& cmd : queue->Commands)
+                {
+                    if (cmd.Type == CommandBuffer::DrawCommandTypes::SpriteInstance)
+                    {
+                        rangeValid &= (cmd.IndexCount == 0);
+                        rangeValid &= (cmd.InstanceStart + cmd.InstanceCount <= drawData.InstanceBuffer.size());
+                        instanceCount += cmd.InstanceCount;
+                        continue;
+                    }
+
+                    if (cmd.IndexStart + cmd.IndexCount > indices.size() || cmd.IndexCount % 6 != 0)
+                    {
+                        rangeValid = false;
+                        continue;
+                    }
+                    indexCount += cmd.IndexCount;
+
+                    for (size_t j = cmd.IndexStart; j < cmd.IndexStart + cmd.IndexCount; j += 6)
+                    {
+                        uint32_t quadId = 0;
+                        for (size_t k = 0; k < 6; ++k)
+                        {
+                            auto vertex = cmd.BaseVertexIndex + indices[j + k];
+                            if (vertex >= vertices.size())
+                            {
+                                vertexValid = false;
+                                break;
+                            }
+                            referenced[vertex] = 1;
+                            if (k == 0)
+                                quadId = vertices[vertex].Color0.rgba32();
+                            else
+                                quadIntact &= (vertices[vertex].Color0.rgba32() == quadId);
+                        }
+                    }
+                }
+            }
+        }
+
+        context.Check(rangeValid, "every IndexStart/IndexCount and instance range is inside the buffers");
+        context.Check(vertexValid, "every BaseVertexIndex + index addresses a recorded vertex");
+        context.Check(quadIntact, "every six indices address a single quad");
+        context.Check(vertices.size() == stat.ExpandedQuads * 4, "four vertices per quad");
+        context.Check(indexCount == stat.ExpandedQuads * 6, "six indices per quad are drawn exactly once");
+        context.Check(std::all_of(referenced.begin(), referenced.end(), [](uint8_t v) { return v != 0; }),
+            "every vertex is referenced");
+        context.Check(instanceCount == stat.Instances, "every instance is drawn exactly once");
+    }
+}
+
+LSTG_BENCHMARK_CASE(Render, CommandBufferIndices)
+{
+    // 校验用例，快速模式下同样录制 10 万个四边形
+    const size_t kQuads = 100000;
+
+    for (int mode = 0; mode < 4; ++mode)
+    {
+        auto reorder = (mode & 1) != 0;
+        auto instancing = (mode & 2) != 0;
+
+        CommandBuffer buffer;
+        buffer.SetReorderEnabled(reorder);
+        buffer.SetInstancingEnabled(instancing);
+        buffer.Begin();
+
+        Stopwatch watch;
+        auto stat = RecordQuads(buffer, kQuads);
+        if (!context.Check(static_cast<bool>(stat), "record quads"))
+            return;
+        auto drawData = buffer.End();
+        auto elapsed = watch.GetElapsed();
+
+        context.Report(fmt::format("Record (reorder {}, instancing {})", reorder ? "on" : "off", instancing ? "on" : "off"),
+            static_cast<double>(kQuads), elapsed, "quad");
+        context.Note("commands before reorder", static_cast<double>(buffer.GetLastCommandCountBeforeReorder()));
+        context.Note("commands after reorder", static_cast<double>(buffer.GetLastCommandCountAfterReorder()));
+        ValidateDrawData(context, drawData, *stat);
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <SDL.h>
+#include <fmt/format.h>
+#include <lstg/Core/AppBase.hpp>
+#include <lstg/Core/Subsystem/SubsystemContainer.hpp>
+#include <lstg/Core/Subsystem/EventBusSystem.hpp>
+#include <lstg/Core/Subsystem/WindowSystem.hpp>
+#include <lstg/Core/Subsystem/VirtualFileSystem.hpp>
+#include <lstg/Core/Subsystem/RenderSystem.hpp>
+#include <lstg/Core/Subsystem/Render/Drawing2D/CommandBuffer.hpp>
+#include <lstg/Core/Subsystem/Render/Drawing2D/CommandExecutor.hpp>
+#include "Subsystem/Render/detail/RenderDevice/RenderDeviceNull.hpp"
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::Render::Drawing2D;
+
+namespace
+{
+    /**
+     * 录制一帧
+     * 录制完成后由调用方 End 获取 DrawData。
+     * @param buffer 命令缓冲
+     * @param quads 四边形个数
+     * @param stateRun 每隔多少个四边形切换一次渲染状态
+     */
+    Result<void> RecordFrame(CommandBuffer& buffer, size_t quads, size_t stateRun) noexcept
+    {
+        static const ColorBlendMode kBlendModes[] = {
+            ColorBlendMode::Alpha,
+            ColorBlendMode::Add,
+        };
+        static const FogTypes kFogTypes[] = {
+            FogTypes::Disabled,
+            FogTypes::Linear,
+        };
+
+        buffer.Begin();
+        for (size_t i = 0; i < quads; ++i)
+        {
+            auto state = i / stateRun;
+            buffer.SetColorBlendMode(kBlendModes[state % 2]);
+            buffer.SetFog(kFogTypes[(state / 2) % 2], 0xFFFFFFFF, 0.f, 1.f);
+
+            auto ret = buffer.DrawQuadInPlace(nullptr);
+            if (!ret)
+                return ret.GetError();
+
+            auto x = static_cast<float>(i % 640), y = static_cast<float>((i / 640) % 480);
+            auto& v = *ret;
+            v[0] = { { x, y, 0.5f }, { 0.f, 0.f }, 0x00000000, 0xFFFFFFFF };
+            v[1] = { { x + 16.f, y, 0.5f }, { 1.f, 0.f }, 0x00000000, 0xFFFFFFFF };
+            v[2] = { { x + 16.f, y + 16.f, 0.5f }, { 1.f, 1.f }, 0x00000000, 0xFFFFFFFF };
+            v[3] = { { x, y + 16.f, 0.5f }, { 0.f, 1.f }, 0x00000000, 0xFFFFFFFF };
+        }
+        return {};
+    }
+}
+
+LSTG_BENCHMARK_CASE(Render, CommandExecutorReplay)
+{
+    // 通过命令行选择无头设备，无显示器时使用 SDL 的 dummy 视频驱动
+    const char* argv[] = { "LuaSTGPlusBenchmark", "-graphics=null" };
+    AppBase::ParseCmdline(2, argv);
+    if (!::SDL_getenv("SDL_VIDEODRIVER"))
+        ::SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+
+    Subsystem::SubsystemContainer container;
+    shared_ptr<Subsystem::RenderSystem> renderSystem;
+    try
+    {
+        const auto kFlags = Subsystem::SubsystemRegisterFlags::NoUpdate | Subsystem::SubsystemRegisterFlags::NoRender |
+            Subsystem::SubsystemRegisterFlags::NoEvent;
+        container.Register<Subsystem::EventBusSystem>("EventBusSystem", 0, kFlags);
+        container.Register<Subsystem::WindowSystem>("WindowSystem", 0, kFlags);
+        container.Register<Subsystem::VirtualFileSystem>("VirtualFileSystem", 0, kFlags);
+        container.Register<Subsystem::RenderSystem>("RenderSystem", 0, kFlags);
+        container.ConstructAll();
+        renderSystem = container.Get<Subsystem::RenderSystem>();
+    }
+    catch (const std::exception& ex)
+    {
+        // dummy 视频驱动下总能创建窗口，失败说明环境有问题，不能静默跳过
+        context.Check(false, fmt::format("construct render system: {}", ex.what()));
+        return;
+    }
+    auto nullDevice = dynamic_cast<Subsystem::Render::detail::RenderDevice::RenderDeviceNull*>(renderSystem->GetRenderDevice());
+    if (!context.Check(nullDevice != nullptr, "null render device (-graphics=null needs LSTG_PARSE_CMDLINE)"))
+        return;
+
+    const size_t kQuads = context.IsQuick() ? 1000 : 20000;
+    const size_t kFrames = context.Scale(200);
+    const auto& stat = nullDevice->GetStatistics();
+    CommandExecutor executor(*renderSystem);
+    CommandBuffer buffer;
+
+    // stateRun 为 1 时每个四边形都是一次绘制，衡量每次绘制的执行器开销（效果组选择、状态设置）
+    for (size_t stateRun : { static_cast<size_t>(1), static_cast<size_t>(64) })
+    {
+        auto ret = RecordFrame(buffer, kQuads, stateRun);
+        if (!context.Check(static_cast<bool>(ret), "record frame"))
+            return;
+        auto drawData = buffer.End();
+
+        size_t expectedDraws = (kQuads + stateRun - 1) / stateRun;
+        size_t draws = 0;
+        auto drawCallsBefore = stat.DrawCalls;
+        Stopwatch watch;
+        for (size_t frame = 0; frame < kFrames; ++frame)
+        {
+            if (!context.Check(static_cast<bool>(renderSystem->BeginFrame()), "BeginFrame"))
+                return;
+            if (!context.Check(static_cast<bool>(executor.Execute(drawData)), "Execute"))
+                return;
+            draws += executor.GetLastExecutedDrawCalls();
+            renderSystem->EndFrame();
+        }
+        auto elapsed = watch.GetElapsed();
+
+        context.Check(draws == expectedDraws * kFrames, "one draw call per state run");
+        context.Check(stat.DrawCalls - drawCallsBefore >= draws, "every draw reaches the device");
+        context.Report(fmt::format("CommandExecutor::Execute draw (state run {})", stateRun), static_cast<double>(draws),
+            elapsed, "draw");
+        context.Report(fmt::format("CommandExecutor::Execute quad (state run {})", stateRun),
+            static_cast<double>(kQuads * kFrames), elapsed, "quad");
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <cmath>
+#include <random>
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/Render/Drawing2D/SpriteTransform.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::Render::Drawing2D;
+
+namespace
+{
+    const char* GetKernelName(SpriteTransformKernels kernel) noexcept
+    {
+        switch (kernel)
+        {
+            case SpriteTransformKernels::Scalar:
+                return "Scalar";
+            case SpriteTransformKernels::SSE2:
+                return "SSE2";
+            case SpriteTransformKernels::AVX2:
+                return "AVX2";
+            case SpriteTransformKernels::NEON:
+                return "NEON";
+            default:
+                return "Unknown";
+        }
+    }
+
+    /**
+     * 比较两组顶点，返回最大误差，属性不一致时返回无穷大
+     */
+    float CompareVertices(const vector<Vertex>& lhs, const vector<Vertex>& rhs) noexcept
+    {
+        float maxError = 0.f;
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            const auto& a = lhs[i];
+            const auto& b = rhs[i];
+            if (a.Position.z != b.Position.z || a.TexCoord != b.TexCoord || !(a.Color0 == b.Color0) || !(a.Color1 == b.Color1))
+                return std::numeric_limits<float>::infinity();
+            auto scale = std::max(1.f, std::max(std::abs(a.Position.x), std::abs(a.Position.y)));
+            maxError = std::max(maxError, std::abs(a.Position.x - b.Position.x) / scale);
+            maxError = std::max(maxError, std::abs(a.Position.y - b.Position.y) / scale);
+        }
+        return maxError;
+    }
+}
+
+LSTG_BENCHMARK_CASE(Render, SpriteTransform)
+{
+    // 数量不是 8 的倍数，以覆盖 SIMD 内核余下的标量部分
+    const size_t kSprites = context.IsQuick() ? 1003 : 100003;
+    const size_t kPasses = context.Scale(200);
+
+    context.Note(fmt::format("Selected kernel: {}", GetKernelName(GetSpriteTransformKernel())), 0);
+
+    // 分别测量没有旋转与一半精灵带有旋转的情况，后者的耗时主要在三角函数上
+    for (auto rotated : { false, true })
+    {
+        const char* scene = rotated ? "half rotated" : "no rotation";
+
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<float> position(-400.f, 400.f);
+        std::uniform_real_distribution<float> size(4.f, 64.f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.f);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> texCoord(0.f, 0.5f);
+        vector<SpriteInstance> instances(kSprites);
+        for (size_t i = 0; i < kSprites; ++i)
+        {
+            auto& instance = instances[i];
+            auto w = size(rng), h = size(rng);
+            instance.Position = { position(rng), position(rng), 0.5f };
+            instance.Rotation = (rotated && (i % 2)) ? angle(rng) : 0.f;
+            instance.Shape = { w, h, w * 0.5f, h * 0.5f };
+            instance.Scale = { scale(rng), scale(rng) };
+            instance.TexRect = { texCoord(rng), texCoord(rng), texCoord(rng), texCoord(rng) };
+            instance.Color0 = static_cast<uint32_t>(i);
+            instance.Color1 = static_cast<uint32_t>(~i);
+        }
+
+        // 以标量版本为基准
+        vector<Vertex> reference(kSprites * 4);
+        TransformSpriteInstances(SpriteTransformKernels::Scalar, { reference.data(), reference.size() },
+            { instances.data(), instances.size() });
+
+        vector<Vertex> output(kSprites * 4);
+        for (auto kernel : { SpriteTransformKernels::Scalar, SpriteTransformKernels::SSE2, SpriteTransformKernels::AVX2,
+            SpriteTransformKernels::NEON })
+        {
+            if (!IsSpriteTransformKernelSupported(kernel))
+                continue;
+
+            Stopwatch watch;
+            for (size_t pass = 0; pass < kPasses; ++pass)
+            {
+                TransformSpriteInstances(kernel, { output.data(), output.size() }, { instances.data(), instances.size() });
+                DoNotOptimize(output.data());
+            }
+            auto elapsed = watch.GetElapsed();
+            context.Report(fmt::format("TransformSpriteInstances ({}, {})", GetKernelName(kernel), scene),
+                static_cast<double>(kSprites * kPasses), elapsed, "quad");
+
+            auto error = CompareVertices(reference, output);
+            context.Note(fmt::format("  max relative error vs scalar ({})", GetKernelName(kernel)), error);
+            context.Check(error <= 1e-5f, fmt::format("{} kernel matches the scalar kernel ({})", GetKernelName(kernel), scene));
+        }
+
+        // 运行时选择的内核
+        TransformSpriteInstances({ output.data(), output.size() }, { instances.data(), instances.size() });
+        context.Check(CompareVertices(reference, output) <= 1e-5f, fmt::format("dispatched kernel matches the scalar kernel ({})", scene));
+    }
+}
@@ -0,0 +1,263 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <algorithm>
+#include <random>
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/VFS/InflateStream.hpp>
+#include <lstg/Core/Subsystem/VFS/ZipArchiveFileSystem.hpp>
+#include "ZipArchiveBuilder.hpp"
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::VFS;
+
+namespace
+{
+    const char* kPassword = "benchmark";
+
+    /**
+     * 块边界
+     */
+    struct BlockBoundary
+    {
+        uint64_t Output = 0;  // 解压后数据中的位置
+        bool Aligned = false;  // 边界是否位于字节边界上
+    };
+
+    /**
+     * 按位写出 deflate 数据
+     */
+    class BitWriter
+    {
+    public:
+        void Write(uint32_t value, unsigned bits)
+        {
+            for (unsigned i = 0; i < bits; ++i)
+                WriteBit((value >> i) & 1u);
+        }
+
+        void WriteHuffman(uint32_t code, unsigned bits)
+        {
+            // Huffman 编码从最高位开始写出
+            for (unsigned i = bits; i > 0; --i)
+                WriteBit((code >> (i - 1)) & 1u);
+        }
+
+        void AlignToByte() noexcept { m_uBits = 0; }
+
+        [[nodiscard]] bool IsAligned() const noexcept { return m_uBits == 0; }
+
+        std::vector<uint8_t>& GetData() noexcept { return m_stData; }
+
+    private:
+        void WriteBit(uint32_t bit)
+        {
+            if (m_uBits == 0)
+                m_stData.push_back(0);
+            m_stData.back() |= static_cast<uint8_t>(bit << m_uBits);
+            m_uBits = (m_uBits + 1) % 8;
+        }
+
+    private:
+        std::vector<uint8_t> m_stData;
+        unsigned m_uBits = 0;
+    };
+
+    /**
+     * 生成 Raw Deflate 数据
+     * 交替使用固定 Huffman 块和不压缩的块：前者结束于任意位，后者结束于字节边界，从而得到两种检查点。
+     * @param content 数据
+     * @param boundaries 输出块边界（不含起始和结尾）
+     */
+    std::vector<uint8_t> DeflateInMixedBlocks(const std::vector<uint8_t>& content, std::vector<BlockBoundary>& boundaries)
+    {
+        BitWriter writer;
+        // mt19937 的输出序列由标准规定，各平台生成的块序列一致
+        std::mt19937 random(3);
+
+        size_t offset = 0;
+        bool fixedHuffman = true;
+        while (offset < content.size())
+        {
+            auto count = std::min<size_t>(8 * 1024 + random() % (16 * 1024), content.size() - offset);
+            auto last = (offset + count == content.size());
+            writer.Write(last ? 1 : 0, 1);  // BFINAL
+            if (fixedHuffman)
+            {
+                writer.Write(1, 2);  // BTYPE = 01
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto literal = content[offset + i];
+                    if (literal < 144)
+                        writer.WriteHuffman(0x30u + literal, 8);
+                    else
+                        writer.WriteHuffman(0x190u + (literal - 144u), 9);
+                }
+                writer.WriteHuffman(0, 7);  // End of block
+            }
+            else
+            {
+                writer.Write(0, 2);  // BTYPE = 00
+                writer.AlignToByte();
+                auto& data = writer.GetData();
+                Benchmark::detail::WriteU16(data, static_cast<uint16_t>(count));
+                Benchmark::detail::WriteU16(data, static_cast<uint16_t>(~count));
+                data.insert(data.end(), content.begin() + offset, content.begin() + offset + count);
+            }
+            offset += count;
+            if (!last)
+                boundaries.push_back({ offset, writer.IsAligned() });
+            fixedHuffman = !fixedHuffman;
+        }
+        return std::move(writer.GetData());
+    }
+
+    /**
+     * 按照 InflateCheckpointIndex 的规则计算会放置检查点的块边界
+     * 每个检查点放在距上一个检查点（起始处视作检查点）至少 interval 的第一个块边界上。
+     */
+    std::vector<BlockBoundary> SelectCheckpoints(const std::vector<BlockBoundary>& boundaries, uint64_t interval)
+    {
+        std::vector<BlockBoundary> ret;
+        uint64_t prev = 0;
+        for (const auto& b : boundaries)
+        {
+            if (b.Output >= prev + interval)
+            {
+                ret.push_back(b);
+                prev = b.Output;
+            }
+        }
+        return ret;
+    }
+
+    void CheckCheckpointKinds(Context& context, const std::vector<BlockBoundary>& checkpoints, std::string_view what)
+    {
+        auto aligned = std::count_if(checkpoints.begin(), checkpoints.end(), [](const BlockBoundary& b) { return b.Aligned; });
+        auto unaligned = static_cast<ptrdiff_t>(checkpoints.size()) - aligned;
+        context.Check(aligned > 0, fmt::format("{}: byte-aligned checkpoints", what));
+        context.Check(unaligned > 0, fmt::format("{}: non-byte-aligned checkpoints", what));
+    }
+
+    /**
+     * 测量 Seek + Read
+     * 检查点在第一遍顺序解压时建立，之后按给定的顺序 Seek 并读取，与原始数据比较。
+     */
+    void MeasureSeek(Context& context, IStream* stream, const std::vector<uint8_t>& content, std::string_view what,
+        const std::vector<BlockBoundary>& checkpoints)
+    {
+        static const size_t kReadSize = 4 * 1024;
+
+        // 完整顺序解压一遍，同时建立检查点
+        vector<uint8_t> buffer(64 * 1024);
+        {
+            vector<uint8_t> data;
+            Stopwatch watch;
+            while (true)
+            {
+                auto ret = stream->Read(buffer.data(), buffer.size());
+                if (!ret || *ret == 0)
+                    break;
+                data.insert(data.end(), buffer.begin(), buffer.begin() + *ret);
+            }
+            auto elapsed = watch.GetElapsed();
+            context.Check(data == content, fmt::format("{}: sequential decode", what));
+            context.Report(fmt::format("{}, sequential decode", what), static_cast<double>(content.size()) / (1024. * 1024.),
+                elapsed, "MiB");
+        }
+
+        // 目标：每个检查点本身及其后方不远处，再加上均匀分布的位置
+        vector<uint64_t> targets;
+        for (const auto& c : checkpoints)
+        {
+            targets.push_back(c.Output);
+            targets.push_back(std::min<uint64_t>(c.Output + 1000, content.size() - 1));
+        }
+        const size_t kUniformTargets = context.IsQuick() ? 16 : 64;
+        for (size_t i = 0; i < kUniformTargets; ++i)
+            targets.push_back(content.size() * i / kUniformTargets);
+        std::sort(targets.begin(), targets.end());
+
+        auto run = [&](const vector<uint64_t>& order, std::string_view direction) {
+            size_t matched = 0;
+            Stopwatch watch;
+            for (auto target : order)
+            {
+                if (!stream->Seek(static_cast<int64_t>(target), StreamSeekOrigins::Begin))
+                    continue;
+                auto ret = stream->Read(buffer.data(), kReadSize);
+                if (!ret)
+                    continue;
+                auto expected = std::min<size_t>(kReadSize, content.size() - target);
+                if (*ret == expected && std::equal(buffer.begin(), buffer.begin() + expected, content.begin() + target))
+                    ++matched;
+            }
+            auto elapsed = watch.GetElapsed();
+            context.Check(matched == order.size(), fmt::format("{}: {} Seek + Read", what, direction));
+            context.Report(fmt::format("{}, {} Seek + 4k Read", what, direction), static_cast<double>(order.size()), elapsed,
+                "seek");
+        };
+
+        run(targets, "forward");
+        vector<uint64_t> backward(targets.rbegin(), targets.rend());
+        run(backward, "backward");
+        vector<uint64_t> shuffled = targets;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1));
+        run(shuffled, "random");
+    }
+}
+
+LSTG_BENCHMARK_CASE(VFS, InflateSeek)
+{
+    const size_t kContentSize = context.IsQuick() ? 3 * 1024 * 1024 : 16 * 1024 * 1024;
+    static const uint64_t kInterval = 32 * 1024;
+
+    auto content = MakeCompressibleContent(kContentSize, 2022);
+    vector<BlockBoundary> boundaries;
+    auto deflated = DeflateInMixedBlocks(content, boundaries);
+
+    // 直接在内存流上解压，使用较小的间隔得到大量检查点
+    {
+        auto checkpoints = SelectCheckpoints(boundaries, kInterval);
+        CheckCheckpointKinds(context, checkpoints, "InflateStream");
+        context.Note("InflateStream checkpoints", static_cast<double>(checkpoints.size()));
+
+        InflateStream stream(make_shared<MemoryStream>(vector<uint8_t>(deflated)), content.size(), kInterval);
+        context.Check(stream.IsSeekable(), "InflateStream: seekable");
+        MeasureSeek(context, &stream, content, "InflateStream", checkpoints);
+    }
+
+    // ZIP 条目：检查点的输入位置需要底层的解密流能够 Seek 到
+    vector<ZipArchiveEntry> entries {
+        { "deflate.bin", content, true, false, deflated },
+        { "deflate_encrypted.bin", content, true, true, deflated },
+    };
+    shared_ptr<ZipArchiveFileSystem> fs;
+    try
+    {
+        fs = make_shared<ZipArchiveFileSystem>(make_shared<MemoryStream>(MakeZipArchive(entries, kPassword)), kPassword);
+    }
+    catch (const std::system_error& ex)
+    {
+        context.Check(false, fmt::format("open zip: {}", ex.code().message()));
+        return;
+    }
+
+    auto checkpoints = SelectCheckpoints(boundaries, InflateStream::kDefaultCheckpointInterval);
+    CheckCheckpointKinds(context, checkpoints, "ZIP entry");
+    for (const auto& entry : entries)
+    {
+        auto stream = fs->OpenFile(Path {entry.Name}, FileAccessMode::Read, FileOpenFlags::RandomAccess);
+        if (!context.Check(static_cast<bool>(stream), fmt::format("open {}", entry.Name)))
+            continue;
+        context.Check((*stream)->IsSeekable(), fmt::format("{}: seekable", entry.Name));
+        MeasureSeek(context, stream->get(), content, entry.Name, checkpoints);
+    }
+}
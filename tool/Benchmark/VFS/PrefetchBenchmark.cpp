@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/SubsystemContainer.hpp>
+#include <lstg/Core/Subsystem/VirtualFileSystem.hpp>
+#include <lstg/Core/Subsystem/VFS/ZipArchiveFileSystem.hpp>
+#include "ZipArchiveBuilder.hpp"
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::VFS;
+
+LSTG_BENCHMARK_CASE(VFS, Prefetch)
+{
+    // 模拟启动阶段：一个资源包中的大量压缩条目被依次打开并读完
+    const size_t kEntryCount = context.IsQuick() ? 8 : 64;
+    const size_t kEntrySize = context.IsQuick() ? 64 * 1024 : 1024 * 1024;
+
+    vector<ZipArchiveEntry> entries;
+    vector<string> paths;
+    for (size_t i = 0; i < kEntryCount; ++i)
+    {
+        auto name = fmt::format("asset{}.bin", i);
+        paths.emplace_back(fmt::format("/assets/{}", name));
+        entries.push_back({ std::move(name), MakeCompressibleContent(kEntrySize, static_cast<uint32_t>(i)), true, false });
+    }
+
+    Subsystem::SubsystemContainer container;
+    Subsystem::VirtualFileSystem vfs(container);
+    try
+    {
+        auto stream = make_shared<MemoryStream>(MakeZipArchive(entries));
+        auto ret = vfs.Mount("assets", make_shared<ZipArchiveFileSystem>(stream, ""));
+        if (!context.Check(static_cast<bool>(ret), "mount pack"))
+            return;
+    }
+    catch (const std::system_error& ex)
+    {
+        context.Check(false, fmt::format("open zip: {}", ex.code().message()));
+        return;
+    }
+
+    auto readAll = [&](const char* what) {
+        size_t matched = 0;
+        vector<uint8_t> data;
+        for (size_t i = 0; i < kEntryCount; ++i)
+        {
+            auto stream = vfs.OpenFile(paths[i], FileAccessMode::Read);
+            if (stream && ReadAll(data, stream->get()) && data == entries[i].Content)
+                ++matched;
+        }
+        context.Check(matched == kEntryCount, fmt::format("{}: content", what));
+    };
+
+    const auto totalMiB = static_cast<double>(kEntryCount * kEntrySize) / (1024. * 1024.);
+
+    // 逐个打开并读取，解压在当前线程上串行进行
+    {
+        Stopwatch watch;
+        readAll("serial");
+        context.Report("OpenFile + ReadAll, serial", totalMiB, watch.GetElapsed(), "MiB");
+    }
+
+    // 先并行预取再读取，读取直接命中缓存
+    {
+        Stopwatch watch;
+        auto ret = vfs.Prefetch(Span<const string>{paths});
+        auto prefetchElapsed = watch.GetElapsed();
+        context.Check(ret && *ret == kEntryCount, "prefetched entries");
+        readAll("prefetched");
+        auto elapsed = watch.GetElapsed();
+        context.Report("Prefetch", totalMiB, prefetchElapsed, "MiB");
+        context.Report("Prefetch + OpenFile + ReadAll", totalMiB, elapsed, "MiB");
+    }
+    context.Note("Hardware threads", static_cast<double>(ThreadPool<>::GetSystemThreadCount()));
+}
@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <lstg/Core/Subsystem/VFS/ContainerStream.hpp>
+#include <lstg/Core/Subsystem/VFS/DeflateStream.hpp>
+
+namespace lstg::Benchmark
+{
+    /**
+     * ZIP 条目描述
+     */
+    struct ZipArchiveEntry
+    {
+        std::string Name;
+        std::vector<uint8_t> Content;
+        bool Deflate = false;
+        bool Encrypt = false;
+        std::vector<uint8_t> Deflated;  // 预先生成的 Raw Deflate 数据，为空时压缩 Content 得到
+    };
+
+    namespace detail
+    {
+        inline void WriteU16(std::vector<uint8_t>& out, uint16_t v)
+        {
+            out.push_back(static_cast<uint8_t>(v & 0xFF));
+            out.push_back(static_cast<uint8_t>(v >> 8));
+        }
+
+        inline void WriteU32(std::vector<uint8_t>& out, uint32_t v)
+        {
+            WriteU16(out, static_cast<uint16_t>(v & 0xFFFF));
+            WriteU16(out, static_cast<uint16_t>(v >> 16));
+        }
+
+        inline uint32_t Crc32UpdateByte(uint32_t crc, uint8_t c) noexcept
+        {
+            crc ^= c;
+            for (int k = 0; k < 8; ++k)
+                crc = (crc & 1u) ? (0xEDB88320u ^ (crc >> 1u)) : (crc >> 1u);
+            return crc;
+        }
+
+        inline uint32_t Crc32(const std::vector<uint8_t>& data) noexcept
+        {
+            uint32_t crc = 0xFFFFFFFFu;
+            for (auto b : data)
+                crc = Crc32UpdateByte(crc, b);
+            return ~crc;
+        }
+
+        /**
+         * ZipCrypto 加密
+         * 与解密使用同一组密钥更新规则，区别在于密钥由明文更新。
+         */
+        inline void PkEncrypt(std::string_view password, uint8_t* buffer, size_t length) noexcept
+        {
+            uint32_t keys[3] = { 305419896u, 591751049u, 878082192u };
+            auto update = [&](uint8_t c) {
+                keys[0] = Crc32UpdateByte(keys[0], c);
+                keys[1] = (keys[1] + (keys[0] & 0xFFu)) * 134775813u + 1u;
+                keys[2] = Crc32UpdateByte(keys[2], static_cast<uint8_t>(keys[1] >> 24u));
+            };
+
+            for (char ch : password)
+                update(static_cast<uint8_t>(ch));
+            for (size_t i = 0; i < length; ++i)
+            {
+                auto t = keys[2] | 2u;
+                auto plain = buffer[i];
+                buffer[i] = static_cast<uint8_t>(plain ^ static_cast<uint8_t>(((t * (t ^ 1u)) >> 8u) & 0xFFu));
+                update(plain);
+            }
+        }
+
+        /**
+         * 生成 Raw Deflate 数据
+         * DeflateStream 输出 zlib 格式，去掉 2 字节头部和 4 字节 Adler32 尾部即为 ZIP 使用的格式。
+         */
+        inline std::vector<uint8_t> RawDeflate(const std::vector<uint8_t>& data)
+        {
+            auto output = std::make_shared<Subsystem::VFS::MemoryStream>();
+            {
+                Subsystem::VFS::DeflateStream deflate(output);
+                deflate.Write(data.data(), data.size()).ThrowIfError();
+                deflate.Finish().ThrowIfError();
+            }
+            auto& ret = output->GetContainer();
+            assert(ret.size() >= 6);
+            return { ret.begin() + 2, ret.end() - 4 };
+        }
+    }
+
+    /**
+     * 在内存中生成 ZIP 档案
+     * @param entries 条目
+     * @param password 加密条目使用的密码
+     * @return 档案数据
+     */
+    inline std::vector<uint8_t> MakeZipArchive(const std::vector<ZipArchiveEntry>& entries, std::string_view password = {})
+    {
+        using namespace detail;
+
+        std::vector<uint8_t> ret;
+        std::vector<uint8_t> cd;
+        for (const auto& entry : entries)
+        {
+            auto crc = Crc32(entry.Content);
+            auto data = entry.Deflate ? (entry.Deflated.empty() ? RawDeflate(entry.Content) : entry.Deflated) : entry.Content;
+            if (entry.Encrypt)
+            {
+                // 加密头最后一个字节为 CRC32 的最高字节
+                std::vector<uint8_t> header(12, 0x5A);
+                header[11] = static_cast<uint8_t>(crc >> 24u);
+                data.insert(data.begin(), header.begin(), header.end());
+                PkEncrypt(password, data.data(), data.size());
+            }
+
+            auto offset = static_cast<uint32_t>(ret.size());
+            auto flags = static_cast<uint16_t>(entry.Encrypt ? 1 : 0);
+            auto method = static_cast<uint16_t>(entry.Deflate ? 8 : 0);
+
+            WriteU32(ret, 0x04034b50);  // Signature
+            WriteU16(ret, 20);  // VersionNeeded
+            WriteU16(ret, flags);
+            WriteU16(ret, method);
+            WriteU16(ret, 0);  // LastModFileTime
+            WriteU16(ret, 0x21);  // LastModFileDate, 1980/1/1
+            WriteU32(ret, crc);
+            WriteU32(ret, static_cast<uint32_t>(data.size()));
+            WriteU32(ret, static_cast<uint32_t>(entry.Content.size()));
+            WriteU16(ret, static_cast<uint16_t>(entry.Name.size()));
+            WriteU16(ret, 0);  // ExtraFieldLength
+            ret.insert(ret.end(), entry.Name.begin(), entry.Name.end());
+            ret.insert(ret.end(), data.begin(), data.end());
+
+            WriteU32(cd, 0x02014b50);  // Signature
+            WriteU16(cd, 20);  // Version
+            WriteU16(cd, 20);  // VersionNeeded
+            WriteU16(cd, flags);
+            WriteU16(cd, method);
+            WriteU16(cd, 0);  // LastModFileTime
+            WriteU16(cd, 0x21);  // LastModFileDate
+            WriteU32(cd, crc);
+            WriteU32(cd, static_cast<uint32_t>(data.size()));
+            WriteU32(cd, static_cast<uint32_t>(entry.Content.size()));
+            WriteU16(cd, static_cast<uint16_t>(entry.Name.size()));
+            WriteU16(cd, 0);  // ExtraFieldLength
+            WriteU16(cd, 0);  // FileCommentLength
+            WriteU16(cd, 0);  // DiskNumberStart
+            WriteU16(cd, 0);  // InternalFileAttributes
+            WriteU32(cd, 0);  // ExternalFileAttributes
+            WriteU32(cd, offset);
+            cd.insert(cd.end(), entry.Name.begin(), entry.Name.end());
+        }
+
+        auto cdOffset = static_cast<uint32_t>(ret.size());
+        ret.insert(ret.end(), cd.begin(), cd.end());
+
+        WriteU32(ret, 0x06054b50);  // Signature
+        WriteU16(ret, 0);  // DiskNum
+        WriteU16(ret, 0);  // DiskNumWithCentralDirectory
+        WriteU16(ret, static_cast<uint16_t>(entries.size()));
+        WriteU16(ret, static_cast<uint16_t>(entries.size()));
+        WriteU32(ret, static_cast<uint32_t>(cd.size()));
+        WriteU32(ret, cdOffset);
+        WriteU16(ret, 0);  // CommentLength
+        return ret;
+    }
+
+    /**
+     * 生成近似资源文件压缩率的测试数据
+     * 每 4 个字节中有 1 个随机字节，其余为缓慢变化的填充。
+     * @param size 大小
+     * @param seed 随机种子
+     */
+    inline std::vector<uint8_t> MakeCompressibleContent(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> ret(size);
+        uint32_t state = seed * 2654435761u + 1u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (i % 4 == 0)
+            {
+                state = state * 1664525u + 1013904223u;
+                ret[i] = static_cast<uint8_t>(state >> 24u);
+            }
+            else
+            {
+                ret[i] = static_cast<uint8_t>(i / 64);
+            }
+        }
+        return ret;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/VFS/FileStream.hpp>
+#include <lstg/Core/Subsystem/VFS/ZipArchiveFileSystem.hpp>
+#include "ZipArchiveBuilder.hpp"
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::VFS;
+
+namespace
+{
+    const char* kPassword = "benchmark";
+
+    /**
+     * 以交替的块大小读取整个流
+     * 覆盖单字节、小块和超过解密流预读缓冲区的大块读取。
+     */
+    Result<vector<uint8_t>> ReadInMixedChunks(IStream* stream)
+    {
+        static const size_t kChunkSizes[] = { 1, 100, 4096, 70000, 12345 };
+
+        vector<uint8_t> ret;
+        size_t index = 0;
+        while (true)
+        {
+            auto chunk = kChunkSizes[index++ % std::extent_v<decltype(kChunkSizes)>];
+            auto offset = ret.size();
+            ret.resize(offset + chunk);
+            auto count = stream->Read(ret.data() + offset, chunk);
+            if (!count)
+                return count.GetError();
+            ret.resize(offset + *count);
+            if (*count == 0)
+                break;
+        }
+        return ret;
+    }
+}
+
+LSTG_BENCHMARK_CASE(VFS, ZipEntryRead)
+{
+    const size_t kContentSize = context.IsQuick() ? 256 * 1024 : 8 * 1024 * 1024;
+    const size_t kPasses = context.IsQuick() ? 1 : 4;
+
+    auto content = MakeCompressibleContent(kContentSize, 12345);
+    vector<ZipArchiveEntry> entries {
+        { "store.bin", content, false, false },
+        { "store_encrypted.bin", content, false, true },
+        { "deflate.bin", content, true, false },
+        { "deflate_encrypted.bin", content, true, true },
+    };
+
+    // 同一个档案分别放在内存中和磁盘上：前者对应内存映射的资源包，后者每次读取都会调用到文件流
+    auto archive = MakeZipArchive(entries, kPassword);
+    auto archivePath = std::filesystem::temp_directory_path() / "LuaSTGPlusBenchmark_ZipEntryRead.zip";
+    vector<tuple<const char*, FileSystemPtr>> packs;
+    try
+    {
+        {
+            FileStream file(archivePath, FileAccessMode::Write, FileOpenFlags::Truncate);
+            file.Write(archive.data(), archive.size()).ThrowIfError();
+        }
+        packs.emplace_back("memory", make_shared<ZipArchiveFileSystem>(make_shared<MemoryStream>(std::move(archive)), kPassword));
+        packs.emplace_back("file", make_shared<ZipArchiveFileSystem>(
+            make_shared<FileStream>(archivePath, FileAccessMode::Read, FileOpenFlags::None), kPassword));
+    }
+    catch (const std::system_error& ex)
+    {
+        context.Check(false, fmt::format("open zip: {}", ex.code().message()));
+        std::error_code ec;
+        std::filesystem::remove(archivePath, ec);
+        return;
+    }
+
+    // 64k 模拟整块加载，4k 模拟解码器等小块读取的调用方
+    static const size_t kReadSizes[] = { 64 * 1024, 4 * 1024 };
+
+    vector<uint8_t> buffer(64 * 1024);
+    for (const auto& [packName, fs] : packs)
+    {
+        for (const auto& entry : entries)
+        {
+            // 先校验一次内容
+            {
+                auto stream = fs->OpenFile(Path {entry.Name}, FileAccessMode::Read, FileOpenFlags::None);
+                if (!context.Check(static_cast<bool>(stream), fmt::format("open {} from {}", entry.Name, packName)))
+                    continue;
+                auto data = ReadInMixedChunks(stream->get());
+                context.Check(data && *data == content, fmt::format("content of {} from {}", entry.Name, packName));
+            }
+
+            for (auto readSize : kReadSizes)
+            {
+                size_t total = 0;
+                Stopwatch watch;
+                for (size_t pass = 0; pass < kPasses; ++pass)
+                {
+                    auto stream = fs->OpenFile(Path {entry.Name}, FileAccessMode::Read, FileOpenFlags::None);
+                    if (!stream)
+                        break;
+                    while (true)
+                    {
+                        auto ret = (*stream)->Read(buffer.data(), readSize);
+                        if (!ret || *ret == 0)
+                            break;
+                        total += *ret;
+                    }
+                }
+                auto elapsed = watch.GetElapsed();
+                DoNotOptimize(buffer);
+
+                context.Check(total == kPasses * kContentSize, fmt::format("bytes read from {} in {}", entry.Name, packName));
+                context.Report(fmt::format("{}{}, {}, {}k reads", entry.Deflate ? "Deflate" : "Store", entry.Encrypt ? " + ZipCrypto" : "",
+                    packName, readSize / 1024), static_cast<double>(total) / (1024. * 1024.), elapsed, "MiB");
+            }
+        }
+    }
+
+    packs.clear();
+    std::error_code ec;
+    std::filesystem::remove(archivePath, ec);
+}
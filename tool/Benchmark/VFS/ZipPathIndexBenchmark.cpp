@@ -0,0 +1,316 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <map>
+#include <random>
+#include <fmt/format.h>
+#include <lstg/Core/Subsystem/VFS/ContainerStream.hpp>
+#include <lstg/Core/Subsystem/VFS/OverlayFileSystem.hpp>
+#include <lstg/Core/Subsystem/VFS/RootFileSystem.hpp>
+#include <lstg/Core/Subsystem/VFS/ZipArchiveFileSystem.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::VFS;
+
+namespace
+{
+    void WriteU16(vector<uint8_t>& out, uint16_t v)
+    {
+        out.push_back(static_cast<uint8_t>(v & 0xFF));
+        out.push_back(static_cast<uint8_t>(v >> 8));
+    }
+
+    void WriteU32(vector<uint8_t>& out, uint32_t v)
+    {
+        WriteU16(out, static_cast<uint16_t>(v & 0xFFFF));
+        WriteU16(out, static_cast<uint16_t>(v >> 16));
+    }
+
+    /**
+     * 生成只有中央目录的 ZIP 档案
+     * 路径查找只读取中央目录，文件内容不会被访问。
+     */
+    vector<uint8_t> MakeCentralDirectoryOnlyZip(const vector<string>& names)
+    {
+        vector<uint8_t> ret;
+        for (const auto& name : names)
+        {
+            WriteU32(ret, 0x02014b50);  // Signature
+            WriteU16(ret, 20);  // Version
+            WriteU16(ret, 20);  // VersionNeeded
+            WriteU16(ret, 0);  // Flags
+            WriteU16(ret, 0);  // CompressionMethod
+            WriteU16(ret, 0);  // LastModFileTime
+            WriteU16(ret, 0x21);  // LastModFileDate, 1980/1/1
+            WriteU32(ret, 0);  // Crc32
+            WriteU32(ret, 0);  // CompressedSize
+            WriteU32(ret, 0);  // UncompressedSize
+            WriteU16(ret, static_cast<uint16_t>(name.size()));
+            WriteU16(ret, 0);  // ExtraFieldLength
+            WriteU16(ret, 0);  // FileCommentLength
+            WriteU16(ret, 0);  // DiskNumberStart
+            WriteU16(ret, 0);  // InternalFileAttributes
+            WriteU32(ret, 0);  // ExternalFileAttributes
+            WriteU32(ret, 0);  // RelativeOffsetOfLocalHeader
+            ret.insert(ret.end(), name.begin(), name.end());
+        }
+        auto cdSize = static_cast<uint32_t>(ret.size());
+
+        WriteU32(ret, 0x06054b50);  // Signature
+        WriteU16(ret, 0);  // DiskNum
+        WriteU16(ret, 0);  // DiskNumWithCentralDirectory
+        WriteU16(ret, static_cast<uint16_t>(names.size()));
+        WriteU16(ret, static_cast<uint16_t>(names.size()));
+        WriteU32(ret, cdSize);
+        WriteU32(ret, 0);  // OffsetOfCentralDirectory
+        WriteU16(ret, 0);  // CommentLength
+        return ret;
+    }
+
+    /**
+     * 引入索引前 ZipArchiveFileSystem 使用的文件树
+     * 每一层文件夹使用 std::map 保存子节点，查找时逐段遍历。
+     */
+    class TreeWalkReference
+    {
+        struct Directory
+        {
+            map<string, unique_ptr<Directory>, less<>> Directories;
+            map<string, int, less<>> Files;
+        };
+
+    public:
+        explicit TreeWalkReference(const vector<string>& names)
+        {
+            for (const auto& name : names)
+            {
+                Path p {name};
+                auto* current = &m_stRoot;
+                for (size_t i = 0; i + 1 < p.GetSegmentCount(); ++i)
+                {
+                    auto seg = p.GetSegment(i);
+                    auto it = current->Directories.find(seg);
+                    if (it == current->Directories.end())
+                        it = current->Directories.emplace(string {seg}, make_unique<Directory>()).first;
+                    current = it->second.get();
+                }
+                current->Files.emplace(string {p.GetSegment(p.GetSegmentCount() - 1)}, 0);
+            }
+        }
+
+    public:
+        bool Exists(Path path) const noexcept
+        {
+            if (path.IsEmpty())
+                return false;
+
+            const Directory* entry = &m_stRoot;
+            for (size_t i = 0; i + 1 < path.GetSegmentCount(); ++i)
+            {
+                auto dir = path.GetSegment(i);
+                if (dir == ".")
+                    continue;
+
+                auto it = entry->Directories.find(dir);
+                if (it == entry->Directories.end())
+                    return false;
+                entry = it->second.get();
+            }
+
+            auto filename = path.GetSegment(path.GetSegmentCount() - 1);
+            if (filename == ".")
+                return true;
+            return entry->Directories.find(filename) != entry->Directories.end() ||
+                entry->Files.find(filename) != entry->Files.end();
+        }
+
+    private:
+        Directory m_stRoot;
+    };
+
+    /**
+     * 转发到另一个文件系统，但不提供路径索引
+     * 用于模拟引入索引前 OverlayFileSystem 逐层查找的行为。
+     */
+    class UnindexedFileSystem :
+        public IFileSystem
+    {
+    public:
+        explicit UnindexedFileSystem(FileSystemPtr fs)
+            : m_pFileSystem(std::move(fs)) {}
+
+    public:
+        Result<void> CreateDirectory(Path path) noexcept override { return m_pFileSystem->CreateDirectory(std::move(path)); }
+        Result<void> Remove(Path path) noexcept override { return m_pFileSystem->Remove(std::move(path)); }
+        Result<void> Rename(Path from, Path to) noexcept override { return m_pFileSystem->Rename(std::move(from), std::move(to)); }
+        Result<FileAttribute> GetFileAttribute(Path path) noexcept override { return m_pFileSystem->GetFileAttribute(std::move(path)); }
+        Result<DirectoryIteratorPtr> VisitDirectory(Path path) noexcept override { return m_pFileSystem->VisitDirectory(std::move(path)); }
+        Result<StreamPtr> OpenFile(Path path, FileAccessMode access, FileOpenFlags flags) noexcept override
+        {
+            return m_pFileSystem->OpenFile(std::move(path), access, flags);
+        }
+        const std::string& GetUserData() const noexcept override { return m_pFileSystem->GetUserData(); }
+        void SetUserData(std::string ud) noexcept override { m_pFileSystem->SetUserData(std::move(ud)); }
+
+    private:
+        FileSystemPtr m_pFileSystem;
+    };
+}
+
+LSTG_BENCHMARK_CASE(VFS, ZipPathIndex)
+{
+    // 三层 ZIP：底层包含所有文件，上面两层各自覆盖一部分
+    const size_t kEntriesPerPack = context.IsQuick() ? 2000 : 40000;
+    const size_t kLookups = context.IsQuick() ? 1000 : 100000;
+    const size_t kPacks = 3;
+
+    vector<vector<string>> packNames(kPacks);
+    vector<string> allNames;
+    for (size_t i = 0; i < kEntriesPerPack; ++i)
+    {
+        auto name = fmt::format("assets/stage{}/group{}/sprite{}.png", i % 8, (i / 8) % 64, i);
+        packNames[0].push_back(name);
+        if (i % 4 == 1)
+            packNames[1].push_back(name);
+        if (i % 4 == 2)
+            packNames[2].push_back(name);
+        allNames.push_back(std::move(name));
+    }
+
+    vector<FileSystemPtr> packs;
+    vector<TreeWalkReference> trees;
+    for (const auto& names : packNames)
+    {
+        try
+        {
+            auto stream = make_shared<MemoryStream>(MakeCentralDirectoryOnlyZip(names));
+            packs.emplace_back(make_shared<ZipArchiveFileSystem>(stream, ""));
+        }
+        catch (const std::system_error& ex)
+        {
+            context.Check(false, fmt::format("open zip: {}", ex.code().message()));
+            return;
+        }
+        trees.emplace_back(names);
+    }
+
+    auto indexed = make_shared<OverlayFileSystem>();
+    auto unindexed = make_shared<OverlayFileSystem>();
+    for (const auto& pack : packs)
+    {
+        indexed->PushFileSystem(pack);
+        unindexed->PushFileSystem(make_shared<UnindexedFileSystem>(pack));
+    }
+
+    // 每 10 次查找中有 1 次不存在
+    std::mt19937 rng(12345);
+    vector<Path> lookups;
+    lookups.reserve(kLookups);
+    size_t expected = 0;
+    for (size_t i = 0; i < kLookups; ++i)
+    {
+        const auto& name = allNames[rng() % allNames.size()];
+        if (i % 10 == 9)
+        {
+            lookups.emplace_back(name + ".missing");
+        }
+        else
+        {
+            lookups.emplace_back(name);
+            ++expected;
+        }
+    }
+
+    // 引入索引前的实现：每层逐段遍历文件树，从上层到下层依次尝试
+    double treeWalkElapsed = 0;
+    {
+        size_t found = 0;
+        Stopwatch watch;
+        for (const auto& p : lookups)
+        {
+            for (size_t i = trees.size(); i-- > 0;)
+            {
+                if (trees[i].Exists(p))
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+        treeWalkElapsed = watch.GetElapsed();
+        DoNotOptimize(found);
+        context.Check(found == expected, "tree walk lookups");
+        context.Report(fmt::format("Tree walk, {} packs", kPacks), static_cast<double>(kLookups), treeWalkElapsed, "lookup");
+    }
+
+    auto measure = [&](const char* what, IFileSystem& fs, const vector<Path>& paths) {
+        size_t found = 0;
+        Stopwatch watch;
+        for (const auto& p : paths)
+            found += static_cast<bool>(fs.GetFileAttribute(p));
+        auto elapsed = watch.GetElapsed();
+        DoNotOptimize(found);
+        context.Check(found == expected, fmt::format("{} lookups", what));
+        context.Report(what, static_cast<double>(kLookups), elapsed, "lookup");
+        return elapsed;
+    };
+    measure("ZipArchiveFileSystem::GetFileAttribute, bottom pack", *packs[0], lookups);
+    measure("OverlayFileSystem::GetFileAttribute, layers unindexed", *unindexed, lookups);
+    auto indexedElapsed = measure("OverlayFileSystem::GetFileAttribute, layers indexed", *indexed, lookups);
+    context.Note("Indexed overlay speedup over tree walk", treeWalkElapsed / indexedElapsed);
+
+    // 经由挂载点访问，与 VirtualFileSystem 的路径一致
+    {
+        RootFileSystem root;
+        root.Mount(Path {"assets"}, indexed);
+        root.Mount(Path {"storage"}, unindexed);
+
+        vector<Path> mounted;
+        mounted.reserve(lookups.size());
+        for (const auto& p : lookups)
+            mounted.emplace_back(fmt::format("assets/{}", p.ToStringView()));
+        measure("RootFileSystem::GetFileAttribute, mounted indexed overlay", root, mounted);
+
+        // 更深的挂载点优先
+        auto nested = make_shared<ZipArchiveFileSystem>(make_shared<MemoryStream>(MakeCentralDirectoryOnlyZip({ "nested.bin" })), "");
+        root.Mount(Path {"assets/assets/stage0"}, nested);
+        context.Check(static_cast<bool>(root.GetFileAttribute(Path {"assets/assets/stage0/nested.bin"})), "nested mount point");
+        context.Check(static_cast<bool>(root.GetFileAttribute(Path {fmt::format("assets/{}", allNames[1])})), "outer mount point");
+        context.Check(static_cast<bool>(root.GetFileAttribute(Path {"assets/./assets/stage0/nested.bin"})),
+            "nested mount point, non-normalized path");
+        root.Unmount(Path {"assets/assets/stage0"});
+        context.Check(!root.GetFileAttribute(Path {"assets/assets/stage0/nested.bin"}), "unmounted mount point");
+    }
+
+    // 上层覆盖的文件应当来自上层
+    auto ret = indexed->GetFileAttribute(Path {allNames[2]});
+    context.Check(ret && ret->Type == FileType::RegularFile, "overlaid file attribute");
+    ret = indexed->GetFileAttribute(Path {"assets/stage0"});
+    context.Check(ret && ret->Type == FileType::Directory, "directory attribute");
+
+    // 索引对只读的层不能改变以写方式打开的结果
+    auto stream = indexed->OpenFile(Path {allNames[2]}, FileAccessMode::Write, FileOpenFlags::None);
+    context.Check(!stream && stream.GetError() == make_error_code(errc::permission_denied), "open indexed file for writing");
+
+    // 层数不受限制：每层一个文件，最底层和最上层的文件都要能通过索引找到
+    {
+        const size_t kLayers = 70;
+        OverlayFileSystem deep;
+        for (size_t i = 0; i < kLayers; ++i)
+        {
+            auto stream = make_shared<MemoryStream>(MakeCentralDirectoryOnlyZip({ fmt::format("layer{}.bin", i) }));
+            deep.PushFileSystem(make_shared<ZipArchiveFileSystem>(stream, ""));
+        }
+        size_t found = 0;
+        for (size_t i = 0; i < kLayers; ++i)
+            found += static_cast<bool>(deep.GetFileAttribute(Path {fmt::format("layer{}.bin", i)}));
+        context.Check(found == kLayers, fmt::format("lookups across {} indexed layers", kLayers));
+    }
+}
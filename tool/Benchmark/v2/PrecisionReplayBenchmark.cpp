@@ -0,0 +1,299 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fmt/format.h>
+#include <glm/gtc/constants.hpp>
+#include <lstg/v2/GamePlay/Motion.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::v2;
+using namespace lstg::v2::GamePlay;
+
+namespace
+{
+    // 与 v2 默认的版面大小及出界判定余量一致
+    constexpr double kBoundaryHalfWidth = 224. + 32.;
+    constexpr double kBoundaryHalfHeight = 256. + 32.;
+
+    // 每隔若干帧重新瞄准自机的间隔
+    constexpr int32_t kAimInterval = 60;
+
+    /**
+     * 确定性的伪随机数
+     */
+    class ReplayRandom
+    {
+    public:
+        double Next(double low, double high) noexcept
+        {
+            m_ullState = m_ullState * 6364136223846793005ull + 1442695040888963407ull;
+            auto r = static_cast<double>(m_ullState >> 11u) / static_cast<double>(1ull << 53u);
+            return low + (high - low) * r;
+        }
+
+    private:
+        uint64_t m_ullState = 0x4C75615354475032ull;
+    };
+
+    Vec2 GetPlayerLocation(int32_t frame) noexcept
+    {
+        return { 100. * ::sin(frame / 97.), -150. + 50. * ::cos(frame / 61.) };
+    }
+
+    /**
+     * 在 ECS 世界上按照 GameWorld 的更新顺序重放一组对象的运动
+     * 对象存储在按列存储的 Transform、Movement 中，运动积分和坐标更新使用与 GameWorld 相同的批量遍历。
+     * 对象生成与脚本行为均为确定性的，只有组件的存储精度不同。
+     */
+    template <typename TScalar>
+    class WorldReplay
+    {
+    public:
+        using Transform = Components::BasicTransform<TScalar>;
+        using Movement = Components::BasicMovement<TScalar>;
+
+    public:
+        WorldReplay(size_t count, ThreadPool<>& pool)
+            : m_stPool(pool)
+        {
+            ReplayRandom random;
+            m_stEntities.reserve(count);
+            m_stDeleteFrames.resize(count, -1);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto entity = m_stWorld.CreateEntity<Transform, Movement>().ThrowIfError();
+                m_stEntities.push_back(entity);
+
+                // 从版面上方的发射点以随机的速度发射，部分对象带有加速度和角速度
+                auto transform = entity.template GetComponent<Transform>();
+                auto movement = entity.template GetComponent<Movement>();
+                auto speed = random.Next(0.5, 4.);
+                auto angle = random.Next(0., 2. * glm::pi<double>());
+                transform.Location = { static_cast<TScalar>(random.Next(-50., 50.)), static_cast<TScalar>(random.Next(80., 120.)) };
+                transform.LastLocation = transform.Location;
+                SetVelocity(transform, movement, speed, angle, i % 2 == 0);
+                if (i % 4 == 1)
+                    movement.AccelVelocity = { static_cast<TScalar>(random.Next(-0.01, 0.01)), static_cast<TScalar>(random.Next(-0.01, 0.01)) };
+                if (i % 8 == 3)
+                    movement.AngularVelocity = static_cast<TScalar>(random.Next(-0.05, 0.05));
+                movement.RotateToSpeedDirection = (i % 4 == 2);
+            }
+        }
+
+    public:
+        const vector<int32_t>& GetDeleteFrames() const noexcept { return m_stDeleteFrames; }
+
+        size_t GetAliveCount() const noexcept { return m_stWorld.GetUsedEntityCount(); }
+
+        /**
+         * 获取对象的坐标
+         * @param index 对象下标，对象必须存活
+         */
+        Vec2 GetLocation(size_t index) noexcept
+        {
+            assert(m_stDeleteFrames[index] < 0);
+            return Vec2 { m_stEntities[index].template GetComponent<Transform>().Location };
+        }
+
+        /**
+         * 执行一帧
+         * 顺序与开启批量运动积分的 GameWorld 一致：Frame（脚本、运动积分）、BoundCheck、UpdateXY、AfterFrame。
+         * @param frame 帧号
+         * @return 本帧积分的对象数
+         */
+        size_t Step(int32_t frame) noexcept
+        {
+            auto player = GetPlayerLocation(frame);
+            auto updated = m_stWorld.GetUsedEntityCount();
+
+            // 脚本：每三个对象中有一个定期重新瞄准自机，角度使用双精度计算，与 Angle/SetV 的行为一致
+            for (size_t i = 0; i < m_stEntities.size(); i += 3)
+            {
+                if (m_stDeleteFrames[i] >= 0 || (frame + static_cast<int32_t>(i)) % kAimInterval != 0)
+                    continue;
+                auto transform = m_stEntities[i].template GetComponent<Transform>();
+                auto movement = m_stEntities[i].template GetComponent<Movement>();
+                auto dt = player - Vec2 { transform.Location };
+                auto speed = glm::length(Vec2 { movement.Velocity });
+                SetVelocity(transform, movement, std::max(speed, 1.), ::atan2(dt.y, dt.x), true);
+            }
+            BatchIntegrateMotion<TScalar>(m_stWorld, m_stPool);
+
+            // 出界检查
+            for (size_t i = 0; i < m_stEntities.size(); ++i)
+            {
+                if (m_stDeleteFrames[i] >= 0)
+                    continue;
+                auto transform = m_stEntities[i].template TryGetComponent<Transform>();
+                assert(transform);
+                Vec2 loc = transform->Location;
+                if (loc.x < -kBoundaryHalfWidth || loc.x > kBoundaryHalfWidth || loc.y < -kBoundaryHalfHeight || loc.y > kBoundaryHalfHeight)
+                {
+                    m_stDeleteFrames[i] = frame;
+                    m_stWorld.DeferDestroy(m_stEntities[i]);
+                }
+            }
+
+            BatchUpdateMotionDelta<TScalar>(m_stWorld, m_stPool);
+            m_stWorld.FlushDeferredDestroy();
+            return updated;
+        }
+
+        /**
+         * 只执行 Frame 和 UpdateXY 中的批量遍历
+         * @return 遍历的对象数
+         */
+        size_t StepBatchPasses() noexcept
+        {
+            BatchIntegrateMotion<TScalar>(m_stWorld, m_stPool);
+            BatchUpdateMotionDelta<TScalar>(m_stWorld, m_stPool);
+            return m_stWorld.GetUsedEntityCount();
+        }
+
+    private:
+        static void SetVelocity(Transform transform, Movement movement, double speed, double angle, bool track) noexcept
+        {
+            movement.Velocity.x = static_cast<TScalar>(speed * ::cos(angle));
+            movement.Velocity.y = static_cast<TScalar>(speed * ::sin(angle));
+            if (track)
+                transform.Rotation = static_cast<TScalar>(angle);
+        }
+
+    private:
+        ThreadPool<>& m_stPool;
+        ECS::World m_stWorld;
+        vector<ECS::Entity> m_stEntities;
+        vector<int32_t> m_stDeleteFrames;
+    };
+
+    template <typename TScalar>
+    void RunTimedReplay(Context& context, ThreadPool<>& pool, const char* what, size_t count, int32_t frames)
+    {
+        WorldReplay<TScalar> replay(count, pool);
+        size_t updated = 0;
+        Stopwatch watch;
+        for (int32_t frame = 0; frame < frames; ++frame)
+            updated += replay.Step(frame);
+        auto elapsed = watch.GetElapsed();
+        DoNotOptimize(updated);
+        context.Report(fmt::format("Replay ({})", what), static_cast<double>(updated), elapsed, "obj");
+
+        // 不出界的对象上只执行批量遍历，即按列存储的 Transform、Movement 上的热点循环
+        WorldReplay<TScalar> batchReplay(count, pool);
+        updated = 0;
+        watch.Restart();
+        for (int32_t frame = 0; frame < frames; ++frame)
+            updated += batchReplay.StepBatchPasses();
+        elapsed = watch.GetElapsed();
+        DoNotOptimize(updated);
+        context.Report(fmt::format("Batch motion passes ({})", what), static_cast<double>(updated), elapsed, "obj");
+    }
+}
+
+LSTG_BENCHMARK_CASE(GamePlay, PrecisionReplay)
+{
+    const size_t kObjectCount = context.IsQuick() ? 500 : 5000;
+    const int32_t kFrames = context.IsQuick() ? 600 : 3600;
+
+    // 单精度下允许的偏差
+    // 只做匀速、匀加速运动的对象只有积分误差，坐标偏差应当保持在亚像素内。
+    // 重新瞄准自机会放大坐标误差，绕自机运动的对象最终可能相差很远，因此只限制这样的对象所占的比例。
+    constexpr double kMaxUnaimedLocationDeviation = 1. / 16.;
+    const size_t kMaxDriftingObjects = kObjectCount / 20;
+    const size_t kMaxDeleteFrameMismatches = kObjectCount / 100;
+    constexpr int32_t kMaxDeleteFrameDeviation = 4;
+
+    // 与 GameWorld 相同的并行遍历线程数
+    auto threads = ThreadPool<>::GetSystemThreadCount();
+    ThreadPool<> pool(std::min(7u, std::max(1u, threads > 1 ? threads - 1 : 1u)));
+
+    // 逐帧比较两种精度下的对象状态
+    WorldReplay<double> replayDouble(kObjectCount, pool);
+    WorldReplay<double> replayDoubleAgain(kObjectCount, pool);
+    WorldReplay<float> replayFloat(kObjectCount, pool);
+    vector<double> maxDeviations(kObjectCount, 0.);
+    int32_t firstSubPixelDeviationFrame = -1;
+    bool deterministic = true;
+    for (int32_t frame = 0; frame < kFrames; ++frame)
+    {
+        replayDouble.Step(frame);
+        replayDoubleAgain.Step(frame);
+        replayFloat.Step(frame);
+
+        if (replayDouble.GetDeleteFrames() != replayDoubleAgain.GetDeleteFrames())
+            deterministic = false;
+        for (size_t i = 0; i < kObjectCount; ++i)
+        {
+            if (replayDouble.GetDeleteFrames()[i] >= 0)
+                continue;
+            auto location = replayDouble.GetLocation(i);
+            if (replayDoubleAgain.GetDeleteFrames()[i] < 0 && location != replayDoubleAgain.GetLocation(i))
+                deterministic = false;
+            if (replayFloat.GetDeleteFrames()[i] >= 0)
+                continue;
+
+            auto deviation = glm::length(location - replayFloat.GetLocation(i));
+            maxDeviations[i] = std::max(maxDeviations[i], deviation);
+            if (deviation >= 1. / 16. && firstSubPixelDeviationFrame < 0)
+                firstSubPixelDeviationFrame = frame;
+        }
+    }
+
+    double maxDeviation = 0., maxUnaimedDeviation = 0.;
+    size_t driftingObjects = 0;
+    for (size_t i = 0; i < kObjectCount; ++i)
+    {
+        maxDeviation = std::max(maxDeviation, maxDeviations[i]);
+        if (i % 3 != 0)
+            maxUnaimedDeviation = std::max(maxUnaimedDeviation, maxDeviations[i]);
+        driftingObjects += (maxDeviations[i] >= 1.) ? 1 : 0;
+    }
+
+    size_t deleteFrameMismatches = 0;
+    int32_t maxDeleteFrameDeviation = 0;
+    for (size_t i = 0; i < kObjectCount; ++i)
+    {
+        auto deleteFrameDouble = replayDouble.GetDeleteFrames()[i];
+        auto deleteFrameFloat = replayFloat.GetDeleteFrames()[i];
+        if (deleteFrameDouble == deleteFrameFloat)
+            continue;
+        ++deleteFrameMismatches;
+
+        // 只在其中一种精度下被删除的对象，按回放结束的帧计算
+        deleteFrameDouble = deleteFrameDouble < 0 ? kFrames : deleteFrameDouble;
+        deleteFrameFloat = deleteFrameFloat < 0 ? kFrames : deleteFrameFloat;
+        maxDeleteFrameDeviation = std::max(maxDeleteFrameDeviation, std::abs(deleteFrameDouble - deleteFrameFloat));
+    }
+
+    context.Check(deterministic, "double replay is deterministic");
+    context.Check(maxUnaimedDeviation <= kMaxUnaimedLocationDeviation, fmt::format("unaimed location deviation {} px <= {} px",
+        maxUnaimedDeviation, kMaxUnaimedLocationDeviation));
+    context.Check(driftingObjects <= kMaxDriftingObjects, fmt::format("{} objects drifting by 1 px or more <= {}", driftingObjects,
+        kMaxDriftingObjects));
+    context.Check(deleteFrameMismatches <= kMaxDeleteFrameMismatches, fmt::format("{} objects removed on a different frame <= {}",
+        deleteFrameMismatches, kMaxDeleteFrameMismatches));
+    context.Check(maxDeleteFrameDeviation <= kMaxDeleteFrameDeviation, fmt::format("removal frame deviation {} <= {}",
+        maxDeleteFrameDeviation, kMaxDeleteFrameDeviation));
+    context.Note("Frames", kFrames);
+    context.Note("Objects", static_cast<double>(kObjectCount));
+    context.Note("Objects alive at end (double)", static_cast<double>(replayDouble.GetAliveCount()));
+    context.Note("Max location deviation (px)", maxDeviation);
+    context.Note("Max location deviation, never re-aimed (px)", maxUnaimedDeviation);
+    context.Note("Objects drifting by 1 px or more", static_cast<double>(driftingObjects));
+    context.Note("First frame deviating >= 1/16 px", firstSubPixelDeviationFrame);
+    context.Note("Objects removed on a different frame", static_cast<double>(deleteFrameMismatches));
+    context.Note("Max removal frame deviation", maxDeleteFrameDeviation);
+
+    // 分别计时
+    RunTimedReplay<double>(context, pool, "double", kObjectCount, kFrames);
+    RunTimedReplay<float>(context, pool, "float", kObjectCount, kFrames);
+}
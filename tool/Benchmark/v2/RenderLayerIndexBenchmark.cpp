@@ -0,0 +1,198 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <memory>
+#include <lstg/Core/IntrusiveSkipList.hpp>
+#include <lstg/v2/GamePlay/RenderLayerIndex.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::v2::GamePlay;
+
+namespace
+{
+    constexpr size_t kSkipListDepth = 8;
+    constexpr size_t kLayerCount = 8;
+
+    /**
+     * 被替换前的跳表实现，比较方式与原先的 RendererSortFunction 一致
+     */
+    class SkipListLayerIndex
+    {
+    public:
+        struct Node
+        {
+            double Layer = 0;
+            uint64_t SortKey = 0;
+            IntrusiveSkipListNode<kSkipListDepth> SkipListNode;
+
+            static Node* FromSkipListNode(IntrusiveSkipListNode<kSkipListDepth>* n) noexcept
+            {
+                return reinterpret_cast<Node*>(reinterpret_cast<uint8_t*>(n) - offsetof(Node, SkipListNode));
+            }
+        };
+
+    public:
+        SkipListLayerIndex() noexcept
+        {
+            for (size_t i = 0; i < kSkipListDepth; ++i)
+            {
+                m_stHeader.SkipListNode.Adj[i].Next = &m_stTailer.SkipListNode;
+                m_stTailer.SkipListNode.Adj[i].Prev = &m_stHeader.SkipListNode;
+            }
+        }
+
+    public:
+        void Insert(Node& node) noexcept
+        {
+            SkipListInsert(&m_stTailer.SkipListNode, &node.SkipListNode, [](auto lhs, auto rhs) {
+                auto left = Node::FromSkipListNode(lhs);
+                auto right = Node::FromSkipListNode(rhs);
+                if (left->Layer < right->Layer)
+                    return true;
+                if (left->Layer == right->Layer)
+                    return left->SortKey < right->SortKey;
+                return false;
+            }, m_stRandomizer);
+        }
+
+        static void Remove(Node& node) noexcept
+        {
+            SkipListRemove(&node.SkipListNode);
+        }
+
+        template <typename TCallback>
+        void Traverse(TCallback&& callback) noexcept
+        {
+            auto p = m_stHeader.SkipListNode.Adj[0].Next;
+            while (p != &m_stTailer.SkipListNode)
+            {
+                callback(*Node::FromSkipListNode(p));
+                p = p->Adj[0].Next;
+            }
+        }
+
+    private:
+        Node m_stHeader;
+        Node m_stTailer;
+        SkipListDepthRandomizer<kSkipListDepth, 2> m_stRandomizer;
+    };
+
+    /**
+     * 每帧修改渲染层的对象
+     */
+    vector<size_t> MakeLayerChanges(size_t objectCount, size_t count) noexcept
+    {
+        Math::Randomizer rand;
+        rand.SetSeed(12345);
+        vector<size_t> ret;
+        ret.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            ret.push_back(rand.Next(static_cast<uint32_t>(objectCount - 1)));
+        return ret;
+    }
+}
+
+LSTG_BENCHMARK_CASE(GamePlay, RenderLayerIndex)
+{
+    const size_t kObjectCount = context.IsQuick() ? 1000 : 10000;
+    const size_t kFrames = context.Scale(300);
+    const size_t kChangesPerFrame = kObjectCount / 10;
+    auto changes = MakeLayerChanges(kObjectCount, kFrames * kChangesPerFrame);
+
+    // RenderLayerIndex
+    {
+        auto renderers = make_unique<Components::Renderer[]>(kObjectCount);
+        RenderLayerIndex index;
+
+        Stopwatch watch;
+        for (size_t i = 0; i < kObjectCount; ++i)
+        {
+            renderers[i].Layer = static_cast<double>(i % kLayerCount);
+            static_cast<void>(index.Insert(renderers[i], renderers[i].Layer, i + 1));
+        }
+        context.Report("RenderLayerIndex spawn", static_cast<double>(kObjectCount), watch.GetElapsed(), "insert");
+
+        // 修改渲染层：已有对象的排序键总是小于层内最新的对象
+        size_t visited = 0;
+        double changeTime = 0, traverseTime = 0;
+        for (size_t frame = 0; frame < kFrames; ++frame)
+        {
+            watch.Restart();
+            for (size_t j = 0; j < kChangesPerFrame; ++j)
+            {
+                auto i = changes[frame * kChangesPerFrame + j];
+                RenderLayerIndex::Remove(renderers[i]);
+                renderers[i].Layer = static_cast<double>((i + frame + 1) % kLayerCount);
+                static_cast<void>(index.Insert(renderers[i], renderers[i].Layer, i + 1));
+            }
+            changeTime += watch.GetElapsed();
+
+            watch.Restart();
+            index.Traverse([&](Components::Renderer& renderer) { ++visited; });
+            traverseTime += watch.GetElapsed();
+        }
+        context.Check(visited == kFrames * kObjectCount, "RenderLayerIndex visits every object once");
+        context.Report("RenderLayerIndex layer change", static_cast<double>(kFrames * kChangesPerFrame), changeTime, "change");
+        context.Report("RenderLayerIndex traverse (incl. sort)", static_cast<double>(visited), traverseTime, "obj");
+        context.Report("RenderLayerIndex frame", static_cast<double>(kFrames), changeTime + traverseTime, "frame");
+
+        // 校验顺序
+        double lastLayer = -1;
+        uint64_t lastKey = 0;
+        bool ordered = true;
+        index.Traverse([&](Components::Renderer& renderer) {
+            auto key = static_cast<uint64_t>(&renderer - renderers.get()) + 1;
+            if (renderer.Layer < lastLayer || (renderer.Layer == lastLayer && key <= lastKey))
+                ordered = false;
+            lastLayer = renderer.Layer;
+            lastKey = key;
+        });
+        context.Check(ordered, "RenderLayerIndex order");
+        index.Clear();
+    }
+
+    // 跳表
+    {
+        auto nodes = make_unique<SkipListLayerIndex::Node[]>(kObjectCount);
+        SkipListLayerIndex index;
+
+        Stopwatch watch;
+        for (size_t i = 0; i < kObjectCount; ++i)
+        {
+            nodes[i].Layer = static_cast<double>(i % kLayerCount);
+            nodes[i].SortKey = i + 1;
+            index.Insert(nodes[i]);
+        }
+        context.Report("IntrusiveSkipList spawn", static_cast<double>(kObjectCount), watch.GetElapsed(), "insert");
+
+        size_t visited = 0;
+        double changeTime = 0, traverseTime = 0;
+        for (size_t frame = 0; frame < kFrames; ++frame)
+        {
+            watch.Restart();
+            for (size_t j = 0; j < kChangesPerFrame; ++j)
+            {
+                auto i = changes[frame * kChangesPerFrame + j];
+                SkipListLayerIndex::Remove(nodes[i]);
+                nodes[i].Layer = static_cast<double>((i + frame + 1) % kLayerCount);
+                index.Insert(nodes[i]);
+            }
+            changeTime += watch.GetElapsed();
+
+            watch.Restart();
+            index.Traverse([&](SkipListLayerIndex::Node& node) { ++visited; });
+            traverseTime += watch.GetElapsed();
+        }
+        context.Check(visited == kFrames * kObjectCount, "IntrusiveSkipList visits every object once");
+        context.Report("IntrusiveSkipList layer change", static_cast<double>(kFrames * kChangesPerFrame), changeTime, "change");
+        context.Report("IntrusiveSkipList traverse", static_cast<double>(visited), traverseTime, "obj");
+        context.Report("IntrusiveSkipList frame", static_cast<double>(kFrames), changeTime + traverseTime, "frame");
+    }
+}
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @date 2022/9/23
+ * @author 9chu
+ * 此文件为 LuaSTGPlus 项目的一部分，版权与许可声明详见 COPYRIGHT.txt。
+ */
+#include "../Benchmark.hpp"
+
+#include <lstg/Core/Subsystem/Script/LuaState.hpp>
+#include <lstg/Core/Subsystem/Script/LuaRead.hpp>
+#include <lstg/v2/GamePlay/ScriptObjectPool.hpp>
+
+using namespace std;
+using namespace lstg;
+using namespace lstg::Benchmark;
+using namespace lstg::Subsystem::Script;
+using namespace lstg::v2::GamePlay;
+
+namespace
+{
+    class NullScriptObjectBridge :
+        public IScriptObjectBridge
+    {
+    public:
+        int OnGetAttribute(LuaStack stack, ECS::EntityId id, std::string_view key) override
+        {
+            return 0;
+        }
+
+        bool OnSetAttribute(LuaStack stack, ECS::EntityId id, std::string_view key, LuaStack::AbsIndex value) override
+        {
+            return false;
+        }
+    };
+
+    // 返回类、读取计数的方法、替换 frame 回调的方法
+    const char kClassScript[] = R"(
+        local counter = 0
+        local class = { is_class = true }
+        class[1] = function(self) end
+        class[3] = function(self) counter = counter + 1 end
+        return class,
+            function() return counter end,
+            function() class[3] = function(self) counter = counter + 1000 end end
+    )";
+
+    double ReadCounter(LuaState& state, LuaStack::AbsIndex getter)
+    {
+        state.PushValue(getter);
+        static_cast<void>(state.ProtectedCallWithTraceback(0, 1));
+        auto ret = state.ReadValue<double>(-1);
+        state.Pop(1);
+        return ret;
+    }
+}
+
+LSTG_BENCHMARK_CASE(GamePlay, ScriptCallback)
+{
+    const size_t kObjectCount = context.IsQuick() ? 1000 : 10000;
+    const size_t kPasses = context.Scale(100);
+
+    LuaState state;
+    state.OpenStandardLibrary();
+    NullScriptObjectBridge bridge;
+    ScriptObjectPool pool(state, &bridge);
+
+    if (!context.Check(state.LoadString(kClassScript) && state.ProtectedCallWithTraceback(0, 3), "load class script"))
+        return;
+    LuaStack::AbsIndex classIndex(state.GetTop() - 2);
+    LuaStack::AbsIndex counterGetter(state.GetTop() - 1);
+    LuaStack::AbsIndex frameReplacer(state.GetTop());
+
+    auto classId = pool.AcquireClass(state, classIndex);
+    if (!context.Check(classId && *classId != kInvalidScriptClassId, "AcquireClass"))
+        return;
+
+    vector<ScriptObjectId> objects;
+    objects.reserve(kObjectCount);
+    for (size_t i = 0; i < kObjectCount; ++i)
+    {
+        auto ret = pool.Alloc(state, classIndex, static_cast<ECS::EntityId>(i));
+        if (!context.Check(static_cast<bool>(ret), "Alloc"))
+            return;
+        objects.push_back(std::get<0>(*ret));
+        state.Pop(1);
+    }
+
+    // 逐次查找类表
+    Stopwatch watch;
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        for (auto id : objects)
+            pool.InvokeCallback(state, id, ScriptCallbackFunctions::OnFrame, 0);
+    }
+    context.Report("OnFrame (object -> class lookup)", static_cast<double>(kPasses * kObjectCount), watch.GetElapsed(), "call");
+
+    // 通过类缓存，与 GameWorld 一样在每次遍历前刷新
+    watch.Restart();
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        pool.RefreshClassCache(state);
+        for (auto id : objects)
+            pool.InvokeCallback(state, id, *classId, ScriptCallbackFunctions::OnFrame, 0);
+    }
+    context.Report("OnFrame (class cache)", static_cast<double>(kPasses * kObjectCount), watch.GetElapsed(), "call");
+    context.Check(ReadCounter(state, counterGetter) == static_cast<double>(2 * kPasses * kObjectCount), "OnFrame call count");
+
+    // 未定义的回调
+    watch.Restart();
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        for (auto id : objects)
+            pool.InvokeCallback(state, id, ScriptCallbackFunctions::OnRender, 0);
+    }
+    context.Report("Undefined OnRender (object -> class lookup)", static_cast<double>(kPasses * kObjectCount), watch.GetElapsed(),
+        "call");
+
+    watch.Restart();
+    for (size_t pass = 0; pass < kPasses; ++pass)
+    {
+        pool.RefreshClassCache(state);
+        for (auto id : objects)
+            pool.InvokeCallback(state, id, *classId, ScriptCallbackFunctions::OnRender, 0);
+    }
+    context.Report("Undefined OnRender (class cache)", static_cast<double>(kPasses * kObjectCount), watch.GetElapsed(), "call");
+
+    // 遍历中替换的回调要到下一次刷新才生效
+    auto before = ReadCounter(state, counterGetter);
+    state.PushValue(frameReplacer);
+    static_cast<void>(state.ProtectedCallWithTraceback(0, 0));
+    pool.InvokeCallback(state, objects[0], *classId, ScriptCallbackFunctions::OnFrame, 0);
+    context.Check(ReadCounter(state, counterGetter) == before + 1, "replaced callback is not seen before refresh");
+    pool.RefreshClassCache(state);
+    pool.InvokeCallback(state, objects[0], *classId, ScriptCallbackFunctions::OnFrame, 0);
+    context.Check(ReadCounter(state, counterGetter) == before + 1001, "replaced callback is seen after refresh");
+
+    for (auto id : objects)
+        pool.Free(state, id);
+    pool.ReleaseClass(*classId);
+    state.Pop(3);
+}